@@ -0,0 +1,211 @@
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+//Constant initialised so they are already zero when static constructors in other files allocate
+atomic<unsigned long long> AllocationCounter::allocationCount(0);
+atomic<unsigned long long> AllocationCounter::allocatedBytes(0);
+
+unsigned long long AllocationCounter::GetAllocationCount()
+{
+	return allocationCount.load(memory_order_relaxed);
+}
+
+unsigned long long AllocationCounter::GetAllocatedBytes()
+{
+	return allocatedBytes.load(memory_order_relaxed);
+}
+
+void AllocationCounter::CountAllocation(const size_t size)
+{
+	allocationCount.fetch_add(1, memory_order_relaxed);
+	allocatedBytes.fetch_add(size, memory_order_relaxed);
+}
+
+//Every replaced operator new allocates through here. Over-aligned types such as the SIMD matrix batches come through
+//the align_val_t forms, and their memory has to go back through the aligned free that matches the allocation
+static void* Allocate(size_t size, const size_t alignment)
+{
+	AllocationCounter::CountAllocation(size);
+
+	if (size == 0)
+	{
+		size = 1;
+	}
+
+	while (true)
+	{
+		void* memory = nullptr;
+
+		if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+		{
+			memory = malloc(size);
+		}
+		else
+		{
+#if defined(_MSC_VER)
+			memory = _aligned_malloc(size, alignment);
+#else
+			//aligned_alloc wants a whole number of alignments
+			memory = aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+		}
+
+		if (memory)
+		{
+			return memory;
+		}
+
+		const auto handler = get_new_handler();
+
+		if (!handler)
+		{
+			throw bad_alloc();
+		}
+
+		handler();
+	}
+}
+
+static void FreeAligned(void* memory, const size_t alignment)
+{
+#if defined(_MSC_VER)
+	if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+	{
+		_aligned_free(memory);
+		return;
+	}
+#else
+	static_cast<void>(alignment);
+#endif
+
+	free(memory);
+}
+
+void* operator new(size_t size)
+{
+	return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](size_t size)
+{
+	return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(size_t size, align_val_t alignment)
+{
+	return Allocate(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, align_val_t alignment)
+{
+	return Allocate(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept
+{
+	try
+	{
+		return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+	}
+	catch (const bad_alloc&)
+	{
+		return nullptr;
+	}
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept
+{
+	try
+	{
+		return Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+	}
+	catch (const bad_alloc&)
+	{
+		return nullptr;
+	}
+}
+
+void* operator new(size_t size, align_val_t alignment, const nothrow_t&) noexcept
+{
+	try
+	{
+		return Allocate(size, static_cast<size_t>(alignment));
+	}
+	catch (const bad_alloc&)
+	{
+		return nullptr;
+	}
+}
+
+void* operator new[](size_t size, align_val_t alignment, const nothrow_t&) noexcept
+{
+	try
+	{
+		return Allocate(size, static_cast<size_t>(alignment));
+	}
+	catch (const bad_alloc&)
+	{
+		return nullptr;
+	}
+}
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, const nothrow_t&) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory, const nothrow_t&) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, align_val_t alignment) noexcept
+{
+	FreeAligned(memory, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* memory, align_val_t alignment) noexcept
+{
+	FreeAligned(memory, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* memory, size_t, align_val_t alignment) noexcept
+{
+	FreeAligned(memory, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* memory, size_t, align_val_t alignment) noexcept
+{
+	FreeAligned(memory, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* memory, align_val_t alignment, const nothrow_t&) noexcept
+{
+	FreeAligned(memory, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* memory, align_val_t alignment, const nothrow_t&) noexcept
+{
+	FreeAligned(memory, static_cast<size_t>(alignment));
+}
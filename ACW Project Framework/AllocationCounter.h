@@ -0,0 +1,22 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+using namespace std;
+
+//Counts every allocation made through operator new anywhere in the process, AllocationCounter.cpp replaces the
+//global operator new and delete, array, aligned and nothrow forms included, to do it. Allocations made with malloc or
+//by the graphics driver aren't counted
+class AllocationCounter
+{
+public:
+	static unsigned long long GetAllocationCount();
+	static unsigned long long GetAllocatedBytes();
+
+	static void CountAllocation(const size_t size);
+
+private:
+	static atomic<unsigned long long> allocationCount;
+	static atomic<unsigned long long> allocatedBytes;
+};
@@ -1,6 +1,7 @@
 #include "ColourShader.h"
 
-ColourShader::ColourShader(ID3D11Device* device, HWND hwnd) : Shader("ColourVertexShader", "ColourHullShader", "ColourDomainShader", "ColourPixelShader", device, hwnd), inputLayout(nullptr) {
+//Its vertices carry a colour rather than a model's attributes, so they are never in a compact format
+ColourShader::ColourShader(ID3D11Device* device, HWND hwnd) : Shader("ColourVertexShader", "ColourHullShader", "ColourDomainShader", "ColourPixelShader", device, hwnd, MeshVertexFormat::Full), inputLayout(nullptr) {
     D3D11_INPUT_ELEMENT_DESC layout[6];
     unsigned int elementCount = 0;
 
@@ -34,7 +35,7 @@ ColourShader::~ColourShader() {
 ColourShader& ColourShader::operator=(const ColourShader & other) = default;
 ColourShader& ColourShader::operator=(ColourShader && other) noexcept = default;
 
-bool ColourShader::Render(ID3D11DeviceContext * deviceContext, int indexCount, int instanceCount, const XMMATRIX & viewMatrix, const XMMATRIX & projectionMatrix, const vector<ID3D11ShaderResourceView*>&textures, const vector<ID3D11ShaderResourceView*>&depthTextures, const vector<shared_ptr<Light>>&pointLightList, const XMFLOAT3 & cameraPosition) {
+bool ColourShader::Render(RenderContext* deviceContext, int indexCount, int instanceCount, const XMMATRIX & viewMatrix, const XMMATRIX & projectionMatrix, const vector<ID3D11ShaderResourceView*>&textures, const vector<ID3D11ShaderResourceView*>&depthTextures, const vector<shared_ptr<Light>>&pointLightList, const XMFLOAT3 & cameraPosition) {
     bool result = SetColourShaderParameters(deviceContext, viewMatrix, projectionMatrix, cameraPosition);
     if (!result) {
         return false;
@@ -44,12 +45,12 @@ bool ColourShader::Render(ID3D11DeviceContext * deviceContext, int indexCount, i
     return true;
 }
 
-bool ColourShader::SetColourShaderParameters(ID3D11DeviceContext * deviceContext, const XMMATRIX & viewMatrix, const XMMATRIX & projectionMatrix, const XMFLOAT3 & cameraPosition) {
+bool ColourShader::SetColourShaderParameters(RenderContext* deviceContext, const XMMATRIX & viewMatrix, const XMMATRIX & projectionMatrix, const XMFLOAT3 & cameraPosition) {
     return SetShaderParameters(deviceContext, viewMatrix, projectionMatrix, cameraPosition);
 }
 
-void ColourShader::RenderShader(ID3D11DeviceContext * deviceContext, int indexCount, int instanceCount) const {
+void ColourShader::RenderShader(RenderContext* deviceContext, int indexCount, int instanceCount) const {
     deviceContext->IASetInputLayout(inputLayout);
     SetShader(deviceContext);
-    deviceContext->DrawInstanced(indexCount, instanceCount, 0, 0);
+    deviceContext->DrawIndexedInstanced(indexCount, instanceCount, 0, 0, 0);
 }
@@ -21,11 +21,11 @@ public:
 	ColourShader& operator = (const ColourShader& other); // Copy Assignment Operator
 	ColourShader& operator = (ColourShader && other) noexcept; // Move Assignment Operator
 
-	bool Render(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) override;
+	bool Render(RenderContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) override;
 
 private:
-	bool SetColourShaderParameters(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition);
-	void RenderShader(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount) const;
+	bool SetColourShaderParameters(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition);
+	void RenderShader(RenderContext* const deviceContext, const int indexCount, const int instanceCount) const;
 
 	ID3D11InputLayout* inputLayout;
 };
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include "D3D11RenderContext.h"
+
+D3D11RenderContext::D3D11RenderContext(ID3D11DeviceContext* const deviceContext) : deviceContext(deviceContext)
+{
+}
+
+D3D11RenderContext::D3D11RenderContext(const D3D11RenderContext& other) = default;
+
+D3D11RenderContext::D3D11RenderContext(D3D11RenderContext&& other) noexcept = default;
+
+D3D11RenderContext::~D3D11RenderContext() = default;
+
+D3D11RenderContext& D3D11RenderContext::operator=(const D3D11RenderContext& other) = default;
+
+D3D11RenderContext& D3D11RenderContext::operator=(D3D11RenderContext&& other) noexcept = default;
+
+ID3D11DeviceContext* D3D11RenderContext::GetDeviceContext() const
+{
+	return deviceContext;
+}
+
+void D3D11RenderContext::GetDevice(ID3D11Device** device)
+{
+	deviceContext->GetDevice(device);
+}
+
+HRESULT D3D11RenderContext::Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags, D3D11_MAPPED_SUBRESOURCE* mappedResource)
+{
+	return deviceContext->Map(resource, subresource, mapType, mapFlags, mappedResource);
+}
+
+void D3D11RenderContext::Unmap(ID3D11Resource* resource, UINT subresource)
+{
+	deviceContext->Unmap(resource, subresource);
+}
+
+void D3D11RenderContext::UpdateSubresource(ID3D11Resource* destinationResource, UINT destinationSubresource, const D3D11_BOX* destinationBox, const void* sourceData, UINT sourceRowPitch, UINT sourceDepthPitch)
+{
+	deviceContext->UpdateSubresource(destinationResource, destinationSubresource, destinationBox, sourceData, sourceRowPitch, sourceDepthPitch);
+}
+
+void D3D11RenderContext::IASetInputLayout(ID3D11InputLayout* inputLayout)
+{
+	deviceContext->IASetInputLayout(inputLayout);
+}
+
+void D3D11RenderContext::IASetVertexBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* vertexBuffers, const UINT* strides, const UINT* offsets)
+{
+	deviceContext->IASetVertexBuffers(startSlot, numberOfBuffers, vertexBuffers, strides, offsets);
+}
+
+void D3D11RenderContext::IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset)
+{
+	deviceContext->IASetIndexBuffer(indexBuffer, format, offset);
+}
+
+void D3D11RenderContext::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology)
+{
+	deviceContext->IASetPrimitiveTopology(topology);
+}
+
+void D3D11RenderContext::VSSetShader(ID3D11VertexShader* vertexShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances)
+{
+	deviceContext->VSSetShader(vertexShader, classInstances, numberOfClassInstances);
+}
+
+void D3D11RenderContext::HSSetShader(ID3D11HullShader* hullShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances)
+{
+	deviceContext->HSSetShader(hullShader, classInstances, numberOfClassInstances);
+}
+
+void D3D11RenderContext::DSSetShader(ID3D11DomainShader* domainShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances)
+{
+	deviceContext->DSSetShader(domainShader, classInstances, numberOfClassInstances);
+}
+
+void D3D11RenderContext::PSSetShader(ID3D11PixelShader* pixelShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances)
+{
+	deviceContext->PSSetShader(pixelShader, classInstances, numberOfClassInstances);
+}
+
+void D3D11RenderContext::VSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers)
+{
+	deviceContext->VSSetConstantBuffers(startSlot, numberOfBuffers, constantBuffers);
+}
+
+void D3D11RenderContext::HSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers)
+{
+	deviceContext->HSSetConstantBuffers(startSlot, numberOfBuffers, constantBuffers);
+}
+
+void D3D11RenderContext::DSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers)
+{
+	deviceContext->DSSetConstantBuffers(startSlot, numberOfBuffers, constantBuffers);
+}
+
+void D3D11RenderContext::PSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers)
+{
+	deviceContext->PSSetConstantBuffers(startSlot, numberOfBuffers, constantBuffers);
+}
+
+void D3D11RenderContext::DSSetShaderResources(UINT startSlot, UINT numberOfViews, ID3D11ShaderResourceView* const* shaderResourceViews)
+{
+	deviceContext->DSSetShaderResources(startSlot, numberOfViews, shaderResourceViews);
+}
+
+void D3D11RenderContext::PSSetShaderResources(UINT startSlot, UINT numberOfViews, ID3D11ShaderResourceView* const* shaderResourceViews)
+{
+	deviceContext->PSSetShaderResources(startSlot, numberOfViews, shaderResourceViews);
+}
+
+void D3D11RenderContext::DSSetSamplers(UINT startSlot, UINT numberOfSamplers, ID3D11SamplerState* const* samplers)
+{
+	deviceContext->DSSetSamplers(startSlot, numberOfSamplers, samplers);
+}
+
+void D3D11RenderContext::PSSetSamplers(UINT startSlot, UINT numberOfSamplers, ID3D11SamplerState* const* samplers)
+{
+	deviceContext->PSSetSamplers(startSlot, numberOfSamplers, samplers);
+}
+
+void D3D11RenderContext::RSSetState(ID3D11RasterizerState* rasterizerState)
+{
+	deviceContext->RSSetState(rasterizerState);
+}
+
+void D3D11RenderContext::RSSetViewports(UINT numberOfViewports, const D3D11_VIEWPORT* viewports)
+{
+	deviceContext->RSSetViewports(numberOfViewports, viewports);
+}
+
+void D3D11RenderContext::OMSetRenderTargets(UINT numberOfViews, ID3D11RenderTargetView* const* renderTargetViews, ID3D11DepthStencilView* depthStencilView)
+{
+	deviceContext->OMSetRenderTargets(numberOfViews, renderTargetViews, depthStencilView);
+}
+
+void D3D11RenderContext::OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilReference)
+{
+	deviceContext->OMSetDepthStencilState(depthStencilState, stencilReference);
+}
+
+void D3D11RenderContext::OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask)
+{
+	deviceContext->OMSetBlendState(blendState, blendFactor, sampleMask);
+}
+
+void D3D11RenderContext::ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colorRGBA[4])
+{
+	deviceContext->ClearRenderTargetView(renderTargetView, colorRGBA);
+}
+
+void D3D11RenderContext::ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags, FLOAT depth, UINT8 stencil)
+{
+	deviceContext->ClearDepthStencilView(depthStencilView, clearFlags, depth, stencil);
+}
+
+void D3D11RenderContext::DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation)
+{
+	deviceContext->DrawIndexed(indexCount, startIndexLocation, baseVertexLocation);
+}
+
+void D3D11RenderContext::DrawInstanced(UINT vertexCountPerInstance, UINT instanceCount, UINT startVertexLocation, UINT startInstanceLocation)
+{
+	deviceContext->DrawInstanced(vertexCountPerInstance, instanceCount, startVertexLocation, startInstanceLocation);
+}
+
+void D3D11RenderContext::DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount, UINT startIndexLocation, INT baseVertexLocation, UINT startInstanceLocation)
+{
+	deviceContext->DrawIndexedInstanced(indexCountPerInstance, instanceCount, startIndexLocation, baseVertexLocation, startInstanceLocation);
+}
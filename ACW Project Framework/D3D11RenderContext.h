@@ -0,0 +1,62 @@
+#pragma once
+
+#include "RenderContext.h"
+
+//Submits straight to the Direct3D 11 immediate context, the context is owned and released by GraphicsDeviceManager
+class D3D11RenderContext : public RenderContext
+{
+public:
+	explicit D3D11RenderContext(ID3D11DeviceContext* const deviceContext);
+	D3D11RenderContext(const D3D11RenderContext& other); // Copy Constructor
+	D3D11RenderContext(D3D11RenderContext&& other) noexcept; // Move Constructor
+	~D3D11RenderContext() override;
+
+	D3D11RenderContext& operator = (const D3D11RenderContext& other); // Copy Assignment Operator
+	D3D11RenderContext& operator = (D3D11RenderContext&& other) noexcept; // Move Assignment Operator
+
+	ID3D11DeviceContext* GetDeviceContext() const;
+
+	void GetDevice(ID3D11Device** device) override;
+
+	HRESULT Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags, D3D11_MAPPED_SUBRESOURCE* mappedResource) override;
+	void Unmap(ID3D11Resource* resource, UINT subresource) override;
+	void UpdateSubresource(ID3D11Resource* destinationResource, UINT destinationSubresource, const D3D11_BOX* destinationBox, const void* sourceData, UINT sourceRowPitch, UINT sourceDepthPitch) override;
+
+	void IASetInputLayout(ID3D11InputLayout* inputLayout) override;
+	void IASetVertexBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* vertexBuffers, const UINT* strides, const UINT* offsets) override;
+	void IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset) override;
+	void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) override;
+
+	void VSSetShader(ID3D11VertexShader* vertexShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances) override;
+	void HSSetShader(ID3D11HullShader* hullShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances) override;
+	void DSSetShader(ID3D11DomainShader* domainShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances) override;
+	void PSSetShader(ID3D11PixelShader* pixelShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances) override;
+
+	void VSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers) override;
+	void HSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers) override;
+	void DSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers) override;
+	void PSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers) override;
+
+	void DSSetShaderResources(UINT startSlot, UINT numberOfViews, ID3D11ShaderResourceView* const* shaderResourceViews) override;
+	void PSSetShaderResources(UINT startSlot, UINT numberOfViews, ID3D11ShaderResourceView* const* shaderResourceViews) override;
+
+	void DSSetSamplers(UINT startSlot, UINT numberOfSamplers, ID3D11SamplerState* const* samplers) override;
+	void PSSetSamplers(UINT startSlot, UINT numberOfSamplers, ID3D11SamplerState* const* samplers) override;
+
+	void RSSetState(ID3D11RasterizerState* rasterizerState) override;
+	void RSSetViewports(UINT numberOfViewports, const D3D11_VIEWPORT* viewports) override;
+
+	void OMSetRenderTargets(UINT numberOfViews, ID3D11RenderTargetView* const* renderTargetViews, ID3D11DepthStencilView* depthStencilView) override;
+	void OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilReference) override;
+	void OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask) override;
+
+	void ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colorRGBA[4]) override;
+	void ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags, FLOAT depth, UINT8 stencil) override;
+
+	void DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation) override;
+	void DrawInstanced(UINT vertexCountPerInstance, UINT instanceCount, UINT startVertexLocation, UINT startInstanceLocation) override;
+	void DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount, UINT startIndexLocation, INT baseVertexLocation, UINT startInstanceLocation) override;
+
+private:
+	ID3D11DeviceContext* deviceContext;
+};
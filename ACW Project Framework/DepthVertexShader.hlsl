@@ -1,3 +1,5 @@
+#include "MeshVertex.hlsli"
+
 
 //Global
 cbuffer MatrixBuffer : register(b0)
@@ -23,9 +25,7 @@ cbuffer CameraBuffer : register(b2)
 //Type definitions
 struct VertexInput
 {
-	float3 position : POSITION;
-	float2 tex : TEXCOORD0;
-	float3 normal : NORMAL;
+	MeshVertexInput vertex;
 	matrix instanceWorldMatrix : INSTANCEMATRIX;
 };
 
@@ -40,12 +40,13 @@ struct HullInput
 HullInput DepthVertexShader(VertexInput input)
 {
 	HullInput output;
+	const MeshVertex vertex = DecodeMeshVertex(input.vertex);
 
 	//Calculate the position of the vertex against the matrices
-	output.position = mul(float4(input.position, 1.0f), input.instanceWorldMatrix).xyz;
+	output.position = mul(float4(vertex.position, 1.0f), input.instanceWorldMatrix).xyz;
 
-	output.tex = input.tex;
-	output.normal = normalize(mul(input.normal, (float3x3)input.instanceWorldMatrix));
+	output.tex = vertex.tex;
+	output.normal = normalize(mul(vertex.normal, (float3x3)input.instanceWorldMatrix));
 
 	float distanceToCamera = distance(output.position, cameraPosition);
 
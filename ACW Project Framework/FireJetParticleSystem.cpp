@@ -17,7 +17,7 @@ void FireJetParticleSystem::UpdateFireJetParticleSystem(const float dt)
 	UpdateParticles(dt);
 }
 
-bool FireJetParticleSystem::RenderFireJetParticleSystem(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition) const
+bool FireJetParticleSystem::RenderFireJetParticleSystem(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition) const
 {
 	return RenderParticles(deviceContext, viewMatrix, projectionMatrix, cameraPosition);
 }
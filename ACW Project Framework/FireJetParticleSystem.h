@@ -13,6 +13,6 @@ public:
 	FireJetParticleSystem& operator = (FireJetParticleSystem&& other) noexcept;
 
 	void UpdateFireJetParticleSystem(const float dt);
-	bool RenderFireJetParticleSystem(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition) const;
+	bool RenderFireJetParticleSystem(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition) const;
 };
 
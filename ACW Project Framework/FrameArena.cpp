@@ -0,0 +1,81 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdint>
+
+FrameArena::FrameArena(const size_t capacity) : block(make_unique<unsigned char[]>(capacity)), capacity(capacity), offset(0), highWaterMark(0), growCount(0), overflowLock(), overflowBlocks(), overflowBytes(0)
+{
+}
+
+FrameArena::~FrameArena() = default;
+
+void* FrameArena::Allocate(const size_t size, const size_t alignment)
+{
+	const auto base = reinterpret_cast<uintptr_t>(block.get());
+	auto current = offset.load(memory_order_relaxed);
+
+	//Claim the aligned range, another thread may have moved the offset since we read it
+	while (true)
+	{
+		const auto first = ((base + current + alignment - 1) & ~(alignment - 1)) - base;
+		const auto last = first + size;
+
+		if (last > capacity)
+		{
+			break;
+		}
+
+		if (offset.compare_exchange_weak(current, last, memory_order_relaxed))
+		{
+			return block.get() + first;
+		}
+	}
+
+	lock_guard<mutex> lock(overflowLock);
+
+	overflowBlocks.push_back(make_unique<unsigned char[]>(size + alignment));
+	overflowBytes += size;
+
+	const auto overflowBase = reinterpret_cast<uintptr_t>(overflowBlocks.back().get());
+
+	return reinterpret_cast<void*>((overflowBase + alignment - 1) & ~(alignment - 1));
+}
+
+void FrameArena::Reset()
+{
+	const auto usedBytes = GetUsedBytes();
+
+	highWaterMark = max(highWaterMark, usedBytes);
+
+	//Grow past what this frame needed so a frame that needs a little more doesn't overflow again
+	if (!overflowBlocks.empty())
+	{
+		capacity = max(capacity * 2, usedBytes);
+		block = make_unique<unsigned char[]>(capacity);
+		growCount++;
+
+		overflowBlocks.clear();
+		overflowBytes = 0;
+	}
+
+	offset = 0;
+}
+
+size_t FrameArena::GetCapacity() const
+{
+	return capacity;
+}
+
+size_t FrameArena::GetUsedBytes() const
+{
+	return offset.load(memory_order_relaxed) + overflowBytes;
+}
+
+size_t FrameArena::GetHighWaterMark() const
+{
+	return highWaterMark;
+}
+
+int FrameArena::GetGrowCount() const
+{
+	return growCount;
+}
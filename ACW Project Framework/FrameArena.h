@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+//Bump allocator for data that only lives until the end of a frame. Allocating moves an offset along one block and
+//Reset frees everything at once, nothing is freed on its own.
+//A frame that needs more than the block holds gets the rest from the heap and the next Reset grows the block to fit,
+//so once the first few frames have sized it a frame makes no heap allocations.
+//Allocate can be called from several threads at once, Reset only while nothing is allocating or using the memory
+class FrameArena
+{
+public:
+	explicit FrameArena(const size_t capacity);
+	FrameArena(const FrameArena& other) = delete; // Copy Constructor
+	FrameArena(FrameArena&& other) noexcept = delete; // Move Constructor
+	~FrameArena(); // Destructor
+
+	FrameArena& operator = (const FrameArena& other) = delete; // Copy Assignment Operator
+	FrameArena& operator = (FrameArena&& other) noexcept = delete; // Move Assignment Operator
+
+	//alignment has to be a power of two
+	void* Allocate(const size_t size, const size_t alignment);
+
+	template <typename T>
+	T* Allocate(const size_t count)
+	{
+		return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+	}
+
+	void Reset();
+
+	size_t GetCapacity() const;
+	//Bytes handed out since the last Reset, including any that came from the heap
+	size_t GetUsedBytes() const;
+	//Most bytes any frame has used
+	size_t GetHighWaterMark() const;
+	//Times the block has been grown
+	int GetGrowCount() const;
+
+private:
+	unique_ptr<unsigned char[]> block;
+	size_t capacity;
+	atomic<size_t> offset;
+
+	size_t highWaterMark;
+	int growCount;
+
+	//Allocations that didn't fit this frame
+	mutex overflowLock;
+	vector<unique_ptr<unsigned char[]>> overflowBlocks;
+	size_t overflowBytes;
+};
+
+//Lets standard containers allocate from a FrameArena, deallocate does nothing so the memory goes back on Reset
+template <typename T>
+class FrameAllocator
+{
+public:
+	typedef T value_type;
+
+	explicit FrameAllocator(FrameArena& arena) : arena(&arena)
+	{
+	}
+
+	template <typename U>
+	FrameAllocator(const FrameAllocator<U>& other) : arena(other.GetArena())
+	{
+	}
+
+	T* allocate(const size_t count)
+	{
+		return arena->Allocate<T>(count);
+	}
+
+	void deallocate(T* const, const size_t)
+	{
+	}
+
+	FrameArena* GetArena() const
+	{
+		return arena;
+	}
+
+	template <typename U>
+	bool operator == (const FrameAllocator<U>& other) const
+	{
+		return arena == other.GetArena();
+	}
+
+	template <typename U>
+	bool operator != (const FrameAllocator<U>& other) const
+	{
+		return arena != other.GetArena();
+	}
+
+private:
+	FrameArena* arena;
+};
+
+//A vector that has to be gone before the arena it came from is Reset
+template <typename T>
+using FrameVector = vector<T, FrameAllocator<T>>;
@@ -0,0 +1,251 @@
+#include "FrameStatistics.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+FrameStatistics::FrameStatistics(const int windowSize) : windowSize(max(windowSize, 1)), phases()
+{
+}
+
+FrameStatistics::FrameStatistics(const FrameStatistics& other) = default;
+
+FrameStatistics::FrameStatistics(FrameStatistics&& other) noexcept = default;
+
+FrameStatistics::~FrameStatistics() = default;
+
+FrameStatistics& FrameStatistics::operator=(const FrameStatistics& other) = default;
+
+FrameStatistics& FrameStatistics::operator=(FrameStatistics&& other) noexcept = default;
+
+int FrameStatistics::AddPhase(const string& name)
+{
+	Phase phase;
+	phase.name = name;
+	phase.samples.resize(windowSize);
+	phase.nextSample = 0;
+	phase.sampleCount = 0;
+	phase.histogram.resize(FRAME_STATISTICS_BUCKET_COUNT);
+	phase.totalSampleCount = 0;
+	phase.max = 0;
+	phase.hitchCount = 0;
+	phase.hitchDuration = 0;
+	phase.samplesUntilHitchRefresh = 0;
+
+	phases.push_back(move(phase));
+
+	return static_cast<int>(phases.size()) - 1;
+}
+
+void FrameStatistics::Record(const int phase, const long long duration)
+{
+	auto& recordedPhase = phases[phase];
+
+	//Compared with the median before this sample so a run of slow frames is counted until they become the median
+	if (recordedPhase.sampleCount >= FRAME_STATISTICS_HITCH_WARM_UP)
+	{
+		if (recordedPhase.samplesUntilHitchRefresh == 0)
+		{
+			recordedPhase.hitchDuration = max(static_cast<long long>(GetPercentile(recordedPhase, 0.5) * FRAME_STATISTICS_HITCH_FACTOR), FRAME_STATISTICS_HITCH_MINIMUM);
+			recordedPhase.samplesUntilHitchRefresh = FRAME_STATISTICS_HITCH_REFRESH;
+		}
+
+		recordedPhase.samplesUntilHitchRefresh--;
+
+		if (duration > recordedPhase.hitchDuration)
+		{
+			recordedPhase.hitchCount++;
+		}
+	}
+
+	if (recordedPhase.sampleCount == windowSize)
+	{
+		recordedPhase.histogram[GetBucket(recordedPhase.samples[recordedPhase.nextSample])]--;
+	}
+	else
+	{
+		recordedPhase.sampleCount++;
+	}
+
+	recordedPhase.samples[recordedPhase.nextSample] = duration;
+	recordedPhase.histogram[GetBucket(duration)]++;
+	recordedPhase.nextSample = (recordedPhase.nextSample + 1) % windowSize;
+
+	recordedPhase.totalSampleCount++;
+	recordedPhase.max = max(recordedPhase.max, duration);
+}
+
+int FrameStatistics::GetPhaseCount() const
+{
+	return static_cast<int>(phases.size());
+}
+
+FramePhaseSummary FrameStatistics::GetSummary(const int phase) const
+{
+	const auto& summarisedPhase = phases[phase];
+
+	FramePhaseSummary summary;
+	summary.name = summarisedPhase.name;
+	summary.windowSampleCount = summarisedPhase.sampleCount;
+	summary.sampleCount = summarisedPhase.totalSampleCount;
+	summary.p50 = GetPercentile(summarisedPhase, 0.5);
+	summary.p95 = GetPercentile(summarisedPhase, 0.95);
+	summary.p99 = GetPercentile(summarisedPhase, 0.99);
+	summary.windowMax = 0;
+	summary.max = summarisedPhase.max;
+	summary.hitchCount = summarisedPhase.hitchCount;
+
+	for (auto i = 0; i < summarisedPhase.sampleCount; i++)
+	{
+		summary.windowMax = max(summary.windowMax, summarisedPhase.samples[i]);
+	}
+
+	//The buckets only give an upper bound, no percentile is more than the slowest sample
+	summary.p50 = min(summary.p50, summary.windowMax);
+	summary.p95 = min(summary.p95, summary.windowMax);
+	summary.p99 = min(summary.p99, summary.windowMax);
+
+	return summary;
+}
+
+void FrameStatistics::WriteSummary(ostream& output) const
+{
+	output << left << setw(32) << "Phase" << right << setw(10) << "Samples" << setw(10) << "p50 ms" << setw(10) << "p95 ms" << setw(10) << "p99 ms" << setw(10) << "Max ms" << setw(10) << "Hitches" << endl;
+
+	output << fixed << setprecision(3);
+
+	for (auto i = 0; i < GetPhaseCount(); i++)
+	{
+		const auto summary = GetSummary(i);
+
+		output << left << setw(32) << summary.name << right << setw(10) << summary.sampleCount << setw(10) << summary.p50 / 1000000.0 << setw(10) << summary.p95 / 1000000.0
+			<< setw(10) << summary.p99 / 1000000.0 << setw(10) << summary.max / 1000000.0 << setw(10) << summary.hitchCount << endl;
+	}
+
+	output << defaultfloat;
+}
+
+void FrameStatistics::WriteCsv(ostream& output) const
+{
+	output << "phase,samples,window_samples,p50_ms,p95_ms,p99_ms,window_max_ms,max_ms,hitches" << endl;
+
+	output << fixed << setprecision(6);
+
+	for (auto i = 0; i < GetPhaseCount(); i++)
+	{
+		const auto summary = GetSummary(i);
+
+		output << summary.name << "," << summary.sampleCount << "," << summary.windowSampleCount << "," << summary.p50 / 1000000.0 << "," << summary.p95 / 1000000.0 << ","
+			<< summary.p99 / 1000000.0 << "," << summary.windowMax / 1000000.0 << "," << summary.max / 1000000.0 << "," << summary.hitchCount << endl;
+	}
+
+	output << defaultfloat;
+}
+
+void FrameStatistics::WriteJson(ostream& output) const
+{
+	output << "{\"phases\":[";
+
+	output << fixed << setprecision(6);
+
+	for (auto i = 0; i < GetPhaseCount(); i++)
+	{
+		const auto summary = GetSummary(i);
+
+		output << (i == 0 ? "" : ",") << "\n{\"name\":\"" << summary.name << "\",\"samples\":" << summary.sampleCount << ",\"window_samples\":" << summary.windowSampleCount
+			<< ",\"p50_ms\":" << summary.p50 / 1000000.0 << ",\"p95_ms\":" << summary.p95 / 1000000.0 << ",\"p99_ms\":" << summary.p99 / 1000000.0
+			<< ",\"window_max_ms\":" << summary.windowMax / 1000000.0 << ",\"max_ms\":" << summary.max / 1000000.0 << ",\"hitches\":" << summary.hitchCount << "}";
+	}
+
+	output << defaultfloat;
+
+	output << "\n]}" << endl;
+}
+
+bool FrameStatistics::ExportCsv(const string& fileName) const
+{
+	ofstream output(fileName);
+
+	if (!output)
+	{
+		return false;
+	}
+
+	WriteCsv(output);
+
+	return static_cast<bool>(output);
+}
+
+bool FrameStatistics::ExportJson(const string& fileName) const
+{
+	ofstream output(fileName);
+
+	if (!output)
+	{
+		return false;
+	}
+
+	WriteJson(output);
+
+	return static_cast<bool>(output);
+}
+
+int FrameStatistics::GetBucket(const long long duration)
+{
+	if (duration < FRAME_STATISTICS_SUB_BUCKETS)
+	{
+		return static_cast<int>(max(duration, 0ll));
+	}
+
+	const auto clampedDuration = min(duration, (1ll << FRAME_STATISTICS_MAX_EXPONENT) - 1);
+
+	//The power of two below the duration picks the range, the next 4 bits the bucket in it
+	auto exponent = 4;
+
+	while ((clampedDuration >> (exponent + 1)) != 0)
+	{
+		exponent++;
+	}
+
+	const auto subBucket = static_cast<int>((clampedDuration >> (exponent - 4)) & (FRAME_STATISTICS_SUB_BUCKETS - 1));
+
+	return (exponent - 3) * FRAME_STATISTICS_SUB_BUCKETS + subBucket;
+}
+
+long long FrameStatistics::GetBucketUpperBound(const int bucket)
+{
+	const auto nextBucket = bucket + 1;
+
+	if (nextBucket < FRAME_STATISTICS_SUB_BUCKETS)
+	{
+		return bucket;
+	}
+
+	const auto exponent = nextBucket / FRAME_STATISTICS_SUB_BUCKETS + 3;
+	const auto subBucket = nextBucket % FRAME_STATISTICS_SUB_BUCKETS;
+
+	return (static_cast<long long>(FRAME_STATISTICS_SUB_BUCKETS + subBucket) << (exponent - 4)) - 1;
+}
+
+long long FrameStatistics::GetPercentile(const Phase& phase, const double percentile)
+{
+	if (phase.sampleCount == 0)
+	{
+		return 0;
+	}
+
+	const auto rank = max(static_cast<int>(ceil(percentile * phase.sampleCount)), 1);
+	auto count = 0;
+
+	for (auto bucket = 0; bucket < FRAME_STATISTICS_BUCKET_COUNT; bucket++)
+	{
+		count += phase.histogram[bucket];
+
+		if (count >= rank)
+		{
+			return GetBucketUpperBound(bucket);
+		}
+	}
+
+	return GetBucketUpperBound(FRAME_STATISTICS_BUCKET_COUNT - 1);
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+//Frames each phase's percentiles are taken over
+const int FRAME_STATISTICS_WINDOW = 600;
+
+//A sample is a hitch if it takes this many times the phase's median, and at least the minimum so phases that take
+//microseconds don't count noise
+const double FRAME_STATISTICS_HITCH_FACTOR = 2.0;
+const long long FRAME_STATISTICS_HITCH_MINIMUM = 1000000;
+//Samples a phase needs before its median means anything
+const int FRAME_STATISTICS_HITCH_WARM_UP = 30;
+//Samples between rescans of the histogram for the median, it barely moves over that many frames
+const int FRAME_STATISTICS_HITCH_REFRESH = 30;
+
+//16 buckets for every power of two up to 2^40 ns, so a percentile is within about 6% of the real time
+const int FRAME_STATISTICS_SUB_BUCKETS = 16;
+const int FRAME_STATISTICS_MAX_EXPONENT = 40;
+const int FRAME_STATISTICS_BUCKET_COUNT = (FRAME_STATISTICS_MAX_EXPONENT - 3) * FRAME_STATISTICS_SUB_BUCKETS;
+
+//Times are in nanoseconds, percentiles and the window max are over the last FRAME_STATISTICS_WINDOW samples,
+//everything else is since the phase was added
+struct FramePhaseSummary
+{
+	string name;
+	int windowSampleCount;
+	unsigned long long sampleCount;
+	long long p50;
+	long long p95;
+	long long p99;
+	long long windowMax;
+	long long max;
+	unsigned long long hitchCount;
+};
+
+//Keeps a rolling histogram of how long each phase of a frame takes, for example the whole frame, the simulation
+//step and rendering. Recording a sample is a few increments, and a histogram scan for the hitch threshold every
+//FRAME_STATISTICS_HITCH_REFRESH samples, so it can be left on in every build.
+//A phase can be recorded from any thread as long as only one thread records it at a time,
+//the summaries and exports are read between frames
+class FrameStatistics
+{
+public:
+	explicit FrameStatistics(const int windowSize);
+	FrameStatistics(const FrameStatistics& other); // Copy Constructor
+	FrameStatistics(FrameStatistics&& other) noexcept; // Move Constructor
+	~FrameStatistics(); // Destructor
+
+	FrameStatistics& operator = (const FrameStatistics& other); // Copy Assignment Operator
+	FrameStatistics& operator = (FrameStatistics&& other) noexcept; // Move Assignment Operator
+
+	//Returns the index Record takes
+	int AddPhase(const string& name);
+	void Record(const int phase, const long long duration);
+
+	int GetPhaseCount() const;
+	FramePhaseSummary GetSummary(const int phase) const;
+
+	//A table for people, the CSV and JSON have the same columns in milliseconds for scripts
+	void WriteSummary(ostream& output) const;
+	void WriteCsv(ostream& output) const;
+	void WriteJson(ostream& output) const;
+
+	bool ExportCsv(const string& fileName) const;
+	bool ExportJson(const string& fileName) const;
+
+private:
+	struct Phase
+	{
+		string name;
+
+		//The window, the oldest sample is overwritten once it is full
+		vector<long long> samples;
+		int nextSample;
+		int sampleCount;
+
+		//How many of the window's samples fall in each bucket
+		vector<int> histogram;
+
+		unsigned long long totalSampleCount;
+		long long max;
+		unsigned long long hitchCount;
+		//Twice the median when it was last worked out, and the samples left until it is again
+		long long hitchDuration;
+		int samplesUntilHitchRefresh;
+	};
+
+	static int GetBucket(const long long duration);
+	static long long GetBucketUpperBound(const int bucket);
+
+	static long long GetPercentile(const Phase& phase, const double percentile);
+
+	int windowSize;
+	vector<Phase> phases;
+};
@@ -1,7 +1,8 @@
 #include "GameObject.h"
+#include "Profiler.h"
 
 //For adding default components or making it empty (defaults components: Position, Rotation, Scale)
-GameObject::GameObject() : initializationFailed(false), updateInstanceData(false), maxTessellationDistance(1.0f), minTessellationDistance(1.0f), maxTessellationFactor(1.0f), minTessellationFactor(1.0f), mipInterval(0.0f), mipClampMinimum(0.0f), mipClampMaximum(0.0f), displacementPower(0.0f), position(nullptr), rotation(nullptr), scale(nullptr), rigidBody(nullptr), model(nullptr), texture(nullptr), shader(nullptr), parentObject(nullptr)
+GameObject::GameObject() : initializationFailed(false), updateInstanceData(false), changedInstances(), maxTessellationDistance(1.0f), minTessellationDistance(1.0f), maxTessellationFactor(1.0f), minTessellationFactor(1.0f), mipInterval(0.0f), mipClampMinimum(0.0f), mipClampMaximum(0.0f), displacementPower(0.0f), position(nullptr), rotation(nullptr), scale(nullptr), rigidBody(nullptr), mesh(), model(nullptr), texture(nullptr), shader(nullptr), parentObject(nullptr)
 {
 	//Empty GameObject with no components
 }
@@ -55,10 +56,8 @@ void GameObject::SetPosition(const float x, const float y, const float z)
 
 void GameObject::SetPosition(const vector<XMFLOAT3>& positions)
 {
-	for (unsigned int i = 0; i < position->GetPositions().size(); i++)
-	{
-		position->SetPositionAt(positions[i], i);
-	}
+	//The number of instances can change, the terrain drops cubes as they are destroyed
+	position->SetPositions(positions);
 
 	updateInstanceData = true;
 
@@ -147,55 +146,60 @@ void GameObject::SetScale(const vector<XMFLOAT3>& scales)
 	updateInstanceData = true;
 }
 
+void GameObject::SetScaleAt(const XMFLOAT3& sc, const int index)
+{
+	scale->SetScaleAt(sc, index);
+
+	changedInstances.push_back(index);
+}
+
 void GameObject::AddRigidBodyComponent(const bool useGravity, const float mass, const float drag, const float angularDrag) {
 	rigidBody = make_shared<RigidBody>(useGravity, mass, drag, angularDrag);
 }
 
 void GameObject::AddModelComponent(ID3D11Device* const device, const ModelType modelType, const shared_ptr<ResourceManager>& resourceManager) {
 
-	const auto* modelFileName = "";
+	const auto* const modelFileName = GetModelFileName(modelType);
+
+	if (!modelFileName)
+	{
+		initializationFailed = true;
+		return;
+	}
+
+	mesh = resourceManager->GetMeshHandle(modelFileName);
+	model = make_shared<Model>(device, mesh, resourceManager, scale->GetScales(), rotation->GetRotations(), position->GetPositions());
+
+	if (model->GetInitializationState())
+	{
+		initializationFailed = true;
+	}
+}
+
+const char* GameObject::GetModelFileName(const ModelType modelType) {
 
 	switch (modelType)
 	{
 		case ModelType::Sphere:
-			modelFileName = "sphere.obj";
-			break;
+			return "sphere.obj";
 		case ModelType::SphereInverted:
-			modelFileName = "SphereInverted.obj";
-			break;
+			return "SphereInverted.obj";
 		case ModelType::HighPolyCube:
-			modelFileName = "cubeHigh.obj";
-			break;
+			return "cubeHigh.obj";
 		case ModelType::LowPolyCube:
-			modelFileName = "cubeLow.obj";
-			break;
+			return "cubeLow.obj";
 		case ModelType::Plane:
-			modelFileName = "plane.obj";
-			break;
+			return "plane.obj";
 		case ModelType::HighPolyCylinder:
-			modelFileName = "cylinderHigh.obj";
-			break;
+			return "cylinderHigh.obj";
 		case ModelType::LowPolyCylinder:
-			modelFileName = "cylinderLow.obj";
-			break;
+			return "cylinderLow.obj";
 		case ModelType::Cone:
-			modelFileName = "cone.obj";
-			break;
+			return "cone.obj";
 		case ModelType::Quad:
-			modelFileName = "quad.obj";
-			break;
+			return "quad.obj";
 		default:
-			initializationFailed = true;
-			return;
-	}
-
-	model = make_shared<Model>(device, modelFileName, resourceManager, scale->GetScales(), rotation->GetRotations(), position->GetPositions());
-
-	modelFileName = nullptr;
-
-	if (model->GetInitializationState())
-	{
-		initializationFailed = true;
+			return nullptr;
 	}
 }
 
@@ -271,6 +275,11 @@ const shared_ptr<Model>& GameObject::GetModelComponent() const
 	return model;
 }
 
+MeshHandle GameObject::GetMeshHandle() const
+{
+	return mesh;
+}
+
 const shared_ptr<Shader>& GameObject::GetShaderComponent() const
 {
 	return shader;
@@ -318,17 +327,29 @@ bool GameObject::Update()
 		}
 
 		updateInstanceData = false;
+		changedInstances.clear();
+	}
+	else if (!changedInstances.empty())
+	{
+		if (model)
+		{
+			model->UpdateInstances(scale->GetScales(), rotation->GetRotations(), position->GetPositions(), XMMatrixIdentity(), changedInstances);
+		}
+
+		changedInstances.clear();
 	}
 
 	return result;
 }
 
-bool GameObject::Render(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) const
+bool GameObject::Render(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) const
 {
 	auto result = true;
 
 	if (model)
 	{
+		//Levels of detail are picked for whichever camera is rendering, shadow maps pick theirs from the light
+		model->SelectLevelOfDetail(cameraPosition, projectionMatrix);
 		model->Render(deviceContext);
 
 		//Render shader
@@ -337,6 +358,8 @@ bool GameObject::Render(ID3D11DeviceContext* const deviceContext, const XMMATRIX
 			shader->SetTessellationVariables(maxTessellationDistance, minTessellationDistance, maxTessellationFactor, minTessellationFactor);
 			shader->SetDisplacementVariables(mipInterval, mipClampMinimum, mipClampMaximum, displacementPower * scale->GetScaleAt(0).x);
 
+			//Every shader's Render is only called from here
+			const ProfileZone zone("Shader::Render");
 			result = shader->Render(deviceContext, GetIndexCount(), model->GetInstanceCount(), viewMatrix, projectionMatrix, GetTextureList(), depthTextures, pointLightList, cameraPosition);
 		}
 	}
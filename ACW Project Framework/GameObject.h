@@ -24,6 +24,9 @@ enum class ModelType {
 	Quad
 };
 
+//Every ModelType, in declaration order
+const ModelType MODEL_TYPES[] = { ModelType::Sphere, ModelType::SphereInverted, ModelType::HighPolyCube, ModelType::LowPolyCube, ModelType::Plane, ModelType::HighPolyCylinder, ModelType::LowPolyCylinder, ModelType::Cone, ModelType::Quad };
+
 class GameObject
 {
 public:
@@ -64,10 +67,14 @@ public:
 	void SetScale(const XMFLOAT3& scale);
 	void SetScale(const float x, const float y, const float z);
 	void SetScale(const vector<XMFLOAT3>& scales);
+	//Only this instance is rebuilt
+	void SetScaleAt(const XMFLOAT3& scale, const int index);
 
 	void AddRigidBodyComponent(const bool useGravity, const float mass, const float drag, const float angularDrag);
 
 	void AddModelComponent(ID3D11Device* const device, const ModelType modelType, const shared_ptr<ResourceManager>& resourceManager);
+	//The file AddModelComponent loads for the type, nullptr if there isn't one
+	static const char* GetModelFileName(const ModelType modelType);
 	void AddTextureComponent(ID3D11Device* const device, const vector<const WCHAR*>& textureFileNames, const shared_ptr<ResourceManager>& resourceManager);
 	void SetShaderComponent(const shared_ptr<Shader>& shader);
 
@@ -88,6 +95,8 @@ public:
 	const shared_ptr<RigidBody>& GetRigidBodyComponent() const;
 
 	const shared_ptr<Model>& GetModelComponent() const;
+	//Invalid until AddModelComponent has been called
+	MeshHandle GetMeshHandle() const;
 
 	const shared_ptr<Shader>& GetShaderComponent() const;
 
@@ -100,13 +109,14 @@ public:
 
 	bool Update();
 
-	bool Render(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) const;
+	bool Render(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) const;
 
 private:
 
 	bool initializationFailed;
 
 	bool updateInstanceData;
+	vector<int> changedInstances;
 
 	//Tessellation only variables
 	float maxTessellationDistance;
@@ -126,6 +136,7 @@ private:
 
 	shared_ptr<RigidBody> rigidBody;
 
+	MeshHandle mesh;
 	shared_ptr<Model> model;
 	shared_ptr<Texture> texture;
 
@@ -4,7 +4,7 @@
 
 GraphicsDeviceManager::GraphicsDeviceManager(int screenWidth, int screenHeight, HWND hwnd, bool fullScreen, bool vSyncEnabled, float screenDepth, float screenNear)
 	: initializationFailed(false), vSyncEnabled(vSyncEnabled), videoCardMemory(0), videoCardDescription{},
-	swapChain(nullptr), device(nullptr), deviceContext(nullptr), renderTargetView(nullptr),
+	swapChain(nullptr), device(nullptr), deviceContext(nullptr), renderContext(nullptr), renderTargetView(nullptr),
 	depthStencilBuffer(nullptr), depthStencilStateEnabled(nullptr), depthStencilStateDisabled(nullptr),
 	depthStencilView(nullptr), rasterStateNormal(nullptr), rasterStateWireFrame(nullptr),
 	alphaEnabledBlendState(nullptr), alphaDisableBlendState(nullptr), projectionMatrix(XMMATRIX()), orthographicMatrix(XMMATRIX()){
@@ -105,6 +105,7 @@ GraphicsDeviceManager::~GraphicsDeviceManager()
 	ReleaseComObject(depthStencilStateEnabled);
 	ReleaseComObject(depthStencilBuffer);
 	ReleaseComObject(renderTargetView);
+	renderContext = nullptr;
 	ReleaseComObject(deviceContext);
 	ReleaseComObject(device);
 	ReleaseComObject(swapChain);
@@ -263,7 +264,10 @@ void GraphicsDeviceManager::InitializeDeviceAndSwapChain(unsigned int screenWidt
 	if (FAILED(result))
 	{
 		initializationFailed = true;
+		return;
 	}
+
+	renderContext = make_shared<D3D11RenderContext>(deviceContext);
 }
 
 void GraphicsDeviceManager::InitializeBuffers(unsigned int screenWidth, unsigned int screenHeight)
@@ -424,8 +428,8 @@ void GraphicsDeviceManager::BeginScene(float red, float green, float blue, float
 {
 	float color[4] = { red, green, blue, alpha };
 
-	deviceContext->ClearRenderTargetView(renderTargetView, color);
-	deviceContext->ClearDepthStencilView(depthStencilView, D3D11_CLEAR_DEPTH, 1.0f, 0);
+	renderContext->ClearRenderTargetView(renderTargetView, color);
+	renderContext->ClearDepthStencilView(depthStencilView, D3D11_CLEAR_DEPTH, 1.0f, 0);
 }
 
 ID3D11Device* GraphicsDeviceManager::GetDevice() const
@@ -438,6 +442,16 @@ ID3D11DeviceContext* GraphicsDeviceManager::GetDeviceContext() const
 	return deviceContext;
 }
 
+const shared_ptr<RenderContext>& GraphicsDeviceManager::GetRenderContext() const
+{
+	return renderContext;
+}
+
+void GraphicsDeviceManager::SetRenderContext(const shared_ptr<RenderContext>& context)
+{
+	renderContext = context;
+}
+
 ID3D11DepthStencilView* GraphicsDeviceManager::GetDepthStencilView() const
 {
 	return depthStencilView;
@@ -445,37 +459,37 @@ ID3D11DepthStencilView* GraphicsDeviceManager::GetDepthStencilView() const
 
 void GraphicsDeviceManager::SetRenderTarget() const
 {
-	deviceContext->OMSetRenderTargets(1, &renderTargetView, depthStencilView);
+	renderContext->OMSetRenderTargets(1, &renderTargetView, depthStencilView);
 }
 
 void GraphicsDeviceManager::EnableWireFrame() const
 {
-	deviceContext->RSSetState(rasterStateWireFrame);
+	renderContext->RSSetState(rasterStateWireFrame);
 }
 
 void GraphicsDeviceManager::DisableWireFrame() const
 {
-	deviceContext->RSSetState(rasterStateNormal);
+	renderContext->RSSetState(rasterStateNormal);
 }
 
 void GraphicsDeviceManager::EnabledDepthStencil() const
 {
-	deviceContext->OMSetDepthStencilState(depthStencilStateEnabled, 1);
+	renderContext->OMSetDepthStencilState(depthStencilStateEnabled, 1);
 }
 
 void GraphicsDeviceManager::DisableDepthStencil() const
 {
-	deviceContext->OMSetDepthStencilState(depthStencilStateDisabled, 1);
+	renderContext->OMSetDepthStencilState(depthStencilStateDisabled, 1);
 }
 
 void GraphicsDeviceManager::EnableAlphaBlending() const
 {
-	deviceContext->OMSetBlendState(alphaEnabledBlendState, nullptr, 0xffffffff);
+	renderContext->OMSetBlendState(alphaEnabledBlendState, nullptr, 0xffffffff);
 }
 
 void GraphicsDeviceManager::DisableAlphaBlending() const
 {
-	deviceContext->OMSetBlendState(alphaDisableBlendState, nullptr, 0xffffffff);
+	renderContext->OMSetBlendState(alphaDisableBlendState, nullptr, 0xffffffff);
 }
 
 void GraphicsDeviceManager::GetProjectionMatrix(XMMATRIX& projectionMat) const
@@ -15,6 +15,8 @@
 
 #include <Windows.h>
 
+#include "D3D11RenderContext.h"
+
 using namespace DirectX;
 using namespace std;
 
@@ -34,6 +36,10 @@ public:
 	ID3D11Device* GetDevice() const;
 	ID3D11DeviceContext* GetDeviceContext() const;
 
+	//Everything drawn each frame goes through the render context so it can be swapped for a recording one
+	const shared_ptr<RenderContext>& GetRenderContext() const;
+	void SetRenderContext(const shared_ptr<RenderContext>& context);
+
 	ID3D11DepthStencilView* GetDepthStencilView() const;
 	void SetRenderTarget() const;
 
@@ -76,6 +82,7 @@ private:
 	IDXGISwapChain* swapChain;
 	ID3D11Device* device;
 	ID3D11DeviceContext* deviceContext;
+	shared_ptr<RenderContext> renderContext;
 
 	ID3D11RenderTargetView* renderTargetView;
 
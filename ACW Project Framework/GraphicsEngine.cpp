@@ -8,7 +8,7 @@ GraphicsEngine::~GraphicsEngine() {
 }
 
 bool GraphicsEngine::Initialize() {
-	input = std::make_unique<Keyboard>();
+	input = std::make_shared<Keyboard>();
 	if (!input) {
 		return false;
 	}
@@ -24,6 +24,13 @@ bool GraphicsEngine::Initialize() {
 		return false;
 	}
 
+	inputController = std::make_unique<InputController>(input, graphics->GetWorld());
+
+	//Recording starts with the world so a replay can start from its initial state too
+	if (!graphics->GetConfiguration()->GetInputRecordFile().empty()) {
+		inputLog = std::make_unique<InputLog>();
+	}
+
 	return true;
 }
 
@@ -51,90 +58,52 @@ bool GraphicsEngine::Update() {
 		return false;
 	}
 	ProcessInputActions();
-	UpdateCameraPositionAndControls();
-	return graphics->UpdateFrame();
-}
 
-bool GraphicsEngine::ShouldExitApplication() const {
-	return input->IsKeyPressed(VK_ESCAPE);
-}
+	const auto result = graphics->UpdateFrame();
 
-void GraphicsEngine::ProcessInputActions() {
-	if (AreAnyKeysUp()) {
-		input->SetCanProcessKey(true);
+	if (inputLog) {
+		inputLog->EndFrame(graphics->GetDeltaTime());
 	}
 
-	ProcessKeyAction(0x50, [&]() { graphics->ResetToInitialState(); });
-	ProcessKeyAction(0x52, [&]() { graphics->ResetToInitialState(); });
-	ProcessKeyAction(VK_F11, [&]() { graphics->LaunchRocket(); });
-
-	ProcessTimeScaleAndRocketRotation();
-	ProcessCameraModeChanges();
-	ProcessRenderingOptions();
+	return result;
 }
 
-bool GraphicsEngine::AreAnyKeysUp() const {
-	return input->IsKeyReleased(0x52) && input->IsKeyReleased(0x50) && input->IsKeyReleased(0x54) &&
-		input->IsKeyReleased(VK_F1) && input->IsKeyReleased(VK_F2) && input->IsKeyReleased(VK_F3) &&
-		input->IsKeyReleased(VK_F4) && input->IsKeyReleased(VK_F5) && input->IsKeyReleased(VK_F6) &&
-		input->IsKeyReleased(VK_F7) && input->IsKeyReleased(VK_F11);
+bool GraphicsEngine::ShouldExitApplication() const {
+	return input->IsKeyPressed(KEY_ESCAPE);
 }
 
-void GraphicsEngine::ProcessKeyAction(unsigned int key, std::function<void()> action) {
-	if (input->IsKeyPressed(key) && input->CanProcessKey()) {
-		action();
-		input->SetCanProcessKey(false);
+void GraphicsEngine::ProcessInputActions() {
+	switch (inputController->ProcessInput()) {
+	case KEY_F6:
+		graphics->ToggleRenderOption();
+		break;
+	case KEY_F7:
+		graphics->ToggleRenderSubmission();
+		break;
+	case KEY_F8:
+		graphics->ExportProfilerTrace();
+		break;
+	case KEY_F9:
+		graphics->ExportFrameStatistics();
+		break;
+	default:
+		break;
 	}
 }
 
-void GraphicsEngine::ProcessTimeScaleAndRocketRotation() {
-	if (input->IsKeyPressed(0x10)) {
-		ProcessKeyAction(0x54, [&]() { graphics->AddTimeScale(1); });
-		ProcessKeyAction(VK_OEM_COMMA, [&]() { graphics->RotateRocketLeft(); });
-		ProcessKeyAction(VK_OEM_PERIOD, [&]() { graphics->RotateRocketRight(); });
+void GraphicsEngine::SaveInputRecording() {
+	if (!inputLog) {
+		return;
 	}
-	else {
-		ProcessKeyAction(0x54, [&]() { graphics->AddTimeScale(-1); });
-	}
-}
 
-void GraphicsEngine::ProcessCameraModeChanges() {
-	ProcessKeyAction(VK_F1, [&]() { graphics->ChangeCameraMode(0); });
-	ProcessKeyAction(VK_F2, [&]() { graphics->ChangeCameraMode(1); });
-	ProcessKeyAction(VK_F3, [&]() { graphics->ChangeCameraMode(2); });
-	ProcessKeyAction(VK_F4, [&]() { graphics->ChangeCameraMode(3); });
-	ProcessKeyAction(VK_F5, [&]() { graphics->ChangeCameraMode(4); });
-}
-
-void GraphicsEngine::ProcessRenderingOptions() {
-	ProcessKeyAction(VK_F6, [&]() { graphics->ToggleRenderOption(); });
-}
+	//The replay checks it ends up with the same world the window did
+	inputLog->SetFinalChecksum(graphics->GetWorld()->GetStateChecksum());
 
-void GraphicsEngine::UpdateCameraPositionAndControls() {
-	if (input->IsKeyPressed(VK_CONTROL)) {
-		AdjustCameraPosition();
+	if (!inputLog->Save(graphics->GetConfiguration()->GetInputRecordFile())) {
+		MessageBox(nullptr, "Could not write the input recording", "Error", MB_OK);
 	}
-	else {
-		RotateCamera();
-	}
-}
 
-void GraphicsEngine::AdjustCameraPosition() {
-	// Example implementation (adjust values as needed)
-	if (input->IsKeyPressed(0x57)) graphics->GetCamera()->AddRotationZ(0.1f);
-	if (input->IsKeyPressed(0x53)) graphics->GetCamera()->AddPositionZ(-0.1f);
-	if (input->IsKeyPressed(0x44)) graphics->GetCamera()->AddPositionX(0.1f);
-	if (input->IsKeyPressed(0x41)) graphics->GetCamera()->AddPositionX(-0.1f);
-	if (input->IsKeyPressed(VK_PRIOR)) graphics->GetCamera()->AddPositionY(0.1f);
-	if (input->IsKeyPressed(VK_NEXT)) graphics->GetCamera()->AddPositionY(-0.1f);
-}
-
-void GraphicsEngine::RotateCamera() {
-	// Example implementation (adjust values as needed)
-	if (input->IsKeyPressed(0x57)) graphics->GetCamera()->AddRotationX(-0.8f);
-	if (input->IsKeyPressed(0x53)) graphics->GetCamera()->AddRotationX(0.8f);
-	if (input->IsKeyPressed(0x41)) graphics->GetCamera()->AddRotationY(-0.8f);
-	if (input->IsKeyPressed(0x44)) graphics->GetCamera()->AddRotationY(0.8f);
+	inputLog.reset();
 }
 
 LRESULT CALLBACK GraphicsEngine::MessageHandler(HWND const hwnd, UINT const umsg, WPARAM const wparam, LPARAM const lparam) {
@@ -153,10 +122,19 @@ LRESULT CALLBACK GraphicsEngine::MessageHandler(HWND const hwnd, UINT const umsg
 }
 
 void GraphicsEngine::HandleKeyDown(unsigned int key) {
+	//Held keys repeat WM_KEYDOWN, only the first press changes anything
+	if (inputLog && input->IsKeyReleased(key)) {
+		inputLog->AddKeyEvent(key, true);
+	}
+
 	input->SetKeyPressed(key);
 }
 
 void GraphicsEngine::HandleKeyUp(unsigned int key) {
+	if (inputLog && input->IsKeyPressed(key)) {
+		inputLog->AddKeyEvent(key, false);
+	}
+
 	input->SetKeyReleased(key);
 }
 
@@ -267,6 +245,8 @@ LRESULT CALLBACK WndProc(HWND const hwnd, UINT const umsg, WPARAM const wparam,
 }
 
 void GraphicsEngine::Shutdown() {
+	SaveInputRecording();
+
 	try
 	{
 
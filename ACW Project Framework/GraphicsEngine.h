@@ -3,6 +3,8 @@
 #include <memory>
 #include "Keyboard.h"
 #include "GraphicsRenderer.h"
+#include "InputController.h"
+#include "InputLog.h"
 #include <functional>
 
 class GraphicsEngine {
@@ -28,14 +30,7 @@ private:
     bool Update();
     bool ShouldExitApplication() const;
     void ProcessInputActions();
-    bool AreAnyKeysUp() const;
-    void ProcessKeyAction(unsigned int key, std::function<void()> action);
-    void ProcessTimeScaleAndRocketRotation();
-    void ProcessCameraModeChanges();
-    void ProcessRenderingOptions();
-    void UpdateCameraPositionAndControls();
-    void AdjustCameraPosition();
-    void RotateCamera();
+    void SaveInputRecording();
 
     bool InitializeWindows(int& screenWidth, int& screenHeight);
     void RegisterWindowClass();
@@ -48,8 +43,11 @@ private:
     HWND hwnd;
     LPCSTR appName;
 
-    std::unique_ptr<Keyboard> input;
+    std::shared_ptr<Keyboard> input;
     std::unique_ptr<GraphicsRenderer> graphics;
+    std::unique_ptr<InputController> inputController;
+    //Only while recording
+    std::unique_ptr<InputLog> inputLog;
 };
 
 static LRESULT CALLBACK WndProc(HWND const hwnd, UINT umessage, WPARAM wparam, LPARAM lparam);
@@ -2,14 +2,27 @@
 #include <algorithm>
 
 GraphicsRenderer::GraphicsRenderer(int screenWidth, int screenHeight, HWND const hwnd)
-	: initializationFailed(false), d3D(nullptr), camera(nullptr), lightManager(nullptr), 
+	: initializationFailed(false), d3D(nullptr), deviceRenderContext(nullptr), renderRecorder(nullptr), jobSystem(nullptr), updateJobs(), frameArena(nullptr), frameAllocationStatistics(), frameStatistics(nullptr), framePhase(0), simulationPhase(0), renderPhase(0), waitPhase(0), world(nullptr), 
 	terrain(nullptr), rocket(nullptr),displacedFloor(nullptr), skyBox(nullptr), gameObjects(), 
 	shaderManager(nullptr), resourceManager(nullptr), shadowMapManager(nullptr), renderToggle(0),
-	renderOptionalGameObjects(false), timeScale(1), updateCamera(false),
-	cameraMode(0), dt(0.0f), fps(0.0f), start({ 0 }), end({ 0 }), frequency({ 0 })
+	renderOptionalGameObjects(false), dt(0.0f), start({ 0 }), end({ 0 }), frequency({ 0 })
 {
 	configuration = make_shared<SimulationConfigLoader>("Configuration.txt");
 
+	jobSystem = make_shared<JobSystem>(JobSystem::GetDefaultWorkerThreadCount());
+	Model::SetJobSystem(jobSystem.get());
+	ResourceManager::SetJobSystem(jobSystem.get());
+
+	frameArena = make_shared<FrameArena>(FRAME_ARENA_SIZE);
+
+	Profiler::SetThreadName("Window");
+
+	frameStatistics = make_shared<FrameStatistics>(FRAME_STATISTICS_WINDOW);
+	framePhase = frameStatistics->AddPhase("Frame");
+	simulationPhase = frameStatistics->AddPhase("Simulation");
+	renderPhase = frameStatistics->AddPhase("Render");
+	waitPhase = frameStatistics->AddPhase("Wait for jobs");
+
 	windowWidth = screenWidth;
 	windowHeight = screenHeight;
 
@@ -26,33 +39,55 @@ GraphicsRenderer::GraphicsRenderer(int screenWidth, int screenHeight, HWND const
 
 bool GraphicsRenderer::InitializeGraphicsDevice(int screenWidth, int screenHeight, HWND hwnd) {
 	d3D = make_shared<GraphicsDeviceManager>(screenWidth, screenHeight, hwnd, FULL_SCREEN, VSYNC_ENABLED, SCREEN_DEPTH, SCREEN_NEAR);
-	return d3D->GetInitializationState() == false;
+
+	if (d3D->GetInitializationState())
+	{
+		return false;
+	}
+
+	//Everything still reaches the device, the recorder sits in front of it to count what each frame submits
+	deviceRenderContext = d3D->GetRenderContext();
+	renderRecorder = make_shared<RecordingRenderContext>(d3D->GetDevice(), deviceRenderContext);
+	d3D->SetRenderContext(renderRecorder);
+
+	return true;
 }
 
 bool GraphicsRenderer::InitializeResources(HWND hwnd) {
 	d3D->GetInitializationState();
-	shaderManager = make_shared<ShaderManager>(d3D->GetDevice(), hwnd);
+	shaderManager = make_shared<ShaderManager>(d3D->GetDevice(), hwnd, configuration->GetVertexFormat());
 	shaderManager->GetInitializationState();
-	resourceManager = make_shared<ResourceManager>();
+	resourceManager = make_shared<ResourceManager>(configuration->GetVertexFormat());
+	LoadSceneAssets();
 	return true;
 }
 
+void GraphicsRenderer::LoadSceneAssets() {
+	const ProfileZone zone("GraphicsRenderer::LoadSceneAssets");
+
+	for (const auto modelType : MODEL_TYPES) {
+		resourceManager->LoadModelAsync(GameObject::GetModelFileName(modelType));
+	}
+
+	for (const auto* textureFileName : SCENE_TEXTURE_FILE_NAMES) {
+		resourceManager->LoadTextureAsync(textureFileName);
+	}
+
+	//Anything that failed is loaded again and reported by the object that uses it
+	resourceManager->FinishLoads(d3D->GetDevice());
+}
+
 bool GraphicsRenderer::InitializeSceneObjects(HWND hwnd) {
 	
-	camera = make_shared<Camera>();
-	camera->SetPosition(configuration->GetCameraPosition());
-	lightManager = make_shared<LightManager>();
-	const auto terrainDimensions = configuration->GetTerrainDimensions();
-	auto rocketPosition = configuration->GetRocketPosition();
-	rocketPosition.x += -terrainDimensions.z;
+	world = make_shared<SimulationWorld>(configuration);
+	world->SetJobSystem(jobSystem.get());
 
-	terrain = make_shared<Terrain>(d3D->GetDevice(), XMFLOAT3(80, 10, 40), XMFLOAT3(1, 1, 1), shaderManager->GetTextureDisplacementShader(), resourceManager);
-	rocket = make_shared<Rocket>(d3D->GetDevice(), rocketPosition, configuration->GetRocketRotation(), configuration->GetRocketScale(), shaderManager, resourceManager);
+	const auto rocketSimulation = world->GetRocket();
 
-	lightManager->AddLight(XMFLOAT3(0.0f, 0.0f, -terrainDimensions.z), XMFLOAT3(0.0f, 0.0f, 0.0f), configuration->GetSunAmbient(), configuration->GetSunDiffuse(), configuration->GetSunSpecular(), configuration->GetSunSpecularPower(), terrainDimensions.x, terrainDimensions.z, 1, terrainDimensions.z, true, true);
-	lightManager->AddLight(XMFLOAT3(-terrainDimensions.x, -terrainDimensions.x, 0.0f), XMFLOAT3(0.0f, 0.0f, 0.0f), configuration->GetSunAmbient(), configuration->GetMoonDiffuse(), configuration->GetMoonSpecular(), configuration->GetMoonSpecularPower(), terrainDimensions.z, terrainDimensions.x, 1, terrainDimensions.x, true, true);
+	terrain = make_shared<Terrain>(d3D->GetDevice(), world->GetTerrain(), shaderManager->GetTextureDisplacementShader(), resourceManager);
+	rocket = make_shared<Rocket>(d3D->GetDevice(), rocketSimulation->GetLauncherPosition(), configuration->GetRocketRotation(), configuration->GetRocketScale(), shaderManager, resourceManager);
 
-	shadowMapManager = make_shared<ShadowMapManager>(hwnd, d3D->GetDevice(), shaderManager->GetDepthShader(), lightManager->GetLightList().size(), SHADOW_MAP_WIDTH, SHADOW_MAP_HEIGHT);
+	shadowMapManager = make_shared<ShadowMapManager>(hwnd, d3D->GetDevice(), shaderManager->GetDepthShader(), world->GetLightManager()->GetLightList().size(), SHADOW_MAP_WIDTH, SHADOW_MAP_HEIGHT);
 
 	InitializeGameObjects(hwnd);
 
@@ -154,6 +189,10 @@ GraphicsRenderer::GraphicsRenderer(GraphicsRenderer&& other) noexcept = default;
 
 GraphicsRenderer::~GraphicsRenderer()
 {
+	ExportFrameStatistics();
+
+	Model::SetJobSystem(nullptr);
+	ResourceManager::SetJobSystem(nullptr);
 }
 
 GraphicsRenderer& GraphicsRenderer::operator=(const GraphicsRenderer&) = default;
@@ -162,7 +201,22 @@ GraphicsRenderer& GraphicsRenderer::operator=(GraphicsRenderer&&) noexcept = def
 
 const shared_ptr<Camera>& GraphicsRenderer::GetCamera() const
 {
-	return  camera;
+	return  world->GetCamera();
+}
+
+const shared_ptr<SimulationWorld>& GraphicsRenderer::GetWorld() const
+{
+	return world;
+}
+
+const shared_ptr<SimulationConfigLoader>& GraphicsRenderer::GetConfiguration() const
+{
+	return configuration;
+}
+
+float GraphicsRenderer::GetDeltaTime() const
+{
+	return dt;
 }
 
 void GraphicsRenderer::ToggleRenderOption() {
@@ -195,131 +249,168 @@ void GraphicsRenderer::ToggleOptionalGameObjects() {
 }
 
 void GraphicsRenderer::ResetToInitialState() const {
-	rocket->ResetRocketState();
-	terrain->ResetTerrainState();
+	world->ResetToInitialState();
 }
 
 void GraphicsRenderer::AddTimeScale(const int number)
 {
-	timeScale = (timeScale + number < 1) ? 1 : timeScale + number;
+	world->AddTimeScale(number);
 }
 
 void GraphicsRenderer::RotateRocketLeft() const {
-	rocket->AdjustRotationLeft();
+	world->RotateRocketLeft();
 }
 
 void GraphicsRenderer::RotateRocketRight() const {
-	rocket->AdjustRotationRight();
+	world->RotateRocketRight();
 }
 
 void GraphicsRenderer::LaunchRocket() const {
-	rocket->LaunchRocket();
+	world->LaunchRocket();
 }
 
 void GraphicsRenderer::ChangeCameraMode(const int camMode) {
-	cameraMode = camMode;
-	updateCamera = (cameraMode >= 2 && cameraMode <= 4);
-
-	switch (cameraMode) {
-	case 0: {
-		const auto position = rocket->GetLauncherPosition();
-		camera->SetPosition(position.x, position.y, position.z - 10.0f);
-		camera->SetRotation(0.0f, 0.0f, 0.0f);
-		break;
-	}
-	case 1:
-		camera->SetPosition(0.0f, 10.0f, -30.0f);
-		camera->SetRotation(0.0f, 45.0f, 0.0f);
-		break;
-	default:
-		camera->SetRotation(0.0f, 0.0f, 0.0f);
-		break;
+	world->ChangeCameraMode(camMode);
+}
+
+void GraphicsRenderer::ToggleRenderSubmission() {
+	renderRecorder->SetForwardContext(renderRecorder->GetForwardContext() ? nullptr : deviceRenderContext);
+}
+
+const RenderStatistics& GraphicsRenderer::GetRenderStatistics() const {
+	return renderRecorder->GetStatistics();
+}
+
+const InstanceReallocationStatistics& GraphicsRenderer::GetInstanceReallocationStatistics() const {
+	return Model::GetReallocationStatistics();
+}
+
+const FrameAllocationStatistics& GraphicsRenderer::GetFrameAllocationStatistics() const {
+	return frameAllocationStatistics;
+}
+
+bool GraphicsRenderer::ExportProfilerTrace() const {
+	//Called between frames so none of the job threads are recording
+	if (!Profiler::ExportChromeTrace(PROFILER_TRACE_FILE_NAME)) {
+		MessageBox(nullptr, "Could not write the profiler trace", "Error", MB_OK);
+		return false;
 	}
+
+	return true;
 }
 
-void GraphicsRenderer::UpdateCameraPosition() const {
-	if (!updateCamera) return;
+const FrameStatistics& GraphicsRenderer::GetFrameStatistics() const {
+	return *frameStatistics;
+}
 
-	XMFLOAT3 cameraPosition;
-	switch (cameraMode) {
-	case 2:
-		cameraPosition = rocket->GetLookAtRocketPosition();
-		cameraPosition.z -= 20.0f;
-		break;
-	case 3:
-		cameraPosition = rocket->GetLookAtRocketConePosition();
-		cameraPosition.z -= 3.0f;
-		break;
-	case 4:
-		cameraPosition = rocket->GetLookAtRocketPosition();
-		cameraPosition.z -= 3.0f;
-		break;
-	default:
-		return;
+bool GraphicsRenderer::ExportFrameStatistics() const {
+	if (!frameStatistics->ExportCsv(FRAME_STATISTICS_CSV_FILE_NAME) || !frameStatistics->ExportJson(FRAME_STATISTICS_JSON_FILE_NAME)) {
+		MessageBox(nullptr, "Could not write the frame statistics", "Error", MB_OK);
+		return false;
 	}
 
-	camera->SetPosition(cameraPosition.x, cameraPosition.y, cameraPosition.z);
+	return true;
 }
 
 bool GraphicsRenderer::UpdateFrame() {
+	const ProfileZone zone("GraphicsRenderer::UpdateFrame");
+
+	const auto allocationsAtFrameStart = AllocationCounter::GetAllocationCount();
+
+	//Last frame's temporaries are all gone by now
+	frameArena->Reset();
+
 	QueryPerformanceCounter(&end);
 	dt = static_cast<float>((end.QuadPart - start.QuadPart) / static_cast<double>(frequency.QuadPart));
+	//The whole frame from the last call to this one, in real time whatever the time scale
+	frameStatistics->Record(framePhase, static_cast<long long>(dt * 1000000000.0));
 	start = end;
 
-	dt *= timeScale;
-	fps = static_cast<int>(1.0 / dt);
-	XMFLOAT3 collisionPosition;
-	float blastRadius = 0.0f;
+	Model::ResetReallocationStatistics();
 
-	UpdateGameObjects();
+	//The step simulated during the last frame is the one drawn this frame
+	Model::PublishSnapshot();
+	world->PublishSnapshot();
+	rocket->PublishSnapshot();
 
-	if (rocket->CheckForTerrainCollision(terrain, collisionPosition, blastRadius)) {
-		
-	}
+	//Simulate the next step on the job system while this thread submits the published one
+	const auto simulationJob = jobSystem->Add([this]() {
+		const auto simulationStart = Profiler::GetTime();
+		world->UpdateFrame(dt);
+		frameStatistics->Record(simulationPhase, Profiler::GetTime() - simulationStart);
+	});
 
-	terrain->UpdateTerrain();
-	rocket->UpdateRocket(dt);
-	UpdateCameraAndLights();
+	UpdateGameObjects(simulationJob);
 
+	const auto renderStart = Profiler::GetTime();
+	const auto result = RenderFrame();
+	const auto waitStart = Profiler::GetTime();
 
-	return RenderFrame();
+	//Input is applied to the world between frames, so the step has to finish before we return
+	jobSystem->Wait(updateJobs);
+
+	frameStatistics->Record(renderPhase, waitStart - renderStart);
+	frameStatistics->Record(waitPhase, Profiler::GetTime() - waitStart);
+
+	frameAllocationStatistics.heapAllocations = AllocationCounter::GetAllocationCount() - allocationsAtFrameStart;
+	frameAllocationStatistics.arenaBytesUsed = frameArena->GetUsedBytes();
+	frameAllocationStatistics.arenaCapacity = frameArena->GetCapacity();
+
+	return result;
 }
 
-void GraphicsRenderer::UpdateGameObjects() {
-	displacedFloor->Update();
-	skyBox->Update();
+void GraphicsRenderer::UpdateGameObjects(const JobHandle& simulationJob) {
+	updateJobs.clear();
+	updateJobs.push_back(simulationJob);
+
+	//Every game object owns its model so they can all be updated at once, alongside the simulation
+	updateJobs.push_back(jobSystem->Add([this]() { displacedFloor->Update(); }));
+	updateJobs.push_back(jobSystem->Add([this]() { skyBox->Update(); }));
 	for (const auto& gameObject : gameObjects) {
-		gameObject->Update();
+		auto* const objectToUpdate = gameObject.get();
+		updateJobs.push_back(jobSystem->Add([objectToUpdate]() { objectToUpdate->Update(); }));
 	}
-}
 
-void GraphicsRenderer::UpdateCameraAndLights() {
-	UpdateCameraPosition();
-	for (const auto& light : lightManager->GetLightList()) {
-		light->UpdateLightVariables(dt);
-	}
+	//These read the simulation's results, the rocket parts read their parent's transform so they stay in one job
+	updateJobs.push_back(jobSystem->Add([this]() { terrain->UpdateTerrain(world->GetTerrain()); }, simulationJob));
+	updateJobs.push_back(jobSystem->Add([this]() { rocket->UpdateRocket(world->GetRocket()); }, simulationJob));
 }
 
 bool GraphicsRenderer::RenderFrame() {
+	const ProfileZone zone("GraphicsRenderer::RenderFrame");
+
+	const auto& snapshot = world->GetPublishedSnapshot();
+	const auto& camera = snapshot.camera;
+	const auto renderContext = d3D->GetRenderContext().get();
+
+	renderRecorder->BeginFrame();
+
 	camera->Render();
 
-	std::vector<shared_ptr<GameObject>> gameObjects;
+	//Plain pointers from the frame arena, every game object outlives the frame so their reference counts needn't be touched
+	FrameVector<GameObject*> renderList{ FrameAllocator<GameObject*>(*frameArena) };
+	renderList.reserve(gameObjects.size() + 7);
 
 	if (renderOptionalGameObjects) {
-		gameObjects.insert(gameObjects.end(), gameObjects.begin(), gameObjects.end());
+		for (const auto& gameObject : gameObjects) {
+			renderList.push_back(gameObject.get());
+		}
 	}
 
-	gameObjects.insert(gameObjects.end(), {
-		static_pointer_cast<GameObject>(terrain),
-		displacedFloor,
-		skyBox,
-		rocket->GetRocketBody(),
-		rocket->GetRocketCone(),
-		rocket->GetRocketCap(),
-		rocket->GetRocketLauncher()
+	renderList.insert(renderList.end(), {
+		static_cast<GameObject*>(terrain.get()),
+		displacedFloor.get(),
+		skyBox.get(),
+		rocket->GetRocketBody().get(),
+		rocket->GetRocketCone().get(),
+		rocket->GetRocketCap().get(),
+		rocket->GetRocketLauncher().get()
 		});
 
-	shadowMapManager->GenerateShadowMapResources(d3D->GetDeviceContext(), d3D->GetDepthStencilView(), lightManager->GetLightList(), gameObjects, camera->GetPosition());
+	//The snapshot's lights don't change until the next PublishSnapshot so they are used as they are
+	const auto& lightList = snapshot.lights;
+
+	shadowMapManager->GenerateShadowMapResources(renderContext, d3D->GetDepthStencilView(), lightList, renderList, camera->GetPosition());
 
 	d3D->SetRenderTarget();
 
@@ -328,14 +419,11 @@ bool GraphicsRenderer::RenderFrame() {
 	camera->GetViewMatrix(viewMatrix);
 	d3D->GetProjectionMatrix(projectionMatrix);
 
-	std::vector<shared_ptr<Light>> lightList = lightManager->GetLightList();
-
-
-	for (const auto& gameObject : gameObjects) {
-		gameObject->Render(d3D->GetDeviceContext(), viewMatrix, projectionMatrix, shadowMapManager->GetShadowMapResources(), lightList, camera->GetPosition());
+	for (const auto gameObject : renderList) {
+		gameObject->Render(renderContext, viewMatrix, projectionMatrix, shadowMapManager->GetShadowMapResources(), lightList, camera->GetPosition());
 	}
 
-	terrain->RenderTerrain(d3D->GetDeviceContext(), viewMatrix, projectionMatrix, shadowMapManager->GetShadowMapResources(), lightList, camera->GetPosition());
+	terrain->RenderTerrain(renderContext, viewMatrix, projectionMatrix, shadowMapManager->GetShadowMapResources(), lightList, camera->GetPosition());
 	rocket->RenderRocket(d3D, viewMatrix, projectionMatrix, shadowMapManager->GetShadowMapResources(), lightList, camera->GetPosition());
 
 	d3D->DisableDepthStencil();
@@ -4,8 +4,13 @@
 
 #include "GraphicsDeviceManager.h"
 
+#include "AllocationCounter.h"
 #include "Camera.h"
+#include "FrameArena.h"
+#include "FrameStatistics.h"
 #include "GameObject.h"
+#include "JobSystem.h"
+#include "Profiler.h"
 #include "ShaderManager.h"
 #include "ResourceManager.h"
 #include "LightManager.h"
@@ -14,6 +19,8 @@
 #include "Terrain.h"
 #include "Rocket.h"
 #include "SimulationConfigLoader.h"
+#include "SimulationWorld.h"
+#include "RecordingRenderContext.h"
 
 auto const FULL_SCREEN = false;
 auto const VSYNC_ENABLED = true;
@@ -23,12 +30,35 @@ auto const SCREEN_NEAR = 0.1f;
 const int SHADOW_MAP_WIDTH = 1360;
 const int SHADOW_MAP_HEIGHT = 720;
 
+//Written to the working directory by ExportProfilerTrace
+const string PROFILER_TRACE_FILE_NAME = "Trace.json";
+//Written by ExportFrameStatistics, which also runs when the renderer is destroyed
+const string FRAME_STATISTICS_CSV_FILE_NAME = "FrameStatistics.csv";
+const string FRAME_STATISTICS_JSON_FILE_NAME = "FrameStatistics.json";
+
+//Every texture the scene's objects use, read together with the models before any of the objects are created
+const WCHAR* const SCENE_TEXTURE_FILE_NAMES[] = { L"BaseColour.dds", L"BaseNormal.dds", L"BaseSpecular.dds", L"BaseDisplacement.dds", L"FloorColour.dds", L"FloorNormal.dds", L"FloorSpecular.dds", L"FloorDisplacement.dds", L"skybox.dds" };
+
+//Starting size of the per frame arena, it grows on its own if a frame needs more
+const size_t FRAME_ARENA_SIZE = 64 * 1024;
+
+struct FrameAllocationStatistics
+{
+	//Through operator new on any thread between the start and end of UpdateFrame, 0 once the frame has settled
+	unsigned long long heapAllocations;
+	size_t arenaBytesUsed;
+	size_t arenaCapacity;
+};
+
 class GraphicsRenderer
 {
 public:
 	GraphicsRenderer(int screenWidth, int screenHeight, HWND const hwnd); // Default Constructor
 	bool InitializeGraphicsDevice(int screenWidth, int screenHeight, HWND hwnd);
 	bool InitializeResources(HWND hwnd);
+	//Starts every model and texture loading across the job system and creates them once they have all been read, so
+	//building the scene finds them already loaded
+	void LoadSceneAssets();
 	bool InitializeSceneObjects(HWND hwnd);
 	
 	bool InitializeGameObjects(HWND hwnd);
@@ -40,6 +70,10 @@ public:
 	GraphicsRenderer& operator = (GraphicsRenderer&& other) noexcept; // Move Assignment Operator
 
 	const shared_ptr<Camera>& GetCamera() const;
+	const shared_ptr<SimulationWorld>& GetWorld() const;
+	const shared_ptr<SimulationConfigLoader>& GetConfiguration() const;
+	//The seconds the last UpdateFrame stepped the world by
+	float GetDeltaTime() const;
 
 	void ToggleRenderOption();
 	void ToggleOptionalGameObjects();
@@ -49,13 +83,29 @@ public:
 	void RotateRocketRight() const;
 	void LaunchRocket() const;
 	void ChangeCameraMode(const int cameraMode);
-	void UpdateCameraPosition() const;
 
-	bool UpdateFrame();
+	//Switches between submitting to the device and only recording, which leaves the CPU side cost of building a frame
+	void ToggleRenderSubmission();
+	//Draw, upload and state change counts for the last rendered frame
+	const RenderStatistics& GetRenderStatistics() const;
+	//Instance array and buffer reallocations made while updating and rendering the last frame
+	const InstanceReallocationStatistics& GetInstanceReallocationStatistics() const;
+	//Heap and frame arena use of the last frame
+	const FrameAllocationStatistics& GetFrameAllocationStatistics() const;
 
-	void UpdateGameObjects();
+	//Writes the zones the profiler is holding, about the last few seconds, as a Chrome trace
+	bool ExportProfilerTrace() const;
 
-	void UpdateCameraAndLights();
+	//Frame, simulation, render and job wait times over the last FRAME_STATISTICS_WINDOW frames
+	const FrameStatistics& GetFrameStatistics() const;
+	bool ExportFrameStatistics() const;
+
+	//Draws the step simulated during the previous call while the next one is simulated on the job system,
+	//so a frame costs about the longer of the two and the picture is one frame behind the input
+	bool UpdateFrame();
+
+	//Queues every game object's update on the job system, the terrain and rocket wait for simulationJob
+	void UpdateGameObjects(const JobHandle& simulationJob);
 
 	bool GetInitializationState() const;
 
@@ -67,9 +117,23 @@ private:
 	shared_ptr<SimulationConfigLoader>  configuration;
 
 	shared_ptr<GraphicsDeviceManager>  d3D;
+	shared_ptr<RenderContext>  deviceRenderContext;
+	shared_ptr<RecordingRenderContext>  renderRecorder;
+
+	shared_ptr<JobSystem>  jobSystem;
+	vector<JobHandle>  updateJobs;
+
+	//Reset at the start of every frame, anything built only for one frame comes from here
+	shared_ptr<FrameArena>  frameArena;
+	FrameAllocationStatistics  frameAllocationStatistics;
+
+	shared_ptr<FrameStatistics>  frameStatistics;
+	int  framePhase;
+	int  simulationPhase;
+	int  renderPhase;
+	int  waitPhase;
 
-	shared_ptr<Camera>  camera;
-	shared_ptr<LightManager>  lightManager;
+	shared_ptr<SimulationWorld>  world;
 
 	shared_ptr<Terrain>  terrain;
 	shared_ptr<Rocket>  rocket;
@@ -88,12 +152,8 @@ private:
 
 	int  renderToggle;
 	bool  renderOptionalGameObjects;
-	int  timeScale;
-	bool  updateCamera;
-	int  cameraMode;
 
 	float  dt;
-	float  fps;
 	LARGE_INTEGER  start;
 	LARGE_INTEGER  end;
 	LARGE_INTEGER  frequency;
@@ -0,0 +1,109 @@
+#include "InputController.h"
+
+InputController::InputController(const shared_ptr<Keyboard>& keyboard, const shared_ptr<SimulationWorld>& world) : keyboard(keyboard), world(world)
+{
+}
+
+InputController::InputController(const InputController& other) = default;
+
+InputController::InputController(InputController&& other) noexcept = default;
+
+InputController::~InputController() = default;
+
+InputController& InputController::operator=(const InputController& other) = default;
+
+InputController& InputController::operator=(InputController&& other) noexcept = default;
+
+unsigned int InputController::ProcessInput()
+{
+	if (AreAllKeysReleased())
+	{
+		keyboard->SetCanProcessKey(true);
+	}
+
+	unsigned int renderingKey = 0;
+
+	ProcessKeyAction(KEY_P, [&]() { world->ResetToInitialState(); });
+	ProcessKeyAction(KEY_R, [&]() { world->ResetToInitialState(); });
+	ProcessKeyAction(KEY_F11, [&]() { world->LaunchRocket(); });
+
+	ProcessTimeScaleAndRocketRotation();
+	ProcessCameraModeChanges();
+
+	for (const auto key : { KEY_F6, KEY_F7, KEY_F8, KEY_F9 })
+	{
+		ProcessKeyAction(key, [&]() { renderingKey = key; });
+	}
+
+	UpdateCameraPositionAndControls();
+
+	return renderingKey;
+}
+
+bool InputController::AreAllKeysReleased() const
+{
+	for (const auto key : { KEY_R, KEY_P, KEY_T, KEY_F1, KEY_F2, KEY_F3, KEY_F4, KEY_F5, KEY_F6, KEY_F7, KEY_F8, KEY_F9, KEY_F11 })
+	{
+		if (!keyboard->IsKeyReleased(key))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void InputController::ProcessKeyAction(const unsigned int key, const function<void()>& action)
+{
+	if (keyboard->IsKeyPressed(key) && keyboard->CanProcessKey())
+	{
+		action();
+		keyboard->SetCanProcessKey(false);
+	}
+}
+
+void InputController::ProcessTimeScaleAndRocketRotation()
+{
+	if (keyboard->IsKeyPressed(KEY_SHIFT))
+	{
+		ProcessKeyAction(KEY_T, [&]() { world->AddTimeScale(1); });
+		ProcessKeyAction(KEY_COMMA, [&]() { world->RotateRocketLeft(); });
+		ProcessKeyAction(KEY_PERIOD, [&]() { world->RotateRocketRight(); });
+	}
+	else
+	{
+		ProcessKeyAction(KEY_T, [&]() { world->AddTimeScale(-1); });
+	}
+}
+
+void InputController::ProcessCameraModeChanges()
+{
+	ProcessKeyAction(KEY_F1, [&]() { world->ChangeCameraMode(0); });
+	ProcessKeyAction(KEY_F2, [&]() { world->ChangeCameraMode(1); });
+	ProcessKeyAction(KEY_F3, [&]() { world->ChangeCameraMode(2); });
+	ProcessKeyAction(KEY_F4, [&]() { world->ChangeCameraMode(3); });
+	ProcessKeyAction(KEY_F5, [&]() { world->ChangeCameraMode(4); });
+}
+
+void InputController::UpdateCameraPositionAndControls() const
+{
+	const auto& camera = world->GetCamera();
+
+	//Held keys move the camera every frame rather than once per press
+	if (keyboard->IsKeyPressed(KEY_CONTROL))
+	{
+		if (keyboard->IsKeyPressed(KEY_W)) camera->AddRotationZ(0.1f);
+		if (keyboard->IsKeyPressed(KEY_S)) camera->AddPositionZ(-0.1f);
+		if (keyboard->IsKeyPressed(KEY_D)) camera->AddPositionX(0.1f);
+		if (keyboard->IsKeyPressed(KEY_A)) camera->AddPositionX(-0.1f);
+		if (keyboard->IsKeyPressed(KEY_PAGE_UP)) camera->AddPositionY(0.1f);
+		if (keyboard->IsKeyPressed(KEY_PAGE_DOWN)) camera->AddPositionY(-0.1f);
+	}
+	else
+	{
+		if (keyboard->IsKeyPressed(KEY_W)) camera->AddRotationX(-0.8f);
+		if (keyboard->IsKeyPressed(KEY_S)) camera->AddRotationX(0.8f);
+		if (keyboard->IsKeyPressed(KEY_A)) camera->AddRotationY(-0.8f);
+		if (keyboard->IsKeyPressed(KEY_D)) camera->AddRotationY(0.8f);
+	}
+}
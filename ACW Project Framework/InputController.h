@@ -0,0 +1,64 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "Keyboard.h"
+#include "SimulationWorld.h"
+
+using namespace std;
+
+//Virtual key codes the controls use, the same values as Windows' VK_ codes so this doesn't need Windows.h
+const unsigned int KEY_SHIFT = 0x10;
+const unsigned int KEY_CONTROL = 0x11;
+const unsigned int KEY_ESCAPE = 0x1B;
+const unsigned int KEY_PAGE_UP = 0x21;
+const unsigned int KEY_PAGE_DOWN = 0x22;
+const unsigned int KEY_A = 0x41;
+const unsigned int KEY_D = 0x44;
+const unsigned int KEY_P = 0x50;
+const unsigned int KEY_R = 0x52;
+const unsigned int KEY_S = 0x53;
+const unsigned int KEY_T = 0x54;
+const unsigned int KEY_W = 0x57;
+const unsigned int KEY_F1 = 0x70;
+const unsigned int KEY_F2 = 0x71;
+const unsigned int KEY_F3 = 0x72;
+const unsigned int KEY_F4 = 0x73;
+const unsigned int KEY_F5 = 0x74;
+const unsigned int KEY_F6 = 0x75;
+const unsigned int KEY_F7 = 0x76;
+const unsigned int KEY_F8 = 0x77;
+const unsigned int KEY_F9 = 0x78;
+const unsigned int KEY_F11 = 0x7A;
+const unsigned int KEY_COMMA = 0xBC;
+const unsigned int KEY_PERIOD = 0xBE;
+
+//Turns the keyboard's state into changes to the world: resetting, launching, time scale, rocket rotation, camera modes
+//and moving the camera. It has no Win32 dependency so a replay drives the world exactly as the window did.
+//Only one key press is acted on until every key is released again, the rendering keys F6 to F9 take part in that
+//but are handed back to the caller since the world knows nothing about rendering
+class InputController
+{
+public:
+	InputController(const shared_ptr<Keyboard>& keyboard, const shared_ptr<SimulationWorld>& world);
+	InputController(const InputController& other); // Copy Constructor
+	InputController(InputController&& other) noexcept; // Move Constructor
+	~InputController(); // Destructor
+
+	InputController& operator = (const InputController& other); // Copy Assignment Operator
+	InputController& operator = (InputController&& other) noexcept; // Move Assignment Operator
+
+	//Call once a frame before the world is stepped, returns the rendering key that was acted on or 0
+	unsigned int ProcessInput();
+
+private:
+	bool AreAllKeysReleased() const;
+	void ProcessKeyAction(const unsigned int key, const function<void()>& action);
+	void ProcessTimeScaleAndRocketRotation();
+	void ProcessCameraModeChanges();
+	void UpdateCameraPositionAndControls() const;
+
+	shared_ptr<Keyboard> keyboard;
+	shared_ptr<SimulationWorld> world;
+};
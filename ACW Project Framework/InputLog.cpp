@@ -0,0 +1,185 @@
+#include "InputLog.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+
+struct InputLogHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t frameCount;
+	uint32_t eventCount;
+	uint64_t finalChecksum;
+};
+
+//Frames can't hold more events than the count on disk allows, any more are carried into the next frame
+static const int MAX_EVENTS_PER_FRAME = 0xFFFF;
+
+//Bytes every frame and event takes up on disk, a dt and event count per frame and a key and state per event
+static const uint64_t FRAME_SIZE_ON_DISK = sizeof(float) + sizeof(uint16_t);
+static const uint64_t EVENT_SIZE_ON_DISK = 2;
+
+InputLog::InputLog() : events(), frames(), pendingEventCount(0), finalChecksum(0)
+{
+}
+
+InputLog::InputLog(const InputLog& other) = default;
+
+InputLog::InputLog(InputLog&& other) noexcept = default;
+
+InputLog::~InputLog() = default;
+
+InputLog& InputLog::operator=(const InputLog& other) = default;
+
+InputLog& InputLog::operator=(InputLog&& other) noexcept = default;
+
+void InputLog::AddKeyEvent(const unsigned int key, const bool pressed)
+{
+	events.push_back({ static_cast<unsigned char>(key), pressed });
+	pendingEventCount++;
+}
+
+void InputLog::EndFrame(const float dt)
+{
+	const auto eventCount = min(pendingEventCount, MAX_EVENTS_PER_FRAME);
+
+	frames.push_back({ dt, static_cast<int>(events.size()) - pendingEventCount, eventCount });
+	pendingEventCount -= eventCount;
+}
+
+int InputLog::GetFrameCount() const
+{
+	return static_cast<int>(frames.size());
+}
+
+float InputLog::GetDeltaTime(const int frame) const
+{
+	return frames[frame].dt;
+}
+
+void InputLog::ApplyKeyEvents(const int frame, Keyboard& keyboard) const
+{
+	const auto& inputFrame = frames[frame];
+
+	for (auto i = inputFrame.firstEvent; i < inputFrame.firstEvent + inputFrame.eventCount; i++)
+	{
+		if (events[i].pressed)
+		{
+			keyboard.SetKeyPressed(events[i].key);
+		}
+		else
+		{
+			keyboard.SetKeyReleased(events[i].key);
+		}
+	}
+}
+
+unsigned long long InputLog::GetFinalChecksum() const
+{
+	return finalChecksum;
+}
+
+void InputLog::SetFinalChecksum(const unsigned long long checksum)
+{
+	finalChecksum = checksum;
+}
+
+bool InputLog::Save(const string& fileName) const
+{
+	ofstream output(fileName, ios::binary);
+
+	if (!output)
+	{
+		return false;
+	}
+
+	//Events after the last EndFrame never reached a frame so they aren't saved
+	const auto savedEventCount = static_cast<int>(events.size()) - pendingEventCount;
+
+	const InputLogHeader header = { INPUT_LOG_MAGIC, INPUT_LOG_VERSION, static_cast<uint32_t>(frames.size()), static_cast<uint32_t>(savedEventCount), finalChecksum };
+	output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	for (const auto& frame : frames)
+	{
+		const auto eventCount = static_cast<uint16_t>(frame.eventCount);
+
+		output.write(reinterpret_cast<const char*>(&frame.dt), sizeof(frame.dt));
+		output.write(reinterpret_cast<const char*>(&eventCount), sizeof(eventCount));
+
+		for (auto i = frame.firstEvent; i < frame.firstEvent + frame.eventCount; i++)
+		{
+			const char event[2] = { static_cast<char>(events[i].key), static_cast<char>(events[i].pressed ? 1 : 0) };
+			output.write(event, sizeof(event));
+		}
+	}
+
+	return static_cast<bool>(output);
+}
+
+bool InputLog::Load(const string& fileName)
+{
+	Clear();
+
+	ifstream input(fileName, ios::binary);
+
+	InputLogHeader header = {};
+
+	if (!input.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != INPUT_LOG_MAGIC || header.version != INPUT_LOG_VERSION)
+	{
+		return false;
+	}
+
+	//Counts the rest of the file is too short to hold are corrupt, reserving for them could throw bad_alloc
+	const auto dataStart = input.tellg();
+	input.seekg(0, ios::end);
+	const auto remainingBytes = static_cast<uint64_t>(input.tellg() - dataStart);
+	input.seekg(dataStart);
+
+	if (header.frameCount * FRAME_SIZE_ON_DISK + header.eventCount * EVENT_SIZE_ON_DISK > remainingBytes)
+	{
+		return false;
+	}
+
+	frames.reserve(header.frameCount);
+	events.reserve(header.eventCount);
+
+	for (auto frame = 0u; frame < header.frameCount; frame++)
+	{
+		InputFrame inputFrame = { 0.0f, static_cast<int>(events.size()), 0 };
+		uint16_t eventCount = 0;
+
+		if (!input.read(reinterpret_cast<char*>(&inputFrame.dt), sizeof(inputFrame.dt)) || !input.read(reinterpret_cast<char*>(&eventCount), sizeof(eventCount)))
+		{
+			Clear();
+			return false;
+		}
+
+		for (auto i = 0; i < eventCount; i++)
+		{
+			char event[2];
+
+			if (!input.read(event, sizeof(event)))
+			{
+				Clear();
+				return false;
+			}
+
+			events.push_back({ static_cast<unsigned char>(event[0]), event[1] != 0 });
+		}
+
+		inputFrame.eventCount = eventCount;
+		frames.push_back(inputFrame);
+	}
+
+	finalChecksum = header.finalChecksum;
+
+	return true;
+}
+
+void InputLog::Clear()
+{
+	events.clear();
+	frames.clear();
+	pendingEventCount = 0;
+	finalChecksum = 0;
+}
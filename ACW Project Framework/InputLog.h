@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Keyboard.h"
+
+using namespace std;
+
+//"IRPL" at the start of every log, the version changes whenever the layout does
+const unsigned int INPUT_LOG_MAGIC = 0x4C505249;
+const unsigned int INPUT_LOG_VERSION = 1;
+
+struct InputEvent
+{
+	unsigned char key;
+	bool pressed;
+};
+
+struct InputFrame
+{
+	float dt;
+	int firstEvent;
+	int eventCount;
+};
+
+//The key presses and releases that arrived before each frame and the dt the frame stepped the world by. Replaying
+//them in order through a Keyboard and InputController steps a world exactly as the recorded session did.
+//On disk it is a header then, for every frame, its dt, a 16 bit event count and two bytes per event
+class InputLog
+{
+public:
+	InputLog();
+	InputLog(const InputLog& other); // Copy Constructor
+	InputLog(InputLog&& other) noexcept; // Move Constructor
+	~InputLog(); // Destructor
+
+	InputLog& operator = (const InputLog& other); // Copy Assignment Operator
+	InputLog& operator = (InputLog&& other) noexcept; // Move Assignment Operator
+
+	//Events belong to the frame the next EndFrame closes
+	void AddKeyEvent(const unsigned int key, const bool pressed);
+	void EndFrame(const float dt);
+
+	int GetFrameCount() const;
+	float GetDeltaTime(const int frame) const;
+	//Presses and releases the keys the way they were before the frame
+	void ApplyKeyEvents(const int frame, Keyboard& keyboard) const;
+
+	//SimulationWorld::GetStateChecksum at the end of the recording, so a replay can tell whether it ended the same way
+	unsigned long long GetFinalChecksum() const;
+	void SetFinalChecksum(const unsigned long long checksum);
+
+	bool Save(const string& fileName) const;
+	//Returns false and leaves the log empty if the file is missing, isn't a log or is cut short
+	bool Load(const string& fileName);
+
+private:
+	void Clear();
+
+	vector<InputEvent> events;
+	vector<InputFrame> frames;
+	//Added since the last EndFrame
+	int pendingEventCount;
+
+	unsigned long long finalChecksum;
+};
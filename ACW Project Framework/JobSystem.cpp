@@ -0,0 +1,347 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+#include "Profiler.h"
+
+//Which queue the running thread owns, threads that aren't workers of this system all share queue 0
+static thread_local const JobSystem* currentJobSystem = nullptr;
+static thread_local int currentThreadIndex = 0;
+
+JobSystem::JobSystem(const int workerThreadCount) : queues(), workers(), jobPoolLock(), jobPool(), nextPooledJob(0), queuedJobCount(0), quit(false), sleepLock(), wakeCondition()
+{
+	const auto threadCount = max(workerThreadCount, 0) + 1;
+
+	for (auto i = 0; i < threadCount; i++)
+	{
+		queues.push_back(make_unique<WorkQueue>());
+		queues.back()->first = 0;
+		queues.back()->count = 0;
+	}
+
+	for (auto i = 1; i < threadCount; i++)
+	{
+		workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		lock_guard<mutex> lock(sleepLock);
+		quit = true;
+	}
+
+	wakeCondition.notify_all();
+
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+int JobSystem::GetThreadCount() const
+{
+	return static_cast<int>(queues.size());
+}
+
+JobHandle JobSystem::Add(const function<void()>& work)
+{
+	const auto job = CreateJob(work);
+
+	Schedule(job);
+
+	return job;
+}
+
+JobHandle JobSystem::Add(const function<void()>& work, const JobHandle& dependency)
+{
+	const auto job = CreateJob(work);
+
+	AddDependency(job, dependency);
+	Schedule(job);
+
+	return job;
+}
+
+JobHandle JobSystem::Add(const function<void()>& work, const vector<JobHandle>& dependencies)
+{
+	const auto job = CreateJob(work);
+
+	for (const auto& dependency : dependencies)
+	{
+		AddDependency(job, dependency);
+	}
+
+	Schedule(job);
+
+	return job;
+}
+
+void JobSystem::Wait(const JobHandle& job)
+{
+	while (!job->finished)
+	{
+		if (!TryRunJob())
+		{
+			this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::Wait(const vector<JobHandle>& jobs)
+{
+	for (const auto& job : jobs)
+	{
+		Wait(job);
+	}
+}
+
+void JobSystem::ParallelFor(const int count, const int chunkSize, const function<void(int, int)>& work)
+{
+	const auto chunk = max(chunkSize, 1);
+
+	//Not worth a job
+	if (count <= chunk || GetThreadCount() == 1)
+	{
+		if (count > 0)
+		{
+			work(0, count);
+		}
+
+		return;
+	}
+
+	vector<JobHandle> chunks;
+
+	//The first range runs here once the rest are queued
+	for (auto first = chunk; first < count; first += chunk)
+	{
+		const auto last = min(first + chunk, count);
+
+		chunks.push_back(Add([&work, first, last]() { work(first, last); }));
+	}
+
+	work(0, chunk);
+
+	Wait(chunks);
+}
+
+int JobSystem::GetDefaultWorkerThreadCount()
+{
+	return max(static_cast<int>(thread::hardware_concurrency()) - 1, 0);
+}
+
+void JobSystem::PushBack(WorkQueue& queue, const JobHandle& job)
+{
+	if (queue.count == queue.jobs.size())
+	{
+		//Unwrap into a bigger buffer so the jobs stay in order
+		vector<JobHandle> jobs(max<size_t>(queue.jobs.size() * 2, 16));
+
+		for (size_t i = 0; i < queue.count; i++)
+		{
+			jobs[i] = move(queue.jobs[(queue.first + i) % queue.jobs.size()]);
+		}
+
+		queue.jobs.swap(jobs);
+		queue.first = 0;
+	}
+
+	queue.jobs[(queue.first + queue.count) % queue.jobs.size()] = job;
+	queue.count++;
+}
+
+JobHandle JobSystem::PopBack(WorkQueue& queue)
+{
+	queue.count--;
+
+	//Moving out leaves the slot empty so the queue doesn't keep the job from being reused
+	return move(queue.jobs[(queue.first + queue.count) % queue.jobs.size()]);
+}
+
+JobHandle JobSystem::PopFront(WorkQueue& queue)
+{
+	auto job = move(queue.jobs[queue.first]);
+
+	queue.first = (queue.first + 1) % queue.jobs.size();
+	queue.count--;
+
+	return job;
+}
+
+void JobSystem::WorkerLoop(const int threadIndex)
+{
+	currentJobSystem = this;
+	currentThreadIndex = threadIndex;
+
+	Profiler::SetThreadName("Job worker " + to_string(threadIndex));
+
+	while (!quit)
+	{
+		if (TryRunJob())
+		{
+			continue;
+		}
+
+		unique_lock<mutex> lock(sleepLock);
+		wakeCondition.wait(lock, [this]() { return queuedJobCount > 0 || quit; });
+	}
+}
+
+JobHandle JobSystem::CreateJob(const function<void()>& work)
+{
+	JobHandle job;
+
+	{
+		lock_guard<mutex> lock(jobPoolLock);
+
+		//Carry on from the last job handed out, the ones just before it are the most likely to still be running
+		for (size_t i = 0; i < jobPool.size() && !job; i++)
+		{
+			const auto index = (nextPooledJob + i) % jobPool.size();
+
+			//Only the pool holds it so nothing can still be using it, and nothing else can get it while we hold the lock
+			if (jobPool[index].use_count() == 1)
+			{
+				job = jobPool[index];
+				nextPooledJob = (index + 1) % jobPool.size();
+			}
+		}
+
+		if (!job)
+		{
+			jobPool.push_back(make_shared<Job>());
+			job = jobPool.back();
+
+			//Whichever job this ends up being reused as, it is unlikely to have more dependents than this
+			job->dependents.reserve(JOB_DEPENDENT_CAPACITY);
+		}
+	}
+
+	//Execute finishes with the job under this lock, taking it makes everything it did visible here
+	lock_guard<mutex> lock(job->dependentsLock);
+
+	job->work = work;
+	job->unfinishedDependencies = 1;
+	job->finished = false;
+
+	return job;
+}
+
+void JobSystem::AddDependency(const JobHandle& job, const JobHandle& dependency)
+{
+	//Holding the lock means the dependency either sees us in its list when it finishes or has already finished
+	lock_guard<mutex> lock(dependency->dependentsLock);
+
+	if (!dependency->finished)
+	{
+		dependency->dependents.push_back(job);
+		job->unfinishedDependencies++;
+	}
+}
+
+void JobSystem::Schedule(const JobHandle& job)
+{
+	if (--job->unfinishedDependencies == 0)
+	{
+		Push(job);
+	}
+}
+
+void JobSystem::Push(const JobHandle& job)
+{
+	auto& queue = *queues[GetCurrentThreadIndex()];
+
+	{
+		lock_guard<mutex> lock(queue.lock);
+		PushBack(queue, job);
+	}
+
+	queuedJobCount++;
+
+	//Taking the lock stops a worker missing the wake between checking the count and sleeping
+	{
+		lock_guard<mutex> lock(sleepLock);
+	}
+
+	wakeCondition.notify_one();
+}
+
+bool JobSystem::TryRunJob()
+{
+	const auto job = TryGetJob(GetCurrentThreadIndex());
+
+	if (!job)
+	{
+		return false;
+	}
+
+	Execute(job);
+
+	return true;
+}
+
+JobHandle JobSystem::TryGetJob(const int threadIndex)
+{
+	const auto threadCount = GetThreadCount();
+
+	//Our own newest job first, it is the most likely to still be in cache
+	{
+		auto& queue = *queues[threadIndex];
+		lock_guard<mutex> lock(queue.lock);
+
+		if (queue.count > 0)
+		{
+			queuedJobCount--;
+
+			return PopBack(queue);
+		}
+	}
+
+	//Then the oldest job of anyone else, starting with the next thread along so thieves spread out
+	for (auto i = 1; i < threadCount; i++)
+	{
+		auto& queue = *queues[(threadIndex + i) % threadCount];
+		lock_guard<mutex> lock(queue.lock);
+
+		if (queue.count > 0)
+		{
+			queuedJobCount--;
+
+			return PopFront(queue);
+		}
+	}
+
+	return nullptr;
+}
+
+void JobSystem::Execute(const JobHandle& job)
+{
+	{
+		const ProfileZone zone("Job");
+		job->work();
+	}
+
+	//Let go of anything the work captured now rather than when the job is reused
+	job->work = nullptr;
+
+	lock_guard<mutex> lock(job->dependentsLock);
+
+	job->finished = true;
+
+	for (const auto& dependent : job->dependents)
+	{
+		if (--dependent->unfinishedDependencies == 0)
+		{
+			Push(dependent);
+		}
+	}
+
+	//clear keeps the storage for the next time the job is used
+	job->dependents.clear();
+}
+
+int JobSystem::GetCurrentThreadIndex() const
+{
+	return currentJobSystem == this ? currentThreadIndex : 0;
+}
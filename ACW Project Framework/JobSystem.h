@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+//Room every pooled job keeps for jobs waiting on it
+const int JOB_DEPENDENT_CAPACITY = 4;
+
+//A job and the jobs waiting on it, JobSystem owns the scheduling state
+struct Job
+{
+	function<void()> work;
+
+	//Dependencies still running plus one held by Add until the job has been wired up
+	atomic<int> unfinishedDependencies;
+	atomic<bool> finished;
+
+	mutex dependentsLock;
+	vector<shared_ptr<Job>> dependents;
+};
+
+typedef shared_ptr<Job> JobHandle;
+
+//Work stealing scheduler for the per frame update phases. Every thread has its own deque, it takes its newest job
+//from the back and when it runs dry it steals the oldest job from the front of another thread's deque.
+//Jobs can depend on other jobs and only become runnable once all of those have finished.
+//The thread that calls Wait or ParallelFor runs jobs too, so a system with no worker threads runs everything inline.
+//Jobs nobody holds a handle to any more are reused and the deques keep their storage, so a frame that adds no more
+//jobs than an earlier one doesn't allocate
+class JobSystem
+{
+public:
+	explicit JobSystem(const int workerThreadCount);
+	JobSystem(const JobSystem& other) = delete; // Copy Constructor
+	JobSystem(JobSystem&& other) noexcept = delete; // Move Constructor
+	~JobSystem(); // Destructor
+
+	JobSystem& operator = (const JobSystem& other) = delete; // Copy Assignment Operator
+	JobSystem& operator = (JobSystem&& other) noexcept = delete; // Move Assignment Operator
+
+	//Worker threads plus the thread that waits
+	int GetThreadCount() const;
+
+	//Queues work to run once every job in dependencies has finished
+	JobHandle Add(const function<void()>& work);
+	JobHandle Add(const function<void()>& work, const JobHandle& dependency);
+	JobHandle Add(const function<void()>& work, const vector<JobHandle>& dependencies);
+
+	//Runs queued jobs on the calling thread until job has finished
+	void Wait(const JobHandle& job);
+	void Wait(const vector<JobHandle>& jobs);
+
+	//Splits 0 to count - 1 into ranges of at most chunkSize, work gets the first index and one past the last,
+	//returns once every range has run
+	void ParallelFor(const int count, const int chunkSize, const function<void(int, int)>& work);
+
+	//One less than the hardware threads, the window thread is the last one
+	static int GetDefaultWorkerThreadCount();
+
+private:
+	//Ring buffer that only grows, std::deque frees and reallocates its blocks as jobs pass through
+	struct WorkQueue
+	{
+		mutex lock;
+		vector<JobHandle> jobs;
+		size_t first;
+		size_t count;
+	};
+
+	static void PushBack(WorkQueue& queue, const JobHandle& job);
+	static JobHandle PopBack(WorkQueue& queue);
+	static JobHandle PopFront(WorkQueue& queue);
+
+	void WorkerLoop(const int threadIndex);
+
+	//A pooled job nobody else holds or a new one, ready for its dependencies to be added
+	JobHandle CreateJob(const function<void()>& work);
+	static void AddDependency(const JobHandle& job, const JobHandle& dependency);
+	//Releases the hold CreateJob put on the job and queues it if no dependencies are left
+	void Schedule(const JobHandle& job);
+
+	void Push(const JobHandle& job);
+	bool TryRunJob();
+	JobHandle TryGetJob(const int threadIndex);
+	void Execute(const JobHandle& job);
+
+	int GetCurrentThreadIndex() const;
+
+	vector<unique_ptr<WorkQueue>> queues;
+	vector<thread> workers;
+
+	mutex jobPoolLock;
+	vector<JobHandle> jobPool;
+	size_t nextPooledJob;
+
+	//Jobs sitting in a queue, workers sleep while this is 0
+	atomic<int> queuedJobCount;
+	atomic<bool> quit;
+
+	mutex sleepLock;
+	condition_variable wakeCondition;
+};
@@ -1,24 +1,12 @@
 #include "LightShader.h"
 
-LightShader::LightShader(ID3D11Device* device, HWND hwnd)
-    : Shader("LightVertexShader", "LightHullShader", "LightDomainShader", "LightPixelShader", device, hwnd),
+LightShader::LightShader(ID3D11Device* device, HWND hwnd, const MeshVertexFormat vertexFormat)
+    : Shader("LightVertexShader", "LightHullShader", "LightDomainShader", "LightPixelShader", device, hwnd, vertexFormat),
     inputLayout(nullptr), sampleState(nullptr), lightBuffer(nullptr)
 {
     if (GetInitializationState()) return;
 
-    D3D11_INPUT_ELEMENT_DESC layout[7] = {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "INSTANCEMATRIX", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
-        { "INSTANCEMATRIX", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
-        { "INSTANCEMATRIX", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
-        { "INSTANCEMATRIX", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 }
-    };
-
-    const unsigned int numberOfElements = sizeof(layout) / sizeof(layout[0]);
-
-    auto result = device->CreateInputLayout(layout, numberOfElements, GetVertexShaderBuffer()->GetBufferPointer(), GetVertexShaderBuffer()->GetBufferSize(), &inputLayout);
+    auto result = CreateMeshInputLayout(device, &inputLayout);
 
     if (FAILED(result) || (GetVertexShaderBuffer()->Release(), SetVertexShaderBuffer(nullptr), false))
     {
@@ -51,7 +39,7 @@ LightShader::~LightShader()
     catch (exception&) {}
 }
 
-bool LightShader::Render(ID3D11DeviceContext* deviceContext, int indexCount, int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition)
+bool LightShader::Render(RenderContext* deviceContext, int indexCount, int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition)
 {
     auto const result = SetLightShaderParameters(deviceContext, viewMatrix, projectionMatrix, textures, pointLightList, cameraPosition);
 
@@ -61,7 +49,7 @@ bool LightShader::Render(ID3D11DeviceContext* deviceContext, int indexCount, int
     return true;
 }
 
-bool LightShader::SetLightShaderParameters(ID3D11DeviceContext* deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition)
+bool LightShader::SetLightShaderParameters(RenderContext* deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition)
 {
     const auto result = SetShaderParameters(deviceContext, viewMatrix, projectionMatrix, cameraPosition);
 
@@ -100,10 +88,10 @@ bool LightShader::SetLightShaderParameters(ID3D11DeviceContext* deviceContext, c
     return true;
 }
 
-void LightShader::RenderShader(ID3D11DeviceContext* deviceContext, int indexCount, int instanceCount) const
+void LightShader::RenderShader(RenderContext* deviceContext, int indexCount, int instanceCount) const
 {
     deviceContext->IASetInputLayout(inputLayout);
     SetShader(deviceContext);
     deviceContext->PSSetSamplers(0, 1, &sampleState);
-    deviceContext->DrawInstanced(indexCount, instanceCount, 0, 0);
+    deviceContext->DrawIndexedInstanced(indexCount, instanceCount, 0, 0, 0);
 }
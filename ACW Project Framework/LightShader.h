@@ -12,7 +12,7 @@ using namespace std;
 class LightShader : public Shader
 {
 public:
-	LightShader(ID3D11Device* const device, HWND const hwnd); // Default Constructor
+	LightShader(ID3D11Device* const device, HWND const hwnd, const MeshVertexFormat vertexFormat); // Default Constructor
 	LightShader(const LightShader& other); // Copy Constructor
 	LightShader(LightShader&& other) noexcept; // Move Constructor
 	~LightShader() override; // Destructor
@@ -20,11 +20,11 @@ public:
 	LightShader& operator = (const LightShader& other); // Copy Assignment Operator
 	LightShader& operator = (LightShader&& other) noexcept; // Move Assignment Operator
 
-	bool Render(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) override;
+	bool Render(RenderContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) override;
 
 private: 
-	bool SetLightShaderParameters(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition);
-	void RenderShader(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount) const;
+	bool SetLightShaderParameters(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition);
+	void RenderShader(RenderContext* const deviceContext, const int indexCount, const int instanceCount) const;
 
 	struct PointLights
 	{
@@ -1,3 +1,5 @@
+#include "MeshVertex.hlsli"
+
 //Global
 cbuffer MatrixBuffer : register(b0)
 {
@@ -22,9 +24,7 @@ cbuffer CameraBuffer : register(b2)
 //Type definitions
 struct VertexInput
 {
-	float3 position : POSITION;
-	float2 tex : TEXCOORD0;
-	float3 normal : NORMAL;
+	MeshVertexInput vertex;
 	matrix instanceWorldMatrix : INSTANCEMATRIX;
 };
 
@@ -39,15 +39,16 @@ struct HullInput
 HullInput LightVertexShader(VertexInput input)
 {
 	HullInput output;
+	const MeshVertex vertex = DecodeMeshVertex(input.vertex);
 
-	output.position = mul(float4(input.position, 1.0f), input.instanceWorldMatrix).xyz;
+	output.position = mul(float4(vertex.position, 1.0f), input.instanceWorldMatrix).xyz;
 
 	//Pass texture coords to pixel shader
-	output.tex = input.tex;
+	output.tex = vertex.tex;
 	//output.tex = mul(float4(input.tex, 0.0f, 1.0f), texTransform).xy;
 
 	//Calculate normal vector against world matrix
-	output.normal = normalize(mul(input.normal, (float3x3)input.instanceWorldMatrix));
+	output.normal = normalize(mul(vertex.normal, (float3x3)input.instanceWorldMatrix));
 
 	float distanceToCamera = distance(output.position, cameraPosition);
 
@@ -0,0 +1,148 @@
+#include "MappedFile.h"
+#include <cstdint>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() : data(nullptr), size(0), file(-1), mapping(-1)
+{
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(const string& fileName)
+{
+	Close();
+
+#if defined(_WIN32)
+	const auto fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	file = reinterpret_cast<intptr_t>(fileHandle);
+
+	LARGE_INTEGER fileSize;
+
+	if (!GetFileSizeEx(fileHandle, &fileSize))
+	{
+		Close();
+		return false;
+	}
+
+	size = static_cast<size_t>(fileSize.QuadPart);
+
+	//Windows can't map an empty file
+	if (size == 0)
+	{
+		return true;
+	}
+
+	const auto mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (!mappingHandle)
+	{
+		Close();
+		return false;
+	}
+
+	mapping = reinterpret_cast<intptr_t>(mappingHandle);
+	data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+	file = open(fileName.c_str(), O_RDONLY);
+
+	if (file < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStatus;
+
+	if (fstat(static_cast<int>(file), &fileStatus) != 0)
+	{
+		Close();
+		return false;
+	}
+
+	size = static_cast<size_t>(fileStatus.st_size);
+
+	if (size == 0)
+	{
+		return true;
+	}
+
+	//Populating the pages up front costs less than faulting them in one at a time while parsing
+#if defined(MAP_POPULATE)
+	const auto flags = MAP_PRIVATE | MAP_POPULATE;
+#else
+	const auto flags = MAP_PRIVATE;
+#endif
+
+	auto* const view = mmap(nullptr, size, PROT_READ, flags, static_cast<int>(file), 0);
+	data = view == MAP_FAILED ? nullptr : static_cast<const char*>(view);
+#endif
+
+	if (!data)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+#if defined(_WIN32)
+	if (data)
+	{
+		UnmapViewOfFile(data);
+	}
+
+	if (mapping != -1)
+	{
+		CloseHandle(reinterpret_cast<HANDLE>(mapping));
+	}
+
+	if (file != -1)
+	{
+		CloseHandle(reinterpret_cast<HANDLE>(file));
+	}
+#else
+	if (data)
+	{
+		munmap(const_cast<char*>(data), size);
+	}
+
+	if (file >= 0)
+	{
+		close(static_cast<int>(file));
+	}
+#endif
+
+	data = nullptr;
+	size = 0;
+	file = -1;
+	mapping = -1;
+}
+
+const char* MappedFile::GetData() const
+{
+	return data;
+}
+
+size_t MappedFile::GetSize() const
+{
+	return size;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+//A file mapped read-only into memory, so it can be parsed in place without being copied through a stream.
+//The view stays valid until the MappedFile is closed or destroyed
+class MappedFile
+{
+public:
+	MappedFile();
+	MappedFile(const MappedFile& other) = delete; // Copy Constructor
+	MappedFile(MappedFile&& other) noexcept = delete; // Move Constructor
+	~MappedFile(); // Destructor
+
+	MappedFile& operator = (const MappedFile& other) = delete; // Copy Assignment Operator
+	MappedFile& operator = (MappedFile&& other) noexcept = delete; // Move Assignment Operator
+
+	//Closes any file already open, an empty file opens with no data
+	bool Open(const string& fileName);
+	void Close();
+
+	const char* GetData() const;
+	size_t GetSize() const;
+
+private:
+	const char* data;
+	size_t size;
+
+	//Platform handles, kept as integers so the header doesn't need Windows.h
+	intptr_t file;
+	intptr_t mapping;
+};
@@ -0,0 +1,231 @@
+#include "MeshCache.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+//Blobs start on this boundary so they can be read in place
+static const uint64_t MESH_CACHE_ALIGNMENT = 16;
+
+MeshCache::MeshCache() : file(), header(nullptr)
+{
+}
+
+MeshCache::~MeshCache() = default;
+
+bool MeshCache::Open(const string& fileName, const uint64_t sourceHash, const MeshVertexLayout& layout)
+{
+	header = nullptr;
+
+	if (!file.Open(fileName) || file.GetSize() < sizeof(Header))
+	{
+		file.Close();
+		return false;
+	}
+
+	const auto* const fileHeader = reinterpret_cast<const Header*>(file.GetData());
+	const auto attributesSize = static_cast<uint64_t>(layout.attributes.size()) * sizeof(MeshVertexAttribute);
+
+	const auto matches = fileHeader->magic == MESH_CACHE_MAGIC && fileHeader->version == MESH_CACHE_VERSION && fileHeader->sourceHash == sourceHash &&
+		fileHeader->layoutVersion == layout.version && fileHeader->vertexStride == layout.stride && fileHeader->attributeCount == layout.attributes.size() &&
+		fileHeader->indexSize == sizeof(uint32_t) && sizeof(Header) + attributesSize <= file.GetSize() &&
+		memcmp(file.GetData() + sizeof(Header), layout.attributes.data(), static_cast<size_t>(attributesSize)) == 0;
+
+	//Offsets and counts are checked against the file's size so a truncated cache is never read past its end
+	if (!matches || fileHeader->vertexOffset % MESH_CACHE_ALIGNMENT != 0 || fileHeader->indexOffset % MESH_CACHE_ALIGNMENT != 0 ||
+		fileHeader->vertexOffset + static_cast<uint64_t>(fileHeader->vertexCount) * fileHeader->vertexStride > file.GetSize() ||
+		fileHeader->indexOffset + static_cast<uint64_t>(fileHeader->indexCount) * fileHeader->indexSize > file.GetSize())
+	{
+		file.Close();
+		return false;
+	}
+
+	//Every level has to be drawn from inside the index blob
+	if (fileHeader->levelOfDetailCount == 0 || fileHeader->levelOfDetailOffset + static_cast<uint64_t>(fileHeader->levelOfDetailCount) * sizeof(MeshLevelOfDetail) > file.GetSize())
+	{
+		file.Close();
+		return false;
+	}
+
+	const auto* const levelsOfDetail = reinterpret_cast<const MeshLevelOfDetail*>(file.GetData() + fileHeader->levelOfDetailOffset);
+
+	for (auto level = 0u; level < fileHeader->levelOfDetailCount; level++)
+	{
+		if (static_cast<uint64_t>(levelsOfDetail[level].firstIndex) + levelsOfDetail[level].indexCount > fileHeader->indexCount)
+		{
+			file.Close();
+			return false;
+		}
+	}
+
+	header = fileHeader;
+
+	return true;
+}
+
+bool MeshCache::Write(const string& fileName, const uint64_t sourceHash, const MeshVertexLayout& layout, const void* const vertices, const uint32_t vertexCount, const uint32_t* const indices, const uint32_t indexCount, const MeshLevelOfDetail* const levelsOfDetail, const uint32_t levelOfDetailCount, const float boundsMin[3], const float boundsMax[3], const uint32_t sourceVertexCount, const float unoptimizedAcmr, const float acmr)
+{
+	Header fileHeader = {};
+	fileHeader.magic = MESH_CACHE_MAGIC;
+	fileHeader.version = MESH_CACHE_VERSION;
+	fileHeader.sourceHash = sourceHash;
+	fileHeader.layoutVersion = layout.version;
+	fileHeader.vertexStride = layout.stride;
+	fileHeader.attributeCount = static_cast<uint32_t>(layout.attributes.size());
+	fileHeader.vertexCount = vertexCount;
+	fileHeader.indexCount = indexCount;
+	fileHeader.indexSize = sizeof(uint32_t);
+	fileHeader.levelOfDetailCount = levelOfDetailCount;
+	memcpy(fileHeader.boundsMin, boundsMin, sizeof(fileHeader.boundsMin));
+	memcpy(fileHeader.boundsMax, boundsMax, sizeof(fileHeader.boundsMax));
+	fileHeader.sourceVertexCount = sourceVertexCount;
+	fileHeader.unoptimizedAcmr = unoptimizedAcmr;
+	fileHeader.acmr = acmr;
+	fileHeader.levelOfDetailOffset = sizeof(Header) + layout.attributes.size() * sizeof(MeshVertexAttribute);
+	fileHeader.vertexOffset = Align(fileHeader.levelOfDetailOffset + static_cast<uint64_t>(levelOfDetailCount) * sizeof(MeshLevelOfDetail));
+	fileHeader.indexOffset = Align(fileHeader.vertexOffset + static_cast<uint64_t>(vertexCount) * layout.stride);
+
+	//Written under another name and renamed so a load that is interrupted never leaves half a cache behind
+	const auto temporaryFileName = fileName + ".tmp";
+
+	{
+		ofstream output(temporaryFileName, ios::binary | ios::trunc);
+
+		if (!output)
+		{
+			return false;
+		}
+
+		const char padding[MESH_CACHE_ALIGNMENT] = {};
+
+		output.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+		output.write(reinterpret_cast<const char*>(layout.attributes.data()), layout.attributes.size() * sizeof(MeshVertexAttribute));
+		output.write(reinterpret_cast<const char*>(levelsOfDetail), static_cast<streamsize>(levelOfDetailCount) * sizeof(MeshLevelOfDetail));
+		output.write(padding, static_cast<streamsize>(fileHeader.vertexOffset - (fileHeader.levelOfDetailOffset + static_cast<uint64_t>(levelOfDetailCount) * sizeof(MeshLevelOfDetail))));
+		output.write(static_cast<const char*>(vertices), static_cast<streamsize>(vertexCount) * layout.stride);
+		output.write(padding, static_cast<streamsize>(fileHeader.indexOffset - (fileHeader.vertexOffset + static_cast<uint64_t>(vertexCount) * layout.stride)));
+		output.write(reinterpret_cast<const char*>(indices), static_cast<streamsize>(indexCount) * sizeof(uint32_t));
+
+		if (!output)
+		{
+			output.close();
+			remove(temporaryFileName.c_str());
+			return false;
+		}
+	}
+
+	remove(fileName.c_str());
+
+	if (rename(temporaryFileName.c_str(), fileName.c_str()) != 0)
+	{
+		remove(temporaryFileName.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+bool MeshCache::HashFile(const string& fileName, uint64_t& hash)
+{
+	MappedFile source;
+
+	if (!source.Open(fileName))
+	{
+		return false;
+	}
+
+	const auto* const data = source.GetData();
+	const auto size = source.GetSize();
+	const auto wordCount = size / sizeof(uint64_t);
+
+	hash = 14695981039346656037ull;
+
+	for (size_t i = 0; i < wordCount; i++)
+	{
+		uint64_t word;
+		memcpy(&word, data + i * sizeof(uint64_t), sizeof(word));
+		hash = (hash ^ word) * 1099511628211ull;
+	}
+
+	for (auto i = wordCount * sizeof(uint64_t); i < size; i++)
+	{
+		hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ull;
+	}
+
+	//Files that only differ by trailing zero bytes would otherwise hash the same
+	hash = (hash ^ size) * 1099511628211ull;
+
+	return true;
+}
+
+string MeshCache::GetCacheFileName(const string& modelFileName)
+{
+	const auto extension = modelFileName.find_last_of('.');
+	const auto directory = modelFileName.find_last_of("/\\");
+
+	if (extension == string::npos || (directory != string::npos && extension < directory))
+	{
+		return modelFileName + MESH_CACHE_EXTENSION;
+	}
+
+	return modelFileName.substr(0, extension) + MESH_CACHE_EXTENSION;
+}
+
+const void* MeshCache::GetVertices() const
+{
+	return file.GetData() + header->vertexOffset;
+}
+
+uint32_t MeshCache::GetVertexCount() const
+{
+	return header->vertexCount;
+}
+
+const uint32_t* MeshCache::GetIndices() const
+{
+	return reinterpret_cast<const uint32_t*>(file.GetData() + header->indexOffset);
+}
+
+uint32_t MeshCache::GetIndexCount() const
+{
+	return header->indexCount;
+}
+
+const MeshLevelOfDetail* MeshCache::GetLevelsOfDetail() const
+{
+	return reinterpret_cast<const MeshLevelOfDetail*>(file.GetData() + header->levelOfDetailOffset);
+}
+
+uint32_t MeshCache::GetLevelOfDetailCount() const
+{
+	return header->levelOfDetailCount;
+}
+
+const float* MeshCache::GetBoundsMin() const
+{
+	return header->boundsMin;
+}
+
+const float* MeshCache::GetBoundsMax() const
+{
+	return header->boundsMax;
+}
+
+uint32_t MeshCache::GetSourceVertexCount() const
+{
+	return header->sourceVertexCount;
+}
+
+float MeshCache::GetUnoptimizedAcmr() const
+{
+	return header->unoptimizedAcmr;
+}
+
+float MeshCache::GetAcmr() const
+{
+	return header->acmr;
+}
+
+uint64_t MeshCache::Align(const uint64_t offset)
+{
+	return (offset + MESH_CACHE_ALIGNMENT - 1) / MESH_CACHE_ALIGNMENT * MESH_CACHE_ALIGNMENT;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+using namespace std;
+
+//"MBIN" at the start of every cache file, the version changes whenever the file layout does
+const uint32_t MESH_CACHE_MAGIC = 0x4E49424D;
+const uint32_t MESH_CACHE_VERSION = 4;
+const char* const MESH_CACHE_EXTENSION = ".meshbin";
+
+//What a vertex attribute holds, the input layout's semantic names
+const uint32_t MESH_SEMANTIC_POSITION = 0;
+const uint32_t MESH_SEMANTIC_TEXCOORD = 1;
+const uint32_t MESH_SEMANTIC_NORMAL = 2;
+const uint32_t MESH_SEMANTIC_TANGENT = 3;
+const uint32_t MESH_SEMANTIC_BINORMAL = 4;
+const uint32_t MESH_SEMANTIC_FRAME = 5;
+
+//Indexed by the semantics above
+const char* const MESH_SEMANTIC_NAMES[] = { "POSITION", "TEXCOORD", "NORMAL", "TANGENT", "BINORMAL", "FRAME" };
+
+//One attribute of a cached vertex. The format is a DXGI_FORMAT value, kept as an integer so the cache doesn't need Direct3D
+struct MeshVertexAttribute
+{
+	uint32_t semantic;
+	uint32_t semanticIndex;
+	uint32_t format;
+	uint32_t offset;
+};
+
+//A range of the index blob drawn at one level of detail, level 0 is the mesh itself. The error is how far the
+//simplified surface strays from the original, relative to the radius of the sphere around the mesh's bounds
+struct MeshLevelOfDetail
+{
+	uint32_t firstIndex;
+	uint32_t indexCount;
+	float error;
+};
+
+//Everything a cache has to match to be used: the version of the code that builds the vertices, their size and attributes
+struct MeshVertexLayout
+{
+	uint32_t version;
+	uint32_t stride;
+	vector<MeshVertexAttribute> attributes;
+};
+
+//A processed mesh saved next to the model it was built from, so later loads skip parsing and tangent generation.
+//A file is a header, the vertex layout, the levels of detail, then the vertex and index blobs, each 16 byte aligned. Open maps the file and
+//hands out pointers straight into it, so the blobs go to buffer creation without being copied.
+//A cache is only used while the model file hashes to the value it was written with and the layout is the same
+class MeshCache
+{
+public:
+	MeshCache();
+	MeshCache(const MeshCache& other) = delete; // Copy Constructor
+	MeshCache(MeshCache&& other) noexcept = delete; // Move Constructor
+	~MeshCache(); // Destructor
+
+	MeshCache& operator = (const MeshCache& other) = delete; // Copy Assignment Operator
+	MeshCache& operator = (MeshCache&& other) noexcept = delete; // Move Assignment Operator
+
+	//False if the file is missing, damaged, out of date or was written for a different layout
+	bool Open(const string& fileName, const uint64_t sourceHash, const MeshVertexLayout& layout);
+
+	//sourceVertexCount and unoptimizedAcmr describe the mesh before it was welded and reordered and acmr after, they are only
+	//kept for reporting. Every level's range has to be inside indices
+	static bool Write(const string& fileName, const uint64_t sourceHash, const MeshVertexLayout& layout, const void* const vertices, const uint32_t vertexCount, const uint32_t* const indices, const uint32_t indexCount, const MeshLevelOfDetail* const levelsOfDetail, const uint32_t levelOfDetailCount, const float boundsMin[3], const float boundsMax[3], const uint32_t sourceVertexCount, const float unoptimizedAcmr, const float acmr);
+
+	//FNV-1a over the file's contents a 64 bit word at a time
+	static bool HashFile(const string& fileName, uint64_t& hash);
+	//The model's file name with its extension replaced by MESH_CACHE_EXTENSION
+	static string GetCacheFileName(const string& modelFileName);
+
+	const void* GetVertices() const;
+	uint32_t GetVertexCount() const;
+	const uint32_t* GetIndices() const;
+	uint32_t GetIndexCount() const;
+	const MeshLevelOfDetail* GetLevelsOfDetail() const;
+	uint32_t GetLevelOfDetailCount() const;
+	const float* GetBoundsMin() const;
+	const float* GetBoundsMax() const;
+	uint32_t GetSourceVertexCount() const;
+	float GetUnoptimizedAcmr() const;
+	float GetAcmr() const;
+
+private:
+	struct Header
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t sourceHash;
+		uint32_t layoutVersion;
+		uint32_t vertexStride;
+		uint32_t attributeCount;
+		uint32_t vertexCount;
+		uint32_t indexCount;
+		uint32_t indexSize;
+		uint32_t levelOfDetailCount;
+		float boundsMin[3];
+		float boundsMax[3];
+		uint32_t sourceVertexCount;
+		float unoptimizedAcmr;
+		float acmr;
+		uint64_t levelOfDetailOffset;
+		uint64_t vertexOffset;
+		uint64_t indexOffset;
+	};
+
+	static uint64_t Align(const uint64_t offset);
+
+	MappedFile file;
+	const Header* header;
+};
@@ -0,0 +1,299 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+//Forsyth's constants, the last three triangles' vertices score the same so a strip doesn't zigzag
+static const float CACHE_DECAY_POWER = 1.5f;
+static const float LAST_TRIANGLE_SCORE = 0.75f;
+static const float VALENCE_BOOST_SCALE = 2.0f;
+static const float VALENCE_BOOST_POWER = 0.5f;
+static const int VALENCE_TABLE_SIZE = 64;
+
+static uint64_t HashVertex(const unsigned char* const vertex, const size_t stride)
+{
+	auto hash = 14695981039346656037ull;
+
+	for (size_t i = 0; i < stride; i++)
+	{
+		hash = (hash ^ vertex[i]) * 1099511628211ull;
+	}
+
+	return hash;
+}
+
+int MeshOptimizer::WeldVertices(void* const vertices, const int vertexCount, const size_t stride, vector<uint32_t>& indices)
+{
+	auto* const bytes = static_cast<unsigned char*>(vertices);
+
+	//Open addressing over the unique vertices, at most half full
+	auto tableSize = 1u;
+
+	while (tableSize < static_cast<unsigned int>(vertexCount) * 2)
+	{
+		tableSize <<= 1;
+	}
+
+	vector<int> table(tableSize, -1);
+	vector<uint32_t> remap(vertexCount);
+	auto uniqueCount = 0;
+
+	for (auto i = 0; i < vertexCount; i++)
+	{
+		const auto* const vertex = bytes + i * stride;
+		auto slot = static_cast<unsigned int>(HashVertex(vertex, stride)) & (tableSize - 1);
+
+		while (table[slot] != -1 && memcmp(bytes + table[slot] * stride, vertex, stride) != 0)
+		{
+			slot = (slot + 1) & (tableSize - 1);
+		}
+
+		if (table[slot] == -1)
+		{
+			//Unique vertices only ever move towards the front, so nothing is overwritten before it is read
+			if (uniqueCount != i)
+			{
+				memcpy(bytes + uniqueCount * stride, vertex, stride);
+			}
+
+			table[slot] = uniqueCount++;
+		}
+
+		remap[i] = table[slot];
+	}
+
+	for (auto& index : indices)
+	{
+		index = remap[index];
+	}
+
+	return uniqueCount;
+}
+
+float MeshOptimizer::GetVertexScore(const int cachePosition, const int remainingTriangles)
+{
+	//pow is too slow to call for every vertex of every triangle, the common cases come from tables built once
+	static const auto scoreTables = []()
+	{
+		vector<float> tables(VERTEX_CACHE_OPTIMIZE_SIZE + VALENCE_TABLE_SIZE);
+
+		for (auto position = 0; position < VERTEX_CACHE_OPTIMIZE_SIZE; position++)
+		{
+			tables[position] = position < 3 ? LAST_TRIANGLE_SCORE : pow(1.0f - (position - 3) / static_cast<float>(VERTEX_CACHE_OPTIMIZE_SIZE - 3), CACHE_DECAY_POWER);
+		}
+
+		for (auto valence = 1; valence < VALENCE_TABLE_SIZE; valence++)
+		{
+			tables[VERTEX_CACHE_OPTIMIZE_SIZE + valence] = VALENCE_BOOST_SCALE * pow(static_cast<float>(valence), -VALENCE_BOOST_POWER);
+		}
+
+		return tables;
+	}();
+
+	if (remainingTriangles == 0)
+	{
+		return -1.0f;
+	}
+
+	const auto cacheScore = cachePosition >= 0 ? scoreTables[cachePosition] : 0.0f;
+	const auto valenceScore = remainingTriangles < VALENCE_TABLE_SIZE ? scoreTables[VERTEX_CACHE_OPTIMIZE_SIZE + remainingTriangles] : VALENCE_BOOST_SCALE * pow(static_cast<float>(remainingTriangles), -VALENCE_BOOST_POWER);
+
+	return cacheScore + valenceScore;
+}
+
+void MeshOptimizer::OptimizeVertexCache(vector<uint32_t>& indices, const int vertexCount)
+{
+	const auto triangleCount = static_cast<int>(indices.size() / 3);
+
+	if (triangleCount == 0)
+	{
+		return;
+	}
+
+	//The triangles each vertex is in, as ranges of one array
+	vector<int> remainingTriangles(vertexCount, 0);
+
+	for (const auto index : indices)
+	{
+		remainingTriangles[index]++;
+	}
+
+	vector<int> firstTriangle(vertexCount + 1, 0);
+
+	for (auto vertex = 0; vertex < vertexCount; vertex++)
+	{
+		firstTriangle[vertex + 1] = firstTriangle[vertex] + remainingTriangles[vertex];
+	}
+
+	vector<int> vertexTriangles(indices.size());
+	vector<int> filledTriangles(vertexCount, 0);
+
+	for (auto triangle = 0; triangle < triangleCount; triangle++)
+	{
+		for (auto corner = 0; corner < 3; corner++)
+		{
+			const auto vertex = indices[triangle * 3 + corner];
+			vertexTriangles[firstTriangle[vertex] + filledTriangles[vertex]++] = triangle;
+		}
+	}
+
+	vector<float> vertexScore(vertexCount);
+
+	for (auto vertex = 0; vertex < vertexCount; vertex++)
+	{
+		vertexScore[vertex] = GetVertexScore(-1, remainingTriangles[vertex]);
+	}
+
+	vector<float> triangleScore(triangleCount);
+	vector<bool> emitted(triangleCount, false);
+
+	for (auto triangle = 0; triangle < triangleCount; triangle++)
+	{
+		triangleScore[triangle] = vertexScore[indices[triangle * 3]] + vertexScore[indices[triangle * 3 + 1]] + vertexScore[indices[triangle * 3 + 2]];
+	}
+
+	//Three extra entries hold the vertices pushed out by the last triangle so their scores can be updated
+	vector<int> cache;
+	vector<int> nextCache;
+	cache.reserve(VERTEX_CACHE_OPTIMIZE_SIZE + 3);
+	nextCache.reserve(VERTEX_CACHE_OPTIMIZE_SIZE + 3);
+
+	vector<uint32_t> optimized;
+	optimized.reserve(indices.size());
+
+	//The emitted triangle that last put each vertex at the front of the cache, so the cache is rebuilt without searching it
+	vector<int> addedBy(vertexCount, -1);
+
+	auto bestTriangle = static_cast<int>(max_element(triangleScore.begin(), triangleScore.end()) - triangleScore.begin());
+	auto nextUnemitted = 0;
+
+	for (auto emittedCount = 0; emittedCount < triangleCount; emittedCount++)
+	{
+		//Nothing in the cache has triangles left, carry on from the first triangle not yet emitted
+		if (bestTriangle < 0)
+		{
+			while (emitted[nextUnemitted])
+			{
+				nextUnemitted++;
+			}
+
+			bestTriangle = nextUnemitted;
+		}
+
+		emitted[bestTriangle] = true;
+
+		nextCache.clear();
+
+		for (auto corner = 0; corner < 3; corner++)
+		{
+			const auto vertex = static_cast<int>(indices[bestTriangle * 3 + corner]);
+
+			optimized.push_back(vertex);
+
+			if (addedBy[vertex] != emittedCount)
+			{
+				addedBy[vertex] = emittedCount;
+				nextCache.push_back(vertex);
+			}
+
+			//Take the triangle out of the vertex's list of triangles left to draw
+			auto* const begin = vertexTriangles.data() + firstTriangle[vertex];
+			auto* const end = begin + remainingTriangles[vertex];
+			*find(begin, end, bestTriangle) = *(end - 1);
+			remainingTriangles[vertex]--;
+		}
+
+		for (const auto vertex : cache)
+		{
+			if (addedBy[vertex] != emittedCount)
+			{
+				nextCache.push_back(vertex);
+			}
+		}
+
+		swap(cache, nextCache);
+
+		//Rescore everything the cache touched, vertices past its end have dropped out
+		bestTriangle = -1;
+		auto bestScore = -1.0f;
+
+		for (auto position = 0; position < static_cast<int>(cache.size()); position++)
+		{
+			const auto vertex = cache[position];
+			const auto newPosition = position < VERTEX_CACHE_OPTIMIZE_SIZE ? position : -1;
+			const auto newScore = GetVertexScore(newPosition, remainingTriangles[vertex]);
+			const auto scoreChange = newScore - vertexScore[vertex];
+
+			vertexScore[vertex] = newScore;
+
+			for (auto i = 0; i < remainingTriangles[vertex]; i++)
+			{
+				const auto triangle = vertexTriangles[firstTriangle[vertex] + i];
+
+				triangleScore[triangle] += scoreChange;
+
+				if (triangleScore[triangle] > bestScore)
+				{
+					bestScore = triangleScore[triangle];
+					bestTriangle = triangle;
+				}
+			}
+		}
+
+		if (cache.size() > VERTEX_CACHE_OPTIMIZE_SIZE)
+		{
+			cache.resize(VERTEX_CACHE_OPTIMIZE_SIZE);
+		}
+	}
+
+	indices = move(optimized);
+}
+
+int MeshOptimizer::OptimizeVertexFetch(void* const vertices, const int vertexCount, const size_t stride, vector<uint32_t>& indices)
+{
+	auto* const bytes = static_cast<unsigned char*>(vertices);
+
+	vector<int> remap(vertexCount, -1);
+	vector<unsigned char> reordered(vertexCount * stride);
+	auto usedCount = 0;
+
+	for (auto& index : indices)
+	{
+		if (remap[index] < 0)
+		{
+			memcpy(reordered.data() + usedCount * stride, bytes + index * stride, stride);
+			remap[index] = usedCount++;
+		}
+
+		index = remap[index];
+	}
+
+	memcpy(bytes, reordered.data(), usedCount * stride);
+
+	return usedCount;
+}
+
+float MeshOptimizer::GetAcmr(const vector<uint32_t>& indices, const int vertexCount, const int cacheSize)
+{
+	const auto triangleCount = indices.size() / 3;
+
+	if (triangleCount == 0)
+	{
+		return 0.0f;
+	}
+
+	//When each vertex last entered the cache, it is still there while fewer than cacheSize misses have happened since
+	vector<int> cachedAt(vertexCount, -cacheSize - 1);
+	auto misses = 0;
+
+	for (const auto index : indices)
+	{
+		if (misses - cachedAt[index] > cacheSize)
+		{
+			cachedAt[index] = misses;
+			misses++;
+		}
+	}
+
+	return static_cast<float>(misses) / triangleCount;
+}
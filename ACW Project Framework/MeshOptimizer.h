@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+//Entries in the LRU cache the triangle order is optimised for
+const int VERTEX_CACHE_OPTIMIZE_SIZE = 32;
+//Entries in the FIFO cache GetAcmr simulates, about what GPUs have had for post transform reuse
+const int VERTEX_CACHE_MEASURE_SIZE = 16;
+
+//Prepares a triangle list for drawing: identical vertices are merged into one, triangles are reordered so vertices
+//are reused from the post transform cache and vertices are reordered into the order they are first used.
+//Vertices are opaque blocks of stride bytes, two are the same vertex only if every byte is equal
+class MeshOptimizer
+{
+public:
+	//Merges identical vertices, moving the unique ones to the front in the order they first appear and rewriting
+	//indices to use them. Returns how many vertices are left
+	static int WeldVertices(void* const vertices, const int vertexCount, const size_t stride, vector<uint32_t>& indices);
+
+	//Tom Forsyth's linear speed vertex cache optimisation: triangles are emitted greedily by a score that favours
+	//vertices in the cache and vertices with few triangles left to draw
+	static void OptimizeVertexCache(vector<uint32_t>& indices, const int vertexCount);
+
+	//Reorders vertices into the order the indices first use them, dropping any that aren't used. Returns how many are left
+	static int OptimizeVertexFetch(void* const vertices, const int vertexCount, const size_t stride, vector<uint32_t>& indices);
+
+	//Average cache miss ratio, vertices transformed per triangle for a FIFO cache of cacheSize. 3 is no reuse at all,
+	//0.5 is about the best a large regular mesh can do
+	static float GetAcmr(const vector<uint32_t>& indices, const int vertexCount, const int cacheSize);
+
+private:
+	static float GetVertexScore(const int cachePosition, const int remainingTriangles);
+};
@@ -0,0 +1,390 @@
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+
+#include "MeshOptimizer.h"
+
+float MeshSimplifier::Simplify(const MeshVertex* const vertices, const int vertexCount, vector<uint32_t>& indices, const int targetIndexCount, const float maxError)
+{
+	if (static_cast<int>(indices.size()) <= targetIndexCount || vertexCount == 0)
+	{
+		return 0.0f;
+	}
+
+	float boundsMin[3] = { vertices[0].position.x, vertices[0].position.y, vertices[0].position.z };
+	float boundsMax[3] = { boundsMin[0], boundsMin[1], boundsMin[2] };
+
+	for (auto i = 1; i < vertexCount; i++)
+	{
+		const float position[3] = { vertices[i].position.x, vertices[i].position.y, vertices[i].position.z };
+
+		for (auto axis = 0; axis < 3; axis++)
+		{
+			boundsMin[axis] = min(boundsMin[axis], position[axis]);
+			boundsMax[axis] = max(boundsMax[axis], position[axis]);
+		}
+	}
+
+	const auto radius = 0.5 * sqrt(pow(boundsMax[0] - boundsMin[0], 2.0) + pow(boundsMax[1] - boundsMin[1], 2.0) + pow(boundsMax[2] - boundsMin[2], 2.0));
+
+	if (radius <= 0.0)
+	{
+		return 0.0f;
+	}
+
+	vector<bool> locked;
+	FindLockedVertices(vertices, vertexCount, indices, locked);
+
+	//Every vertex starts with the planes of the triangles around it
+	vector<Quadric> quadrics(vertexCount, Quadric());
+
+	for (auto i = 0u; i + 2 < indices.size(); i += 3)
+	{
+		const auto& p0 = vertices[indices[i]].position;
+		const auto& p1 = vertices[indices[i + 1]].position;
+		const auto& p2 = vertices[indices[i + 2]].position;
+
+		const double edge0[3] = { p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+		const double edge1[3] = { p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+		double normal[3] = { edge0[1] * edge1[2] - edge0[2] * edge1[1], edge0[2] * edge1[0] - edge0[0] * edge1[2], edge0[0] * edge1[1] - edge0[1] * edge1[0] };
+
+		const auto length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+		if (length == 0.0)
+		{
+			continue;
+		}
+
+		normal[0] /= length;
+		normal[1] /= length;
+		normal[2] /= length;
+
+		const auto distance = -(normal[0] * p0.x + normal[1] * p0.y + normal[2] * p0.z);
+
+		for (auto corner = 0; corner < 3; corner++)
+		{
+			AddPlane(quadrics[indices[i + corner]], normal, distance);
+		}
+	}
+
+	const auto maxSquaredError = static_cast<double>(maxError) * maxError * radius * radius;
+	auto reachedError = 0.0;
+
+	vector<int> triangleStarts;
+	vector<int> triangles;
+	vector<Collapse> collapses;
+	vector<uint32_t> remap(vertexCount);
+	vector<bool> touched;
+
+	//Each pass collapses the cheapest edges it can without two collapses touching the same triangles, then rewrites the indices
+	while (static_cast<int>(indices.size()) > targetIndexCount)
+	{
+		const auto triangleCount = static_cast<int>(indices.size() / 3);
+
+		triangleStarts.assign(vertexCount + 1, 0);
+
+		for (const auto index : indices)
+		{
+			triangleStarts[index + 1]++;
+		}
+
+		partial_sum(triangleStarts.begin(), triangleStarts.end(), triangleStarts.begin());
+
+		triangles.resize(indices.size());
+		vector<int> triangleCursors(triangleStarts.begin(), triangleStarts.end() - 1);
+
+		for (auto i = 0; i < triangleCount * 3; i++)
+		{
+			triangles[triangleCursors[indices[i]]++] = i / 3;
+		}
+
+		collapses.clear();
+
+		for (auto triangle = 0; triangle < triangleCount; triangle++)
+		{
+			for (auto edge = 0; edge < 3; edge++)
+			{
+				const auto first = indices[triangle * 3 + edge];
+				const auto second = indices[triangle * 3 + (edge + 1) % 3];
+
+				if (!locked[first])
+				{
+					collapses.push_back({ first, second, GetError(quadrics[first], quadrics[second], vertices[second].position) });
+				}
+
+				if (!locked[second])
+				{
+					collapses.push_back({ second, first, GetError(quadrics[first], quadrics[second], vertices[first].position) });
+				}
+			}
+		}
+
+		sort(collapses.begin(), collapses.end(), [](const Collapse& first, const Collapse& second) { return first.error < second.error; });
+
+		iota(remap.begin(), remap.end(), 0u);
+		touched.assign(vertexCount, false);
+
+		auto remainingIndexCount = static_cast<int>(indices.size());
+		auto collapseCount = 0;
+
+		for (const auto& collapse : collapses)
+		{
+			if (collapse.error > maxSquaredError || remainingIndexCount <= targetIndexCount)
+			{
+				break;
+			}
+
+			const auto* const fromTriangles = &triangles[triangleStarts[collapse.from]];
+			const auto fromTriangleCount = triangleStarts[collapse.from + 1] - triangleStarts[collapse.from];
+
+			if (touched[collapse.from] || touched[collapse.to] || FlipsTriangle(vertices, indices, fromTriangles, fromTriangleCount, collapse.from, collapse.to))
+			{
+				continue;
+			}
+
+			//The triangles around from change shape, none of their vertices can move again this pass
+			for (auto i = 0; i < fromTriangleCount; i++)
+			{
+				const auto triangle = fromTriangles[i];
+
+				if (indices[triangle * 3] == collapse.to || indices[triangle * 3 + 1] == collapse.to || indices[triangle * 3 + 2] == collapse.to)
+				{
+					remainingIndexCount -= 3;
+				}
+
+				for (auto corner = 0; corner < 3; corner++)
+				{
+					touched[indices[triangle * 3 + corner]] = true;
+				}
+			}
+
+			remap[collapse.from] = collapse.to;
+			AddQuadric(quadrics[collapse.to], quadrics[collapse.from]);
+			reachedError = max(reachedError, collapse.error);
+			collapseCount++;
+		}
+
+		if (collapseCount == 0)
+		{
+			break;
+		}
+
+		//Triangles that lost an edge are dropped
+		auto writtenIndexCount = 0u;
+
+		for (auto i = 0u; i < indices.size(); i += 3)
+		{
+			const auto index0 = remap[indices[i]];
+			const auto index1 = remap[indices[i + 1]];
+			const auto index2 = remap[indices[i + 2]];
+
+			if (index0 != index1 && index1 != index2 && index0 != index2)
+			{
+				indices[writtenIndexCount++] = index0;
+				indices[writtenIndexCount++] = index1;
+				indices[writtenIndexCount++] = index2;
+			}
+		}
+
+		indices.resize(writtenIndexCount);
+	}
+
+	return static_cast<float>(sqrt(reachedError) / radius);
+}
+
+void MeshSimplifier::GenerateLevelsOfDetail(const MeshVertex* const vertices, const int vertexCount, vector<uint32_t>& indices, vector<MeshLevelOfDetail>& levelsOfDetail)
+{
+	levelsOfDetail.assign(1, { 0, static_cast<uint32_t>(indices.size()), 0.0f });
+
+	//Every level is simplified from the mesh itself so its error is measured against it rather than the level before
+	const vector<uint32_t> mesh(indices);
+	auto targetTriangleCount = static_cast<float>(mesh.size() / 3);
+
+	for (auto level = 1; level < MESH_LOD_MAX_COUNT; level++)
+	{
+		const auto& previousLevel = levelsOfDetail.back();
+		targetTriangleCount *= MESH_LOD_TRIANGLE_RATIO;
+
+		auto simplified = mesh;
+		const auto error = Simplify(vertices, vertexCount, simplified, static_cast<int>(targetTriangleCount) * 3, MESH_LOD_MAX_ERROR);
+
+		if (simplified.empty() || simplified.size() > previousLevel.indexCount * MESH_LOD_MIN_REDUCTION)
+		{
+			break;
+		}
+
+		MeshOptimizer::OptimizeVertexCache(simplified, vertexCount);
+
+		levelsOfDetail.push_back({ static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(simplified.size()), max(error, previousLevel.error) });
+		indices.insert(indices.end(), simplified.begin(), simplified.end());
+	}
+}
+
+void MeshSimplifier::AddPlane(Quadric& quadric, const double normal[3], const double distance)
+{
+	quadric.a00 += normal[0] * normal[0];
+	quadric.a01 += normal[0] * normal[1];
+	quadric.a02 += normal[0] * normal[2];
+	quadric.a03 += normal[0] * distance;
+	quadric.a11 += normal[1] * normal[1];
+	quadric.a12 += normal[1] * normal[2];
+	quadric.a13 += normal[1] * distance;
+	quadric.a22 += normal[2] * normal[2];
+	quadric.a23 += normal[2] * distance;
+	quadric.a33 += distance * distance;
+}
+
+void MeshSimplifier::AddQuadric(Quadric& quadric, const Quadric& other)
+{
+	quadric.a00 += other.a00;
+	quadric.a01 += other.a01;
+	quadric.a02 += other.a02;
+	quadric.a03 += other.a03;
+	quadric.a11 += other.a11;
+	quadric.a12 += other.a12;
+	quadric.a13 += other.a13;
+	quadric.a22 += other.a22;
+	quadric.a23 += other.a23;
+	quadric.a33 += other.a33;
+}
+
+double MeshSimplifier::GetError(const Quadric& first, const Quadric& second, const XMFLOAT3& position)
+{
+	const double x = position.x;
+	const double y = position.y;
+	const double z = position.z;
+
+	const auto a00 = first.a00 + second.a00;
+	const auto a01 = first.a01 + second.a01;
+	const auto a02 = first.a02 + second.a02;
+	const auto a03 = first.a03 + second.a03;
+	const auto a11 = first.a11 + second.a11;
+	const auto a12 = first.a12 + second.a12;
+	const auto a13 = first.a13 + second.a13;
+	const auto a22 = first.a22 + second.a22;
+	const auto a23 = first.a23 + second.a23;
+	const auto a33 = first.a33 + second.a33;
+
+	const auto error = a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z + 2.0 * a03 * x + a11 * y * y + 2.0 * a12 * y * z + 2.0 * a13 * y + a22 * z * z + 2.0 * a23 * z + a33;
+
+	//Rounding can take a perfectly flat collapse just below zero
+	return max(error, 0.0);
+}
+
+void MeshSimplifier::FindLockedVertices(const MeshVertex* const vertices, const int vertexCount, const vector<uint32_t>& indices, vector<bool>& locked)
+{
+	locked.assign(vertexCount, false);
+
+	//Vertices with the same position are grouped under the first of them
+	vector<uint32_t> sortedVertices(vertexCount);
+	iota(sortedVertices.begin(), sortedVertices.end(), 0u);
+
+	sort(sortedVertices.begin(), sortedVertices.end(), [vertices](const uint32_t first, const uint32_t second)
+	{
+		const auto order = memcmp(&vertices[first].position, &vertices[second].position, sizeof(XMFLOAT3));
+		return order < 0 || (order == 0 && first < second);
+	});
+
+	vector<uint32_t> positionGroups(vertexCount);
+
+	for (auto i = 0; i < vertexCount; i++)
+	{
+		const auto sharesPosition = i > 0 && memcmp(&vertices[sortedVertices[i]].position, &vertices[sortedVertices[i - 1]].position, sizeof(XMFLOAT3)) == 0;
+
+		positionGroups[sortedVertices[i]] = sharesPosition ? positionGroups[sortedVertices[i - 1]] : sortedVertices[i];
+
+		//A seam, the group's other vertices have different texture coordinates or normals
+		if (sharesPosition)
+		{
+			locked[sortedVertices[i]] = true;
+			locked[sortedVertices[i - 1]] = true;
+		}
+	}
+
+	//Edges between positions rather than vertices so a seam isn't mistaken for a border
+	unordered_map<uint64_t, int> edgeTriangleCounts;
+	edgeTriangleCounts.reserve(indices.size());
+
+	for (auto i = 0u; i + 2 < indices.size(); i += 3)
+	{
+		for (auto edge = 0; edge < 3; edge++)
+		{
+			const auto first = positionGroups[indices[i + edge]];
+			const auto second = positionGroups[indices[i + (edge + 1) % 3]];
+
+			edgeTriangleCounts[static_cast<uint64_t>(min(first, second)) << 32 | max(first, second)]++;
+		}
+	}
+
+	for (auto i = 0u; i + 2 < indices.size(); i += 3)
+	{
+		for (auto edge = 0; edge < 3; edge++)
+		{
+			const auto first = indices[i + edge];
+			const auto second = indices[i + (edge + 1) % 3];
+			const auto firstGroup = positionGroups[first];
+			const auto secondGroup = positionGroups[second];
+
+			if (edgeTriangleCounts[static_cast<uint64_t>(min(firstGroup, secondGroup)) << 32 | max(firstGroup, secondGroup)] != 2)
+			{
+				locked[first] = true;
+				locked[second] = true;
+			}
+		}
+	}
+}
+
+bool MeshSimplifier::FlipsTriangle(const MeshVertex* const vertices, const vector<uint32_t>& indices, const int* const triangles, const int triangleCount, const uint32_t from, const uint32_t to)
+{
+	const auto& target = vertices[to].position;
+
+	for (auto i = 0; i < triangleCount; i++)
+	{
+		const auto* const triangle = &indices[triangles[i] * 3];
+
+		//Triangles on the collapsed edge disappear rather than move
+		if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+		{
+			continue;
+		}
+
+		const XMFLOAT3* corners[3] = { &vertices[triangle[0]].position, &vertices[triangle[1]].position, &vertices[triangle[2]].position };
+		double normals[2][3];
+
+		for (auto moved = 0; moved < 2; moved++)
+		{
+			if (moved == 1)
+			{
+				for (auto corner = 0; corner < 3; corner++)
+				{
+					if (triangle[corner] == from)
+					{
+						corners[corner] = &target;
+					}
+				}
+			}
+
+			const double edge0[3] = { corners[1]->x - corners[0]->x, corners[1]->y - corners[0]->y, corners[1]->z - corners[0]->z };
+			const double edge1[3] = { corners[2]->x - corners[0]->x, corners[2]->y - corners[0]->y, corners[2]->z - corners[0]->z };
+
+			normals[moved][0] = edge0[1] * edge1[2] - edge0[2] * edge1[1];
+			normals[moved][1] = edge0[2] * edge1[0] - edge0[0] * edge1[2];
+			normals[moved][2] = edge0[0] * edge1[1] - edge0[1] * edge1[0];
+		}
+
+		const auto dot = normals[0][0] * normals[1][0] + normals[0][1] * normals[1][1] + normals[0][2] * normals[1][2];
+		const auto length = sqrt(normals[0][0] * normals[0][0] + normals[0][1] * normals[0][1] + normals[0][2] * normals[0][2]);
+		const auto movedLength = sqrt(normals[1][0] * normals[1][0] + normals[1][1] * normals[1][1] + normals[1][2] * normals[1][2]);
+
+		//Already flat triangles can't get any worse, the rest may not turn more than about 75 degrees
+		if (length > 0.0 && dot <= 0.25 * length * movedLength)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
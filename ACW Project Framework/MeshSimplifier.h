@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "MeshCache.h"
+#include "MeshVertex.h"
+
+using namespace std;
+
+//Levels in a chain including the mesh itself, each aims for this fraction of the triangles of the one before
+const int MESH_LOD_MAX_COUNT = 4;
+const float MESH_LOD_TRIANGLE_RATIO = 0.5f;
+//A level is dropped if simplifying couldn't get it below this fraction of the level before
+const float MESH_LOD_MIN_REDUCTION = 0.8f;
+//The most a level may stray from the mesh, relative to the radius of the sphere around its bounds
+const float MESH_LOD_MAX_ERROR = 0.05f;
+
+//Quadric error metric simplification (Garland and Heckbert) by half edge collapses, so every level draws the same
+//vertices with fewer indices and the whole chain shares one vertex buffer.
+//Vertices whose position is shared with other vertices are on a texture or normal seam, they and vertices on an open
+//border never move so the seams and silhouettes of the shipped models stay where they are
+class MeshSimplifier
+{
+public:
+	//Collapses edges in order of their error until indices is down to targetIndexCount or the next collapse would stray
+	//further than maxError from the mesh. Returns the error reached, relative to the radius of the mesh's bounds
+	static float Simplify(const MeshVertex* const vertices, const int vertexCount, vector<uint32_t>& indices, const int targetIndexCount, const float maxError);
+
+	//Appends each simplified level to indices after the mesh, which is level 0 and the whole of indices on entry,
+	//and orders each for the vertex cache. A chain stops early once a level can't be made much smaller
+	static void GenerateLevelsOfDetail(const MeshVertex* const vertices, const int vertexCount, vector<uint32_t>& indices, vector<MeshLevelOfDetail>& levelsOfDetail);
+
+private:
+	//The symmetric 4x4 matrix of summed plane equations, the squared distance from every plane is p^T Q p
+	struct Quadric
+	{
+		double a00, a01, a02, a03;
+		double a11, a12, a13;
+		double a22, a23;
+		double a33;
+	};
+
+	struct Collapse
+	{
+		uint32_t from;
+		uint32_t to;
+		double error;
+	};
+
+	static void AddPlane(Quadric& quadric, const double normal[3], const double distance);
+	static void AddQuadric(Quadric& quadric, const Quadric& other);
+	static double GetError(const Quadric& first, const Quadric& second, const XMFLOAT3& position);
+
+	//Seam and border vertices, and vertices on edges more than two triangles share
+	static void FindLockedVertices(const MeshVertex* const vertices, const int vertexCount, const vector<uint32_t>& indices, vector<bool>& locked);
+	//True if moving from to to's position would turn one of the triangles around it over or squash it flat
+	static bool FlipsTriangle(const MeshVertex* const vertices, const vector<uint32_t>& indices, const int* const triangles, const int triangleCount, const uint32_t from, const uint32_t to);
+};
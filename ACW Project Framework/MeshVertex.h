@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <DirectXMath.h>
+
+using namespace DirectX;
+
+//The vertex every model's vertex buffer holds, the layout the shaders' input layouts describe
+struct MeshVertex
+{
+	XMFLOAT3 position;
+	XMFLOAT2 texture;
+	XMFLOAT3 normal;
+	XMFLOAT3 tangent;
+	XMFLOAT3 binormal;
+};
+
+//How ResourceManager stores vertices in the vertex buffers. The compact formats keep the texture coordinates as
+//halves and the normal and tangent octahedrally encoded in 16 bits a component, with the binormal's sign in the
+//tangent's last bit. Quantized positions are 16 bits a component across the mesh's bounding box
+enum class MeshVertexFormat
+{
+	Full,
+	Compact,
+	CompactQuantized
+};
+
+//MeshVertexFormat::Compact, 24 bytes
+struct CompactMeshVertex
+{
+	XMFLOAT3 position;
+	uint16_t texture[2];
+	uint16_t frame[4];
+};
+
+//MeshVertexFormat::CompactQuantized, 20 bytes. The fourth position component only pads the attribute to a DXGI format
+struct QuantizedMeshVertex
+{
+	uint16_t position[4];
+	uint16_t texture[2];
+	uint16_t frame[4];
+};
@@ -0,0 +1,80 @@
+//The vertex every model's vertex buffer holds, see MeshVertex.h. Shader compiles the vertex shaders with COMPACT_VERTEX
+//defined when ResourceManager stores the compact formats, which are decoded here exactly as VertexCompressor does
+
+struct MeshVertex
+{
+	float3 position;
+	float2 tex;
+	float3 normal;
+	float3 tangent;
+	float3 binormal;
+};
+
+#ifdef COMPACT_VERTEX
+
+//Set by Model, an identity unless the positions are quantized across the mesh's bounds
+cbuffer MeshQuantizationBuffer : register(b13)
+{
+	float3 quantizationOffset;
+	float quantizationPadding0;
+	float3 quantizationScale;
+	float quantizationPadding1;
+};
+
+struct MeshVertexInput
+{
+	float3 position : POSITION;
+	float2 tex : TEXCOORD0;
+	//The normal in the first two components, the tangent in the last two with the binormal's sign in the lowest bit
+	uint4 frame : FRAME;
+};
+
+float3 DecodeOctahedral(float2 encoded)
+{
+	float3 decoded = float3(encoded, 1.0f - abs(encoded.x) - abs(encoded.y));
+
+	//Unfolds the lower half
+	float fold = saturate(-decoded.z);
+	decoded.xy += decoded.xy >= 0.0f ? -fold : fold;
+
+	return normalize(decoded);
+}
+
+MeshVertex DecodeMeshVertex(MeshVertexInput input)
+{
+	MeshVertex vertex;
+
+	vertex.position = quantizationOffset + input.position * quantizationScale;
+	vertex.tex = input.tex;
+	vertex.normal = DecodeOctahedral(float2(input.frame.xy) / 65535.0f * 2.0f - 1.0f);
+	vertex.tangent = DecodeOctahedral(float2(input.frame.z / 65535.0f, (input.frame.w >> 1) / 32767.0f) * 2.0f - 1.0f);
+	vertex.binormal = cross(vertex.normal, vertex.tangent) * ((input.frame.w & 1) ? 1.0f : -1.0f);
+
+	return vertex;
+}
+
+#else
+
+struct MeshVertexInput
+{
+	float3 position : POSITION;
+	float2 tex : TEXCOORD0;
+	float3 normal : NORMAL;
+	float3 tangent : TANGENT;
+	float3 binormal : BINORMAL;
+};
+
+MeshVertex DecodeMeshVertex(MeshVertexInput input)
+{
+	MeshVertex vertex;
+
+	vertex.position = input.position;
+	vertex.tex = input.tex;
+	vertex.normal = input.normal;
+	vertex.tangent = input.tangent;
+	vertex.binormal = input.binormal;
+
+	return vertex;
+}
+
+#endif
@@ -1,8 +1,32 @@
 #include "Model.h"
+#include "Profiler.h"
+#include "VertexCompressor.h"
+#include <cfloat>
+#include <cmath>
 
-Model::Model(ID3D11Device* const device, const char* const modelFileName, const shared_ptr<ResourceManager>& resourceManager) : initializationFailed(false), bufferDescriptionSizeChange(false), updateInstanceBuffer(false), sizeOfVertexType(0), indexCount(0), instanceCount(0), vertexBuffer(nullptr), indexBuffer(nullptr), instanceBuffer(nullptr), instances(nullptr), instanceBufferDescription(nullptr), instanceData(nullptr)
+InstanceReallocationStatistics Model::reallocationStatistics = InstanceReallocationStatistics();
+mutex Model::reallocationStatisticsLock;
+
+JobSystem* Model::jobSystem = nullptr;
+
+atomic<unsigned int> Model::simulationStep(1);
+
+//Instances per job when building world matrices in parallel, a multiple of the SIMD block
+static const int INSTANCE_CHUNK_SIZE = 4096;
+
+Model::Model(ID3D11Device* const device, const MeshHandle mesh, const shared_ptr<ResourceManager>& resourceManager) : initializationFailed(false), mesh(mesh), sizeOfVertexType(0), levelsOfDetail(1, { 0, 0, 0.0f }), levelOfDetail(0), boundsCenter(), boundsRadius(0.0f), instanceCentersMin(), instanceCentersMax(), instanceMaxScale(0.0f), instanceBoundsStep(0), vertexBuffer(nullptr), indexBuffer(nullptr), instanceBuffer(nullptr), quantizationBuffer(nullptr), snapshots(), latestSnapshot(0), bufferCapacity(0), uploadedStep(0), sortedInstances(), staleRanges(), instanceBufferDescription(nullptr), instanceData(nullptr)
 {
-	const auto result = resourceManager->GetModel(device, modelFileName, vertexBuffer, indexBuffer);
+	for (auto& snapshot : snapshots)
+	{
+		snapshot.instances = nullptr;
+		snapshot.count = 0;
+		snapshot.capacity = 0;
+		snapshot.step = 0;
+		snapshot.baseStep = 0;
+		snapshot.changedAll = false;
+	}
+
+	const auto result = resourceManager->GetModel(device, mesh, vertexBuffer, indexBuffer);
 
 	if (!result)
 	{
@@ -11,50 +35,57 @@ Model::Model(ID3D11Device* const device, const char* const modelFileName, const
 	}
 
 	sizeOfVertexType = resourceManager->GetSizeOfVertexType();
-	indexCount = resourceManager->GetIndexCount(modelFileName);
-}
+	levelsOfDetail = resourceManager->GetLevelsOfDetail(mesh);
 
-Model::Model(ID3D11Device* const device, const char* const modelFileName, const shared_ptr<ResourceManager>& resourceManager, const vector<XMFLOAT3> &scales, const vector<XMFLOAT3> &rotations, const vector<XMFLOAT3> &positions) : Model(device, modelFileName, resourceManager)
-{
-	//Set the number of instances we have
-	instanceCount = positions.size();
+	const auto& bounds = resourceManager->GetMeshBounds(mesh);
 
-	instances  = new InstanceType[instanceCount];
+	boundsCenter = XMFLOAT3((bounds.minimum[0] + bounds.maximum[0]) * 0.5f, (bounds.minimum[1] + bounds.maximum[1]) * 0.5f, (bounds.minimum[2] + bounds.maximum[2]) * 0.5f);
+	boundsRadius = 0.5f * sqrt(pow(bounds.maximum[0] - bounds.minimum[0], 2.0f) + pow(bounds.maximum[1] - bounds.minimum[1], 2.0f) + pow(bounds.maximum[2] - bounds.minimum[2], 2.0f));
 
-	if (!instances)
+	const auto vertexFormat = resourceManager->GetVertexFormat();
+
+	if (vertexFormat != MeshVertexFormat::Full)
 	{
-		delete[] instances;
-		instances = nullptr;
 
-		initializationFailed = true;
-		return;
-	}
+		MeshQuantizationBufferType quantization = {};
+		VertexCompressor::GetQuantization(vertexFormat, bounds.minimum, bounds.maximum, quantization.offset, quantization.scale);
 
-	//Construct world matrixes
-	for (unsigned int i = 0; i < positions.size(); i++)
-	{
-		auto worldMatrix = XMMatrixIdentity();
+		D3D11_BUFFER_DESC quantizationBufferDescription = { sizeof(MeshQuantizationBufferType), D3D11_USAGE_IMMUTABLE, D3D11_BIND_CONSTANT_BUFFER, 0, 0, 0 };
+		D3D11_SUBRESOURCE_DATA quantizationData = { &quantization, 0, 0 };
 
-		const auto position = positions[i];
-		const auto scale = i < scales.size() ? scales[i] : scales[scales.size() - 1];
-		const auto rotation = i < rotations.size() ? rotations[i] : rotations[rotations.size() - 1];
+		if (FAILED(device->CreateBuffer(&quantizationBufferDescription, &quantizationData, &quantizationBuffer)))
+		{
+			initializationFailed = true;
+			return;
+		}
+	}
+}
 
-		worldMatrix = XMMatrixMultiply(worldMatrix, XMMatrixScaling(scale.x, scale.y, scale.z));
-		worldMatrix = XMMatrixMultiply(worldMatrix, XMMatrixRotationQuaternion(XMQuaternionRotationRollPitchYaw(rotation.x, rotation.y, rotation.z)));
-		worldMatrix = XMMatrixMultiply(worldMatrix, XMMatrixTranslation(position.x, position.y, position.z));
+Model::Model(ID3D11Device* const device, const MeshHandle mesh, const shared_ptr<ResourceManager>& resourceManager, const vector<XMFLOAT3> &scales, const vector<XMFLOAT3> &rotations, const vector<XMFLOAT3> &positions) : Model(device, mesh, resourceManager)
+{
+	//The first snapshot, written in whichever step the model is created in
+	auto& snapshot = snapshots[0];
+	snapshot.step = simulationStep;
+	snapshot.changedAll = true;
 
-		instances[i].worldMatrix = XMMatrixTranspose(worldMatrix);
+	if (!ResizeSnapshot(snapshot, static_cast<int>(positions.size())))
+	{
+		initializationFailed = true;
+		return;
 	}
 
-	updateInstanceBuffer = true;
+	//Construct world matrixes
+	WorldMatrixBatch::Compose(scales, rotations, positions, XMMatrixIdentity(), &snapshot.instances[0].worldMatrix);
+
+	bufferCapacity = snapshot.capacity;
 
-	//Set up instance buffer description
+	//Set up instance buffer description, default usage so changed ranges can be updated without rewriting the rest
 	instanceBufferDescription = make_shared<D3D11_BUFFER_DESC>();
 
-	instanceBufferDescription->Usage = D3D11_USAGE_DYNAMIC;
-	instanceBufferDescription->ByteWidth = sizeof(InstanceType) * instanceCount;
+	instanceBufferDescription->Usage = D3D11_USAGE_DEFAULT;
+	instanceBufferDescription->ByteWidth = sizeof(InstanceType) * bufferCapacity;
 	instanceBufferDescription->BindFlags = D3D11_BIND_VERTEX_BUFFER;
-	instanceBufferDescription->CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	instanceBufferDescription->CPUAccessFlags = 0;
 	instanceBufferDescription->MiscFlags = 0;
 	instanceBufferDescription->StructureByteStride = 0;
 
@@ -63,27 +94,20 @@ Model::Model(ID3D11Device* const device, const char* const modelFileName, const
 
 	if (FAILED(result))
 	{
-		delete[] instances;
-		instances = nullptr;
-
 		initializationFailed = true;
 		return;
 	}
 }
 
-Model::Model(const Model& other) = default;
-
-Model::Model(Model&& other) noexcept = default;
-
 Model::~Model()
 {
 	try
 	{
 		//Release resources
-		if (instances)
+		for (auto& snapshot : snapshots)
 		{
-			delete[] instances;
-			instances = nullptr;
+			delete[] snapshot.instances;
+			snapshot.instances = nullptr;
 		}
 
 		if (instanceBuffer)
@@ -92,6 +116,12 @@ Model::~Model()
 			instanceBuffer = nullptr;
 		}
 
+		if (quantizationBuffer)
+		{
+			quantizationBuffer->Release();
+			quantizationBuffer = nullptr;
+		}
+
 		if (indexBuffer)
 		{
 			//Don't release, resource manager does this
@@ -112,51 +142,104 @@ Model::~Model()
 	}
 }
 
-Model& Model::operator=(const Model& other) = default;
+void Model::Update(const vector<XMFLOAT3> &scales, const vector<XMFLOAT3> &rotations, const vector<XMFLOAT3> &positions, const XMMATRIX& parentMatrix)
+{
+	const ProfileZone zone("Model::Update");
 
-Model& Model::operator=(Model&& other) noexcept = default;
+	auto staleAll = false;
+	auto& snapshot = BeginSnapshotWrite(staleAll, staleRanges);
 
-void Model::Update(const vector<XMFLOAT3> &scales, const vector<XMFLOAT3> &rotations, const vector<XMFLOAT3> &positions, const XMMATRIX& parentMatrix)
+	if (!ResizeSnapshot(snapshot, static_cast<int>(positions.size())))
+	{
+		return;
+	}
+
+	ComposeAll(scales, rotations, positions, parentMatrix, snapshot);
+
+	snapshot.changedAll = true;
+	snapshot.changedRanges.clear();
+}
+
+void Model::UpdateInstances(const vector<XMFLOAT3> &scales, const vector<XMFLOAT3> &rotations, const vector<XMFLOAT3> &positions, const XMMATRIX& parentMatrix, const vector<int>& changedInstances)
 {
-	if (instanceCount != positions.size())
+	const ProfileZone zone("Model::UpdateInstances");
+
+	auto staleAll = false;
+	auto& snapshot = BeginSnapshotWrite(staleAll, staleRanges);
+
+	//Reallocating or catching up on a whole rebuild means rebuilding everything anyway
+	if (staleAll || GetInstanceCapacityFor(static_cast<int>(positions.size()), snapshot.capacity) != snapshot.capacity)
 	{
-		instanceCount = positions.size();
+		Update(scales, rotations, positions, parentMatrix);
+		return;
+	}
 
-		delete[] instances;
-		instances = nullptr;
+	snapshot.count = static_cast<int>(positions.size());
 
-		instances = new InstanceType[instanceCount];
+	//Catch up on what the last snapshot changed, the renderer already has those so they aren't uploaded again
+	for (const auto& range : staleRanges)
+	{
+		const auto count = min(range.second, snapshot.count - range.first);
 
-		bufferDescriptionSizeChange = true;
+		if (count > 0)
+		{
+			WorldMatrixBatch::ComposeRange(scales, rotations, positions, parentMatrix, range.first, count, &snapshot.instances[0].worldMatrix);
+		}
 	}
 
-	//Construct world matrixes
-	for (unsigned int i = 0; i < instanceCount; i++)
+	sortedInstances.assign(changedInstances.begin(), changedInstances.end());
+	sort(sortedInstances.begin(), sortedInstances.end());
+
+	//Merge nearby instances into one range, rebuilding a few unchanged ones is cheaper than another upload
+	const auto mergeDistance = 8;
+
+	auto rangeStart = -1;
+	auto rangeEnd = -1;
+
+	for (auto i = 0u; i <= sortedInstances.size(); i++)
 	{
-		auto worldMatrix = XMMatrixIdentity();
+		const auto atEnd = i == sortedInstances.size() || sortedInstances[i] >= snapshot.count;
 
-		const auto position = positions[i];
-		const auto scale = i < scales.size() ? scales[i] : scales[scales.size() - 1];
-		const auto rotation = i < rotations.size() ? rotations[i] : rotations[rotations.size() - 1];
+		if (!atEnd && rangeStart >= 0 && sortedInstances[i] <= rangeEnd + mergeDistance)
+		{
+			rangeEnd = max(rangeEnd, sortedInstances[i]);
+			continue;
+		}
 
-		worldMatrix = XMMatrixMultiply(worldMatrix, XMMatrixScaling(scale.x, scale.y, scale.z));
-		worldMatrix = XMMatrixMultiply(worldMatrix, XMMatrixRotationQuaternion(XMQuaternionRotationRollPitchYaw(rotation.x, rotation.y, rotation.z)));
-		worldMatrix = XMMatrixMultiply(worldMatrix, XMMatrixTranslation(position.x, position.y, position.z));
+		if (rangeStart >= 0)
+		{
+			WorldMatrixBatch::ComposeRange(scales, rotations, positions, parentMatrix, rangeStart, rangeEnd - rangeStart + 1, &snapshot.instances[0].worldMatrix);
 
-		worldMatrix = worldMatrix * parentMatrix;
+			//A pending full upload already covers this range
+			if (!snapshot.changedAll)
+			{
+				snapshot.changedRanges.emplace_back(rangeStart, rangeEnd - rangeStart + 1);
+			}
+		}
 
-		instances[i].worldMatrix = XMMatrixTranspose(worldMatrix);
-	}
+		if (atEnd)
+		{
+			break;
+		}
 
-	updateInstanceBuffer = true;
+		rangeStart = sortedInstances[i];
+		rangeEnd = sortedInstances[i];
+	}
 }
 
 
-bool Model::Render(ID3D11DeviceContext* const deviceContext) {
+bool Model::Render(RenderContext* const deviceContext) {
+
+	const auto& snapshot = GetRenderSnapshot();
 
-	if (updateInstanceBuffer)
+	if (snapshot.step != uploadedStep)
 	{
-		if (bufferDescriptionSizeChange)
+		//The renderer skipped a snapshot if this one's changes aren't relative to the last one uploaded
+		auto uploadAll = snapshot.changedAll || snapshot.baseStep != uploadedStep;
+
+		const auto capacity = GetInstanceCapacityFor(snapshot.count, bufferCapacity);
+
+		if (capacity != bufferCapacity)
 		{
 			ID3D11Device* device;
 
@@ -164,34 +247,45 @@ bool Model::Render(ID3D11DeviceContext* const deviceContext) {
 
 			instanceBuffer->Release();
 
-			instanceBufferDescription->ByteWidth = sizeof(InstanceType) * instanceCount;
+			instanceBufferDescription->ByteWidth = sizeof(InstanceType) * capacity;
 
 			const auto result = device->CreateBuffer(instanceBufferDescription.get(), nullptr, &instanceBuffer);
 
+			device->Release();
+
 			if (FAILED(result))
 			{
 				return false;
 			}
 
-			bufferDescriptionSizeChange = false;
-		}
-
-		D3D11_MAPPED_SUBRESOURCE mappedResource;
-
-		const auto hresult = deviceContext->Map(instanceBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
+			bufferCapacity = capacity;
+			uploadAll = true;
 
-		if (FAILED(hresult))
-		{
-			return false;
+			lock_guard<mutex> lock(reallocationStatisticsLock);
+			reallocationStatistics.bufferReallocations++;
 		}
 
-		//auto* matrixBufferData = static_cast<InstanceType*>(mappedResource.pData);
+		if (uploadAll)
+		{
+			if (snapshot.count > 0)
+			{
+				D3D11_BOX instanceBox = { 0, 0, 0, static_cast<UINT>(snapshot.count * sizeof(InstanceType)), 1, 1 };
 
-		memcpy(mappedResource.pData, instances, instanceCount * sizeof(InstanceType));
+				deviceContext->UpdateSubresource(instanceBuffer, 0, &instanceBox, snapshot.instances, 0, 0);
+			}
+		}
+		else
+		{
+			//Only the instances that changed since the last snapshot
+			for (const auto& range : snapshot.changedRanges)
+			{
+				D3D11_BOX instanceBox = { static_cast<UINT>(range.first * sizeof(InstanceType)), 0, 0, static_cast<UINT>((range.first + range.second) * sizeof(InstanceType)), 1, 1 };
 
-		deviceContext->Unmap(instanceBuffer, 0);
+				deviceContext->UpdateSubresource(instanceBuffer, 0, &instanceBox, &snapshot.instances[range.first], 0, 0);
+			}
+		}
 
-		updateInstanceBuffer = false;
+		uploadedStep = snapshot.step;
 	}
 
 	//Render buffers
@@ -213,8 +307,14 @@ bool Model::Render(ID3D11DeviceContext* const deviceContext) {
 	//Set the vertex buffer to active in the input assembler so it will render it
 	deviceContext->IASetVertexBuffers(0, 2, bufferPointers, strides, offsets);
 
-	//Set the index buffer to active in the input assembler so it will render it
-	deviceContext->IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R32_UINT, 0);
+	//Set the index buffer to active in the input assembler so it will render it, starting at the level of detail's indices
+	deviceContext->IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R32_UINT, levelsOfDetail[levelOfDetail].firstIndex * sizeof(uint32_t));
+
+	//Compact positions are decoded against this mesh's bounds, the shaders don't touch the slot
+	if (quantizationBuffer)
+	{
+		deviceContext->VSSetConstantBuffers(MESH_QUANTIZATION_BUFFER_SLOT, 1, &quantizationBuffer);
+	}
 
 	//Set the type of primitive render style for the vertex buffer
 	//deviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
@@ -223,13 +323,209 @@ bool Model::Render(ID3D11DeviceContext* const deviceContext) {
 	return true;
 }
 
+void Model::SelectLevelOfDetail(const XMFLOAT3& cameraPosition, const XMMATRIX& projectionMatrix)
+{
+	levelOfDetail = 0;
+
+	const auto& snapshot = GetRenderSnapshot();
+
+	if (levelsOfDetail.size() < 2 || snapshot.count == 0)
+	{
+		return;
+	}
+
+	if (snapshot.step != instanceBoundsStep)
+	{
+		UpdateInstanceBounds(snapshot);
+		instanceBoundsStep = snapshot.step;
+	}
+
+	//No instance's bounding sphere can be any closer than the box around their centres less the largest radius
+	const auto x = max(max(instanceCentersMin.x - cameraPosition.x, cameraPosition.x - instanceCentersMax.x), 0.0f);
+	const auto y = max(max(instanceCentersMin.y - cameraPosition.y, cameraPosition.y - instanceCentersMax.y), 0.0f);
+	const auto z = max(max(instanceCentersMin.z - cameraPosition.z, cameraPosition.z - instanceCentersMax.z), 0.0f);
+
+	const auto radius = boundsRadius * instanceMaxScale;
+	const auto distance = sqrt(x * x + y * y + z * z) - radius;
+
+	if (distance <= 0.0f)
+	{
+		return;
+	}
+
+	//The projection scales y so the screen is two units high
+	const auto projectedRadius = radius * XMVectorGetY(projectionMatrix.r[1]) * 0.5f / distance;
+
+	for (auto level = static_cast<int>(levelsOfDetail.size()) - 1; level > 0; level--)
+	{
+		if (levelsOfDetail[level].error * projectedRadius <= MESH_LOD_MAX_SCREEN_ERROR)
+		{
+			levelOfDetail = level;
+			return;
+		}
+	}
+}
+
+int Model::GetLevelOfDetail() const
+{
+	return levelOfDetail;
+}
+
 int Model::GetIndexCount() const {
-	return indexCount;
+	return static_cast<int>(levelsOfDetail[levelOfDetail].indexCount);
+}
+
+MeshHandle Model::GetMeshHandle() const {
+	return mesh;
 }
 
 int Model::GetInstanceCount() const
 {
-	return instanceCount;
+	return GetRenderSnapshot().count;
+}
+
+int Model::GetInstanceCapacity() const
+{
+	return bufferCapacity;
+}
+
+void Model::PublishSnapshot()
+{
+	simulationStep++;
+}
+
+const InstanceReallocationStatistics& Model::GetReallocationStatistics()
+{
+	return reallocationStatistics;
+}
+
+void Model::ResetReallocationStatistics()
+{
+	reallocationStatistics = InstanceReallocationStatistics();
+}
+
+void Model::SetJobSystem(JobSystem* const jobSystem)
+{
+	Model::jobSystem = jobSystem;
+}
+
+Model::InstanceSnapshot& Model::BeginSnapshotWrite(bool& outStaleAll, vector<pair<int, int>>& outStaleRanges)
+{
+	const unsigned int step = simulationStep;
+	const auto latest = latestSnapshot.load();
+
+	outStaleAll = false;
+	outStaleRanges.clear();
+
+	//Already writing this step's snapshot
+	if (snapshots[latest].step == step)
+	{
+		return snapshots[latest];
+	}
+
+	//The other snapshot is the one the newest snapshot's changes were made on top of, unless it has never been written
+	auto& newest = snapshots[latest];
+	auto& snapshot = snapshots[1 - latest];
+
+	outStaleAll = newest.changedAll || snapshot.step != newest.baseStep;
+	outStaleRanges.assign(newest.changedRanges.begin(), newest.changedRanges.end());
+
+	snapshot.step = step;
+	snapshot.baseStep = newest.step;
+	snapshot.changedAll = false;
+	snapshot.changedRanges.clear();
+
+	//Render keeps reading the newest snapshot until it sees this one, and then ignores it until it is published
+	latestSnapshot = 1 - latest;
+
+	return snapshot;
+}
+
+const Model::InstanceSnapshot& Model::GetRenderSnapshot() const
+{
+	const auto latest = latestSnapshot.load();
+
+	return snapshots[latest].step < simulationStep ? snapshots[latest] : snapshots[1 - latest];
+}
+
+bool Model::ResizeSnapshot(InstanceSnapshot& snapshot, const int count)
+{
+	const auto capacity = GetInstanceCapacityFor(count, snapshot.capacity);
+
+	if (capacity != snapshot.capacity)
+	{
+		delete[] snapshot.instances;
+		snapshot.instances = new InstanceType[capacity];
+		snapshot.capacity = capacity;
+
+		lock_guard<mutex> lock(reallocationStatisticsLock);
+		reallocationStatistics.arrayReallocations++;
+	}
+
+	snapshot.count = count;
+
+	return snapshot.instances != nullptr;
+}
+
+void Model::UpdateInstanceBounds(const InstanceSnapshot& snapshot)
+{
+	instanceCentersMin = XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX);
+	instanceCentersMax = XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+	auto maxSquaredScale = 0.0f;
+
+	for (auto i = 0; i < snapshot.count; i++)
+	{
+		//Transposed, each row makes one component of the world position
+		const auto& matrix = snapshot.instances[i].worldMatrix.m;
+
+		const auto x = matrix[0][0] * boundsCenter.x + matrix[0][1] * boundsCenter.y + matrix[0][2] * boundsCenter.z + matrix[0][3];
+		const auto y = matrix[1][0] * boundsCenter.x + matrix[1][1] * boundsCenter.y + matrix[1][2] * boundsCenter.z + matrix[1][3];
+		const auto z = matrix[2][0] * boundsCenter.x + matrix[2][1] * boundsCenter.y + matrix[2][2] * boundsCenter.z + matrix[2][3];
+
+		instanceCentersMin = XMFLOAT3(min(instanceCentersMin.x, x), min(instanceCentersMin.y, y), min(instanceCentersMin.z, z));
+		instanceCentersMax = XMFLOAT3(max(instanceCentersMax.x, x), max(instanceCentersMax.y, y), max(instanceCentersMax.z, z));
+
+		for (auto axis = 0; axis < 3; axis++)
+		{
+			maxSquaredScale = max(maxSquaredScale, matrix[0][axis] * matrix[0][axis] + matrix[1][axis] * matrix[1][axis] + matrix[2][axis] * matrix[2][axis]);
+		}
+	}
+
+	instanceMaxScale = sqrt(maxSquaredScale);
+}
+
+void Model::ComposeAll(const vector<XMFLOAT3> &scales, const vector<XMFLOAT3> &rotations, const vector<XMFLOAT3> &positions, const XMMATRIX& parentMatrix, InstanceSnapshot& snapshot)
+{
+	//Construct world matrixes
+	if (jobSystem)
+	{
+		jobSystem->ParallelFor(snapshot.count, INSTANCE_CHUNK_SIZE, [&](const int first, const int last)
+		{
+			WorldMatrixBatch::ComposeRange(scales, rotations, positions, parentMatrix, first, last - first, &snapshot.instances[0].worldMatrix);
+		});
+	}
+	else
+	{
+		WorldMatrixBatch::Compose(scales, rotations, positions, parentMatrix, &snapshot.instances[0].worldMatrix);
+	}
+}
+
+int Model::GetInstanceCapacityFor(const int count, const int currentCapacity)
+{
+	const auto minimumCapacity = 16;
+
+	if (count > currentCapacity)
+	{
+		return max(max(count, currentCapacity + currentCapacity / 2), minimumCapacity);
+	}
+
+	if (count < currentCapacity / 4 && currentCapacity > minimumCapacity)
+	{
+		return max(count * 2, minimumCapacity);
+	}
+
+	return currentCapacity;
 }
 
 bool Model::GetInitializationState() const {
@@ -2,56 +2,172 @@
 
 #include <d3d11.h>
 #include <DirectXMath.h>
+#include <algorithm>
+#include <atomic>
 #include <vector>
 #include <fstream>
+#include <mutex>
 
+#include "JobSystem.h"
 #include "Texture.h"
 #include "ResourceManager.h"
+#include "RenderContext.h"
+#include "WorldMatrixBatch.h"
 
 using namespace DirectX;
 using namespace std;
 
+//The vertex shader constant buffer Model binds the mesh's quantization to, register b13 in MeshVertex.hlsli
+const int MESH_QUANTIZATION_BUFFER_SLOT = 13;
+
+//The furthest a level of detail may stray from the mesh on screen, as a fraction of the screen's height. About two
+//pixels at 1080p
+const float MESH_LOD_MAX_SCREEN_ERROR = 0.002f;
+
+//How often instance storage was reallocated, summed over every model
+struct InstanceReallocationStatistics
+{
+	unsigned int arrayReallocations;
+	unsigned int bufferReallocations;
+};
+
 class Model
 {
 public:
-	Model(ID3D11Device* const device, const char* const modelFileName, const shared_ptr<ResourceManager>& resourceManager);
-	Model(ID3D11Device* const device, const char* const modelFileName, const shared_ptr<ResourceManager>& resourceManager, const vector<XMFLOAT3> &scales, const vector<XMFLOAT3> &rotations, const vector<XMFLOAT3> &positions);
+	Model(ID3D11Device* const device, const MeshHandle mesh, const shared_ptr<ResourceManager>& resourceManager);
+	Model(ID3D11Device* const device, const MeshHandle mesh, const shared_ptr<ResourceManager>& resourceManager, const vector<XMFLOAT3> &scales, const vector<XMFLOAT3> &rotations, const vector<XMFLOAT3> &positions);
 
-	Model(const Model& other); // Copy Constructor
-	Model(Model && other) noexcept; // Move Constructor
+	Model(const Model& other) = delete; // Copy Constructor
+	Model(Model && other) noexcept = delete; // Move Constructor
 	~Model(); // Destructor
 
-	Model& operator = (const Model& other); // Copy Assignment Operator
-	Model& operator = (Model&& other) noexcept; // Move Assignment Operator
+	Model& operator = (const Model& other) = delete; // Copy Assignment Operator
+	Model& operator = (Model&& other) noexcept = delete; // Move Assignment Operator
 
 	void Update(const vector<XMFLOAT3> &scales, const vector<XMFLOAT3> &rotations, const vector<XMFLOAT3> &positions, const XMMATRIX& parentMatrix);
-	bool Render(ID3D11DeviceContext* const deviceContext);
+	//Only rebuilds and uploads the listed instances, indices past the end of positions are instances that were removed
+	void UpdateInstances(const vector<XMFLOAT3> &scales, const vector<XMFLOAT3> &rotations, const vector<XMFLOAT3> &positions, const XMMATRIX& parentMatrix, const vector<int>& changedInstances);
+	//Uploads and binds the newest published snapshot, see PublishSnapshot
+	bool Render(RenderContext* const deviceContext);
+
+	//Picks the coarsest level of detail whose error, seen from the camera at the nearest any instance could be, is
+	//within MESH_LOD_MAX_SCREEN_ERROR. Render and GetIndexCount use the level picked
+	void SelectLevelOfDetail(const XMFLOAT3& cameraPosition, const XMMATRIX& projectionMatrix);
+	int GetLevelOfDetail() const;
 
 	int GetIndexCount() const;
+	MeshHandle GetMeshHandle() const;
+	//Instances in the snapshot Render draws
 	int GetInstanceCount() const;
+	//Instances the instance buffer has room for
+	int GetInstanceCapacity() const;
+
+	//Every model keeps two snapshots of its instances, updates write the newer one while Render reads the other.
+	//Updates made before this is called become the ones Render draws and the next updates start a new snapshot.
+	//Call it once a frame while no model is being updated or rendered
+	static void PublishSnapshot();
+
+	//Counts since the last reset, GraphicsRenderer resets them once a frame
+	static const InstanceReallocationStatistics& GetReallocationStatistics();
+	static void ResetReallocationStatistics();
+
+	//Update splits large instance counts across this job system's threads, nullptr builds them all on the calling thread.
+	//Models can be updated from several jobs at once as long as each model is only updated by one of them
+	static void SetJobSystem(JobSystem* const jobSystem);
 
 	bool GetInitializationState() const;
 
 private:
+	//Capacity grows by half again and only shrinks once less than a quarter is used, so instance counts that
+	//move up and down by a few every frame settle on one array and buffer
+	static int GetInstanceCapacityFor(const int count, const int currentCapacity);
+
+	static InstanceReallocationStatistics reallocationStatistics;
+	static mutex reallocationStatisticsLock;
+
+	static JobSystem* jobSystem;
+
+	//What MeshVertex.hlsli decodes compact positions with
+	struct MeshQuantizationBufferType
+	{
+		XMFLOAT3 offset;
+		float padding0;
+		XMFLOAT3 scale;
+		float padding1;
+	};
+
+	//Transposed world matrix, written by WorldMatrixBatch
 	struct InstanceType
 	{
-		XMMATRIX worldMatrix;
+		XMFLOAT4X4 worldMatrix;
 	};
 
+	//One copy of the instance matrices
+	struct InstanceSnapshot
+	{
+		InstanceType* instances;
+		int count;
+		int capacity;
+
+		//Simulation step it was written in and the step of the snapshot its changes are relative to
+		unsigned int step;
+		unsigned int baseStep;
+
+		//Every instance changed, otherwise only the first and count ranges listed
+		bool changedAll;
+		vector<pair<int, int>> changedRanges;
+	};
+
+	//Switches to a new snapshot if this is the first write this step. The ranges the newest snapshot changed
+	//aren't in the new one yet, outStaleAll means it has to be rebuilt completely
+	InstanceSnapshot& BeginSnapshotWrite(bool& outStaleAll, vector<pair<int, int>>& outStaleRanges);
+	const InstanceSnapshot& GetRenderSnapshot() const;
+
+	//Returns false if the array couldn't be allocated
+	static bool ResizeSnapshot(InstanceSnapshot& snapshot, const int count);
+	//The box around where the snapshot puts the mesh's bounding sphere centre and the largest scale it is drawn at
+	void UpdateInstanceBounds(const InstanceSnapshot& snapshot);
+
+	static void ComposeAll(const vector<XMFLOAT3> &scales, const vector<XMFLOAT3> &rotations, const vector<XMFLOAT3> &positions, const XMMATRIX& parentMatrix, InstanceSnapshot& snapshot);
+
 	bool initializationFailed;
-	bool bufferDescriptionSizeChange = false;
-	bool updateInstanceBuffer;
 
+	MeshHandle mesh;
 	int sizeOfVertexType = 0;
 
-	int indexCount = 0;
-	int instanceCount;
+	//Level 0 is the whole mesh, the rest are simplified index ranges in the same index buffer
+	vector<MeshLevelOfDetail> levelsOfDetail;
+	int levelOfDetail;
+
+	//Sphere around the mesh's bounds in model space
+	XMFLOAT3 boundsCenter;
+	float boundsRadius;
+
+	//Only recomputed when a newer snapshot is rendered
+	XMFLOAT3 instanceCentersMin;
+	XMFLOAT3 instanceCentersMax;
+	float instanceMaxScale;
+	unsigned int instanceBoundsStep;
 
 	ID3D11Buffer* vertexBuffer = nullptr;
 	ID3D11Buffer* indexBuffer = nullptr;
 	ID3D11Buffer* instanceBuffer = nullptr;
+	//Only created for the compact vertex formats
+	ID3D11Buffer* quantizationBuffer = nullptr;
+
+	InstanceSnapshot snapshots[2];
+	//Written by updates, Render reads it while the next step is being simulated
+	atomic<int> latestSnapshot;
+
+	//Instances the instance buffer has room for and the step its contents were uploaded from
+	int bufferCapacity;
+	unsigned int uploadedStep;
+
+	vector<int> sortedInstances;
+	vector<pair<int, int>> staleRanges;
 
-	InstanceType* instances = nullptr;
+	//Step updates are writing, everything older can be rendered
+	static atomic<unsigned int> simulationStep;
 
 	shared_ptr<D3D11_BUFFER_DESC> instanceBufferDescription;
 	shared_ptr<D3D11_SUBRESOURCE_DATA> instanceData;
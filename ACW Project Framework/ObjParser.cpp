@@ -0,0 +1,371 @@
+#include "ObjParser.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "MappedFile.h"
+
+//Indexed by exponent + MAX_EXPONENT so every number is scaled with one multiply, the reciprocals aren't exact but
+//the double result is still far more precise than the float it becomes
+static const int MAX_EXPONENT = 22;
+static const double POWERS_OF_TEN[] = { 1e-22, 1e-21, 1e-20, 1e-19, 1e-18, 1e-17, 1e-16, 1e-15, 1e-14, 1e-13, 1e-12, 1e-11, 1e-10, 1e-9, 1e-8, 1e-7, 1e-6, 1e-5, 1e-4, 1e-3, 1e-2, 1e-1, 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+//More digits than this could overflow a signed 64 bit mantissa, which converts to a double in one instruction
+static const int MAX_SIGNIFICANT_DIGITS = 18;
+
+//File bytes per vertex and per face in the shipped models, which write a v, vt and vn line for every vertex and have
+//about two faces per vertex. A low guess only means the arrays grow while parsing
+static const size_t BYTES_PER_VERTEX = 160;
+static const size_t BYTES_PER_FACE = 80;
+
+//"f 1 2 3" and its newline, the shortest line a face can be written on
+static const size_t MIN_FACE_LINE_LENGTH = 8;
+
+static bool IsSpace(const char character)
+{
+	return character == ' ' || character == '\t' || character == '\r';
+}
+
+static bool IsDigit(const char character)
+{
+	return static_cast<unsigned char>(character - '0') < 10;
+}
+
+static void SkipSpaces(const char*& cursor, const char* const end)
+{
+	while (cursor < end && IsSpace(*cursor))
+	{
+		cursor++;
+	}
+}
+
+static void SkipLine(const char*& cursor, const char* const end)
+{
+	const auto* const lineEnd = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+	cursor = lineEnd ? lineEnd : end;
+}
+
+//True if the line continues with keyword followed by a space or the end of the line
+static bool MatchKeyword(const char*& cursor, const char* const end, const char* const keyword, const size_t length)
+{
+	if (static_cast<size_t>(end - cursor) < length || memcmp(cursor, keyword, length) != 0)
+	{
+		return false;
+	}
+
+	if (cursor + length != end && !IsSpace(cursor[length]) && cursor[length] != '\n')
+	{
+		return false;
+	}
+
+	cursor += length;
+	return true;
+}
+
+bool ObjParser::ParseFile(const string& fileName, ObjMesh& mesh, string& error)
+{
+	MappedFile file;
+
+	if (!file.Open(fileName))
+	{
+		error = "Could not open " + fileName;
+		return false;
+	}
+
+	return Parse(file.GetData(), file.GetSize(), mesh, error);
+}
+
+bool ObjParser::Parse(const char* const text, const size_t size, ObjMesh& mesh, string& error)
+{
+	Clear(mesh);
+
+	//Sized from the file up front rather than grown line by line
+	mesh.positions.reserve(size / BYTES_PER_VERTEX);
+	mesh.textures.reserve(size / BYTES_PER_VERTEX);
+	mesh.normals.reserve(size / BYTES_PER_VERTEX);
+	mesh.corners.reserve(size / BYTES_PER_FACE * 3);
+
+	const auto* cursor = text;
+	const auto* const end = text + size;
+	auto line = 1;
+
+	while (cursor < end)
+	{
+		SkipSpaces(cursor, end);
+
+		auto valid = true;
+
+		//Dispatched on the first character so each line is only compared with the keywords it could be
+		if (cursor < end && *cursor == 'v')
+		{
+			if (MatchKeyword(cursor, end, "v", 1))
+			{
+				XMFLOAT3 position;
+				valid = ParseFloat(cursor, end, position.x) && ParseFloat(cursor, end, position.y) && ParseFloat(cursor, end, position.z);
+				mesh.positions.push_back(position);
+			}
+			else if (MatchKeyword(cursor, end, "vt", 2))
+			{
+				//The third coordinate some exporters write is ignored
+				XMFLOAT2 texture;
+				valid = ParseFloat(cursor, end, texture.x) && ParseFloat(cursor, end, texture.y);
+				mesh.textures.push_back(texture);
+			}
+			else if (MatchKeyword(cursor, end, "vn", 2))
+			{
+				XMFLOAT3 normal;
+				valid = ParseFloat(cursor, end, normal.x) && ParseFloat(cursor, end, normal.y) && ParseFloat(cursor, end, normal.z);
+				mesh.normals.push_back(normal);
+			}
+		}
+		else if (cursor < end && *cursor == 'f')
+		{
+			if (MatchKeyword(cursor, end, "f", 1))
+			{
+				valid = ParseFace(cursor, end, mesh);
+			}
+			else if (MatchKeyword(cursor, end, "faces", 5))
+			{
+				auto faceCount = 0;
+
+				//A count more faces than the rest of the file could hold is corrupt, reserving it would throw bad_alloc
+				if (ParseInt(cursor, end, faceCount) && faceCount > 0 && static_cast<size_t>(faceCount) <= static_cast<size_t>(end - cursor) / MIN_FACE_LINE_LENGTH)
+				{
+					mesh.corners.reserve(static_cast<size_t>(faceCount) * 3);
+				}
+			}
+		}
+
+		if (!valid)
+		{
+			error = "Line " + to_string(line) + " is not a valid vertex or face";
+			Clear(mesh);
+			return false;
+		}
+
+		SkipLine(cursor, end);
+
+		if (cursor < end)
+		{
+			cursor++;
+			line++;
+		}
+	}
+
+	//Positive indices can refer to vertices later in the file, so they are checked once everything is read
+	const auto positionCount = static_cast<int>(mesh.positions.size());
+	const auto textureCount = static_cast<int>(mesh.textures.size());
+	const auto normalCount = static_cast<int>(mesh.normals.size());
+
+	for (auto& corner : mesh.corners)
+	{
+		if (corner.position < 0 || corner.position >= positionCount || corner.texture >= textureCount || corner.normal >= normalCount)
+		{
+			error = "A face refers to a vertex that isn't in the file";
+			Clear(mesh);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void ObjParser::Clear(ObjMesh& mesh)
+{
+	mesh.positions.clear();
+	mesh.textures.clear();
+	mesh.normals.clear();
+	mesh.corners.clear();
+}
+
+bool ObjParser::ParseFloat(const char*& cursor, const char* const end, float& value)
+{
+	SkipSpaces(cursor, end);
+
+	const auto* const start = cursor;
+	auto negative = false;
+
+	if (cursor < end && (*cursor == '-' || *cursor == '+'))
+	{
+		negative = *cursor == '-';
+		cursor++;
+	}
+
+	uint64_t mantissa = 0;
+	auto exponent = 0;
+	const auto* const digitsStart = cursor;
+
+	for (; cursor < end && IsDigit(*cursor); cursor++)
+	{
+		mantissa = mantissa * 10 + (*cursor - '0');
+	}
+
+	auto digitCount = static_cast<int>(cursor - digitsStart);
+
+	if (cursor < end && *cursor == '.')
+	{
+		cursor++;
+
+		const auto* const fractionStart = cursor;
+
+		for (; cursor < end && IsDigit(*cursor); cursor++)
+		{
+			mantissa = mantissa * 10 + (*cursor - '0');
+		}
+
+		exponent = -static_cast<int>(cursor - fractionStart);
+		digitCount -= exponent;
+	}
+
+	if (digitCount == 0)
+	{
+		return false;
+	}
+
+	if (cursor < end && (*cursor == 'e' || *cursor == 'E'))
+	{
+		cursor++;
+
+		auto exponentValue = 0;
+
+		if (!ParseInt(cursor, end, exponentValue))
+		{
+			return false;
+		}
+
+		exponent += exponentValue;
+	}
+
+	//Too many digits for the mantissa or too large an exponent for one exact power of ten, rare enough to hand to strtod
+	if (digitCount > MAX_SIGNIFICANT_DIGITS || exponent > MAX_EXPONENT || exponent < -MAX_EXPONENT)
+	{
+		char number[128];
+		const auto length = min(static_cast<size_t>(cursor - start), sizeof(number) - 1);
+
+		memcpy(number, start, length);
+		number[length] = '\0';
+
+		value = static_cast<float>(strtod(number, nullptr));
+		return true;
+	}
+
+	const auto result = static_cast<double>(static_cast<int64_t>(mantissa)) * POWERS_OF_TEN[exponent + MAX_EXPONENT];
+
+	value = static_cast<float>(negative ? -result : result);
+
+	return true;
+}
+
+bool ObjParser::ParseInt(const char*& cursor, const char* const end, int& value)
+{
+	SkipSpaces(cursor, end);
+
+	auto negative = false;
+
+	if (cursor < end && (*cursor == '-' || *cursor == '+'))
+	{
+		negative = *cursor == '-';
+		cursor++;
+	}
+
+	if (cursor == end || !IsDigit(*cursor))
+	{
+		return false;
+	}
+
+	long long result = 0;
+
+	for (; cursor < end && IsDigit(*cursor); cursor++)
+	{
+		//Anything this large is out of range of every array anyway
+		if (result < INT32_MAX)
+		{
+			result = result * 10 + (*cursor - '0');
+		}
+	}
+
+	result = result > INT32_MAX ? INT32_MAX : result;
+	value = static_cast<int>(negative ? -result : result);
+
+	return true;
+}
+
+bool ObjParser::ParseFace(const char*& cursor, const char* const end, ObjMesh& mesh)
+{
+	ObjVertexIndex firstCorner = { 0, 0, 0 };
+	ObjVertexIndex previousCorner = { 0, 0, 0 };
+	auto cornerCount = 0;
+
+	while (true)
+	{
+		SkipSpaces(cursor, end);
+
+		if (cursor == end || *cursor == '\n' || *cursor == '#')
+		{
+			break;
+		}
+
+		ObjVertexIndex corner = { 0, 0, 0 };
+
+		if (!ParseInt(cursor, end, corner.position) || !ResolveIndex(corner.position, static_cast<int>(mesh.positions.size())))
+		{
+			return false;
+		}
+
+		if (cursor < end && *cursor == '/')
+		{
+			cursor++;
+
+			//v//n leaves the texture out
+			if (cursor < end && *cursor != '/' && (!ParseInt(cursor, end, corner.texture) || !ResolveIndex(corner.texture, static_cast<int>(mesh.textures.size()))))
+			{
+				return false;
+			}
+
+			if (cursor < end && *cursor == '/')
+			{
+				cursor++;
+
+				if (!ParseInt(cursor, end, corner.normal) || !ResolveIndex(corner.normal, static_cast<int>(mesh.normals.size())))
+				{
+					return false;
+				}
+			}
+		}
+
+		//Converted from one based, anything left at 0 becomes -1
+		corner.position--;
+		corner.texture--;
+		corner.normal--;
+
+		//From the third corner on each one adds a triangle fanned out from the first, so polygons need no buffer
+		if (cornerCount == 0)
+		{
+			firstCorner = corner;
+		}
+		else if (cornerCount >= 2)
+		{
+			mesh.corners.push_back(firstCorner);
+			mesh.corners.push_back(previousCorner);
+			mesh.corners.push_back(corner);
+		}
+
+		previousCorner = corner;
+		cornerCount++;
+	}
+
+	return cornerCount >= 3;
+}
+
+bool ObjParser::ResolveIndex(int& index, const int count)
+{
+	//Negative indices count back from the last vertex read so far, 0 isn't an index
+	if (index < 0)
+	{
+		index += count + 1;
+		return index > 0;
+	}
+
+	return index != 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace DirectX;
+
+//Zero based indices into an ObjMesh's arrays, -1 when the face didn't give one
+struct ObjVertexIndex
+{
+	int position;
+	int texture;
+	int normal;
+};
+
+//Everything a Wavefront OBJ file describes that the renderer uses. Faces are split into triangles, three corners each
+struct ObjMesh
+{
+	vector<XMFLOAT3> positions;
+	vector<XMFLOAT2> textures;
+	vector<XMFLOAT3> normals;
+	vector<ObjVertexIndex> corners;
+};
+
+//Parses OBJ files in place from a memory mapped view rather than token by token through a stream.
+//Handles v, vt, vn and f lines with any of the v, v/t, v//n and v/t/n forms, negative indices and polygons, which are
+//split into a fan of triangles. Groups, materials, smoothing groups and comments are skipped. The "faces" line the
+//shipped models start with is only used to reserve space, so standard OBJ files load too.
+//Every index is checked against the arrays it refers to, a file with one out of range fails to parse
+class ObjParser
+{
+public:
+	static bool ParseFile(const string& fileName, ObjMesh& mesh, string& error);
+	//text doesn't have to be null terminated. The mesh's arrays are cleared but keep their capacity, so a mesh reused
+	//for several files only allocates for the largest
+	static bool Parse(const char* const text, const size_t size, ObjMesh& mesh, string& error);
+
+private:
+	static void Clear(ObjMesh& mesh);
+	static bool ParseFloat(const char*& cursor, const char* const end, float& value);
+	static bool ParseInt(const char*& cursor, const char* const end, int& value);
+	static bool ParseFace(const char*& cursor, const char* const end, ObjMesh& mesh);
+	static bool ResolveIndex(int& index, const int count);
+};
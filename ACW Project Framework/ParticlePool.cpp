@@ -0,0 +1,348 @@
+#include "ParticlePool.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PARTICLE_POOL_AVX
+#elif !defined(_XM_NO_INTRINSICS_) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define PARTICLE_POOL_SSE
+#endif
+
+//Per particle amounts for one call to Advance
+struct ParticleStep
+{
+	XMFLOAT3 movement;
+	XMFLOAT3 growth;
+	float killScale;
+	float dt;
+};
+
+//Advances count particles starting at the given slots, returns how many were flagged
+static int AdvanceScalarSpan(XMFLOAT3* const positions, XMFLOAT3* const scales, float* const ages, unsigned char* const killFlags, const int count, const ParticleStep& step)
+{
+	auto killed = 0;
+
+	for (auto i = 0; i < count; i++)
+	{
+		positions[i] = XMFLOAT3(positions[i].x + step.movement.x, positions[i].y + step.movement.y, positions[i].z + step.movement.z);
+		scales[i] = XMFLOAT3(scales[i].x + step.growth.x, scales[i].y + step.growth.y, scales[i].z + step.growth.z);
+		ages[i] += step.dt;
+
+		if (scales[i].x > step.killScale)
+		{
+			killFlags[i] = 1;
+			killed++;
+		}
+	}
+
+	return killed;
+}
+
+#if defined(PARTICLE_POOL_AVX) || defined(PARTICLE_POOL_SSE)
+
+#if defined(PARTICLE_POOL_AVX)
+typedef __m256 Lanes;
+static const int LANE_COUNT = 8;
+
+static Lanes Set(const float value) { return _mm256_set1_ps(value); }
+static Lanes Load(const float* const values) { return _mm256_loadu_ps(values); }
+static void Store(float* const values, const Lanes a) { _mm256_storeu_ps(values, a); }
+static Lanes Add(const Lanes a, const Lanes b) { return _mm256_add_ps(a, b); }
+static Lanes Greater(const Lanes a, const Lanes b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+static unsigned int MoveMask(const Lanes a) { return static_cast<unsigned int>(_mm256_movemask_ps(a)); }
+#else
+typedef __m128 Lanes;
+static const int LANE_COUNT = 4;
+
+static Lanes Set(const float value) { return _mm_set1_ps(value); }
+static Lanes Load(const float* const values) { return _mm_loadu_ps(values); }
+static void Store(float* const values, const Lanes a) { _mm_storeu_ps(values, a); }
+static Lanes Add(const Lanes a, const Lanes b) { return _mm_add_ps(a, b); }
+static Lanes Greater(const Lanes a, const Lanes b) { return _mm_cmpgt_ps(a, b); }
+static unsigned int MoveMask(const Lanes a) { return static_cast<unsigned int>(_mm_movemask_ps(a)); }
+#endif
+
+//x, y, z repeated across three registers, which lines up with LANE_COUNT packed XMFLOAT3s
+static void SetRepeating(const XMFLOAT3& value, Lanes outLanes[3])
+{
+	float values[3 * LANE_COUNT];
+
+	for (auto i = 0; i < LANE_COUNT; i++)
+	{
+		values[i * 3 + 0] = value.x;
+		values[i * 3 + 1] = value.y;
+		values[i * 3 + 2] = value.z;
+	}
+
+	for (auto k = 0; k < 3; k++)
+	{
+		outLanes[k] = Load(values + k * LANE_COUNT);
+	}
+}
+
+static int AdvanceLanesSpan(XMFLOAT3* const positions, XMFLOAT3* const scales, float* const ages, unsigned char* const killFlags, const int count, const ParticleStep& step)
+{
+	Lanes movement[3], growth[3], killScale[3];
+
+	SetRepeating(step.movement, movement);
+	SetRepeating(step.growth, growth);
+	//Only the x component can pass the kill test
+	SetRepeating(XMFLOAT3(step.killScale, numeric_limits<float>::infinity(), numeric_limits<float>::infinity()), killScale);
+
+	const auto dt = Set(step.dt);
+	const auto blockEnd = count - count % LANE_COUNT;
+
+	auto killed = 0;
+
+	//The arrays are read as flat floats, LANE_COUNT particles at a time
+	for (auto block = 0; block < blockEnd; block += LANE_COUNT)
+	{
+		auto* const position = &positions[block].x;
+		auto* const scale = &scales[block].x;
+		auto mask = 0u;
+
+		for (auto k = 0; k < 3; k++)
+		{
+			Store(position + k * LANE_COUNT, Add(Load(position + k * LANE_COUNT), movement[k]));
+
+			const auto grown = Add(Load(scale + k * LANE_COUNT), growth[k]);
+			Store(scale + k * LANE_COUNT, grown);
+
+			mask |= MoveMask(Greater(grown, killScale[k])) << (k * LANE_COUNT);
+		}
+
+		Store(ages + block, Add(Load(ages + block), dt));
+
+		//Bit 3 * i of the mask is particle i's x component
+		if (mask != 0)
+		{
+			for (auto lane = 0; lane < LANE_COUNT; lane++)
+			{
+				if ((mask >> (lane * 3)) & 1u)
+				{
+					killFlags[block + lane] = 1;
+					killed++;
+				}
+			}
+		}
+	}
+
+	return killed + AdvanceScalarSpan(positions + blockEnd, scales + blockEnd, ages + blockEnd, killFlags + blockEnd, count - blockEnd, step);
+}
+
+#endif
+
+ParticlePool::ParticlePool(const int capacity) : capacity(capacity), oldest(0), count(0), positions(capacity, XMFLOAT3()), scales(capacity, XMFLOAT3()), ages(capacity, 0.0f), killFlags(capacity, 0)
+{
+}
+
+ParticlePool::ParticlePool(const ParticlePool& other) = default;
+
+ParticlePool::ParticlePool(ParticlePool&& other) noexcept = default;
+
+ParticlePool::~ParticlePool() = default;
+
+ParticlePool& ParticlePool::operator=(const ParticlePool& other) = default;
+
+ParticlePool& ParticlePool::operator=(ParticlePool&& other) noexcept = default;
+
+int ParticlePool::GetCapacity() const
+{
+	return capacity;
+}
+
+int ParticlePool::GetCount() const
+{
+	return count;
+}
+
+int ParticlePool::GetSlot(const int index) const
+{
+	const auto slot = oldest + index;
+
+	return slot < capacity ? slot : slot - capacity;
+}
+
+int ParticlePool::Spawn(const XMFLOAT3& position, const XMFLOAT3& scale)
+{
+	if (capacity == 0)
+	{
+		return -1;
+	}
+
+	if (count == capacity)
+	{
+		RetireOldest();
+	}
+
+	const auto slot = GetSlot(count);
+
+	positions[slot] = position;
+	scales[slot] = scale;
+	ages[slot] = 0.0f;
+
+	count++;
+
+	return slot;
+}
+
+void ParticlePool::RetireOldest()
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	//Collapse it so it draws nothing
+	scales[oldest] = XMFLOAT3();
+
+	oldest = GetSlot(1);
+	count--;
+}
+
+void ParticlePool::Clear()
+{
+	while (count > 0)
+	{
+		RetireOldest();
+	}
+
+	oldest = 0;
+}
+
+int ParticlePool::Advance(const XMFLOAT3& velocity, const XMFLOAT3& scaleRate, const float killScale, const float dt)
+{
+	return Advance(velocity, scaleRate, killScale, dt, true);
+}
+
+int ParticlePool::AdvanceScalar(const XMFLOAT3& velocity, const XMFLOAT3& scaleRate, const float killScale, const float dt)
+{
+	return Advance(velocity, scaleRate, killScale, dt, false);
+}
+
+int ParticlePool::GetLaneCount()
+{
+#if defined(PARTICLE_POOL_AVX) || defined(PARTICLE_POOL_SSE)
+	return LANE_COUNT;
+#else
+	return 1;
+#endif
+}
+
+int ParticlePool::Advance(const XMFLOAT3& velocity, const XMFLOAT3& scaleRate, const float killScale, const float dt, const bool useLanes)
+{
+	ParticleStep step;
+	step.movement = XMFLOAT3(velocity.x * dt, velocity.y * dt, velocity.z * dt);
+	step.growth = XMFLOAT3(scaleRate.x * dt, scaleRate.y * dt, scaleRate.z * dt);
+	step.killScale = killScale;
+	step.dt = dt;
+
+#if defined(PARTICLE_POOL_AVX) || defined(PARTICLE_POOL_SSE)
+	const auto advanceSpan = useLanes ? &AdvanceLanesSpan : &AdvanceScalarSpan;
+#else
+	//Without a lane path both callers get the scalar one
+	static_cast<void>(useLanes);
+	const auto advanceSpan = &AdvanceScalarSpan;
+#endif
+
+	//The live particles are at most two runs of slots, up to the end of the arrays and then from the start
+	const auto firstRun = min(count, capacity - oldest);
+	auto killed = 0;
+
+	if (firstRun > 0)
+	{
+		killed += advanceSpan(&positions[oldest], &scales[oldest], &ages[oldest], &killFlags[oldest], firstRun, step);
+	}
+
+	if (count > firstRun)
+	{
+		killed += advanceSpan(positions.data(), scales.data(), ages.data(), killFlags.data(), count - firstRun, step);
+	}
+
+	if (killed > 0)
+	{
+		Compact(killed);
+	}
+
+	return killed;
+}
+
+void ParticlePool::Compact(int killedCount)
+{
+	//Particles usually pass the kill scale oldest first, those only have to move the tail on
+	while (killedCount > 0 && killFlags[oldest])
+	{
+		killFlags[oldest] = 0;
+		RetireOldest();
+		killedCount--;
+	}
+
+	if (killedCount == 0)
+	{
+		return;
+	}
+
+	auto survivors = 0;
+
+	for (auto i = 0; i < count; i++)
+	{
+		const auto slot = GetSlot(i);
+
+		if (killFlags[slot])
+		{
+			killFlags[slot] = 0;
+			continue;
+		}
+
+		if (survivors != i)
+		{
+			const auto target = GetSlot(survivors);
+
+			positions[target] = positions[slot];
+			scales[target] = scales[slot];
+			ages[target] = ages[slot];
+		}
+
+		survivors++;
+	}
+
+	//Collapse the slots left behind at the head
+	for (auto i = survivors; i < count; i++)
+	{
+		scales[GetSlot(i)] = XMFLOAT3();
+	}
+
+	count = survivors;
+}
+
+vector<XMFLOAT3>& ParticlePool::GetPositions()
+{
+	return positions;
+}
+
+vector<XMFLOAT3>& ParticlePool::GetScales()
+{
+	return scales;
+}
+
+vector<float>& ParticlePool::GetAges()
+{
+	return ages;
+}
+
+const vector<XMFLOAT3>& ParticlePool::GetPositions() const
+{
+	return positions;
+}
+
+const vector<XMFLOAT3>& ParticlePool::GetScales() const
+{
+	return scales;
+}
+
+const vector<float>& ParticlePool::GetAges() const
+{
+	return ages;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <vector>
+
+using namespace DirectX;
+using namespace std;
+
+//Fixed capacity ring of particles stored as separate position, scale and age arrays.
+//Particles are spawned at the head and retired from the tail in O(1) and are updated in place through the arrays.
+//Slots that aren't live keep a zero scale, so the arrays can be drawn as they are with every slot as an instance.
+//Advance updates the live particles with SSE or AVX, four or eight particles per instruction
+class ParticlePool
+{
+public:
+	explicit ParticlePool(const int capacity);
+	ParticlePool(const ParticlePool& other); // Copy Constructor
+	ParticlePool(ParticlePool&& other) noexcept; // Move Constructor
+	~ParticlePool(); // Destructor
+
+	ParticlePool& operator = (const ParticlePool& other); // Copy Assignment Operator
+	ParticlePool& operator = (ParticlePool&& other) noexcept; // Move Assignment Operator
+
+	int GetCapacity() const;
+	int GetCount() const;
+
+	//Slot of the index-th live particle, 0 is the oldest
+	int GetSlot(const int index) const;
+
+	//Retires the oldest particle first if the pool is full, returns the slot used
+	int Spawn(const XMFLOAT3& position, const XMFLOAT3& scale);
+	void RetireOldest();
+	void Clear();
+
+	//Moves every live particle by velocity * dt, grows its scale by scaleRate * dt and ages it by dt, then retires every
+	//particle whose scale.x is now past killScale. The survivors keep their order, returns how many were retired
+	int Advance(const XMFLOAT3& velocity, const XMFLOAT3& scaleRate, const float killScale, const float dt);
+	//Same one particle at a time, kept to check and benchmark against
+	int AdvanceScalar(const XMFLOAT3& velocity, const XMFLOAT3& scaleRate, const float killScale, const float dt);
+
+	//Particles handled per iteration of the SIMD loop, 1 when the build only has the scalar path
+	static int GetLaneCount();
+
+	vector<XMFLOAT3>& GetPositions();
+	vector<XMFLOAT3>& GetScales();
+	vector<float>& GetAges();
+
+	const vector<XMFLOAT3>& GetPositions() const;
+	const vector<XMFLOAT3>& GetScales() const;
+	const vector<float>& GetAges() const;
+
+private:
+	int Advance(const XMFLOAT3& velocity, const XMFLOAT3& scaleRate, const float killScale, const float dt, const bool useLanes);
+	//Removes the flagged particles, closing the gaps by moving the newer ones back
+	void Compact(int killedCount);
+
+	int capacity;
+	int oldest;
+	int count;
+
+	vector<XMFLOAT3> positions;
+	vector<XMFLOAT3> scales;
+	vector<float> ages;
+	//Set by Advance for each slot that has to be retired, always clear in between
+	vector<unsigned char> killFlags;
+};
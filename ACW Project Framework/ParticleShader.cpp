@@ -1,62 +1,8 @@
 #include "ParticleShader.h"
 
-ParticleShader::ParticleShader(ID3D11Device* const device, HWND const hwnd) : Shader("ParticleVertexShader", "ParticleHullShader", "ParticleDomainShader", "ParticlePixelShader", device, hwnd), transparency(0.0f), colourTint(0.0f, 0.0f, 0.0f), inputLayout(nullptr), sampleState(nullptr)
+ParticleShader::ParticleShader(ID3D11Device* const device, HWND const hwnd, const MeshVertexFormat vertexFormat) : Shader("ParticleVertexShader", "ParticleHullShader", "ParticleDomainShader", "ParticlePixelShader", device, hwnd, vertexFormat), transparency(0.0f), colourTint(0.0f, 0.0f, 0.0f), inputLayout(nullptr), sampleState(nullptr)
 {
-	D3D11_INPUT_ELEMENT_DESC layout[6];
-
-	unsigned int numberOfElements = 0;
-
-	layout[0].SemanticName = "POSITION";
-	layout[0].SemanticIndex = 0;
-	layout[0].Format = DXGI_FORMAT_R32G32B32_FLOAT;
-	layout[0].InputSlot = 0;
-	layout[0].AlignedByteOffset = 0;
-	layout[0].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-	layout[0].InstanceDataStepRate = 0;
-
-	layout[1].SemanticName = "TEXCOORD";
-	layout[1].SemanticIndex = 0;
-	layout[1].Format = DXGI_FORMAT_R32G32_FLOAT;
-	layout[1].InputSlot = 0;
-	layout[1].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	layout[1].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-	layout[1].InstanceDataStepRate = 0;
-
-	layout[2].SemanticName = "INSTANCEMATRIX";
-	layout[2].SemanticIndex = 0;
-	layout[2].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
-	layout[2].InputSlot = 1;
-	layout[2].AlignedByteOffset = 0;
-	layout[2].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
-	layout[2].InstanceDataStepRate = 1;
-
-	layout[3].SemanticName = "INSTANCEMATRIX";
-	layout[3].SemanticIndex = 1;
-	layout[3].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
-	layout[3].InputSlot = 1;
-	layout[3].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	layout[3].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
-	layout[3].InstanceDataStepRate = 1;
-
-	layout[4].SemanticName = "INSTANCEMATRIX";
-	layout[4].SemanticIndex = 2;
-	layout[4].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
-	layout[4].InputSlot = 1;
-	layout[4].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	layout[4].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
-	layout[4].InstanceDataStepRate = 1;
-
-	layout[5].SemanticName = "INSTANCEMATRIX";
-	layout[5].SemanticIndex = 3;
-	layout[5].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
-	layout[5].InputSlot = 1;
-	layout[5].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	layout[5].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
-	layout[5].InstanceDataStepRate = 1;
-
-	numberOfElements = sizeof(layout) / sizeof(layout[0]);
-
-	auto result = device->CreateInputLayout(layout, numberOfElements, GetVertexShaderBuffer()->GetBufferPointer(), GetVertexShaderBuffer()->GetBufferSize(), &inputLayout);
+	auto result = CreateMeshInputLayout(device, &inputLayout);
 
 	GetVertexShaderBuffer()->Release();
 	SetVertexShaderBuffer(nullptr);
@@ -158,14 +104,14 @@ void ParticleShader::SetParticleParameters(const XMFLOAT3& clTint, const float t
 	transparency = tr;
 }
 
-bool ParticleShader::Render(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition)
+bool ParticleShader::Render(RenderContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition)
 {
 	SetParticleShaderParameters(deviceContext, viewMatrix, projectionMatrix, textures, cameraPosition);
 	RenderShader(deviceContext, indexCount, instanceCount);
 	return true;
 }
 
-bool ParticleShader::SetParticleShaderParameters(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const XMFLOAT3& cameraPosition)
+bool ParticleShader::SetParticleShaderParameters(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const XMFLOAT3& cameraPosition)
 {
 	SetShaderParameters(deviceContext, viewMatrix, projectionMatrix, cameraPosition);
 	ID3D11ShaderResourceView* textureArray[1];
@@ -191,10 +137,10 @@ bool ParticleShader::SetParticleShaderParameters(ID3D11DeviceContext* const devi
 	return true;
 }
 
-void ParticleShader::RenderShader(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount) const
+void ParticleShader::RenderShader(RenderContext* const deviceContext, const int indexCount, const int instanceCount) const
 {
 	deviceContext->IASetInputLayout(inputLayout);
 	SetShader(deviceContext);
 	deviceContext->PSSetSamplers(0, 1, &sampleState);
-	deviceContext->DrawInstanced(indexCount, instanceCount, 0, 0);
+	deviceContext->DrawIndexedInstanced(indexCount, instanceCount, 0, 0, 0);
 }
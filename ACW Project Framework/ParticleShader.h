@@ -12,7 +12,7 @@ using namespace std;
 class ParticleShader : public Shader
 {
 public:
-	ParticleShader(ID3D11Device* const device, HWND const hwnd); // Default Constructor
+	ParticleShader(ID3D11Device* const device, HWND const hwnd, const MeshVertexFormat vertexFormat); // Default Constructor
 	void CreateBuffer(ID3D11Device* device, UINT byteWidth, D3D11_BIND_FLAG bindFlags, ID3D11Buffer** buffer);
 	ParticleShader(const ParticleShader& other); // Copy Constructor
 	ParticleShader(ParticleShader&& other) noexcept; // Move Constructor
@@ -23,13 +23,13 @@ public:
 
 	void SetParticleParameters(const XMFLOAT3& colourTint, const float transparency);
 
-	bool Render(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const XMFLOAT3& cameraPosition);
+	bool Render(RenderContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const XMFLOAT3& cameraPosition);
 
-	bool Render(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) override;
+	bool Render(RenderContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) override;
 
 private:
-	bool SetParticleShaderParameters(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const XMFLOAT3& cameraPosition);
-	void RenderShader(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount) const;
+	bool SetParticleShaderParameters(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const XMFLOAT3& cameraPosition);
+	void RenderShader(RenderContext* const deviceContext, const int indexCount, const int instanceCount) const;
 
 	struct InverseViewBuffer {
 		XMMATRIX inverseViewMatrix;
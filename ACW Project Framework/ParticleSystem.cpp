@@ -1,23 +1,19 @@
 #include "ParticleSystem.h"
+#include <algorithm>
+#include <cmath>
 
-ParticleSystem::ParticleSystem(ID3D11Device* const device, HWND const hwnd, const ModelType modelType, const XMFLOAT3& initialPosition, const XMFLOAT3& initialScale, const XMFLOAT3& finalScale, const XMFLOAT3& colourTint, const WCHAR* const textureName, const float transparency, const float lifeCycle, const float velocity, const int particleDensity, const shared_ptr<ResourceManager>& resourceManager) : initialPosition(initialPosition), initialScale(initialScale), scaleReduction(XMFLOAT3()), killScale(XMFLOAT3()), emitterType(false), spawnRate(0.0f), elapsedTime(0.0f), lifeCycle(lifeCycle), velocity(velocity), particleSpread(lifeCycle / particleDensity)
+ParticleSystem::ParticleSystem(ID3D11Device* const device, HWND const hwnd, const ModelType modelType, const XMFLOAT3& initialPosition, const XMFLOAT3& initialScale, const XMFLOAT3& finalScale, const XMFLOAT3& colourTint, const WCHAR* const textureName, const float transparency, const float lifeCycle, const float velocity, const int particleDensity, const shared_ptr<ResourceManager>& resourceManager) : initialPosition(initialPosition), initialScale(initialScale), finalScale(finalScale), scaleReduction(XMFLOAT3()), killScale(XMFLOAT3()), emitterType(false), spawnRate(0.0f), elapsedTime(0.0f), lifeCycle(lifeCycle), velocity(velocity), particleSpread(lifeCycle / particleDensity), particles(particleDensity)
 {
-	auto positions = vector<XMFLOAT3>();
-	auto scales = vector<XMFLOAT3>();
-
-	//Add particle instances
+	//Add particle instances, spread out along the stream as if it had been running for a while
 	for (auto i = 1; i <= particleDensity; i++)
 	{
-		positions.emplace_back(XMFLOAT3(initialPosition.x, initialPosition.y - (i * particleSpread), initialPosition.z));
-
-		auto particleScale = XMFLOAT3(initialScale.x - ((initialScale.x - finalScale.x) / particleDensity) * i, initialScale.y - ((initialScale.y - finalScale.y) / particleDensity) * i, initialScale.z - ((initialScale.z - finalScale.z) / particleDensity) * i);
+		const auto slot = particles.Spawn(initialPosition, initialScale);
 
-		//scales.emplace_back(initialScale - ((initialScale - finalScale) / particleDensity) * i);
-		scales.emplace_back(particleScale);
+		particles.GetAges()[slot] = velocity != 0.0f ? (i * particleSpread) / abs(velocity) : 0.0f;
 	}
 
-	AddPositionComponent(positions);
-	AddScaleComponent(scales);
+	AddPositionComponent(initialPosition);
+	AddScaleComponent(initialScale);
 	AddRotationComponent(0.0f, 0.0f, 0.0f);
 
 	vector<const WCHAR*> textureNames;
@@ -26,15 +22,20 @@ ParticleSystem::ParticleSystem(ID3D11Device* const device, HWND const hwnd, cons
 	AddModelComponent(device, modelType, resourceManager);
 	AddTextureComponent(device, textureNames, resourceManager);
 
-	const auto particleShader = make_shared<ParticleShader>(device, hwnd);
+	const auto particleShader = make_shared<ParticleShader>(device, hwnd, resourceManager->GetVertexFormat());
 
 	particleShader->SetParticleParameters(colourTint, transparency);
 
 	SetShaderComponent(particleShader);
+
+	//Size the model's instances to the pool
+	UpdateParticles(0.0f);
 }
 
-ParticleSystem::ParticleSystem(ID3D11Device* const device, HWND const hwnd, const XMFLOAT3& initialPosition, const XMFLOAT3& initialScale, const XMFLOAT3& scaleReduction, const XMFLOAT3& killScale, const XMFLOAT3& colourTint, const WCHAR* const textureName, const float transparency, const float spawnRate, const float velocity, const shared_ptr<ResourceManager>& resourceManager) : initialPosition(initialPosition), initialScale(initialScale), scaleReduction(scaleReduction), killScale(killScale), emitterType(true), spawnRate(spawnRate), elapsedTime(0.0f), lifeCycle(0.0f), velocity(velocity), particleSpread(0.0f)
+ParticleSystem::ParticleSystem(ID3D11Device* const device, HWND const hwnd, const XMFLOAT3& initialPosition, const XMFLOAT3& initialScale, const XMFLOAT3& scaleReduction, const XMFLOAT3& killScale, const XMFLOAT3& colourTint, const WCHAR* const textureName, const float transparency, const float spawnRate, const float velocity, const shared_ptr<ResourceManager>& resourceManager) : initialPosition(initialPosition), initialScale(initialScale), finalScale(killScale), scaleReduction(scaleReduction), killScale(killScale), emitterType(true), spawnRate(spawnRate), elapsedTime(0.0f), lifeCycle(0.0f), velocity(velocity), particleSpread(0.0f), particles(GetEmitterCapacity(initialScale, scaleReduction, killScale, spawnRate))
 {
+	particles.Spawn(initialPosition, initialScale);
+
 	AddPositionComponent(initialPosition);
 	AddScaleComponent(initialScale);
 	AddRotationComponent(0.0f, 0.0f, 0.0f);
@@ -45,11 +46,14 @@ ParticleSystem::ParticleSystem(ID3D11Device* const device, HWND const hwnd, cons
 	AddModelComponent(device, ModelType::Quad, resourceManager);
 	AddTextureComponent(device, textureNames, resourceManager);
 
-	const auto particleShader = make_shared<ParticleShader>(device, hwnd);
+	const auto particleShader = make_shared<ParticleShader>(device, hwnd, resourceManager->GetVertexFormat());
 
 	particleShader->SetParticleParameters(colourTint, transparency);
 
 	SetShaderComponent(particleShader);
+
+	//Size the model's instances to the pool
+	UpdateParticles(0.0f);
 }
 
 //ParticleSystem::ParticleSystem(const ParticleSystem& other) = default;
@@ -60,8 +64,25 @@ ParticleSystem::~ParticleSystem()
 {
 }
 
+int ParticleSystem::GetEmitterCapacity(const XMFLOAT3& initialScale, const XMFLOAT3& scaleReduction, const XMFLOAT3& killScale, const float spawnRate)
+{
+	//Particles grow by -scaleReduction a second until they pass the kill scale, so at most lifetime / spawnRate are alive
+	if (scaleReduction.x >= 0.0f || spawnRate <= 0.0f)
+	{
+		return MAX_EMITTER_PARTICLES;
+	}
+
+	const auto lifetime = (killScale.x - initialScale.x) / -scaleReduction.x;
+
+	return min(max(static_cast<int>(ceil(lifetime / spawnRate)) + 2, 1), MAX_EMITTER_PARTICLES);
+}
+
 void ParticleSystem::UpdateParticles(const float dt)
 {
+	auto& positions = particles.GetPositions();
+	auto& scales = particles.GetScales();
+	auto& ages = particles.GetAges();
+
 	if (emitterType)
 	{
 		elapsedTime += dt;
@@ -69,62 +90,46 @@ void ParticleSystem::UpdateParticles(const float dt)
 		//Add a new particle if the spawn rate is reached
 		if (elapsedTime > spawnRate)
 		{
-			GetPositionComponent()->AddPositionFront(initialPosition);
-			GetScaleComponent()->AddScaleFront(initialScale);
+			particles.Spawn(initialPosition, initialScale);
 
 			elapsedTime = 0.0f;
 		}
 
-		//Check if we need to remove any particles
-		for (const auto scale : GetScaleComponent()->GetScales())
-		{
-			if (scale.x > killScale.x)
-			{
-				//Remove particle
-				GetPositionComponent()->RemovePositionBack();
-				GetScaleComponent()->RemoveScaleBack();
-			}
-		}
-
-		auto positions = GetPositionComponent()->GetPositions();
-		auto scales = GetScaleComponent()->GetScales();
-
-		//Update particles
-		for (unsigned int i = 0; i < positions.size(); i++)
-		{
-			positions[i].y = positions[i].y + abs(velocity * dt);
-			//scales[i] = scales[i] - (XMFLOAT3(scaleReduction.x * dt, scaleReduction.y * dt, scaleReduction.z * dt));
-			scales[i] = XMFLOAT3(scales[i].x - scaleReduction.x * dt, scales[i].y - scaleReduction.y * dt, scales[i].z - scaleReduction.z * dt);
-		}
-
-		SetPosition(positions);
-		SetScale(scales);
+		//Rise, grow and retire everything that has passed the kill scale in one SIMD pass over the pool
+		particles.Advance(XMFLOAT3(0.0f, abs(velocity), 0.0f), XMFLOAT3(-scaleReduction.x, -scaleReduction.y, -scaleReduction.z), killScale.x, dt);
 	}
 	else
 	{
-		auto positions = GetPositionComponent()->GetPositions();
-
-		for (auto& position : positions)
+		for (auto i = 0; i < particles.GetCount(); i++)
 		{
-			position = XMFLOAT3(position.x + 0.0f * velocity * dt, position.y + -1.0f * velocity * dt, position.z + 0.0f * velocity * dt);
+			const auto slot = particles.GetSlot(i);
+
+			ages[slot] += dt;
 
-			//If the new updated position has reached the end of its lifecycle then we 
-			if (position.y < initialPosition.y - lifeCycle)
+			auto distance = abs(velocity) * ages[slot];
+
+			//If the particle has reached the end of its lifecycle then it starts again at the top of the stream
+			if (distance > lifeCycle)
 			{
-				positions.pop_back();
-				positions.insert(positions.begin(), initialPosition);
+				ages[slot] = 0.0f;
+				distance = 0.0f;
 			}
-		}
 
-		SetPosition(positions);
+			const auto lifeFraction = lifeCycle > 0.0f ? distance / lifeCycle : 0.0f;
+
+			positions[slot] = XMFLOAT3(initialPosition.x, initialPosition.y - distance, initialPosition.z);
+			scales[slot] = XMFLOAT3(initialScale.x - (initialScale.x - finalScale.x) * lifeFraction, initialScale.y - (initialScale.y - finalScale.y) * lifeFraction, initialScale.z - (initialScale.z - finalScale.z) * lifeFraction);
+		}
 	}
 
-	Update();
+	//Straight from the pool's arrays, no copies through the position and scale components
+	if (GetModelComponent())
+	{
+		GetModelComponent()->Update(scales, GetRotationComponent()->GetRotations(), positions, XMMatrixIdentity());
+	}
 }
 
-bool ParticleSystem::RenderParticles(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition) const
+bool ParticleSystem::RenderParticles(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition) const
 {
 	return Render(deviceContext, viewMatrix, projectionMatrix, {}, {}, cameraPosition);
 }
-
-
@@ -1,9 +1,13 @@
 #pragma once
 #include "GameObject.h"
+#include "ParticlePool.h"
 #include "ParticleShader.h"
 
 //GameObject contains all the components types we need for the particle system
 
+//Most emitter particles alive at once, the oldest is recycled past this
+const int MAX_EMITTER_PARTICLES = 256;
+
 class ParticleSystem : public GameObject
 {
 public:
@@ -19,12 +23,14 @@ public:
 	ParticleSystem& operator = (ParticleSystem&& other) noexcept;
 
 	void UpdateParticles(const float dt);
-	bool RenderParticles(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition) const;
+	bool RenderParticles(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition) const;
 
 private:
+	static int GetEmitterCapacity(const XMFLOAT3& initialScale, const XMFLOAT3& scaleReduction, const XMFLOAT3& killScale, const float spawnRate);
 
 	XMFLOAT3 initialPosition;
 	XMFLOAT3 initialScale;
+	XMFLOAT3 finalScale;
 	XMFLOAT3 scaleReduction;
 	XMFLOAT3 killScale;
 
@@ -38,5 +44,6 @@ private:
 
 	float particleSpread;
 
+	//Every slot is drawn, so the instance count never changes
+	ParticlePool particles;
 };
-
@@ -1,3 +1,5 @@
+#include "MeshVertex.hlsli"
+
 cbuffer MatrixBuffer : register(b0)
 {
 	matrix worldInverseMatrix;
@@ -26,8 +28,7 @@ cbuffer InverseViewBuffer : register(b3)
 //Type definitions
 struct VertexInput
 {
-	float3 position : POSITION;
-	float2 tex : TEXCOORD0;
+	MeshVertexInput vertex;
 	matrix instanceWorldMatrix : INSTANCEMATRIX;
 };
 
@@ -41,13 +42,14 @@ struct HullInput
 HullInput ParticleVertexShader(VertexInput input)
 {
 	HullInput output;
+	const MeshVertex vertex = DecodeMeshVertex(input.vertex);
 
-	output.position.xyz = (input.position.x * inverseView[0] + input.position.y * inverseView[1]).xyz;
+	output.position.xyz = (vertex.position.x * inverseView[0] + vertex.position.y * inverseView[1]).xyz;
 
 	output.position = mul(float4(output.position.xyz, 1.0f), input.instanceWorldMatrix).xyz;
 
 	//Pass colour as is to pixel shader
-	output.tex = input.tex;
+	output.tex = vertex.tex;
 
 	float distanceToCamera = distance(output.position, cameraPosition);
 
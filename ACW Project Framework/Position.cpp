@@ -61,6 +61,11 @@ void Position::RemovePositionBack()
 	positions.pop_back();
 }
 
+void Position::SetPositions(const vector<XMFLOAT3>& newPositions)
+{
+	positions = newPositions;
+}
+
 void Position::SetPositionAt(const XMFLOAT3& newPosition, const int index)
 {
 	positions[index] = newPosition;
@@ -31,6 +31,7 @@ public:
 
 	void RemovePositionBack();
 
+	void SetPositions(const vector<XMFLOAT3>& newPositions);
 	void SetPositionAt(const XMFLOAT3& newPosition, const int index);
 	void SetPositionAt(const float x, const float y, const float z, const int index);
 
@@ -0,0 +1,155 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+atomic<bool> Profiler::enabled(true);
+
+mutex Profiler::buffersLock;
+vector<unique_ptr<Profiler::ThreadBuffer>> Profiler::buffers;
+
+thread_local Profiler::ThreadBufferLease Profiler::threadBufferLease;
+
+//Everything is relative to the first time anything asks, so trace timestamps start near 0
+static chrono::steady_clock::time_point GetEpoch()
+{
+	static const auto epoch = chrono::steady_clock::now();
+
+	return epoch;
+}
+
+void Profiler::SetEnabled(const bool enabled)
+{
+	Profiler::enabled = enabled;
+}
+
+bool Profiler::IsEnabled()
+{
+	return enabled.load(memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(const string& name)
+{
+	auto& buffer = GetThreadBuffer();
+
+	lock_guard<mutex> lock(buffersLock);
+	buffer.threadName = name;
+}
+
+long long Profiler::GetTime()
+{
+	return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - GetEpoch()).count();
+}
+
+void Profiler::Record(const char* const name, const long long start, const long long end)
+{
+	auto& buffer = GetThreadBuffer();
+
+	//Only this thread writes the buffer, the release lets an exporter that reads written see the event
+	const auto written = buffer.written.load(memory_order_relaxed);
+
+	buffer.events[written % buffer.events.size()] = { name, start, end - start };
+	buffer.written.store(written + 1, memory_order_release);
+}
+
+void Profiler::WriteChromeTrace(ostream& output)
+{
+	lock_guard<mutex> lock(buffersLock);
+
+	output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	auto first = true;
+
+	for (const auto& buffer : buffers)
+	{
+		output << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":\"" << buffer->threadName << "\"}}";
+		first = false;
+
+		const auto written = buffer->written.load(memory_order_acquire);
+		const auto count = min<unsigned long long>(written, buffer->events.size());
+
+		for (auto i = written - count; i < written; i++)
+		{
+			const auto& event = buffer->events[i % buffer->events.size()];
+
+			//Complete events in microseconds
+			output << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId << fixed << setprecision(3) << ",\"ts\":" << event.start / 1000.0 << ",\"dur\":" << event.duration / 1000.0 << defaultfloat << "}";
+		}
+	}
+
+	output << "\n]}" << endl;
+}
+
+bool Profiler::ExportChromeTrace(const string& fileName)
+{
+	ofstream output(fileName);
+
+	if (!output)
+	{
+		return false;
+	}
+
+	WriteChromeTrace(output);
+
+	return static_cast<bool>(output);
+}
+
+Profiler::ThreadBufferLease::~ThreadBufferLease()
+{
+	if (buffer)
+	{
+		lock_guard<mutex> lock(buffersLock);
+		buffer->inUse = false;
+	}
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+{
+	if (threadBufferLease.buffer)
+	{
+		return *threadBufferLease.buffer;
+	}
+
+	lock_guard<mutex> lock(buffersLock);
+
+	//A thread that has exited leaves its buffer for the next one, so job systems that come and go don't keep adding them
+	ThreadBuffer* buffer = nullptr;
+
+	for (const auto& existingBuffer : buffers)
+	{
+		if (!existingBuffer->inUse)
+		{
+			buffer = existingBuffer.get();
+			break;
+		}
+	}
+
+	if (!buffer)
+	{
+		buffers.push_back(make_unique<ThreadBuffer>());
+		buffer = buffers.back().get();
+		buffer->threadId = static_cast<int>(buffers.size());
+		buffer->events.resize(PROFILER_EVENTS_PER_THREAD);
+	}
+
+	buffer->threadName = "Thread " + to_string(buffer->threadId);
+	buffer->inUse = true;
+	buffer->written = 0;
+
+	threadBufferLease.buffer = buffer;
+
+	return *buffer;
+}
+
+ProfileZone::ProfileZone(const char* const name) : name(name), start(Profiler::IsEnabled() ? Profiler::GetTime() : -1)
+{
+}
+
+ProfileZone::~ProfileZone()
+{
+	if (start >= 0)
+	{
+		Profiler::Record(name, start, Profiler::GetTime());
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+//Zones each thread keeps, older ones are overwritten. 24 bytes each
+const int PROFILER_EVENTS_PER_THREAD = 32768;
+
+//A zone that has closed, times are in nanoseconds since the profiler started
+struct ProfileEvent
+{
+	const char* name;
+	long long start;
+	long long duration;
+};
+
+//Records timed zones from any thread. Every thread writes to a buffer of its own so recording takes no locks,
+//the buffer is handed to the next thread that starts once its thread exits.
+//ExportChromeTrace writes what the buffers hold as Chrome trace JSON for chrome://tracing or ui.perfetto.dev
+class Profiler
+{
+public:
+	//Zones opened while disabled aren't recorded
+	static void SetEnabled(const bool enabled);
+	static bool IsEnabled();
+
+	//Names the calling thread in exported traces
+	static void SetThreadName(const string& name);
+
+	static long long GetTime();
+	static void Record(const char* const name, const long long start, const long long end);
+
+	//Call these between frames, zones recorded on other threads while exporting may come out torn
+	static void WriteChromeTrace(ostream& output);
+	static bool ExportChromeTrace(const string& fileName);
+
+private:
+	struct ThreadBuffer
+	{
+		int threadId;
+		string threadName;
+		bool inUse;
+
+		vector<ProfileEvent> events;
+		//Zones ever written, the newest is at (written - 1) % events.size()
+		atomic<unsigned long long> written;
+	};
+
+	//Gives the buffer back when its thread exits
+	struct ThreadBufferLease
+	{
+		ThreadBuffer* buffer = nullptr;
+
+		~ThreadBufferLease();
+	};
+
+	static ThreadBuffer& GetThreadBuffer();
+
+	static atomic<bool> enabled;
+
+	static mutex buffersLock;
+	static vector<unique_ptr<ThreadBuffer>> buffers;
+
+	static thread_local ThreadBufferLease threadBufferLease;
+};
+
+//Records the time between construction and destruction as a zone called name, name has to outlive the profiler
+class ProfileZone
+{
+public:
+	explicit ProfileZone(const char* const name);
+	ProfileZone(const ProfileZone& other) = delete; // Copy Constructor
+	ProfileZone(ProfileZone&& other) noexcept = delete; // Move Constructor
+	~ProfileZone(); // Destructor
+
+	ProfileZone& operator = (const ProfileZone& other) = delete; // Copy Assignment Operator
+	ProfileZone& operator = (ProfileZone&& other) noexcept = delete; // Move Assignment Operator
+
+private:
+	const char* name;
+	long long start;
+};
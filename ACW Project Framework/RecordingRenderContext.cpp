@@ -0,0 +1,446 @@
+#include "RecordingRenderContext.h"
+#include <cstdint>
+
+RecordingRenderContext::RecordingRenderContext(ID3D11Device* const device, const shared_ptr<RenderContext>& forwardContext) : device(device), forwardContext(forwardContext), commandLog(), statistics(), boundState(), scratchMemory()
+{
+	BeginFrame();
+}
+
+RecordingRenderContext::RecordingRenderContext(const RecordingRenderContext& other) = default;
+
+RecordingRenderContext::RecordingRenderContext(RecordingRenderContext&& other) noexcept = default;
+
+RecordingRenderContext::~RecordingRenderContext() = default;
+
+RecordingRenderContext& RecordingRenderContext::operator=(const RecordingRenderContext& other) = default;
+
+RecordingRenderContext& RecordingRenderContext::operator=(RecordingRenderContext&& other) noexcept = default;
+
+void RecordingRenderContext::BeginFrame()
+{
+	//Keep the capacity so recording a frame doesn't allocate once the log has grown
+	commandLog.clear();
+	statistics = RenderStatistics();
+
+	for (auto& state : boundState)
+	{
+		state = nullptr;
+	}
+}
+
+const vector<RenderCommand>& RecordingRenderContext::GetCommandLog() const
+{
+	return commandLog;
+}
+
+const RenderStatistics& RecordingRenderContext::GetStatistics() const
+{
+	return statistics;
+}
+
+const shared_ptr<RenderContext>& RecordingRenderContext::GetForwardContext() const
+{
+	return forwardContext;
+}
+
+void RecordingRenderContext::SetForwardContext(const shared_ptr<RenderContext>& context)
+{
+	forwardContext = context;
+}
+
+void RecordingRenderContext::GetDevice(ID3D11Device** outDevice)
+{
+	if (forwardContext)
+	{
+		forwardContext->GetDevice(outDevice);
+		return;
+	}
+
+	//Match ID3D11DeviceContext::GetDevice, the caller owns a reference
+	if (device)
+	{
+		device->AddRef();
+	}
+
+	*outDevice = device;
+}
+
+HRESULT RecordingRenderContext::Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags, D3D11_MAPPED_SUBRESOURCE* mappedResource)
+{
+	const auto byteWidth = GetResourceByteWidth(resource);
+
+	Record(RenderCommandType::Map, resource, subresource, byteWidth);
+
+	statistics.bufferMaps++;
+	statistics.bytesUploaded += byteWidth;
+
+	if (forwardContext)
+	{
+		return forwardContext->Map(resource, subresource, mapType, mapFlags, mappedResource);
+	}
+
+	if (!resource || byteWidth == 0)
+	{
+		return E_INVALIDARG;
+	}
+
+	auto& memory = scratchMemory[resource];
+
+	if (memory.size() < byteWidth)
+	{
+		memory.resize(byteWidth);
+	}
+
+	mappedResource->pData = memory.data();
+	mappedResource->RowPitch = byteWidth;
+	mappedResource->DepthPitch = byteWidth;
+
+	return S_OK;
+}
+
+void RecordingRenderContext::Unmap(ID3D11Resource* resource, UINT subresource)
+{
+	Record(RenderCommandType::Unmap, resource, subresource, 0);
+
+	if (forwardContext)
+	{
+		forwardContext->Unmap(resource, subresource);
+	}
+}
+
+void RecordingRenderContext::UpdateSubresource(ID3D11Resource* destinationResource, UINT destinationSubresource, const D3D11_BOX* destinationBox, const void* sourceData, UINT sourceRowPitch, UINT sourceDepthPitch)
+{
+	//Only buffers are updated this way, a box narrows it to a byte range
+	const auto byteCount = destinationBox ? destinationBox->right - destinationBox->left : GetResourceByteWidth(destinationResource);
+
+	Record(RenderCommandType::UpdateSubresource, destinationResource, destinationSubresource, byteCount);
+
+	statistics.bufferUpdates++;
+	statistics.bytesUploaded += byteCount;
+
+	if (forwardContext)
+	{
+		forwardContext->UpdateSubresource(destinationResource, destinationSubresource, destinationBox, sourceData, sourceRowPitch, sourceDepthPitch);
+	}
+}
+
+void RecordingRenderContext::IASetInputLayout(ID3D11InputLayout* inputLayout)
+{
+	RecordStateChange(RenderCommandType::SetInputLayout, InputLayoutState, inputLayout);
+
+	if (forwardContext)
+	{
+		forwardContext->IASetInputLayout(inputLayout);
+	}
+}
+
+void RecordingRenderContext::IASetVertexBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* vertexBuffers, const UINT* strides, const UINT* offsets)
+{
+	Record(RenderCommandType::SetVertexBuffers, numberOfBuffers > 0 ? vertexBuffers[0] : nullptr, numberOfBuffers, 0);
+	statistics.stateChanges++;
+
+	if (forwardContext)
+	{
+		forwardContext->IASetVertexBuffers(startSlot, numberOfBuffers, vertexBuffers, strides, offsets);
+	}
+}
+
+void RecordingRenderContext::IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset)
+{
+	Record(RenderCommandType::SetIndexBuffer, indexBuffer, 1, 0);
+	statistics.stateChanges++;
+
+	if (forwardContext)
+	{
+		forwardContext->IASetIndexBuffer(indexBuffer, format, offset);
+	}
+}
+
+void RecordingRenderContext::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology)
+{
+	RecordStateChange(RenderCommandType::SetPrimitiveTopology, TopologyState, reinterpret_cast<const void*>(static_cast<uintptr_t>(topology)));
+
+	if (forwardContext)
+	{
+		forwardContext->IASetPrimitiveTopology(topology);
+	}
+}
+
+void RecordingRenderContext::VSSetShader(ID3D11VertexShader* vertexShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances)
+{
+	RecordStateChange(RenderCommandType::SetShader, VertexShaderState, vertexShader);
+
+	if (forwardContext)
+	{
+		forwardContext->VSSetShader(vertexShader, classInstances, numberOfClassInstances);
+	}
+}
+
+void RecordingRenderContext::HSSetShader(ID3D11HullShader* hullShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances)
+{
+	RecordStateChange(RenderCommandType::SetShader, HullShaderState, hullShader);
+
+	if (forwardContext)
+	{
+		forwardContext->HSSetShader(hullShader, classInstances, numberOfClassInstances);
+	}
+}
+
+void RecordingRenderContext::DSSetShader(ID3D11DomainShader* domainShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances)
+{
+	RecordStateChange(RenderCommandType::SetShader, DomainShaderState, domainShader);
+
+	if (forwardContext)
+	{
+		forwardContext->DSSetShader(domainShader, classInstances, numberOfClassInstances);
+	}
+}
+
+void RecordingRenderContext::PSSetShader(ID3D11PixelShader* pixelShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances)
+{
+	RecordStateChange(RenderCommandType::SetShader, PixelShaderState, pixelShader);
+
+	if (forwardContext)
+	{
+		forwardContext->PSSetShader(pixelShader, classInstances, numberOfClassInstances);
+	}
+}
+
+void RecordingRenderContext::VSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers)
+{
+	Record(RenderCommandType::SetConstantBuffers, numberOfBuffers > 0 ? constantBuffers[0] : nullptr, numberOfBuffers, 0);
+	statistics.stateChanges++;
+
+	if (forwardContext)
+	{
+		forwardContext->VSSetConstantBuffers(startSlot, numberOfBuffers, constantBuffers);
+	}
+}
+
+void RecordingRenderContext::HSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers)
+{
+	Record(RenderCommandType::SetConstantBuffers, numberOfBuffers > 0 ? constantBuffers[0] : nullptr, numberOfBuffers, 0);
+	statistics.stateChanges++;
+
+	if (forwardContext)
+	{
+		forwardContext->HSSetConstantBuffers(startSlot, numberOfBuffers, constantBuffers);
+	}
+}
+
+void RecordingRenderContext::DSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers)
+{
+	Record(RenderCommandType::SetConstantBuffers, numberOfBuffers > 0 ? constantBuffers[0] : nullptr, numberOfBuffers, 0);
+	statistics.stateChanges++;
+
+	if (forwardContext)
+	{
+		forwardContext->DSSetConstantBuffers(startSlot, numberOfBuffers, constantBuffers);
+	}
+}
+
+void RecordingRenderContext::PSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers)
+{
+	Record(RenderCommandType::SetConstantBuffers, numberOfBuffers > 0 ? constantBuffers[0] : nullptr, numberOfBuffers, 0);
+	statistics.stateChanges++;
+
+	if (forwardContext)
+	{
+		forwardContext->PSSetConstantBuffers(startSlot, numberOfBuffers, constantBuffers);
+	}
+}
+
+void RecordingRenderContext::DSSetShaderResources(UINT startSlot, UINT numberOfViews, ID3D11ShaderResourceView* const* shaderResourceViews)
+{
+	Record(RenderCommandType::SetShaderResources, numberOfViews > 0 ? shaderResourceViews[0] : nullptr, numberOfViews, 0);
+	statistics.stateChanges++;
+
+	if (forwardContext)
+	{
+		forwardContext->DSSetShaderResources(startSlot, numberOfViews, shaderResourceViews);
+	}
+}
+
+void RecordingRenderContext::PSSetShaderResources(UINT startSlot, UINT numberOfViews, ID3D11ShaderResourceView* const* shaderResourceViews)
+{
+	Record(RenderCommandType::SetShaderResources, numberOfViews > 0 ? shaderResourceViews[0] : nullptr, numberOfViews, 0);
+	statistics.stateChanges++;
+
+	if (forwardContext)
+	{
+		forwardContext->PSSetShaderResources(startSlot, numberOfViews, shaderResourceViews);
+	}
+}
+
+void RecordingRenderContext::DSSetSamplers(UINT startSlot, UINT numberOfSamplers, ID3D11SamplerState* const* samplers)
+{
+	Record(RenderCommandType::SetSamplers, numberOfSamplers > 0 ? samplers[0] : nullptr, numberOfSamplers, 0);
+	statistics.stateChanges++;
+
+	if (forwardContext)
+	{
+		forwardContext->DSSetSamplers(startSlot, numberOfSamplers, samplers);
+	}
+}
+
+void RecordingRenderContext::PSSetSamplers(UINT startSlot, UINT numberOfSamplers, ID3D11SamplerState* const* samplers)
+{
+	Record(RenderCommandType::SetSamplers, numberOfSamplers > 0 ? samplers[0] : nullptr, numberOfSamplers, 0);
+	statistics.stateChanges++;
+
+	if (forwardContext)
+	{
+		forwardContext->PSSetSamplers(startSlot, numberOfSamplers, samplers);
+	}
+}
+
+void RecordingRenderContext::RSSetState(ID3D11RasterizerState* rasterizerState)
+{
+	RecordStateChange(RenderCommandType::SetRasterizerState, RasterizerState, rasterizerState);
+
+	if (forwardContext)
+	{
+		forwardContext->RSSetState(rasterizerState);
+	}
+}
+
+void RecordingRenderContext::RSSetViewports(UINT numberOfViewports, const D3D11_VIEWPORT* viewports)
+{
+	Record(RenderCommandType::SetViewports, viewports, numberOfViewports, 0);
+	statistics.stateChanges++;
+
+	if (forwardContext)
+	{
+		forwardContext->RSSetViewports(numberOfViewports, viewports);
+	}
+}
+
+void RecordingRenderContext::OMSetRenderTargets(UINT numberOfViews, ID3D11RenderTargetView* const* renderTargetViews, ID3D11DepthStencilView* depthStencilView)
+{
+	Record(RenderCommandType::SetRenderTargets, numberOfViews > 0 ? renderTargetViews[0] : nullptr, numberOfViews, 0);
+	statistics.stateChanges++;
+
+	if (forwardContext)
+	{
+		forwardContext->OMSetRenderTargets(numberOfViews, renderTargetViews, depthStencilView);
+	}
+}
+
+void RecordingRenderContext::OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilReference)
+{
+	RecordStateChange(RenderCommandType::SetDepthStencilState, DepthStencilState, depthStencilState);
+
+	if (forwardContext)
+	{
+		forwardContext->OMSetDepthStencilState(depthStencilState, stencilReference);
+	}
+}
+
+void RecordingRenderContext::OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask)
+{
+	RecordStateChange(RenderCommandType::SetBlendState, BlendState, blendState);
+
+	if (forwardContext)
+	{
+		forwardContext->OMSetBlendState(blendState, blendFactor, sampleMask);
+	}
+}
+
+void RecordingRenderContext::ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colorRGBA[4])
+{
+	Record(RenderCommandType::ClearRenderTarget, renderTargetView, 1, 0);
+
+	if (forwardContext)
+	{
+		forwardContext->ClearRenderTargetView(renderTargetView, colorRGBA);
+	}
+}
+
+void RecordingRenderContext::ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags, FLOAT depth, UINT8 stencil)
+{
+	Record(RenderCommandType::ClearDepthStencil, depthStencilView, 1, 0);
+
+	if (forwardContext)
+	{
+		forwardContext->ClearDepthStencilView(depthStencilView, clearFlags, depth, stencil);
+	}
+}
+
+void RecordingRenderContext::DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation)
+{
+	RecordDraw(indexCount, 1);
+
+	if (forwardContext)
+	{
+		forwardContext->DrawIndexed(indexCount, startIndexLocation, baseVertexLocation);
+	}
+}
+
+void RecordingRenderContext::DrawInstanced(UINT vertexCountPerInstance, UINT instanceCount, UINT startVertexLocation, UINT startInstanceLocation)
+{
+	RecordDraw(vertexCountPerInstance, instanceCount);
+
+	if (forwardContext)
+	{
+		forwardContext->DrawInstanced(vertexCountPerInstance, instanceCount, startVertexLocation, startInstanceLocation);
+	}
+}
+
+void RecordingRenderContext::DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount, UINT startIndexLocation, INT baseVertexLocation, UINT startInstanceLocation)
+{
+	RecordDraw(indexCountPerInstance, instanceCount);
+
+	if (forwardContext)
+	{
+		forwardContext->DrawIndexedInstanced(indexCountPerInstance, instanceCount, startIndexLocation, baseVertexLocation, startInstanceLocation);
+	}
+}
+
+void RecordingRenderContext::Record(const RenderCommandType type, const void* const object, const unsigned int count, const unsigned int size)
+{
+	commandLog.push_back({ type, object, count, size });
+	statistics.commands++;
+}
+
+void RecordingRenderContext::RecordStateChange(const RenderCommandType type, const BoundState state, const void* const object)
+{
+	Record(type, object, 1, 0);
+	statistics.stateChanges++;
+
+	if (boundState[state] == object)
+	{
+		statistics.redundantStateChanges++;
+	}
+
+	boundState[state] = object;
+}
+
+void RecordingRenderContext::RecordDraw(const unsigned int vertexCount, const unsigned int instanceCount)
+{
+	Record(RenderCommandType::Draw, nullptr, vertexCount, instanceCount);
+
+	statistics.drawCalls++;
+	statistics.verticesDrawn += static_cast<unsigned long long>(vertexCount) * instanceCount;
+	statistics.instancesDrawn += instanceCount;
+}
+
+unsigned int RecordingRenderContext::GetResourceByteWidth(ID3D11Resource* const resource)
+{
+	if (!resource)
+	{
+		return 0;
+	}
+
+	D3D11_RESOURCE_DIMENSION dimension;
+	resource->GetType(&dimension);
+
+	if (dimension != D3D11_RESOURCE_DIMENSION_BUFFER)
+	{
+		return 0;
+	}
+
+	D3D11_BUFFER_DESC bufferDescription;
+	static_cast<ID3D11Buffer*>(resource)->GetDesc(&bufferDescription);
+
+	return bufferDescription.ByteWidth;
+}
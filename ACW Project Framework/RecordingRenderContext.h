@@ -0,0 +1,155 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "RenderContext.h"
+
+using namespace std;
+
+enum class RenderCommandType
+{
+	Map,
+	Unmap,
+	UpdateSubresource,
+	SetInputLayout,
+	SetVertexBuffers,
+	SetIndexBuffer,
+	SetPrimitiveTopology,
+	SetShader,
+	SetConstantBuffers,
+	SetShaderResources,
+	SetSamplers,
+	SetRasterizerState,
+	SetViewports,
+	SetRenderTargets,
+	SetDepthStencilState,
+	SetBlendState,
+	ClearRenderTarget,
+	ClearDepthStencil,
+	Draw
+};
+
+struct RenderCommand
+{
+	RenderCommandType type;
+	//The resource, shader or state object the command was issued with, the first one for ranged binds
+	const void* object;
+	//Slot count for binds, vertex or index count for draws
+	unsigned int count;
+	//Instance count for draws, bytes for maps and updates
+	unsigned int size;
+};
+
+struct RenderStatistics
+{
+	unsigned int commands;
+	unsigned int drawCalls;
+	unsigned long long verticesDrawn;
+	unsigned long long instancesDrawn;
+	unsigned int bufferMaps;
+	unsigned int bufferUpdates;
+	unsigned long long bytesUploaded;
+	unsigned int stateChanges;
+	//State changes that bound the same object that was already bound
+	unsigned int redundantStateChanges;
+};
+
+//Records everything the render path submits into an in memory command log and keeps per frame counts.
+//With a forward context every command is also passed on, so a live frame can be measured; without one nothing reaches
+//the driver and Map hands back scratch memory, which isolates the CPU cost of building the frame
+class RecordingRenderContext : public RenderContext
+{
+public:
+	RecordingRenderContext(ID3D11Device* const device, const shared_ptr<RenderContext>& forwardContext);
+	RecordingRenderContext(const RecordingRenderContext& other); // Copy Constructor
+	RecordingRenderContext(RecordingRenderContext&& other) noexcept; // Move Constructor
+	~RecordingRenderContext() override;
+
+	RecordingRenderContext& operator = (const RecordingRenderContext& other); // Copy Assignment Operator
+	RecordingRenderContext& operator = (RecordingRenderContext&& other) noexcept; // Move Assignment Operator
+
+	//Clears the command log and the counts, call once at the start of every frame
+	void BeginFrame();
+
+	const vector<RenderCommand>& GetCommandLog() const;
+	const RenderStatistics& GetStatistics() const;
+
+	const shared_ptr<RenderContext>& GetForwardContext() const;
+	void SetForwardContext(const shared_ptr<RenderContext>& context);
+
+	void GetDevice(ID3D11Device** device) override;
+
+	HRESULT Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags, D3D11_MAPPED_SUBRESOURCE* mappedResource) override;
+	void Unmap(ID3D11Resource* resource, UINT subresource) override;
+	void UpdateSubresource(ID3D11Resource* destinationResource, UINT destinationSubresource, const D3D11_BOX* destinationBox, const void* sourceData, UINT sourceRowPitch, UINT sourceDepthPitch) override;
+
+	void IASetInputLayout(ID3D11InputLayout* inputLayout) override;
+	void IASetVertexBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* vertexBuffers, const UINT* strides, const UINT* offsets) override;
+	void IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset) override;
+	void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) override;
+
+	void VSSetShader(ID3D11VertexShader* vertexShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances) override;
+	void HSSetShader(ID3D11HullShader* hullShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances) override;
+	void DSSetShader(ID3D11DomainShader* domainShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances) override;
+	void PSSetShader(ID3D11PixelShader* pixelShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances) override;
+
+	void VSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers) override;
+	void HSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers) override;
+	void DSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers) override;
+	void PSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers) override;
+
+	void DSSetShaderResources(UINT startSlot, UINT numberOfViews, ID3D11ShaderResourceView* const* shaderResourceViews) override;
+	void PSSetShaderResources(UINT startSlot, UINT numberOfViews, ID3D11ShaderResourceView* const* shaderResourceViews) override;
+
+	void DSSetSamplers(UINT startSlot, UINT numberOfSamplers, ID3D11SamplerState* const* samplers) override;
+	void PSSetSamplers(UINT startSlot, UINT numberOfSamplers, ID3D11SamplerState* const* samplers) override;
+
+	void RSSetState(ID3D11RasterizerState* rasterizerState) override;
+	void RSSetViewports(UINT numberOfViewports, const D3D11_VIEWPORT* viewports) override;
+
+	void OMSetRenderTargets(UINT numberOfViews, ID3D11RenderTargetView* const* renderTargetViews, ID3D11DepthStencilView* depthStencilView) override;
+	void OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilReference) override;
+	void OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask) override;
+
+	void ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colorRGBA[4]) override;
+	void ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags, FLOAT depth, UINT8 stencil) override;
+
+	void DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation) override;
+	void DrawInstanced(UINT vertexCountPerInstance, UINT instanceCount, UINT startVertexLocation, UINT startInstanceLocation) override;
+	void DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount, UINT startIndexLocation, INT baseVertexLocation, UINT startInstanceLocation) override;
+
+private:
+	//Slots we track to spot redundant binds
+	enum BoundState
+	{
+		InputLayoutState,
+		TopologyState,
+		VertexShaderState,
+		HullShaderState,
+		DomainShaderState,
+		PixelShaderState,
+		RasterizerState,
+		DepthStencilState,
+		BlendState,
+		BoundStateCount
+	};
+
+	void Record(const RenderCommandType type, const void* const object, const unsigned int count, const unsigned int size);
+	void RecordStateChange(const RenderCommandType type, const BoundState state, const void* const object);
+	void RecordDraw(const unsigned int vertexCount, const unsigned int instanceCount);
+
+	static unsigned int GetResourceByteWidth(ID3D11Resource* const resource);
+
+	ID3D11Device* device;
+	shared_ptr<RenderContext> forwardContext;
+
+	vector<RenderCommand> commandLog;
+	RenderStatistics statistics;
+
+	const void* boundState[BoundStateCount];
+
+	//Backing memory handed out by Map when nothing is forwarded
+	unordered_map<ID3D11Resource*, vector<unsigned char>> scratchMemory;
+};
@@ -1,3 +1,5 @@
+#include "MeshVertex.hlsli"
+
 cbuffer MatrixBuffer : register(b0)
 {
 	matrix worldInverseMatrix;
@@ -21,9 +23,7 @@ cbuffer CameraBuffer : register(b2)
 //Type definitions
 struct VertexInput
 {
-	float3 position : POSITION;
-	float2 tex : TEXCOORD0;
-	float3 normal : NORMAL;
+	MeshVertexInput vertex;
 	matrix instanceWorldMatrix : INSTANCEMATRIX;
 };
 
@@ -38,12 +38,13 @@ struct HullInput
 HullInput ReflectionVertexShader(VertexInput input)
 {
 	HullInput output;
+	const MeshVertex vertex = DecodeMeshVertex(input.vertex);
 
-	output.posWorld = input.position;
+	output.posWorld = vertex.position;
 
-	output.position = mul(float4(input.position, 1.0f), input.instanceWorldMatrix).xyz;
+	output.position = mul(float4(vertex.position, 1.0f), input.instanceWorldMatrix).xyz;
 
-	output.normal = mul(float4(input.normal, 1.0f), input.instanceWorldMatrix).xyz;
+	output.normal = mul(float4(vertex.normal, 1.0f), input.instanceWorldMatrix).xyz;
 
 	float distanceToCamera = distance(output.position, cameraPosition);
 
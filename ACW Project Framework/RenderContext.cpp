@@ -0,0 +1,13 @@
+#include "RenderContext.h"
+
+RenderContext::RenderContext() = default;
+
+RenderContext::RenderContext(const RenderContext& other) = default;
+
+RenderContext::RenderContext(RenderContext&& other) noexcept = default;
+
+RenderContext::~RenderContext() = default;
+
+RenderContext& RenderContext::operator=(const RenderContext& other) = default;
+
+RenderContext& RenderContext::operator=(RenderContext&& other) noexcept = default;
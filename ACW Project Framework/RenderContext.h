@@ -0,0 +1,58 @@
+#pragma once
+
+#include <d3d11.h>
+
+//The subset of ID3D11DeviceContext the render path submits through. Shaders, models and game objects only ever talk to this,
+//so the backend can be the real device context or a recording one that counts and logs what would have been submitted
+class RenderContext
+{
+public:
+	RenderContext(); // Default Constructor
+	RenderContext(const RenderContext& other); // Copy Constructor
+	RenderContext(RenderContext&& other) noexcept; // Move Constructor
+	virtual ~RenderContext();
+
+	RenderContext& operator = (const RenderContext& other); // Copy Assignment Operator
+	RenderContext& operator = (RenderContext&& other) noexcept; // Move Assignment Operator
+
+	virtual void GetDevice(ID3D11Device** device) = 0;
+
+	virtual HRESULT Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags, D3D11_MAPPED_SUBRESOURCE* mappedResource) = 0;
+	virtual void Unmap(ID3D11Resource* resource, UINT subresource) = 0;
+	virtual void UpdateSubresource(ID3D11Resource* destinationResource, UINT destinationSubresource, const D3D11_BOX* destinationBox, const void* sourceData, UINT sourceRowPitch, UINT sourceDepthPitch) = 0;
+
+	virtual void IASetInputLayout(ID3D11InputLayout* inputLayout) = 0;
+	virtual void IASetVertexBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* vertexBuffers, const UINT* strides, const UINT* offsets) = 0;
+	virtual void IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset) = 0;
+	virtual void IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) = 0;
+
+	virtual void VSSetShader(ID3D11VertexShader* vertexShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances) = 0;
+	virtual void HSSetShader(ID3D11HullShader* hullShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances) = 0;
+	virtual void DSSetShader(ID3D11DomainShader* domainShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances) = 0;
+	virtual void PSSetShader(ID3D11PixelShader* pixelShader, ID3D11ClassInstance* const* classInstances, UINT numberOfClassInstances) = 0;
+
+	virtual void VSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers) = 0;
+	virtual void HSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers) = 0;
+	virtual void DSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers) = 0;
+	virtual void PSSetConstantBuffers(UINT startSlot, UINT numberOfBuffers, ID3D11Buffer* const* constantBuffers) = 0;
+
+	virtual void DSSetShaderResources(UINT startSlot, UINT numberOfViews, ID3D11ShaderResourceView* const* shaderResourceViews) = 0;
+	virtual void PSSetShaderResources(UINT startSlot, UINT numberOfViews, ID3D11ShaderResourceView* const* shaderResourceViews) = 0;
+
+	virtual void DSSetSamplers(UINT startSlot, UINT numberOfSamplers, ID3D11SamplerState* const* samplers) = 0;
+	virtual void PSSetSamplers(UINT startSlot, UINT numberOfSamplers, ID3D11SamplerState* const* samplers) = 0;
+
+	virtual void RSSetState(ID3D11RasterizerState* rasterizerState) = 0;
+	virtual void RSSetViewports(UINT numberOfViewports, const D3D11_VIEWPORT* viewports) = 0;
+
+	virtual void OMSetRenderTargets(UINT numberOfViews, ID3D11RenderTargetView* const* renderTargetViews, ID3D11DepthStencilView* depthStencilView) = 0;
+	virtual void OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilReference) = 0;
+	virtual void OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask) = 0;
+
+	virtual void ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colorRGBA[4]) = 0;
+	virtual void ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags, FLOAT depth, UINT8 stencil) = 0;
+
+	virtual void DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation) = 0;
+	virtual void DrawInstanced(UINT vertexCountPerInstance, UINT instanceCount, UINT startVertexLocation, UINT startInstanceLocation) = 0;
+	virtual void DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount, UINT startIndexLocation, INT baseVertexLocation, UINT startInstanceLocation) = 0;
+};
@@ -0,0 +1,132 @@
+#include "ResourceIdTable.h"
+
+ResourceIdTable::ResourceIdTable() : slots(RESOURCE_TABLE_INITIAL_CAPACITY, { 0, INVALID_RESOURCE_INDEX }), names(), foldedNames()
+{
+}
+
+ResourceIdTable::ResourceIdTable(const ResourceIdTable& other) = default;
+
+ResourceIdTable::ResourceIdTable(ResourceIdTable&& other) noexcept = default;
+
+ResourceIdTable::~ResourceIdTable() = default;
+
+ResourceIdTable& ResourceIdTable::operator=(const ResourceIdTable& other) = default;
+
+ResourceIdTable& ResourceIdTable::operator=(ResourceIdTable&& other) noexcept = default;
+
+uint32_t ResourceIdTable::Intern(const wstring& name)
+{
+	auto foldedName = FoldName(name);
+	const auto hash = Hash(foldedName);
+	auto slot = FindSlot(foldedName, hash);
+
+	if (slots[slot].index != INVALID_RESOURCE_INDEX)
+	{
+		return slots[slot].index;
+	}
+
+	const auto index = static_cast<uint32_t>(names.size());
+
+	names.push_back(name);
+	foldedNames.push_back(move(foldedName));
+
+	//Growing rehashes everything so the empty slot found before has probably moved
+	if ((names.size() + 1) * 4 > slots.size() * 3)
+	{
+		Grow();
+		slot = FindSlot(foldedNames.back(), hash);
+	}
+
+	slots[slot] = { hash, index };
+
+	return index;
+}
+
+uint32_t ResourceIdTable::Find(const wstring& name) const
+{
+	const auto foldedName = FoldName(name);
+	return slots[FindSlot(foldedName, Hash(foldedName))].index;
+}
+
+const wstring& ResourceIdTable::GetName(const uint32_t index) const
+{
+	return names[index];
+}
+
+int ResourceIdTable::GetCount() const
+{
+	return static_cast<int>(names.size());
+}
+
+uint64_t ResourceIdTable::Hash(const wstring& foldedName)
+{
+	auto hash = 14695981039346656037ull;
+
+	for (const auto character : foldedName)
+	{
+		hash = (hash ^ static_cast<uint64_t>(character)) * 1099511628211ull;
+	}
+
+	return hash;
+}
+
+wstring ResourceIdTable::FoldName(const wstring& name)
+{
+	auto foldedName = name;
+
+	for (auto& character : foldedName)
+	{
+		if (character >= L'A' && character <= L'Z')
+		{
+			character = character - L'A' + L'a';
+		}
+		else if (character == L'\\')
+		{
+			character = L'/';
+		}
+	}
+
+	return foldedName;
+}
+
+size_t ResourceIdTable::FindSlot(const wstring& foldedName, const uint64_t hash) const
+{
+	//The capacity is always a power of two
+	const auto mask = slots.size() - 1;
+
+	for (auto slot = static_cast<size_t>(hash) & mask;; slot = (slot + 1) & mask)
+	{
+		const auto& entry = slots[slot];
+
+		if (entry.index == INVALID_RESOURCE_INDEX || (entry.hash == hash && foldedNames[entry.index] == foldedName))
+		{
+			return slot;
+		}
+	}
+}
+
+void ResourceIdTable::Grow()
+{
+	const auto oldSlots = move(slots);
+
+	slots.assign(oldSlots.size() * 2, { 0, INVALID_RESOURCE_INDEX });
+
+	const auto mask = slots.size() - 1;
+
+	for (const auto& entry : oldSlots)
+	{
+		if (entry.index == INVALID_RESOURCE_INDEX)
+		{
+			continue;
+		}
+
+		auto slot = static_cast<size_t>(entry.hash) & mask;
+
+		while (slots[slot].index != INVALID_RESOURCE_INDEX)
+		{
+			slot = (slot + 1) & mask;
+		}
+
+		slots[slot] = entry;
+	}
+}
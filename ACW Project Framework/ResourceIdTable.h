@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+//Index of a name the table doesn't hold, and of a handle that was never given one
+const uint32_t INVALID_RESOURCE_INDEX = 0xFFFFFFFF;
+
+//Slots the table starts with, it doubles whenever more than three quarters are in use
+const int RESOURCE_TABLE_INITIAL_CAPACITY = 16;
+
+//Interns resource names into dense indices, the first name added is 0, the next 1 and so on, so the resources
+//themselves can live in plain vectors. Names are hashed by their contents after folding case and turning
+//backslashes into forward slashes, the way Windows treats file names, so every spelling of a file gets the same index.
+//The hashes live in one flat array with linear probing and only the name of a slot whose hash matches is compared
+class ResourceIdTable
+{
+public:
+	ResourceIdTable();
+	ResourceIdTable(const ResourceIdTable& other); // Copy Constructor
+	ResourceIdTable(ResourceIdTable&& other) noexcept; // Move Constructor
+	~ResourceIdTable(); // Destructor
+
+	ResourceIdTable& operator = (const ResourceIdTable& other); // Copy Assignment Operator
+	ResourceIdTable& operator = (ResourceIdTable&& other) noexcept; // Move Assignment Operator
+
+	//The name's index, added if the table doesn't hold it yet
+	uint32_t Intern(const wstring& name);
+	//INVALID_RESOURCE_INDEX if the table doesn't hold the name
+	uint32_t Find(const wstring& name) const;
+
+	//The name as it was first interned
+	const wstring& GetName(const uint32_t index) const;
+	int GetCount() const;
+
+	//FNV-1a over the folded name's characters
+	static uint64_t Hash(const wstring& foldedName);
+	static wstring FoldName(const wstring& name);
+
+private:
+	struct Slot
+	{
+		uint64_t hash;
+		uint32_t index;
+	};
+
+	//The slot holding the name, or the empty slot it would go in
+	size_t FindSlot(const wstring& foldedName, const uint64_t hash) const;
+	void Grow();
+
+	vector<Slot> slots;
+	vector<wstring> names;
+	vector<wstring> foldedNames;
+};
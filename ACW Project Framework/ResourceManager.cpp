@@ -1,193 +1,398 @@
 #include "ResourceManager.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "ObjParser.h"
+#include "Profiler.h"
+#include "TangentGenerator.h"
+#include "VertexCompressor.h"
+#include <algorithm>
+#include <cfloat>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <sstream>
 
-ResourceManager::ResourceManager(){}
+JobSystem* ResourceManager::jobSystem = nullptr;
+
+ResourceManager::ResourceManager() : ResourceManager(MeshVertexFormat::Full) {}
+
+ResourceManager::ResourceManager(const MeshVertexFormat vertexFormat) : vertexFormat(vertexFormat), meshIds(), textureIds(), meshes(), textures(), pendingMeshes(), pendingTextures(), pendingLoads() {}
 
 ResourceManager::ResourceManager(const ResourceManager& other) = default;
 
 ResourceManager::~ResourceManager() {
-	auto releaseResources = [](auto& resources) {
-		for (auto& resource : resources) {
-			if (resource.second) {
-				resource.second->Release();
-				resource.second = nullptr;
-			}
+	//Reads still running would write into assets nothing is waiting for
+	if (jobSystem) {
+		jobSystem->Wait(pendingLoads);
+	}
+
+	auto releaseResource = [](auto*& resource) {
+		if (resource) {
+			resource->Release();
+			resource = nullptr;
 		}
 	};
-	releaseResources(textures);
-	releaseResources(indexBuffers);
-	releaseResources(vertexBuffers);
+	for (auto& texture : textures) {
+		releaseResource(texture.texture);
+	}
+	for (auto& mesh : meshes) {
+		releaseResource(mesh.indexBuffer);
+		releaseResource(mesh.vertexBuffer);
+	}
 }
 
 ResourceManager& ResourceManager::operator=(const ResourceManager& other) = default;
 
 ResourceManager& ResourceManager::operator=(ResourceManager&& other) noexcept = default;
 
-bool ResourceManager::GetModel(ID3D11Device* const device, const char* const modelFileName, ID3D11Buffer*& vertexBuffer, ID3D11Buffer*& indexBuffer) {
-	if (vertexBuffers.count(modelFileName) == 0 && !LoadModel(device, modelFileName)) return false;
-	vertexBuffer = vertexBuffers[modelFileName];
-	indexBuffer = indexBuffers[modelFileName];
+MeshHandle ResourceManager::GetMeshHandle(const char* const modelFileName) {
+	const auto index = meshIds.Intern(wstring(modelFileName, modelFileName + strlen(modelFileName)));
+	if (index == meshes.size()) {
+		meshes.emplace_back();
+		meshes.back().fileName = modelFileName;
+	}
+	return { index };
+}
+
+TextureHandle ResourceManager::GetTextureHandle(const WCHAR* const textureFileName) {
+	const auto index = textureIds.Intern(textureFileName);
+	if (index == textures.size()) {
+		textures.emplace_back();
+	}
+	return { index };
+}
+
+bool ResourceManager::GetModel(ID3D11Device* const device, const MeshHandle mesh, ID3D11Buffer*& vertexBuffer, ID3D11Buffer*& indexBuffer) {
+	if (mesh.index >= meshes.size()) return false;
+	if (meshes[mesh.index].pending) FinishLoads(device);
+	if (!meshes[mesh.index].vertexBuffer && !LoadModel(device, mesh.index)) return false;
+	vertexBuffer = meshes[mesh.index].vertexBuffer;
+	indexBuffer = meshes[mesh.index].indexBuffer;
 	return true;
 }
 
-bool ResourceManager::GetTexture(ID3D11Device* const device, const WCHAR* const textureFileName, ID3D11ShaderResourceView*& texture) {
-	if (textures.count(textureFileName) == 0 && !LoadTexture(device, textureFileName)) {
+bool ResourceManager::GetModel(ID3D11Device* const device, const char* const modelFileName, ID3D11Buffer*& vertexBuffer, ID3D11Buffer*& indexBuffer) {
+	return GetModel(device, GetMeshHandle(modelFileName), vertexBuffer, indexBuffer);
+}
+
+bool ResourceManager::GetTexture(ID3D11Device* const device, const TextureHandle textureHandle, ID3D11ShaderResourceView*& texture) {
+	if (textureHandle.index >= textures.size()) {
 		return false;
 	}
-	texture = textures[textureFileName];
+	if (textures[textureHandle.index].pending) {
+		FinishLoads(device);
+	}
+	if (!textures[textureHandle.index].texture && !LoadTexture(device, textureHandle.index)) {
+		return false;
+	}
+	texture = textures[textureHandle.index].texture;
     return true;
 }
 
+bool ResourceManager::GetTexture(ID3D11Device* const device, const WCHAR* const textureFileName, ID3D11ShaderResourceView*& texture) {
+	return GetTexture(device, GetTextureHandle(textureFileName), texture);
+}
+
+JobHandle ResourceManager::LoadModelAsync(const char* const modelFileName) {
+	const auto index = GetMeshHandle(modelFileName).index;
+	auto& mesh = meshes[index];
+
+	if (mesh.vertexBuffer || mesh.pending) {
+		return nullptr;
+	}
+
+	auto model = make_shared<ModelData>();
+	mesh.pending = model;
+	pendingMeshes.push_back(index);
+
+	//The job keeps its own copy of the name, meshes can grow while it runs
+	auto read = [this, fileName = mesh.fileName, model]() {
+		model->loaded = ReadModel(fileName.c_str(), *model);
+	};
+
+	if (!jobSystem) {
+		read();
+		return nullptr;
+	}
+
+	pendingLoads.push_back(jobSystem->Add(read));
+	return pendingLoads.back();
+}
+
+JobHandle ResourceManager::LoadTextureAsync(const WCHAR* const textureFileName) {
+	const auto index = GetTextureHandle(textureFileName).index;
+	auto& textureResource = textures[index];
+
+	if (textureResource.texture || textureResource.pending) {
+		return nullptr;
+	}
+
+	auto texture = make_shared<TextureData>();
+	textureResource.pending = texture;
+	pendingTextures.push_back(index);
+
+	auto read = [fileName = textureIds.GetName(index), texture]() {
+		texture->loaded = ReadTexture(fileName.c_str(), texture->data);
+	};
+
+	if (!jobSystem) {
+		read();
+		return nullptr;
+	}
+
+	pendingLoads.push_back(jobSystem->Add(read));
+	return pendingLoads.back();
+}
+
+bool ResourceManager::FinishLoads(ID3D11Device* const device) {
+	const ProfileZone zone("ResourceManager::FinishLoads");
+
+	//This thread reads files too while it waits
+	if (jobSystem) {
+		jobSystem->Wait(pendingLoads);
+	}
+
+	pendingLoads.clear();
+
+	//Failed loads aren't kept, GetModel and GetTexture try them again and report why
+	auto result = true;
+
+	for (const auto mesh : pendingMeshes) {
+		const auto model = move(meshes[mesh].pending);
+		result = model->loaded && CreateModel(device, mesh, *model) && result;
+	}
+
+	for (const auto texture : pendingTextures) {
+		const auto textureData = move(textures[texture].pending);
+		result = textureData->loaded && CreateTexture(device, texture, textureData->data) && result;
+	}
+
+	pendingMeshes.clear();
+	pendingTextures.clear();
+
+	return result;
+}
+
+MeshVertexFormat ResourceManager::GetVertexFormat() const {
+	return vertexFormat;
+}
+
 int ResourceManager::GetSizeOfVertexType() const {
-	return sizeof(VertexType);
+	return VertexCompressor::GetVertexSize(vertexFormat);
+}
+
+int ResourceManager::GetIndexCount(const MeshHandle mesh) const {
+	return meshes.at(mesh.index).indexCount;
+}
+
+const MeshStatistics& ResourceManager::GetMeshStatistics(const MeshHandle mesh) const {
+	return meshes.at(mesh.index).statistics;
+}
+
+const MeshBounds& ResourceManager::GetMeshBounds(const MeshHandle mesh) const {
+	return meshes.at(mesh.index).bounds;
+}
+
+const vector<MeshLevelOfDetail>& ResourceManager::GetLevelsOfDetail(const MeshHandle mesh) const {
+	return meshes.at(mesh.index).levelsOfDetail;
 }
 
-int ResourceManager::GetIndexCount(const char* const modelFileName) const {
-	return indexCount.at(modelFileName);
+void ResourceManager::SetJobSystem(JobSystem* const jobSystem) {
+	ResourceManager::jobSystem = jobSystem;
 }
 
-bool ResourceManager::LoadModel(ID3D11Device* const device, const char* const modelFileName)
+bool ResourceManager::LoadModel(ID3D11Device* const device, const uint32_t mesh)
 {
-	ifstream fin;
-	fin.open(modelFileName);
-
-	vector<XMFLOAT3> positions;
-	vector<XMFLOAT2> textures;
-	vector<XMFLOAT3> normals;
-	char cmd[256] = { 0 };
-	auto faceCount = 0, vertexCount = 0, indCount = 0;
-	VertexType* vertices = nullptr;
-	unsigned long* indices = nullptr;
-
-	while (!fin.eof())
+	const auto* const modelFileName = meshes[mesh].fileName.c_str();
+	ModelData model;
+
+	if (!ReadModel(modelFileName, model))
 	{
-		float x, y, z;
-		fin >> cmd;
-		if (0 == strcmp(cmd, "faces"))
-		{
-			fin >> faceCount;
-			vertices = new VertexType[faceCount * 3];
-			vertexCount = faceCount * 3;
-			indices = new unsigned long[faceCount * 3];
-			indCount = faceCount * 3;
-		}
-		if (0 == strcmp(cmd, "v"))
-		{
-			fin >> x >> y >> z;
-			positions.emplace_back(XMFLOAT3(x, y, z));
-		}
-		else if (0 == strcmp(cmd, "vn"))
-		{
-			fin >> x >> y >> z;
-			normals.emplace_back(XMFLOAT3(x, y, z));
-		}
-		else if (0 == strcmp(cmd, "vt"))
-		{
-			fin >> x >> y >> z;
-			textures.emplace_back(XMFLOAT2(x, y));
-		}
-		else if (0 == strcmp(cmd, "f"))
-		{
-			int value;
-			auto count = 0;
-			while (0 == strcmp(cmd, "f"))
-			{
-				VertexType* tempVertexFace[3];
-				for (auto i = 0; i < 3; i++)
-				{
-					fin >> value;
-					vertices[count].position = positions[value - 1];
-					fin.ignore();
-					fin >> value;
-					vertices[count].texture = textures[value - 1];
-					fin.ignore();
-					fin >> value;
-					vertices[count].normal = normals[value - 1];
-					fin.ignore();
-					indices[count] = count;
-					tempVertexFace[i] = &vertices[count];
-					count++;
-				}
-
-				CalculateTangentBinormal(tempVertexFace);
-				fin >> cmd;
-			}
-		}
+		MessageBox(nullptr, model.error.c_str(), modelFileName, MB_OK);
+		return false;
 	}
 
+	return CreateModel(device, mesh, model);
+}
 
-	ID3D11Buffer* vertexBuffer = nullptr;
-	ID3D11Buffer* indexBuffer = nullptr;
-	if (!CreateBuffers(device, vertices, indices, vertexCount, indCount, &vertexBuffer, &indexBuffer)) {
-		delete[] vertices;
-		delete[] indices;
+bool ResourceManager::ReadModel(const char* const modelFileName, ModelData& model) const
+{
+	const ProfileZone zone("ResourceManager::ReadModel");
+
+	const auto cacheFileName = MeshCache::GetCacheFileName(modelFileName);
+	uint64_t sourceHash = 0;
+
+	if (!MeshCache::HashFile(modelFileName, sourceHash))
+	{
+		model.error = "Could not open the model file";
 		return false;
 	}
 
-	indexCount[modelFileName] = indCount;
-	vertexBuffers[modelFileName] = vertexBuffer;
-	indexBuffers[modelFileName] = indexBuffer;
+	if (ReadCachedModel(cacheFileName, sourceHash, model))
+	{
+		return true;
+	}
+
+	ObjMesh mesh;
+	string error;
+
+	if (!ObjParser::ParseFile(modelFileName, mesh, error) || mesh.corners.empty())
+	{
+		model.error = error.empty() ? "The model has no faces" : error;
+		return false;
+	}
+
+	const auto sourceVertexCount = static_cast<int>(mesh.corners.size());
+	vector<VertexType> vertices(sourceVertexCount);
+	auto& indices = model.indexData;
+	indices.resize(sourceVertexCount);
+
+	for (auto count = 0; count < sourceVertexCount; count++)
+	{
+		const auto& corner = mesh.corners[count];
+		vertices[count].position = mesh.positions[corner.position];
+		vertices[count].texture = corner.texture >= 0 ? mesh.textures[corner.texture] : XMFLOAT2(0.0f, 0.0f);
+		vertices[count].normal = corner.normal >= 0 ? mesh.normals[corner.normal] : XMFLOAT3(0.0f, 0.0f, 0.0f);
+		vertices[count].tangent = XMFLOAT3(0.0f, 0.0f, 0.0f);
+		vertices[count].binormal = XMFLOAT3(0.0f, 0.0f, 0.0f);
+		indices[count] = count;
+	}
+
+	//Faces that share a vertex share one copy of it, drawn in an order that reuses it from the post transform cache.
+	//Welding comes first so the tangents are smoothed over every face the vertex is part of
+	auto vertexCount = MeshOptimizer::WeldVertices(vertices.data(), sourceVertexCount, sizeof(VertexType), indices);
+	TangentGenerator::Generate(vertices.data(), vertexCount, indices, jobSystem);
+	const auto unoptimizedAcmr = MeshOptimizer::GetAcmr(indices, vertexCount, VERTEX_CACHE_MEASURE_SIZE);
+	MeshOptimizer::OptimizeVertexCache(indices, vertexCount);
+	vertexCount = MeshOptimizer::OptimizeVertexFetch(vertices.data(), vertexCount, sizeof(VertexType), indices);
+	vertices.resize(vertexCount);
+	const auto acmr = MeshOptimizer::GetAcmr(indices, vertexCount, VERTEX_CACHE_MEASURE_SIZE);
+
+	//The simplified levels go after the mesh's own indices and reuse its vertices
+	MeshSimplifier::GenerateLevelsOfDetail(vertices.data(), vertexCount, indices, model.levelsOfDetail);
+
+	auto& bounds = model.bounds;
+	bounds = { { FLT_MAX, FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+
+	for (const auto& position : mesh.positions)
+	{
+		bounds.minimum[0] = min(bounds.minimum[0], position.x);
+		bounds.minimum[1] = min(bounds.minimum[1], position.y);
+		bounds.minimum[2] = min(bounds.minimum[2], position.z);
+		bounds.maximum[0] = max(bounds.maximum[0], position.x);
+		bounds.maximum[1] = max(bounds.maximum[1], position.y);
+		bounds.maximum[2] = max(bounds.maximum[2], position.z);
+	}
+
+	//Full vertices go to the buffers as they are
+	if (vertexFormat != MeshVertexFormat::Full)
+	{
+		VertexCompressor::Compress(vertices.data(), vertexCount, vertexFormat, bounds.minimum, bounds.maximum, model.vertexData);
+	}
+	else
+	{
+		const auto* const vertexBytes = reinterpret_cast<const unsigned char*>(vertices.data());
+		model.vertexData.assign(vertexBytes, vertexBytes + vertices.size() * sizeof(VertexType));
+	}
+
+	model.vertices = model.vertexData.data();
+	model.indices = indices.data();
+	model.vertexCount = vertexCount;
+	model.indexCount = static_cast<int>(indices.size());
+	model.statistics = { sourceVertexCount, vertexCount, static_cast<int>(model.levelsOfDetail[0].indexCount / 3), unoptimizedAcmr, acmr, GetTriangleCounts(model.levelsOfDetail) };
 
-	delete[] vertices;
-	delete[] indices;
+	//A model in a read only folder just isn't cached, it still loads
+	MeshCache::Write(cacheFileName, sourceHash, GetVertexLayout(vertexFormat), model.vertices, vertexCount, model.indices, model.indexCount, model.levelsOfDetail.data(), static_cast<uint32_t>(model.levelsOfDetail.size()), bounds.minimum, bounds.maximum, sourceVertexCount, unoptimizedAcmr, acmr);
 
 	return true;
 }
 
-void ResourceManager::CalculateTangentBinormal(VertexType* tempVertexFace[3]) {
-	auto subtract3 = [](const XMFLOAT3& a, const XMFLOAT3& b) -> XMFLOAT3 {return { a.x - b.x, a.y - b.y, a.z - b.z };};
-	auto subtract2 = [](const XMFLOAT2& a, const XMFLOAT2& b) -> XMFLOAT2 {return { a.x - b.x, a.y - b.y };};
+bool ResourceManager::ReadCachedModel(const string& cacheFileName, const uint64_t sourceHash, ModelData& model) const
+{
+	auto cache = make_shared<MeshCache>();
 
-	XMFLOAT3 edge1 = subtract3(tempVertexFace[1]->position, tempVertexFace[0]->position);
-	XMFLOAT3 edge2 = subtract3(tempVertexFace[2]->position, tempVertexFace[0]->position);
-	XMFLOAT2 deltaUV1 = subtract2(tempVertexFace[1]->texture, tempVertexFace[0]->texture);
-	XMFLOAT2 deltaUV2 = subtract2(tempVertexFace[2]->texture, tempVertexFace[0]->texture);
+	if (!cache->Open(cacheFileName, sourceHash, GetVertexLayout(vertexFormat)))
+	{
+		return false;
+	}
 
-	float det = deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y;
-	float invDet = 1.0f / (det == 0.0f ? 1.0f : det);  
+	model.levelsOfDetail.assign(cache->GetLevelsOfDetail(), cache->GetLevelsOfDetail() + cache->GetLevelOfDetailCount());
 
-	XMFLOAT3 tangent = {
-		invDet * (deltaUV2.y * edge1.x - deltaUV1.y * edge2.x),
-		invDet * (deltaUV2.y * edge1.y - deltaUV1.y * edge2.y),
-		invDet * (deltaUV2.y * edge1.z - deltaUV1.y * edge2.z),
-	};
-	XMFLOAT3 binormal = {
-		invDet * (deltaUV1.x * edge2.x - deltaUV2.x * edge1.x),
-		invDet * (deltaUV1.x * edge2.y - deltaUV2.x * edge1.y),
-		invDet * (deltaUV1.x * edge2.z - deltaUV2.x * edge1.z),
-	};
+	const auto indCount = static_cast<int>(model.levelsOfDetail[0].indexCount);
+	const auto vertexCount = static_cast<int>(cache->GetVertexCount());
 
-	NormalizeVector(tangent);
-	NormalizeVector(binormal);
+	//The mapped blobs go straight to the buffers, the cache stays open until they are created
+	model.cache = cache;
+	model.vertices = cache->GetVertices();
+	model.indices = cache->GetIndices();
+	model.vertexCount = vertexCount;
+	model.indexCount = static_cast<int>(cache->GetIndexCount());
+	model.statistics = { static_cast<int>(cache->GetSourceVertexCount()), vertexCount, indCount / 3, cache->GetUnoptimizedAcmr(), cache->GetAcmr(), GetTriangleCounts(model.levelsOfDetail) };
+	model.bounds = { { cache->GetBoundsMin()[0], cache->GetBoundsMin()[1], cache->GetBoundsMin()[2] }, { cache->GetBoundsMax()[0], cache->GetBoundsMax()[1], cache->GetBoundsMax()[2] } };
 
-	XMFLOAT3 normal = CrossProduct(tangent, binormal);
-	NormalizeVector(normal);
+	return true;
+}
 
-	for (int i = 0; i < 3; ++i) {
-		tempVertexFace[i]->tangent = tangent;
-		tempVertexFace[i]->binormal = binormal;
-		tempVertexFace[i]->normal = normal;
+bool ResourceManager::CreateModel(ID3D11Device* const device, const uint32_t mesh, const ModelData& model)
+{
+	ID3D11Buffer* vertexBuffer = nullptr;
+	ID3D11Buffer* indexBuffer = nullptr;
+	if (!CreateBuffers(device, model.vertices, model.indices, model.vertexCount, model.indexCount, &vertexBuffer, &indexBuffer)) {
+		return false;
 	}
+
+	auto& resource = meshes[mesh];
+	resource.indexCount = static_cast<int>(model.levelsOfDetail[0].indexCount);
+	resource.statistics = model.statistics;
+	resource.levelsOfDetail = model.levelsOfDetail;
+	resource.bounds = model.bounds;
+	resource.vertexBuffer = vertexBuffer;
+	resource.indexBuffer = indexBuffer;
+
+	return true;
 }
 
-XMFLOAT3 ResourceManager::CrossProduct(const XMFLOAT3& a, const XMFLOAT3& b) {
-	XMFLOAT3 result;
-	result.x = a.y * b.z - a.z * b.y;
-	result.y = a.z * b.x - a.x * b.z;
-	result.z = a.x * b.y - a.y * b.x;
-	return result;
+vector<int> ResourceManager::GetTriangleCounts(const vector<MeshLevelOfDetail>& modelLevelsOfDetail) {
+	vector<int> triangleCounts;
+	for (const auto& levelOfDetail : modelLevelsOfDetail) {
+		triangleCounts.push_back(static_cast<int>(levelOfDetail.indexCount / 3));
+	}
+	return triangleCounts;
 }
 
-void ResourceManager::NormalizeVector(XMFLOAT3& vector) {
-	float length = sqrt(vector.x * vector.x + vector.y * vector.y + vector.z * vector.z);
-	// Ensure the length is not zero to avoid division by zero.
-	if (length != 0.0f) {
-		vector.x /= length;
-		vector.y /= length;
-		vector.z /= length;
+MeshVertexLayout ResourceManager::GetVertexLayout(const MeshVertexFormat vertexFormat) {
+	MeshVertexLayout layout;
+	layout.version = VERTEX_LAYOUT_VERSION;
+	layout.stride = VertexCompressor::GetVertexSize(vertexFormat);
+
+	switch (vertexFormat) {
+	case MeshVertexFormat::Compact:
+		layout.attributes = {
+			{ MESH_SEMANTIC_POSITION, 0, DXGI_FORMAT_R32G32B32_FLOAT, offsetof(CompactMeshVertex, position) },
+			{ MESH_SEMANTIC_TEXCOORD, 0, DXGI_FORMAT_R16G16_FLOAT, offsetof(CompactMeshVertex, texture) },
+			{ MESH_SEMANTIC_FRAME, 0, DXGI_FORMAT_R16G16B16A16_UINT, offsetof(CompactMeshVertex, frame) },
+		};
+		break;
+	case MeshVertexFormat::CompactQuantized:
+		layout.attributes = {
+			{ MESH_SEMANTIC_POSITION, 0, DXGI_FORMAT_R16G16B16A16_UNORM, offsetof(QuantizedMeshVertex, position) },
+			{ MESH_SEMANTIC_TEXCOORD, 0, DXGI_FORMAT_R16G16_FLOAT, offsetof(QuantizedMeshVertex, texture) },
+			{ MESH_SEMANTIC_FRAME, 0, DXGI_FORMAT_R16G16B16A16_UINT, offsetof(QuantizedMeshVertex, frame) },
+		};
+		break;
+	default:
+		layout.attributes = {
+			{ MESH_SEMANTIC_POSITION, 0, DXGI_FORMAT_R32G32B32_FLOAT, offsetof(VertexType, position) },
+			{ MESH_SEMANTIC_TEXCOORD, 0, DXGI_FORMAT_R32G32_FLOAT, offsetof(VertexType, texture) },
+			{ MESH_SEMANTIC_NORMAL, 0, DXGI_FORMAT_R32G32B32_FLOAT, offsetof(VertexType, normal) },
+			{ MESH_SEMANTIC_TANGENT, 0, DXGI_FORMAT_R32G32B32_FLOAT, offsetof(VertexType, tangent) },
+			{ MESH_SEMANTIC_BINORMAL, 0, DXGI_FORMAT_R32G32B32_FLOAT, offsetof(VertexType, binormal) },
+		};
+		break;
 	}
+
+	return layout;
 }
 
 bool ResourceManager::CreateBuffer(ID3D11Device* const device, const void* data, UINT dataSize, UINT bindFlags, ID3D11Buffer** buffer) {
@@ -196,22 +401,41 @@ bool ResourceManager::CreateBuffer(ID3D11Device* const device, const void* data,
 	return SUCCEEDED(device->CreateBuffer(&bufferDesc, &subData, buffer));
 }
 
-bool ResourceManager::CreateBuffers(ID3D11Device* const device, VertexType* vertices, unsigned long* indices, int vertexCount, int indCount, ID3D11Buffer** vertexBuffer, ID3D11Buffer** indexBuffer) {
-	UINT vertexBufferSize = sizeof(VertexType) * vertexCount;
-	UINT indexBufferSize = sizeof(unsigned long) * indCount;
+bool ResourceManager::CreateBuffers(ID3D11Device* const device, const void* vertices, const uint32_t* indices, int vertexCount, int indCount, ID3D11Buffer** vertexBuffer, ID3D11Buffer** indexBuffer) {
+	UINT vertexBufferSize = GetSizeOfVertexType() * vertexCount;
+	UINT indexBufferSize = sizeof(uint32_t) * indCount;
 
 	return CreateBuffer(device, vertices, vertexBufferSize, D3D11_BIND_VERTEX_BUFFER, vertexBuffer) &&
 		CreateBuffer(device, indices, indexBufferSize, D3D11_BIND_INDEX_BUFFER, indexBuffer);
 }
 
-bool ResourceManager::LoadTexture(ID3D11Device* const device, const WCHAR* textureFileName) {
+bool ResourceManager::LoadTexture(ID3D11Device* const device, const uint32_t texture) {
+	vector<uint8_t> textureData;
+	return ReadTexture(textureIds.GetName(texture).c_str(), textureData) && CreateTexture(device, texture, textureData);
+}
+
+bool ResourceManager::ReadTexture(const WCHAR* textureFileName, vector<uint8_t>& textureData) {
+	const ProfileZone zone("ResourceManager::ReadTexture");
+
+	ifstream file(textureFileName, ios::binary | ios::ate);
+
+	if (!file) {
+		return false;
+	}
+
+	textureData.resize(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+
+	return static_cast<bool>(file.read(reinterpret_cast<char*>(textureData.data()), textureData.size()));
+}
+
+bool ResourceManager::CreateTexture(ID3D11Device* const device, const uint32_t textureIndex, const vector<uint8_t>& textureData) {
 	ID3D11ShaderResourceView* texture = nullptr;
-	HRESULT result = CreateDDSTextureFromFile(device, textureFileName, nullptr, &texture);
+	HRESULT result = CreateDDSTextureFromMemory(device, textureData.data(), textureData.size(), nullptr, &texture);
 
 	if (SUCCEEDED(result)) {
-		textures[textureFileName] = texture;
+		textures[textureIndex].texture = texture;
 		return true;
 	}
-	delete texture;
 	return false;
 }
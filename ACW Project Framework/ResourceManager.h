@@ -1,5 +1,4 @@
 #pragma once
-#include <map>
 #include <memory>
 #include <fstream>
 #include <vector>
@@ -8,13 +7,55 @@
 
 #include <DDSTextureLoader.h>
 
+#include "JobSystem.h"
+#include "MeshCache.h"
+#include "MeshVertex.h"
+#include "ResourceIdTable.h"
+
 using namespace std;
 using namespace DirectX;
 
+//Changes whenever VertexType or the way LoadModel builds vertices does, so caches written by older builds are rebuilt
+const uint32_t VERTEX_LAYOUT_VERSION = 3;
+
+//What welding and reordering did to a model, to check the optimisations are paying off
+struct MeshStatistics
+{
+	//Three per triangle, as the OBJ file describes them
+	int sourceVertexCount;
+	int vertexCount;
+	int triangleCount;
+	//Vertices transformed per triangle with MeshOptimizer's FIFO cache, after welding and before and after reordering
+	float unoptimizedAcmr;
+	float acmr;
+	//Triangles at each level of detail, the first is triangleCount
+	vector<int> levelOfDetailTriangleCounts;
+};
+
+struct MeshBounds
+{
+	float minimum[3];
+	float maximum[3];
+};
+
+//Indices into the manager's tables, only meaningful to the manager that gave them out. A distinct type each so a mesh
+//can't be looked up as a texture
+struct MeshHandle
+{
+	uint32_t index = INVALID_RESOURCE_INDEX;
+};
+
+struct TextureHandle
+{
+	uint32_t index = INVALID_RESOURCE_INDEX;
+};
+
 class ResourceManager
 {
 public:
 	ResourceManager();
+	//Models are stored in the vertex format, the shaders have to be created with the same one
+	explicit ResourceManager(const MeshVertexFormat vertexFormat);
 	ResourceManager(const ResourceManager& other); // Copy Constructor
 	
 	~ResourceManager();
@@ -22,36 +63,122 @@ public:
 	ResourceManager& operator = (const ResourceManager& other); // Copy Assignment Operator
 	ResourceManager& operator = (ResourceManager&& other) noexcept; // Move Assignment Operator
 
+	//The same handle for every spelling of a file's name, see ResourceIdTable. Nothing is loaded until the handle is
+	//first asked for its model or texture
+	MeshHandle GetMeshHandle(const char* const modelFileName);
+	TextureHandle GetTextureHandle(const WCHAR* const textureFileName);
+
+	bool GetModel(ID3D11Device* const device, const MeshHandle mesh, ID3D11Buffer* &vertexBuffer, ID3D11Buffer* &indexBuffer);
 	bool GetModel(ID3D11Device* const device, const char* const modelFileName, ID3D11Buffer* &vertexBuffer, ID3D11Buffer* &indexBuffer);
+	bool GetTexture(ID3D11Device* const device, const TextureHandle textureHandle, ID3D11ShaderResourceView* &texture);
 	bool GetTexture(ID3D11Device* const device, const WCHAR* const textureFileName, ID3D11ShaderResourceView* &texture);
 
+	//Start reading the file on the job system and return its job without touching the device, the buffers and textures
+	//are created by FinishLoads. Assets already loaded or loading return nullptr, without a job system they are read
+	//before returning
+	JobHandle LoadModelAsync(const char* const modelFileName);
+	JobHandle LoadTextureAsync(const WCHAR* const textureFileName);
+	//Waits for every load started since the last call and creates their buffers and textures together on the calling
+	//thread, which has to own the device. Returns false if any failed, GetModel and GetTexture try those again.
+	//GetModel and GetTexture call it themselves if the asset they are asked for is still loading
+	bool FinishLoads(ID3D11Device* const device);
+
+	MeshVertexFormat GetVertexFormat() const;
 	int GetSizeOfVertexType() const;
-	int GetIndexCount(const char* modelFileName) const;
+	//Only valid once GetModel has loaded the mesh
+	int GetIndexCount(const MeshHandle mesh) const;
+	const MeshStatistics& GetMeshStatistics(const MeshHandle mesh) const;
+	//The box around the model's positions, quantized positions are stored relative to it
+	const MeshBounds& GetMeshBounds(const MeshHandle mesh) const;
+	//Index ranges of the model's simplified levels, all drawn from its one index buffer
+	const vector<MeshLevelOfDetail>& GetLevelsOfDetail(const MeshHandle mesh) const;
+
+	//The attributes of a vertex in the format, both the cache files and the shaders' input layouts are built from it
+	static MeshVertexLayout GetVertexLayout(const MeshVertexFormat vertexFormat);
+
+	//LoadModel generates tangents across this job system's threads, nullptr generates them on the calling thread
+	static void SetJobSystem(JobSystem* const jobSystem);
 
 private:
 
-	struct VertexType {
-		XMFLOAT3 position;
-		XMFLOAT2 texture;
-		XMFLOAT3 normal;
-		XMFLOAT3 tangent;
-		XMFLOAT3 binormal;
+	typedef MeshVertex VertexType;
+
+	//A model read on the job system, everything CreateModel needs without parsing it again. The vertices and indices
+	//point into the open cache or the vectors
+	struct ModelData
+	{
+		bool loaded = false;
+		string error;
+
+		shared_ptr<MeshCache> cache;
+		vector<unsigned char> vertexData;
+		vector<uint32_t> indexData;
+
+		const void* vertices = nullptr;
+		const uint32_t* indices = nullptr;
+		int vertexCount = 0;
+		int indexCount = 0;
+
+		vector<MeshLevelOfDetail> levelsOfDetail;
+		MeshStatistics statistics = {};
+		MeshBounds bounds = {};
+	};
+
+	//The file's contents, DDS data is already laid out the way the texture wants it
+	struct TextureData
+	{
+		bool loaded = false;
+		vector<uint8_t> data;
+	};
+
+	//A mesh is loaded once its vertex buffer is set, one still waiting for FinishLoads has its data pending
+	struct MeshResource
+	{
+		string fileName;
+
+		ID3D11Buffer* vertexBuffer = nullptr;
+		ID3D11Buffer* indexBuffer = nullptr;
+
+		int indexCount = 0;
+		MeshStatistics statistics = {};
+		MeshBounds bounds = {};
+		vector<MeshLevelOfDetail> levelsOfDetail;
+
+		shared_ptr<ModelData> pending;
 	};
 
-	bool LoadModel(ID3D11Device* const device, const char* const modelFileName);
-	void CalculateTangentBinormal(VertexType* tempVertexFace[3]);
-	XMFLOAT3 CrossProduct(const XMFLOAT3& a, const XMFLOAT3& b);
+	struct TextureResource
+	{
+		ID3D11ShaderResourceView* texture = nullptr;
+
+		shared_ptr<TextureData> pending;
+	};
+
+	bool LoadModel(ID3D11Device* const device, const uint32_t mesh);
+	//Only reads files, so any number can run at once
+	bool ReadModel(const char* const modelFileName, ModelData& model) const;
+	bool ReadCachedModel(const string& cacheFileName, const uint64_t sourceHash, ModelData& model) const;
+	bool CreateModel(ID3D11Device* const device, const uint32_t mesh, const ModelData& model);
+	static vector<int> GetTriangleCounts(const vector<MeshLevelOfDetail>& modelLevelsOfDetail);
 	bool CreateBuffer(ID3D11Device* const device, const void* data, UINT dataSize, UINT bindFlags, ID3D11Buffer** buffer);
-	void NormalizeVector(XMFLOAT3& vector);
-	bool CreateBuffers(ID3D11Device* const device, VertexType* vertices, unsigned long* indices, int vertexCount, int indCount, ID3D11Buffer** vertexBuffer, ID3D11Buffer** indexBuffer);
-	bool LoadTexture(ID3D11Device* const device, const WCHAR* textureFileName);
+	bool CreateBuffers(ID3D11Device* const device, const void* vertices, const uint32_t* indices, int vertexCount, int indCount, ID3D11Buffer** vertexBuffer, ID3D11Buffer** indexBuffer);
+	bool LoadTexture(ID3D11Device* const device, const uint32_t texture);
+	static bool ReadTexture(const WCHAR* textureFileName, vector<uint8_t>& textureData);
+	bool CreateTexture(ID3D11Device* const device, const uint32_t textureIndex, const vector<uint8_t>& textureData);
+
+	MeshVertexFormat vertexFormat;
 
-	map<const char*, int> indexCount;
-	map<const char*, int> instanceCount;
+	//A handle's index is its place in these
+	ResourceIdTable meshIds;
+	ResourceIdTable textureIds;
+	vector<MeshResource> meshes;
+	vector<TextureResource> textures;
 
-	map<const char*, ID3D11Buffer*> vertexBuffers;
-	map<const char*, ID3D11Buffer*> indexBuffers;
+	//Started by LoadModelAsync and LoadTextureAsync and waiting for FinishLoads
+	vector<uint32_t> pendingMeshes;
+	vector<uint32_t> pendingTextures;
+	vector<JobHandle> pendingLoads;
 
-	map<const WCHAR*, ID3D11ShaderResourceView*> textures;
+	static JobSystem* jobSystem;
 };
 
@@ -1,10 +1,7 @@
 #include "Rocket.h"
 
-Rocket::Rocket(ID3D11Device* const device, const XMFLOAT3& position, const XMFLOAT3& rotation, const XMFLOAT3& scale, const shared_ptr<ShaderManager>& shaderManager, const shared_ptr<ResourceManager>& resourceManager) : initializationFailed(false), rocketLaunched(false), blastRadius(5.0f), initialVelocity(25.0f), gravity(-9.81f), velocity(XMFLOAT2()), angularVelocity(XMFLOAT2()), initialLauncherPosition(XMFLOAT3()), initialLauncherRotation(XMFLOAT3()), lookAtRocketPosition(XMFLOAT3()), lookAtRocketConePosition(XMFLOAT3()), rocketCone(nullptr), rocketBody(nullptr), rocketCap(nullptr), rocketLauncher(nullptr)
+Rocket::Rocket(ID3D11Device* const device, const XMFLOAT3& position, const XMFLOAT3& rotation, const XMFLOAT3& scale, const shared_ptr<ShaderManager>& shaderManager, const shared_ptr<ResourceManager>& resourceManager) : initializationFailed(false), rocketLaunched(false), publishedRocketLaunched(false), rocketCone(nullptr), rocketBody(nullptr), rocketCap(nullptr), rocketLauncher(nullptr)
 {
-	initialLauncherPosition = position;
-	initialLauncherRotation = rotation;
-
 	vector<const WCHAR*> textureNames;
 	
 	textureNames.push_back(L"BaseColour.dds");
@@ -132,122 +129,6 @@ Rocket::~Rocket()
 {
 }
 
-void Rocket::AdjustRotationLeft() const
-{
-	if (!rocketLaunched)
-	{
-		auto launchAngle = rocketBody->GetRotationComponent()->GetRotationAt(0);
-
-		launchAngle.z -= -XM_PIDIV4 / 30.0f;
-
-		if (launchAngle.z > 0.0f)
-		{
-			launchAngle.z = 0.0f;
-		}
-
-		rocketBody->SetRotation(launchAngle);
-		rocketLauncher->Update();
-	}
-}
-
-void Rocket::AdjustRotationRight() const
-{
-	if (!rocketLaunched)
-	{
-		auto launchAngle = rocketBody->GetRotationComponent()->GetRotationAt(0);
-
-		launchAngle.z += -XM_PIDIV4 / 30.0f;
-
-		if (launchAngle.z < -XM_PIDIV2 + (XM_PIDIV4 / 10.0f))
-		{
-			launchAngle.z = -XM_PIDIV2 + (XM_PIDIV4 / 10.0f);
-		}
-
-		rocketBody->SetRotation(launchAngle);
-		rocketLauncher->Update();
-	}
-}
-
-void Rocket::LaunchRocket()
-{
-	if (!rocketLaunched)
-	{
-		const auto launchAngle = rocketBody->GetRotationComponent()->GetRotationAt(0);
-
-		//Turn the rocket angle to the launch angle we need
-		const auto angle = XM_PIDIV2 + launchAngle.z;
-
-		velocity = XMFLOAT2(initialVelocity * cos(angle), initialVelocity * sin(angle));
-		angularVelocity = XMFLOAT2(cos(-angle), sin(-angle));
-
-		const auto totalAngularMovement = angle + XM_PIDIV2;
-
-		const auto v = velocity.x * velocity.x + velocity.y * velocity.y;
-
-		auto totalTimeOfJourney = (v * sin(angle) + sqrt(((v * sin(angle)) * (v * sin(angle))) + 2.0f * (gravity * 3.0f))) / gravity;
-
-		totalTimeOfJourney *= 2.0f;
-
-		angularVelocity = XMFLOAT2(totalAngularMovement / totalTimeOfJourney, totalAngularMovement / totalTimeOfJourney);
-
-		rocketLaunched = true;
-		
-	}
-}
-
-const bool Rocket::RocketLaunched() const
-{
-	return rocketLaunched;
-}
-
-const XMFLOAT3& Rocket::GetLauncherPosition() const
-{
-	return initialLauncherPosition;
-}
-
-const XMFLOAT3& Rocket::GetLookAtRocketPosition()
-{
-	const auto rocketBodyPosition = rocketBody->GetPositionComponent()->GetPositionAt(0);
-	const auto rocketBodyScale = rocketBody->GetScaleComponent()->GetScaleAt(0);
-
-	lookAtRocketPosition = XMFLOAT3(rocketBodyPosition.x, rocketBodyPosition.y, rocketBodyPosition.z - rocketBodyScale.x);
-
-	return lookAtRocketPosition;
-}
-
-const XMFLOAT3& Rocket::GetLookAtRocketConePosition()
-{
-	const auto rocketBodyScale = rocketBody->GetScaleComponent()->GetScaleAt(0);
-	const auto rocketBodyRot = rocketBody->GetRotationComponent()->GetRotationAt(0);
-	const auto rocketBodyPos = rocketBody->GetPositionComponent()->GetPositionAt(0);
-
-	auto rocketMatrix = XMMatrixIdentity();
-
-	rocketMatrix = XMMatrixMultiply(rocketMatrix, XMMatrixScaling(rocketBodyScale.x, rocketBodyScale.y, rocketBodyScale.z));
-	rocketMatrix = XMMatrixMultiply(rocketMatrix, XMMatrixRotationQuaternion(XMQuaternionRotationRollPitchYaw(rocketBodyRot.x, rocketBodyRot.y, rocketBodyRot.z)));
-	rocketMatrix = XMMatrixMultiply(rocketMatrix, XMMatrixTranslation(rocketBodyPos.x, rocketBodyPos.y, rocketBodyPos.z));
-
-	auto posMatrix = XMMatrixIdentity();
-
-	posMatrix = XMMatrixMultiply(posMatrix, XMMatrixTranslation(0.0f, 0.6f, 0.0f));
-
-	posMatrix = posMatrix * rocketMatrix;
-
-	auto lookAtRocketConeScale = XMVECTOR();
-	auto lookAtRocketConeRotation = XMVECTOR();
-	auto lookAtRocketConePos = XMVECTOR();
-
-	XMMatrixDecompose(&lookAtRocketConeScale, &lookAtRocketConeRotation, &lookAtRocketConePos, posMatrix);
-
-	auto conePositionFloat = XMFLOAT3();
-
-	XMStoreFloat3(&conePositionFloat, lookAtRocketConePos);
-
-	lookAtRocketConePosition = XMFLOAT3(conePositionFloat.x, conePositionFloat.y, conePositionFloat.z - rocketBodyScale.x);
-
-	return lookAtRocketConePosition;
-}
-
 const shared_ptr<GameObject> Rocket::GetRocketBody() const
 {
 	return rocketBody;
@@ -269,218 +150,69 @@ const shared_ptr<GameObject> Rocket::GetRocketLauncher() const
 }
 
 
-bool Rocket::CheckForTerrainCollision(const shared_ptr<Terrain>& terrain, XMFLOAT3& outCollisionPosition, float& outBlastRadius)
+void Rocket::UpdateRocket(const shared_ptr<RocketSimulation>& rocketSimulation)
 {
-	const auto rocketBodyScale = rocketBody->GetScaleComponent()->GetScaleAt(0);
-	const auto rocketBodyRot = rocketBody->GetRotationComponent()->GetRotationAt(0);
-	const auto rocketBodyPos = rocketBody->GetPositionComponent()->GetPositionAt(0);
-
-	auto rocketMatrix = XMMatrixIdentity();
-
-	rocketMatrix = XMMatrixMultiply(rocketMatrix, XMMatrixScaling(rocketBodyScale.x, rocketBodyScale.y, rocketBodyScale.z));
-	rocketMatrix = XMMatrixMultiply(rocketMatrix, XMMatrixRotationQuaternion(XMQuaternionRotationRollPitchYaw(rocketBodyRot.x, rocketBodyRot.y, rocketBodyRot.z)));
-	rocketMatrix = XMMatrixMultiply(rocketMatrix, XMMatrixTranslation(rocketBodyPos.x, rocketBodyPos.y, rocketBodyPos.z));
-
-	auto posMatrix = XMMatrixIdentity();
-
-	posMatrix = XMMatrixMultiply(posMatrix, XMMatrixTranslation(0.0f, 0.6f, 0.0f));
-
-	posMatrix = posMatrix * rocketMatrix;
-
-	auto rocketConeScale = XMVECTOR();
-	auto rocketConeRotation = XMVECTOR();
-	auto rocketConePosition = XMVECTOR();
+	rocketBody->SetPosition(rocketSimulation->GetBodyPosition());
+	rocketBody->SetRotation(rocketSimulation->GetBodyRotation());
 
-	XMMatrixDecompose(&rocketConeScale, &rocketConeRotation, &rocketConePosition, posMatrix);
-
-	auto conePositionFloat = XMFLOAT3();
-
-	XMStoreFloat3(&conePositionFloat, rocketConePosition);
-
-	if (conePositionFloat.y < 0.0f)
-	{
-		//Collision true
-
-		if (conePositionFloat.y < -200.0f)
-		{
-			//Reset if we have fallen too far
-			ResetRocketState();
-			return false;
-		}
-
-		auto terrainPositions = terrain->GetPositionComponent()->GetPositions();
-		const auto terrainCubeRadius = terrain->GetScaleComponent()->GetScaleAt(0).x;
-
-		for (unsigned int i = 0; i < terrainPositions.size(); i++)
-		{
-			auto distance = XMFLOAT3(terrainPositions[i].x - conePositionFloat.x, terrainPositions[i].y - conePositionFloat.y, terrainPositions[i].z - conePositionFloat.z);
-
-			auto size = 0.0f;
-
-			XMStoreFloat(&size, XMVector3Length(XMLoadFloat3(&distance)));
-
-			//See if we collide with a single block and don't destroy within the blast radius
-
-			auto radiusSum = XMVectorGetX(rocketConeScale) + terrainCubeRadius;
-
-			if (size*size <= radiusSum * radiusSum)
-			{
-				outCollisionPosition = terrainPositions[i];
-				outBlastRadius = blastRadius;
-
-				terrain->GetPositionComponent()->TranslatePositionAt(XMFLOAT3(0.0f, -1000.0f, 0.0f), i);
-
-				terrainPositions = terrain->GetPositionComponent()->GetPositions();
-
-				for (unsigned int j = 0; j < terrainPositions.size(); j++)
-				{
-					distance = XMFLOAT3(terrainPositions[j].x - conePositionFloat.x, terrainPositions[j].y - conePositionFloat.y, terrainPositions[j].z - conePositionFloat.z);
-
-					size = 0.0f;
-
-					XMStoreFloat(&size, XMVector3Length(XMLoadFloat3(&distance)));
-
-					//Destroy all blocks in the radius
-					radiusSum = XMVectorGetX(rocketConeScale) + terrainCubeRadius + blastRadius;
-
-					if (size*size <= radiusSum * radiusSum)
-					{
-						terrain->GetPositionComponent()->TranslatePositionAt(XMFLOAT3(0.0f, -500.0f, 0.0f), j);
-					}
-				}
-
-				terrain->UpdateInstanceData();
-
-				//Reset rocket
-				ResetRocketState();
-
-				//Return true and break out of loop
-				return true;
-			}
-		}
-
-		return false;
-	}
-}
-
-void Rocket::ResetRocketState()
-{
-	rocketBody->SetPosition(initialLauncherPosition);
-	rocketBody->SetRotation(initialLauncherRotation);
-
-	rocketLaunched = false;
-	rocketLauncher->Update();
-}
-
-
-void Rocket::UpdateRocket(const float dt)
-{
-	if (rocketLaunched)
-	{
-		velocity = XMFLOAT2(velocity.x, (velocity.y + (gravity * dt)));
-		angularVelocity = XMFLOAT2(angularVelocity.x, angularVelocity.y);
-
-		if (velocity.y < 0.0f)
-		{
-			auto rocketRotation = rocketBody->GetRotationComponent()->GetRotationAt(0);
-			rocketRotation = XMFLOAT3(rocketRotation.x, rocketRotation.y, rocketRotation.z + angularVelocity.x);
-			rocketBody->SetRotation(rocketRotation);
-		}
-
-		const auto rocketPosition = rocketBody->GetPositionComponent()->GetPositionAt(0);
-
-		rocketBody->SetPosition(rocketPosition.x + velocity.x * dt, rocketPosition.y + velocity.y * dt, rocketPosition.z);
-	}
+	rocketLaunched = rocketSimulation->RocketLaunched();
 
 	rocketBody->Update();
 	rocketCone->Update();
 	rocketCap->Update();
 
-	UpdateLightPosition();
+	//The launcher stays on the launch pad once the rocket has left it
+	if (!rocketLaunched)
+	{
+		rocketLauncher->Update();
+	}
 }
 
-void Rocket::UpdateLightPosition() const
+void Rocket::PublishSnapshot()
 {
-	const auto rocketBodyScale = rocketBody->GetScaleComponent()->GetScaleAt(0);
-	const auto rocketBodyRot = rocketBody->GetRotationComponent()->GetRotationAt(0);
-	const auto rocketBodyPos = rocketBody->GetPositionComponent()->GetPositionAt(0);
-
-	auto rocketMatrix = XMMatrixIdentity();
-
-	rocketMatrix = XMMatrixMultiply(rocketMatrix, XMMatrixScaling(rocketBodyScale.x, rocketBodyScale.y, rocketBodyScale.z));
-	rocketMatrix = XMMatrixMultiply(rocketMatrix, XMMatrixRotationQuaternion(XMQuaternionRotationRollPitchYaw(rocketBodyRot.x, rocketBodyRot.y, rocketBodyRot.z)));
-	rocketMatrix = XMMatrixMultiply(rocketMatrix, XMMatrixTranslation(rocketBodyPos.x, rocketBodyPos.y, rocketBodyPos.z));
-
-	auto posMatrix = XMMatrixIdentity();
-
-	posMatrix = XMMatrixMultiply(posMatrix, XMMatrixTranslation(0.0f, -0.6f, 0.0f));
-
-	posMatrix = posMatrix * rocketMatrix;
-
-	auto lightScale = XMVECTOR();
-	auto lightRotation = XMVECTOR();
-	auto lightPosition = XMVECTOR();
-
-	XMMatrixDecompose(&lightScale, &lightRotation, &lightPosition, posMatrix);
-
-	posMatrix = XMMatrixIdentity();
-
-	posMatrix = XMMatrixMultiply(posMatrix, XMMatrixTranslation(0.0f, -1.2f, 0.0f));
-
-	posMatrix = posMatrix * rocketMatrix;
-
-	auto lightPointPosition = XMVECTOR();
-	XMMatrixDecompose(&lightScale, &lightRotation, &lightPointPosition, posMatrix);
-
-	auto lightPositionFloat = XMFLOAT3();
-	auto lightPointPositionFloat = XMFLOAT3();
-
-	XMStoreFloat3(&lightPositionFloat, lightPosition);
-	XMStoreFloat3(&lightPointPositionFloat, lightPointPosition);
-
+	publishedRocketLaunched = rocketLaunched;
 }
 
-
 bool Rocket::RenderRocket(const shared_ptr<GraphicsDeviceManager>& d3dContainer, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) const
 {
 	auto result = true;
 
-	result = rocketBody->Render(d3dContainer->GetDeviceContext(), viewMatrix, projectionMatrix, depthTextures, pointLightList, cameraPosition);
+	result = rocketBody->Render(d3dContainer->GetRenderContext().get(), viewMatrix, projectionMatrix, depthTextures, pointLightList, cameraPosition);
 
 	if (!result)
 	{
 		return false;
 	}
 
-	result = rocketCone->Render(d3dContainer->GetDeviceContext(), viewMatrix, projectionMatrix, depthTextures, pointLightList, cameraPosition);
+	result = rocketCone->Render(d3dContainer->GetRenderContext().get(), viewMatrix, projectionMatrix, depthTextures, pointLightList, cameraPosition);
 
 	if (!result)
 	{
 		return false;
 	}
 
-	result = rocketCap->Render(d3dContainer->GetDeviceContext(), viewMatrix, projectionMatrix, depthTextures, pointLightList, cameraPosition);
+	result = rocketCap->Render(d3dContainer->GetRenderContext().get(), viewMatrix, projectionMatrix, depthTextures, pointLightList, cameraPosition);
 
 	if (!result)
 	{
 		return false;
 	}
 
-	result = rocketLauncher->Render(d3dContainer->GetDeviceContext(), viewMatrix, projectionMatrix, depthTextures, pointLightList, cameraPosition);
+	result = rocketLauncher->Render(d3dContainer->GetRenderContext().get(), viewMatrix, projectionMatrix, depthTextures, pointLightList, cameraPosition);
 
 	if (!result)
 	{
 		return false;
 	}
 
-	if (rocketLaunched)
+	if (publishedRocketLaunched)
 	{
 		d3dContainer->DisableDepthStencil();
 		d3dContainer->EnableAlphaBlending();
 		d3dContainer->EnabledDepthStencil();
 		d3dContainer->DisableAlphaBlending();
 	}
-	else if (rocketLaunched)
+	else if (publishedRocketLaunched)
 	{
 		d3dContainer->DisableDepthStencil();
 		d3dContainer->EnableAlphaBlending();
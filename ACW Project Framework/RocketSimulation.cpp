@@ -0,0 +1,218 @@
+#include "RocketSimulation.h"
+#include <cmath>
+
+RocketSimulation::RocketSimulation(const XMFLOAT3& position, const XMFLOAT3& rotation, const XMFLOAT3& scale) : rocketLaunched(false), blastRadius(5.0f), initialVelocity(25.0f), gravity(-9.81f), velocity(XMFLOAT2()), angularVelocity(XMFLOAT2()), bodyPosition(position), bodyRotation(rotation), bodyScale(XMFLOAT3()), initialLauncherPosition(position), initialLauncherRotation(rotation), lookAtRocketPosition(XMFLOAT3()), lookAtRocketConePosition(XMFLOAT3()), previousConePosition(XMFLOAT3())
+{
+	//Same proportions as the rocket body game object
+	bodyScale = XMFLOAT3(1.0f * scale.x, 6.0f * scale.y, 1.0f * scale.z);
+
+	auto coneScale = XMVECTOR();
+	previousConePosition = GetConePosition(coneScale);
+}
+
+RocketSimulation::RocketSimulation(const RocketSimulation& other) = default;
+
+RocketSimulation::RocketSimulation(RocketSimulation&& other) noexcept = default;
+
+RocketSimulation::~RocketSimulation() = default;
+
+RocketSimulation& RocketSimulation::operator=(const RocketSimulation& other) = default;
+
+RocketSimulation& RocketSimulation::operator=(RocketSimulation&& other) noexcept = default;
+
+void RocketSimulation::AdjustRotationLeft()
+{
+	if (!rocketLaunched)
+	{
+		bodyRotation.z -= -XM_PIDIV4 / 30.0f;
+
+		if (bodyRotation.z > 0.0f)
+		{
+			bodyRotation.z = 0.0f;
+		}
+	}
+}
+
+void RocketSimulation::AdjustRotationRight()
+{
+	if (!rocketLaunched)
+	{
+		bodyRotation.z += -XM_PIDIV4 / 30.0f;
+
+		if (bodyRotation.z < -XM_PIDIV2 + (XM_PIDIV4 / 10.0f))
+		{
+			bodyRotation.z = -XM_PIDIV2 + (XM_PIDIV4 / 10.0f);
+		}
+	}
+}
+
+void RocketSimulation::LaunchRocket()
+{
+	if (!rocketLaunched)
+	{
+		//Turn the rocket angle to the launch angle we need
+		const auto angle = XM_PIDIV2 + bodyRotation.z;
+
+		velocity = XMFLOAT2(initialVelocity * cos(angle), initialVelocity * sin(angle));
+		angularVelocity = XMFLOAT2(cos(-angle), sin(-angle));
+
+		const auto totalAngularMovement = angle + XM_PIDIV2;
+
+		const auto v = velocity.x * velocity.x + velocity.y * velocity.y;
+
+		auto totalTimeOfJourney = (v * sin(angle) + sqrt(((v * sin(angle)) * (v * sin(angle))) + 2.0f * (gravity * 3.0f))) / gravity;
+
+		totalTimeOfJourney *= 2.0f;
+
+		angularVelocity = XMFLOAT2(totalAngularMovement / totalTimeOfJourney, totalAngularMovement / totalTimeOfJourney);
+
+		rocketLaunched = true;
+	}
+}
+
+const bool RocketSimulation::RocketLaunched() const
+{
+	return rocketLaunched;
+}
+
+const XMFLOAT3& RocketSimulation::GetLauncherPosition() const
+{
+	return initialLauncherPosition;
+}
+
+const XMFLOAT3& RocketSimulation::GetLookAtRocketPosition()
+{
+	lookAtRocketPosition = XMFLOAT3(bodyPosition.x, bodyPosition.y, bodyPosition.z - bodyScale.x);
+
+	return lookAtRocketPosition;
+}
+
+const XMFLOAT3& RocketSimulation::GetLookAtRocketConePosition()
+{
+	auto coneScale = XMVECTOR();
+
+	const auto conePosition = GetConePosition(coneScale);
+
+	lookAtRocketConePosition = XMFLOAT3(conePosition.x, conePosition.y, conePosition.z - bodyScale.x);
+
+	return lookAtRocketConePosition;
+}
+
+const XMFLOAT3& RocketSimulation::GetBodyPosition() const
+{
+	return bodyPosition;
+}
+
+const XMFLOAT3& RocketSimulation::GetBodyRotation() const
+{
+	return bodyRotation;
+}
+
+const XMFLOAT3& RocketSimulation::GetBodyScale() const
+{
+	return bodyScale;
+}
+
+bool RocketSimulation::CheckForTerrainCollision(const shared_ptr<TerrainSimulation>& terrain, XMFLOAT3& outCollisionPosition, float& outBlastRadius)
+{
+	auto rocketConeScale = XMVECTOR();
+
+	const auto conePositionFloat = GetConePosition(rocketConeScale);
+
+	//Terrain is all below y = 0 so there is nothing to hit unless the last step went under it
+	if (conePositionFloat.y >= 0.0f && previousConePosition.y >= 0.0f)
+	{
+		return false;
+	}
+
+	const auto terrainCubeRadius = terrain->GetCubeScale().x;
+	const auto coneRadius = XMVectorGetX(rocketConeScale);
+
+	auto hitVoxel = XMINT3();
+	auto contactPosition = XMFLOAT3();
+
+	//See if we collide with a single block anywhere along the last step and don't destroy within the blast radius
+	if (!terrain->GetVoxelGrid().FindFirstOccupiedAlongSweep(previousConePosition, conePositionFloat, coneRadius + terrainCubeRadius, hitVoxel, contactPosition))
+	{
+		if (conePositionFloat.y < -200.0f)
+		{
+			//Reset if we have fallen too far
+			ResetRocketState();
+		}
+
+		return false;
+	}
+
+	outCollisionPosition = terrain->GetVoxelGrid().GetVoxelPosition(hitVoxel.x, hitVoxel.y, hitVoxel.z);
+	outBlastRadius = blastRadius;
+
+	terrain->DestroyCube(hitVoxel.x, hitVoxel.y, hitVoxel.z);
+
+	//Destroy all blocks in the radius around where the cone hit rather than where it ended up
+	terrain->DestroyCubesInSphere(contactPosition, coneRadius + terrainCubeRadius + blastRadius);
+
+	//Reset rocket
+	ResetRocketState();
+
+	return true;
+}
+
+void RocketSimulation::ResetRocketState()
+{
+	bodyPosition = initialLauncherPosition;
+	bodyRotation = initialLauncherRotation;
+
+	auto coneScale = XMVECTOR();
+	previousConePosition = GetConePosition(coneScale);
+
+	rocketLaunched = false;
+}
+
+void RocketSimulation::UpdateRocket(const float dt)
+{
+	auto coneScale = XMVECTOR();
+	previousConePosition = GetConePosition(coneScale);
+
+	if (rocketLaunched)
+	{
+		velocity = XMFLOAT2(velocity.x, (velocity.y + (gravity * dt)));
+
+		if (velocity.y < 0.0f)
+		{
+			bodyRotation = XMFLOAT3(bodyRotation.x, bodyRotation.y, bodyRotation.z + angularVelocity.x);
+		}
+
+		bodyPosition = XMFLOAT3(bodyPosition.x + velocity.x * dt, bodyPosition.y + velocity.y * dt, bodyPosition.z);
+	}
+}
+
+XMMATRIX RocketSimulation::GetRocketMatrix() const
+{
+	auto rocketMatrix = XMMatrixIdentity();
+
+	rocketMatrix = XMMatrixMultiply(rocketMatrix, XMMatrixScaling(bodyScale.x, bodyScale.y, bodyScale.z));
+	rocketMatrix = XMMatrixMultiply(rocketMatrix, XMMatrixRotationQuaternion(XMQuaternionRotationRollPitchYaw(bodyRotation.x, bodyRotation.y, bodyRotation.z)));
+	rocketMatrix = XMMatrixMultiply(rocketMatrix, XMMatrixTranslation(bodyPosition.x, bodyPosition.y, bodyPosition.z));
+
+	return rocketMatrix;
+}
+
+XMFLOAT3 RocketSimulation::GetConePosition(XMVECTOR& outConeScale) const
+{
+	auto posMatrix = XMMatrixIdentity();
+
+	posMatrix = XMMatrixMultiply(posMatrix, XMMatrixTranslation(0.0f, 0.6f, 0.0f));
+
+	posMatrix = posMatrix * GetRocketMatrix();
+
+	auto coneRotation = XMVECTOR();
+	auto conePosition = XMVECTOR();
+
+	XMMatrixDecompose(&outConeScale, &coneRotation, &conePosition, posMatrix);
+
+	auto conePositionFloat = XMFLOAT3();
+
+	XMStoreFloat3(&conePositionFloat, conePosition);
+
+	return conePositionFloat;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <memory>
+
+#include "TerrainSimulation.h"
+
+using namespace DirectX;
+using namespace std;
+
+//Platform neutral rocket state and physics, the Rocket game object reads its transform from here when rendering
+class RocketSimulation
+{
+public:
+	RocketSimulation(const XMFLOAT3& position, const XMFLOAT3& rotation, const XMFLOAT3& scale);
+	RocketSimulation(const RocketSimulation& other); // Copy Constructor
+	RocketSimulation(RocketSimulation&& other) noexcept; // Move Constructor
+	~RocketSimulation(); // Destructor
+
+	RocketSimulation& operator = (const RocketSimulation& other); // Copy Assignment Operator
+	RocketSimulation& operator = (RocketSimulation&& other) noexcept; // Move Assignment Operator
+
+	void AdjustRotationLeft();
+	void AdjustRotationRight();
+
+	void LaunchRocket();
+	const bool RocketLaunched() const;
+
+	const XMFLOAT3& GetLauncherPosition() const;
+	const XMFLOAT3& GetLookAtRocketPosition();
+	const XMFLOAT3& GetLookAtRocketConePosition();
+
+	const XMFLOAT3& GetBodyPosition() const;
+	const XMFLOAT3& GetBodyRotation() const;
+	const XMFLOAT3& GetBodyScale() const;
+
+	//Sweeps the cone from where it was before the last update so no time scale can step it through the terrain
+	bool CheckForTerrainCollision(const shared_ptr<TerrainSimulation>& terrain, XMFLOAT3& outCollisionPosition, float& outBlastRadius);
+
+	void ResetRocketState();
+
+	void UpdateRocket(const float dt);
+
+private:
+	XMMATRIX GetRocketMatrix() const;
+	XMFLOAT3 GetConePosition(XMVECTOR& outConeScale) const;
+
+	bool rocketLaunched;
+
+	float blastRadius;
+	float initialVelocity;
+	float gravity;
+	XMFLOAT2 velocity;
+	XMFLOAT2 angularVelocity;
+
+	XMFLOAT3 bodyPosition;
+	XMFLOAT3 bodyRotation;
+	XMFLOAT3 bodyScale;
+
+	XMFLOAT3 initialLauncherPosition;
+	XMFLOAT3 initialLauncherRotation;
+	XMFLOAT3 lookAtRocketPosition;
+	XMFLOAT3 lookAtRocketConePosition;
+	XMFLOAT3 previousConePosition;
+};
@@ -1,6 +1,6 @@
 #include "Shader.h"
 
-Shader::Shader(const string& vertexShaderFileName, const string& hullShaderFileName, const string& domainShaderFileName, const string& pixelShaderFileName, ID3D11Device* const device, HWND const hwnd) : initializationFailed(false), vertexBufferResourceCount(0), hullBufferResourceCount(0), domainBufferResourceCount(0), pixelBufferResourceCount(0), nonTextureRenderMode(0), textureDiffuseRenderMode(0), displacementRenderMode(0), maxTessellationDistance(1.0f), minTessellationDistance(1.0f), maxTessellationFactor(0.0f), minTessellationFactor(0.0f), mipInterval(0.0f), mipClampMinimum(0.0f), mipClampMaximum(0.0f), displacementPower(0.0f), vertexShaderBuffer(nullptr), vertexShader(nullptr), hullShader(nullptr), domainShader(nullptr), pixelShader(nullptr), matrixBuffer(nullptr), tessellationBuffer(nullptr), cameraBuffer(nullptr), renderModeBuffer(nullptr)
+Shader::Shader(const string& vertexShaderFileName, const string& hullShaderFileName, const string& domainShaderFileName, const string& pixelShaderFileName, ID3D11Device* const device, HWND const hwnd, const MeshVertexFormat vertexFormat) : initializationFailed(false), vertexFormat(vertexFormat), vertexBufferResourceCount(0), hullBufferResourceCount(0), domainBufferResourceCount(0), pixelBufferResourceCount(0), nonTextureRenderMode(0), textureDiffuseRenderMode(0), displacementRenderMode(0), maxTessellationDistance(1.0f), minTessellationDistance(1.0f), maxTessellationFactor(0.0f), minTessellationFactor(0.0f), mipInterval(0.0f), mipClampMinimum(0.0f), mipClampMaximum(0.0f), displacementPower(0.0f), vertexShaderBuffer(nullptr), vertexShader(nullptr), hullShader(nullptr), domainShader(nullptr), pixelShader(nullptr), matrixBuffer(nullptr), tessellationBuffer(nullptr), cameraBuffer(nullptr), renderModeBuffer(nullptr)
 {
 	ID3D10Blob* errorMessage = nullptr;
 
@@ -10,7 +10,11 @@ Shader::Shader(const string& vertexShaderFileName, const string& hullShaderFileN
 
 	const auto hlslVertexFileName = vertexShaderFileName + ".hlsl";
 
-	auto result = D3DCompileFromFile(CA2W(hlslVertexFileName.c_str()), nullptr, nullptr, vertexShaderFileName.c_str(), "vs_5_0", D3D10_SHADER_ENABLE_STRICTNESS, /*D3DCOMPILE_DEBUG*/ 0, &vertexShaderBuffer, &errorMessage);
+	//MeshVertex.hlsli decodes the compact formats when COMPACT_VERTEX is defined
+	const D3D_SHADER_MACRO compactVertexDefines[] = { { "COMPACT_VERTEX", "1" }, { nullptr, nullptr } };
+	const auto* const vertexDefines = vertexFormat == MeshVertexFormat::Full ? nullptr : compactVertexDefines;
+
+	auto result = D3DCompileFromFile(CA2W(hlslVertexFileName.c_str()), vertexDefines, D3D_COMPILE_STANDARD_FILE_INCLUDE, vertexShaderFileName.c_str(), "vs_5_0", D3D10_SHADER_ENABLE_STRICTNESS, /*D3DCOMPILE_DEBUG*/ 0, &vertexShaderBuffer, &errorMessage);
 
 	if (FAILED(result))
 	{
@@ -402,7 +406,7 @@ void Shader::SetVertexShaderBuffer(ID3D10Blob* const vtShaderBuffer)
 	vertexShaderBuffer = vtShaderBuffer;
 }
 
-bool Shader::SetShaderParameters(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition) {
+bool Shader::SetShaderParameters(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition) {
 	
 	vertexBufferResourceCount = 0;
 	hullBufferResourceCount = 0;
@@ -552,7 +556,21 @@ bool Shader::SetShaderParameters(ID3D11DeviceContext* const deviceContext, const
 	return true;
 }
 
-void Shader::SetShader(ID3D11DeviceContext* const deviceContext) const {
+HRESULT Shader::CreateMeshInputLayout(ID3D11Device* const device, ID3D11InputLayout** const inputLayout) const {
+	vector<D3D11_INPUT_ELEMENT_DESC> layout;
+
+	for (const auto& attribute : ResourceManager::GetVertexLayout(vertexFormat).attributes) {
+		layout.push_back({ MESH_SEMANTIC_NAMES[attribute.semantic], attribute.semanticIndex, static_cast<DXGI_FORMAT>(attribute.format), 0, attribute.offset, D3D11_INPUT_PER_VERTEX_DATA, 0 });
+	}
+
+	for (auto i = 0; i < 4; i++) {
+		layout.push_back({ "INSTANCEMATRIX", static_cast<UINT>(i), DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 });
+	}
+
+	return device->CreateInputLayout(layout.data(), static_cast<UINT>(layout.size()), vertexShaderBuffer->GetBufferPointer(), vertexShaderBuffer->GetBufferSize(), inputLayout);
+}
+
+void Shader::SetShader(RenderContext* const deviceContext) const {
 	deviceContext->VSSetShader(vertexShader, nullptr, 0);
 	deviceContext->HSSetShader(hullShader, nullptr, 0);
 	deviceContext->DSSetShader(domainShader, nullptr, 0);
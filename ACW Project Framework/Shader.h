@@ -7,6 +7,8 @@
 #include <string>
 #include <vector>
 #include "Light.h"
+#include "RenderContext.h"
+#include "ResourceManager.h"
 
 const int MAX_LIGHTS = 16;
 
@@ -16,7 +18,8 @@ using namespace std;
 class Shader
 {
 public:
-	Shader(const string& vertexShaderFileName, const string& hullShaderFileName, const string& domainShaderFileName, const string& pixelShaderFileName, ID3D11Device* const device, HWND const hwnd);
+	//The vertex shader is compiled for the vertex format the models are stored in, see MeshVertex.hlsli
+	Shader(const string& vertexShaderFileName, const string& hullShaderFileName, const string& domainShaderFileName, const string& pixelShaderFileName, ID3D11Device* const device, HWND const hwnd, const MeshVertexFormat vertexFormat);
 	Shader(const Shader& other); // Copy Constructor
 	Shader(Shader&& other) noexcept; // Move Constructor
 	virtual ~Shader();
@@ -52,12 +55,14 @@ public:
 	void SetInitializationState(const bool state);
 	void SetVertexShaderBuffer(ID3D10Blob* const vertexShaderBuffer);
 
-	virtual bool Render(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) = 0;
+	virtual bool Render(RenderContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) = 0;
 
 protected:
 
-	bool SetShaderParameters(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition);
-	void SetShader(ID3D11DeviceContext* const deviceContext) const;
+	bool SetShaderParameters(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition);
+	//A model's vertices in the vertex format followed by the instance matrices, which have to be vertex buffer 1
+	HRESULT CreateMeshInputLayout(ID3D11Device* const device, ID3D11InputLayout** const inputLayout) const;
+	void SetShader(RenderContext* const deviceContext) const;
 	void OutputShaderErrorMessage(ID3D10Blob* errorMessage, HWND const hwnd, const LPCSTR& shaderFileName) const;
 
 private:
@@ -100,6 +105,8 @@ private:
 
 	bool initializationFailed;
 
+	MeshVertexFormat vertexFormat;
+
 	int vertexBufferResourceCount;
 	int hullBufferResourceCount;
 	int domainBufferResourceCount;
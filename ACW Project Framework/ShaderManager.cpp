@@ -1,24 +1,24 @@
 #include "ShaderManager.h"
 
-ShaderManager::ShaderManager(ID3D11Device* const device, HWND const hwnd) : initializationFailed(false), colourShader(nullptr), lightShader(nullptr), texture2DShader(nullptr), textureCubeShader(nullptr), textureNormalShader(nullptr), textureNormalSpecularShader(nullptr)
+ShaderManager::ShaderManager(ID3D11Device* const device, HWND const hwnd, const MeshVertexFormat vertexFormat) : initializationFailed(false), colourShader(nullptr), lightShader(nullptr), texture2DShader(nullptr), textureCubeShader(nullptr), textureNormalShader(nullptr), textureNormalSpecularShader(nullptr)
 {
-	lightShader = make_shared<LightShader>(device, hwnd);
+	lightShader = make_shared<LightShader>(device, hwnd, vertexFormat);
 	lightShader->GetInitializationState();
 
-	texture2DShader = make_shared<Texture2DShader>(device, hwnd);
+	texture2DShader = make_shared<Texture2DShader>(device, hwnd, vertexFormat);
 	texture2DShader->GetInitializationState();
-	textureCubeShader = make_shared<TextureCubeShader>(device, hwnd);
+	textureCubeShader = make_shared<TextureCubeShader>(device, hwnd, vertexFormat);
 
 	textureCubeShader->GetInitializationState();
-	textureNormalShader = make_shared<TextureNormalMappingShader>(device, hwnd);
+	textureNormalShader = make_shared<TextureNormalMappingShader>(device, hwnd, vertexFormat);
 
 	textureNormalShader->GetInitializationState();
-	textureNormalSpecularShader = make_shared<TextureNormalSpecularShader>(device, hwnd);
+	textureNormalSpecularShader = make_shared<TextureNormalSpecularShader>(device, hwnd, vertexFormat);
 	textureNormalSpecularShader->GetInitializationState();
 
-	textureDisplacementShader = make_shared<TextureDisplacement>(device, hwnd);
+	textureDisplacementShader = make_shared<TextureDisplacement>(device, hwnd, vertexFormat);
 	textureDisplacementShader->GetInitializationState();
-	depthShader = make_shared<DepthShader>(device, hwnd);
+	depthShader = make_shared<DepthShader>(device, hwnd, vertexFormat);
 	depthShader->GetInitializationState();
 }
 
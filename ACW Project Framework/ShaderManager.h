@@ -18,7 +18,7 @@ class ShaderManager
 {
 public:
 
-	ShaderManager(ID3D11Device* const device, HWND const hwnd); //Default Constructor
+	ShaderManager(ID3D11Device* const device, HWND const hwnd, const MeshVertexFormat vertexFormat); //Default Constructor
 	ShaderManager(const ShaderManager& other); //Copy Constructor
 	ShaderManager(ShaderManager&& other) noexcept; //Move Constructor
 	~ShaderManager(); //Destructor
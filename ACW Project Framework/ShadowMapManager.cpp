@@ -1,4 +1,5 @@
 #include "ShadowMapManager.h"
+#include "Profiler.h"
 
 ShadowMapManager::ShadowMapManager(HWND const hwnd, ID3D11Device* const device, const shared_ptr<Shader>& depthShadr, const int lightCount, const int shadowMapWidth, const int shadowMapHeight) : initializationFailed(false), depthShader(nullptr), renderToTextures(), shadowMapShaderResources()
 {
@@ -49,8 +50,10 @@ void ShadowMapManager::AddShadowMap(ID3D11Device* const device, const int shadow
 }
 
 
-bool ShadowMapManager::GenerateShadowMapResources(ID3D11DeviceContext* const deviceContext, ID3D11DepthStencilView* const depthStencilView, const vector<shared_ptr<Light>>& pointLightList, const vector<shared_ptr<GameObject>>& gameObjects, const XMFLOAT3& cameraPosition)
+bool ShadowMapManager::GenerateShadowMapResources(RenderContext* const deviceContext, ID3D11DepthStencilView* const depthStencilView, const vector<shared_ptr<Light>>& pointLightList, const FrameVector<GameObject*>& gameObjects, const XMFLOAT3& cameraPosition)
 {
+	const ProfileZone zone("ShadowMapManager::GenerateShadowMapResources");
+
 	auto result = true;
 
 	shadowMapShaderResources.clear();
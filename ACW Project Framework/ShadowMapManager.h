@@ -3,6 +3,7 @@
 #include <d3d11.h>
 #include <DirectXMath.h>
 #include "Shader.h"
+#include "FrameArena.h"
 #include "GameObject.h"
 #include "TextureRenderer.h"
 
@@ -21,7 +22,7 @@ public:
 
 	void AddShadowMap(ID3D11Device* const device, const int shadowMapWidth, const int shadowMapHeight);
 
-	bool GenerateShadowMapResources(ID3D11DeviceContext* const deviceContext, ID3D11DepthStencilView* const depthStencilView, const vector<shared_ptr<Light>>& pointLightList, const vector<shared_ptr<GameObject>>& gameObjects, const XMFLOAT3& cameraPosition);
+	bool GenerateShadowMapResources(RenderContext* const deviceContext, ID3D11DepthStencilView* const depthStencilView, const vector<shared_ptr<Light>>& pointLightList, const FrameVector<GameObject*>& gameObjects, const XMFLOAT3& cameraPosition);
 
 	const vector<ID3D11ShaderResourceView*>& GetShadowMapResources() const;
 
@@ -21,7 +21,11 @@ SimulationConfigLoader::SimulationConfigLoader(const char* const configurationFi
     moonlightSpecularIntensity(0.0f),
     launchPadScale(XMFLOAT3()),
     launchPadTessellationSettings(XMFLOAT4()),
-    launchPadDisplacementSettings(XMFLOAT4()) {
+    launchPadDisplacementSettings(XMFLOAT4()),
+    simulationTimeStep(1.0f / 60.0f),
+    headlessFrameCount(600),
+    inputRecordFile(),
+    vertexFormat(MeshVertexFormat::Full) {
     LoadConfiguration(configurationFile);
 }
 
@@ -46,7 +50,15 @@ void SimulationConfigLoader::LoadConfiguration(const char* const configurationFi
         {"MoonlightSpecularIntensity", [&] { fileStream >> moonlightSpecularIntensity; }},
         {"LaunchPadInitialScale", [&] { launchPadScale = ReadXMFLOAT3(fileStream); }},
         {"LaunchPadTessellationSettings", [&] { launchPadTessellationSettings = ReadXMFLOAT4(fileStream); }},
-        {"LaunchPadDisplacementSettings", [&] { launchPadDisplacementSettings = ReadXMFLOAT4(fileStream); }}
+        {"LaunchPadDisplacementSettings", [&] { launchPadDisplacementSettings = ReadXMFLOAT4(fileStream); }},
+        {"SimulationTimeStep", [&] { fileStream >> simulationTimeStep; }},
+        {"HeadlessFrameCount", [&] { fileStream >> headlessFrameCount; }},
+        {"InputRecordFile", [&] { fileStream >> inputRecordFile; }},
+        {"VertexFormat", [&] {
+            std::string format;
+            fileStream >> format;
+            vertexFormat = format == "Compact" ? MeshVertexFormat::Compact : format == "CompactQuantized" ? MeshVertexFormat::CompactQuantized : MeshVertexFormat::Full;
+        }}
     };
 
     std::string command;
@@ -157,3 +169,23 @@ const XMFLOAT4& SimulationConfigLoader::GetLaunchPadDisplacementValues() const
 {
     return  launchPadDisplacementSettings;
 }
+
+const float SimulationConfigLoader::GetSimulationTimeStep() const
+{
+    return  simulationTimeStep;
+}
+
+const int SimulationConfigLoader::GetHeadlessFrameCount() const
+{
+    return  headlessFrameCount;
+}
+
+const string& SimulationConfigLoader::GetInputRecordFile() const
+{
+    return  inputRecordFile;
+}
+
+const MeshVertexFormat SimulationConfigLoader::GetVertexFormat() const
+{
+    return  vertexFormat;
+}
@@ -1,7 +1,9 @@
 #pragma once
 #include <DirectXMath.h>
 #include <fstream>
-#include <d3d11.h>
+#include <string>
+
+#include "MeshVertex.h"
 
 using namespace DirectX;
 using namespace std;
@@ -41,6 +43,13 @@ public:
 	const XMFLOAT4& GetLaunchPadTessellationValues() const;
 	const XMFLOAT4& GetLaunchPadDisplacementValues() const;
 
+	const float GetSimulationTimeStep() const;
+	const int GetHeadlessFrameCount() const;
+	//Where the window records its input for headless replays, empty if it shouldn't
+	const string& GetInputRecordFile() const;
+	//Full, Compact or CompactQuantized, anything else is Full
+	const MeshVertexFormat GetVertexFormat() const;
+
 private:
 
 	XMFLOAT3  rocketPosition;
@@ -66,4 +75,9 @@ private:
 	XMFLOAT4  launchPadTessellationSettings;
 	XMFLOAT4  launchPadDisplacementSettings;
 
+	float  simulationTimeStep;
+	int  headlessFrameCount;
+	string  inputRecordFile;
+	MeshVertexFormat  vertexFormat;
+
 };
@@ -0,0 +1,252 @@
+#include "SimulationWorld.h"
+#include "Profiler.h"
+
+SimulationWorld::SimulationWorld(const shared_ptr<SimulationConfigLoader>& configuration) : timeScale(1), updateCamera(false), cameraMode(0), collisionCount(0), camera(nullptr), lightManager(nullptr), terrain(nullptr), rocket(nullptr), jobSystem(nullptr), lightJobs(), snapshots(), publishedSnapshot(0)
+{
+	camera = make_shared<Camera>();
+	camera->SetPosition(configuration->GetCameraPosition());
+
+	lightManager = make_shared<LightManager>();
+
+	const auto terrainDimensions = configuration->GetTerrainDimensions();
+	auto rocketPosition = configuration->GetRocketPosition();
+	rocketPosition.x += -terrainDimensions.z;
+
+	terrain = make_shared<TerrainSimulation>(TERRAIN_VOXEL_AREA, TERRAIN_CUBE_SCALE);
+	rocket = make_shared<RocketSimulation>(rocketPosition, configuration->GetRocketRotation(), configuration->GetRocketScale());
+
+	lightManager->AddLight(XMFLOAT3(0.0f, 0.0f, -terrainDimensions.z), XMFLOAT3(0.0f, 0.0f, 0.0f), configuration->GetSunAmbient(), configuration->GetSunDiffuse(), configuration->GetSunSpecular(), configuration->GetSunSpecularPower(), terrainDimensions.x, terrainDimensions.z, 1, terrainDimensions.z, true, true);
+	lightManager->AddLight(XMFLOAT3(-terrainDimensions.x, -terrainDimensions.x, 0.0f), XMFLOAT3(0.0f, 0.0f, 0.0f), configuration->GetSunAmbient(), configuration->GetMoonDiffuse(), configuration->GetMoonSpecular(), configuration->GetMoonSpecularPower(), terrainDimensions.z, terrainDimensions.x, 1, terrainDimensions.x, true, true);
+
+	//Both start as the initial state, after this they are only copied into so the renderer's pointers stay valid
+	for (auto& snapshot : snapshots)
+	{
+		snapshot.camera = make_shared<Camera>(*camera);
+
+		for (const auto& light : lightManager->GetLightList())
+		{
+			snapshot.lights.push_back(make_shared<Light>(*light));
+		}
+	}
+}
+
+SimulationWorld::SimulationWorld(const SimulationWorld& other) = default;
+
+SimulationWorld::SimulationWorld(SimulationWorld&& other) noexcept = default;
+
+SimulationWorld::~SimulationWorld() = default;
+
+SimulationWorld& SimulationWorld::operator=(const SimulationWorld& other) = default;
+
+SimulationWorld& SimulationWorld::operator=(SimulationWorld&& other) noexcept = default;
+
+const shared_ptr<Camera>& SimulationWorld::GetCamera() const
+{
+	return camera;
+}
+
+const shared_ptr<LightManager>& SimulationWorld::GetLightManager() const
+{
+	return lightManager;
+}
+
+const shared_ptr<TerrainSimulation>& SimulationWorld::GetTerrain() const
+{
+	return terrain;
+}
+
+const shared_ptr<RocketSimulation>& SimulationWorld::GetRocket() const
+{
+	return rocket;
+}
+
+int SimulationWorld::GetTimeScale() const
+{
+	return timeScale;
+}
+
+int SimulationWorld::GetCameraMode() const
+{
+	return cameraMode;
+}
+
+int SimulationWorld::GetCollisionCount() const
+{
+	return collisionCount;
+}
+
+//FNV-1a over the bytes of value
+template <typename T>
+static void HashValue(unsigned long long& hash, const T& value)
+{
+	const auto* const bytes = reinterpret_cast<const unsigned char*>(&value);
+
+	for (auto i = size_t(0); i < sizeof(T); i++)
+	{
+		hash = (hash ^ bytes[i]) * 1099511628211ull;
+	}
+}
+
+unsigned long long SimulationWorld::GetStateChecksum() const
+{
+	auto hash = 14695981039346656037ull;
+
+	HashValue(hash, timeScale);
+	HashValue(hash, cameraMode);
+	HashValue(hash, collisionCount);
+
+	HashValue(hash, rocket->RocketLaunched());
+	HashValue(hash, rocket->GetBodyPosition());
+	HashValue(hash, rocket->GetBodyRotation());
+
+	HashValue(hash, terrain->GetRevision());
+
+	for (auto instance = 0; instance < terrain->GetInstanceCount(); instance++)
+	{
+		HashValue(hash, terrain->IsInstanceStanding(instance));
+	}
+
+	HashValue(hash, camera->GetPosition());
+	HashValue(hash, camera->GetRotation());
+
+	for (const auto& light : lightManager->GetLightList())
+	{
+		HashValue(hash, light->GetLightPosition());
+	}
+
+	return hash;
+}
+
+void SimulationWorld::ResetToInitialState() const {
+	rocket->ResetRocketState();
+	terrain->ResetTerrainState();
+}
+
+void SimulationWorld::AddTimeScale(const int number)
+{
+	timeScale = (timeScale + number < 1) ? 1 : timeScale + number;
+}
+
+void SimulationWorld::RotateRocketLeft() const {
+	rocket->AdjustRotationLeft();
+}
+
+void SimulationWorld::RotateRocketRight() const {
+	rocket->AdjustRotationRight();
+}
+
+void SimulationWorld::LaunchRocket() const {
+	rocket->LaunchRocket();
+}
+
+void SimulationWorld::ChangeCameraMode(const int camMode) {
+	cameraMode = camMode;
+	updateCamera = (cameraMode >= 2 && cameraMode <= 4);
+
+	switch (cameraMode) {
+	case 0: {
+		const auto position = rocket->GetLauncherPosition();
+		camera->SetPosition(position.x, position.y, position.z - 10.0f);
+		camera->SetRotation(0.0f, 0.0f, 0.0f);
+		break;
+	}
+	case 1:
+		camera->SetPosition(0.0f, 10.0f, -30.0f);
+		camera->SetRotation(0.0f, 45.0f, 0.0f);
+		break;
+	default:
+		camera->SetRotation(0.0f, 0.0f, 0.0f);
+		break;
+	}
+}
+
+void SimulationWorld::SetJobSystem(JobSystem* const jobSystem)
+{
+	this->jobSystem = jobSystem;
+}
+
+void SimulationWorld::UpdateFrame(const float dt) {
+	const ProfileZone zone("SimulationWorld::UpdateFrame");
+
+	const auto scaledDt = dt * timeScale;
+
+	//The lights don't depend on anything else in the frame
+	UpdateLights(scaledDt);
+
+	XMFLOAT3 collisionPosition;
+	float blastRadius = 0.0f;
+
+	if (rocket->CheckForTerrainCollision(terrain, collisionPosition, blastRadius))
+	{
+		collisionCount++;
+	}
+
+	rocket->UpdateRocket(scaledDt);
+
+	UpdateCameraPosition();
+
+	if (jobSystem)
+	{
+		jobSystem->Wait(lightJobs);
+	}
+
+	WriteSnapshot(snapshots[1 - publishedSnapshot]);
+}
+
+const WorldSnapshot& SimulationWorld::GetPublishedSnapshot() const
+{
+	return snapshots[publishedSnapshot];
+}
+
+void SimulationWorld::PublishSnapshot()
+{
+	publishedSnapshot = 1 - publishedSnapshot;
+}
+
+void SimulationWorld::UpdateCameraPosition() const {
+	if (!updateCamera) return;
+
+	XMFLOAT3 cameraPosition;
+	switch (cameraMode) {
+	case 2:
+		cameraPosition = rocket->GetLookAtRocketPosition();
+		cameraPosition.z -= 20.0f;
+		break;
+	case 3:
+		cameraPosition = rocket->GetLookAtRocketConePosition();
+		cameraPosition.z -= 3.0f;
+		break;
+	case 4:
+		cameraPosition = rocket->GetLookAtRocketPosition();
+		cameraPosition.z -= 3.0f;
+		break;
+	default:
+		return;
+	}
+
+	camera->SetPosition(cameraPosition.x, cameraPosition.y, cameraPosition.z);
+}
+
+void SimulationWorld::UpdateLights(const float dt) {
+	lightJobs.clear();
+
+	for (const auto& light : lightManager->GetLightList()) {
+		if (jobSystem) {
+			auto* const lightToUpdate = light.get();
+			lightJobs.push_back(jobSystem->Add([lightToUpdate, dt]() { lightToUpdate->UpdateLightVariables(dt); }));
+		}
+		else {
+			light->UpdateLightVariables(dt);
+		}
+	}
+}
+
+void SimulationWorld::WriteSnapshot(WorldSnapshot& snapshot) const {
+	*snapshot.camera = *camera;
+
+	const auto& lights = lightManager->GetLightList();
+
+	for (size_t i = 0; i < lights.size(); i++) {
+		*snapshot.lights[i] = *lights[i];
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <memory>
+
+#include "Camera.h"
+#include "JobSystem.h"
+#include "LightManager.h"
+#include "RocketSimulation.h"
+#include "TerrainSimulation.h"
+#include "SimulationConfigLoader.h"
+
+using namespace DirectX;
+using namespace std;
+
+//The terrain the scene is built with, Configuration.txt TerrainSize is used for the launch pad and lights
+const XMFLOAT3 TERRAIN_VOXEL_AREA = XMFLOAT3(80, 10, 40);
+const XMFLOAT3 TERRAIN_CUBE_SCALE = XMFLOAT3(1, 1, 1);
+
+//Camera and lights as they were at the end of a step
+struct WorldSnapshot
+{
+	shared_ptr<Camera> camera;
+	vector<shared_ptr<Light>> lights;
+};
+
+//Owns all of the simulation state of the scene without any dependency on Direct3D or Win32.
+//GraphicsRenderer steps this once per frame and then only reads from it, the headless build steps it on its own
+class SimulationWorld
+{
+public:
+	explicit SimulationWorld(const shared_ptr<SimulationConfigLoader>& configuration);
+	SimulationWorld(const SimulationWorld& other); // Copy Constructor
+	SimulationWorld(SimulationWorld&& other) noexcept; // Move Constructor
+	~SimulationWorld(); // Destructor
+
+	SimulationWorld& operator = (const SimulationWorld& other); // Copy Assignment Operator
+	SimulationWorld& operator = (SimulationWorld&& other) noexcept; // Move Assignment Operator
+
+	const shared_ptr<Camera>& GetCamera() const;
+	const shared_ptr<LightManager>& GetLightManager() const;
+	const shared_ptr<TerrainSimulation>& GetTerrain() const;
+	const shared_ptr<RocketSimulation>& GetRocket() const;
+
+	int GetTimeScale() const;
+	int GetCameraMode() const;
+	int GetCollisionCount() const;
+
+	//Hashes the rocket, terrain, camera, lights and counters so two runs can be checked for ending up the same
+	unsigned long long GetStateChecksum() const;
+
+	void ResetToInitialState() const;
+	void AddTimeScale(const int number);
+	void RotateRocketLeft() const;
+	void RotateRocketRight() const;
+	void LaunchRocket() const;
+	void ChangeCameraMode(const int cameraMode);
+
+	//Lights are updated as jobs on this while the rocket steps, nullptr updates everything on the calling thread
+	void SetJobSystem(JobSystem* const jobSystem);
+
+	//Steps the simulation by dt seconds of real time, the time scale is applied here
+	void UpdateFrame(const float dt);
+
+	//The renderer draws from the published snapshot while the next step writes the other one.
+	//PublishSnapshot makes the last finished step the published one, call it while UpdateFrame isn't running
+	const WorldSnapshot& GetPublishedSnapshot() const;
+	void PublishSnapshot();
+
+private:
+	void UpdateCameraPosition() const;
+	void UpdateLights(const float dt);
+	void WriteSnapshot(WorldSnapshot& snapshot) const;
+
+	int timeScale;
+	bool updateCamera;
+	int cameraMode;
+	int collisionCount;
+
+	shared_ptr<Camera> camera;
+	shared_ptr<LightManager> lightManager;
+
+	shared_ptr<TerrainSimulation> terrain;
+	shared_ptr<RocketSimulation> rocket;
+
+	JobSystem* jobSystem;
+	vector<JobHandle> lightJobs;
+
+	WorldSnapshot snapshots[2];
+	int publishedSnapshot;
+};
@@ -13,7 +13,7 @@ void SmokeParticleSystem::UpdateSmokeParticleSystem(const float dt)
 	UpdateParticles(dt);
 }
 
-bool SmokeParticleSystem::RenderSmokeParticleSystem(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition) const
+bool SmokeParticleSystem::RenderSmokeParticleSystem(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition) const
 {
 	return RenderParticles(deviceContext, viewMatrix, projectionMatrix, cameraPosition);
 }
\ No newline at end of file
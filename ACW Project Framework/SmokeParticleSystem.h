@@ -13,6 +13,6 @@ public:
 	SmokeParticleSystem& operator = (SmokeParticleSystem&& other) noexcept;
 
 	void UpdateSmokeParticleSystem(const float dt);
-	bool RenderSmokeParticleSystem(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition) const;
+	bool RenderSmokeParticleSystem(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const XMFLOAT3& cameraPosition) const;
 };
 
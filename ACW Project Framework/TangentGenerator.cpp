@@ -0,0 +1,152 @@
+#include "TangentGenerator.h"
+#include <cmath>
+
+//Lengths below this are treated as zero
+static const float TANGENT_EPSILON = 1e-12f;
+
+static XMVECTOR Orthogonal(const XMVECTOR& normal)
+{
+	//Any direction perpendicular to the normal, for vertices whose texture coordinates don't define one
+	const auto axis = fabs(XMVectorGetX(normal)) < 0.9f ? XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f) : XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+	return XMVector3Normalize(XMVector3Cross(normal, axis));
+}
+
+void TangentGenerator::Generate(MeshVertex* const vertices, const int vertexCount, const vector<uint32_t>& indices, JobSystem* const jobSystem)
+{
+	const auto triangleCount = static_cast<int>(indices.size() / 3);
+
+	//Every corner's share of its vertex's frame, written by one triangle so the triangles can run in parallel
+	vector<CornerFrame> cornerFrames(indices.size());
+
+	//The corners each vertex is at, as ranges of one array, so every vertex sums its own corners without locking
+	vector<int> firstCorner(vertexCount + 1, 0);
+
+	for (const auto index : indices)
+	{
+		firstCorner[index + 1]++;
+	}
+
+	for (auto vertex = 0; vertex < vertexCount; vertex++)
+	{
+		firstCorner[vertex + 1] += firstCorner[vertex];
+	}
+
+	vector<int> vertexCorners(indices.size());
+	vector<int> filledCorners(firstCorner.begin(), firstCorner.end() - 1);
+
+	for (auto corner = 0; corner < static_cast<int>(indices.size()); corner++)
+	{
+		vertexCorners[filledCorners[indices[corner]]++] = corner;
+	}
+
+	if (jobSystem)
+	{
+		jobSystem->ParallelFor(triangleCount, TANGENT_TRIANGLE_CHUNK_SIZE, [&](const int first, const int last)
+		{
+			AccumulateTriangles(vertices, indices, first, last, cornerFrames);
+		});
+
+		jobSystem->ParallelFor(vertexCount, TANGENT_VERTEX_CHUNK_SIZE, [&](const int first, const int last)
+		{
+			ResolveVertices(vertices, firstCorner, vertexCorners, cornerFrames, first, last);
+		});
+	}
+	else
+	{
+		AccumulateTriangles(vertices, indices, 0, triangleCount, cornerFrames);
+		ResolveVertices(vertices, firstCorner, vertexCorners, cornerFrames, 0, vertexCount);
+	}
+}
+
+void TangentGenerator::AccumulateTriangles(const MeshVertex* const vertices, const vector<uint32_t>& indices, const int firstTriangle, const int lastTriangle, vector<CornerFrame>& cornerFrames)
+{
+	for (auto triangle = firstTriangle; triangle < lastTriangle; triangle++)
+	{
+		const MeshVertex* corners[3] = { &vertices[indices[triangle * 3]], &vertices[indices[triangle * 3 + 1]], &vertices[indices[triangle * 3 + 2]] };
+
+		XMVECTOR positions[3];
+		XMVECTOR textures[3];
+
+		for (auto corner = 0; corner < 3; corner++)
+		{
+			positions[corner] = XMLoadFloat3(&corners[corner]->position);
+			textures[corner] = XMLoadFloat2(&corners[corner]->texture);
+		}
+
+		const auto edge1 = XMVectorSubtract(positions[1], positions[0]);
+		const auto edge2 = XMVectorSubtract(positions[2], positions[0]);
+		const auto deltaUV1 = XMVectorSubtract(textures[1], textures[0]);
+		const auto deltaUV2 = XMVectorSubtract(textures[2], textures[0]);
+
+		//Solves edge = deltaU * tangent + deltaV * binormal, only the directions matter so the determinant's size doesn't
+		const auto det = XMVectorGetX(deltaUV1) * XMVectorGetY(deltaUV2) - XMVectorGetX(deltaUV2) * XMVectorGetY(deltaUV1);
+		const auto invDet = det == 0.0f ? 0.0f : 1.0f / det;
+
+		const auto faceTangent = XMVectorScale(XMVectorSubtract(XMVectorScale(edge1, XMVectorGetY(deltaUV2)), XMVectorScale(edge2, XMVectorGetY(deltaUV1))), invDet);
+		const auto faceBinormal = XMVectorScale(XMVectorSubtract(XMVectorScale(edge2, XMVectorGetX(deltaUV1)), XMVectorScale(edge1, XMVectorGetX(deltaUV2))), invDet);
+		const auto faceNormal = XMVector3Normalize(XMVector3Cross(edge1, edge2));
+
+		for (auto corner = 0; corner < 3; corner++)
+		{
+			const auto toNext = XMVector3Normalize(XMVectorSubtract(positions[(corner + 1) % 3], positions[corner]));
+			const auto toPrevious = XMVector3Normalize(XMVectorSubtract(positions[(corner + 2) % 3], positions[corner]));
+			const auto angle = acos(fmin(fmax(XMVectorGetX(XMVector3Dot(toNext, toPrevious)), -1.0f), 1.0f));
+
+			//Projected onto the plane of the normal the vertex will end up with
+			auto normal = XMLoadFloat3(&corners[corner]->normal);
+			normal = XMVectorGetX(XMVector3LengthSq(normal)) > TANGENT_EPSILON ? XMVector3Normalize(normal) : faceNormal;
+
+			const auto tangent = XMVector3Normalize(XMVectorSubtract(faceTangent, XMVectorScale(normal, XMVectorGetX(XMVector3Dot(normal, faceTangent)))));
+			const auto binormal = XMVector3Normalize(XMVectorSubtract(faceBinormal, XMVectorScale(normal, XMVectorGetX(XMVector3Dot(normal, faceBinormal)))));
+
+			auto& cornerFrame = cornerFrames[triangle * 3 + corner];
+			XMStoreFloat3(&cornerFrame.tangent, XMVectorScale(tangent, angle));
+			XMStoreFloat3(&cornerFrame.binormal, XMVectorScale(binormal, angle));
+			XMStoreFloat3(&cornerFrame.normal, XMVectorScale(faceNormal, angle));
+		}
+	}
+}
+
+void TangentGenerator::ResolveVertices(MeshVertex* const vertices, const vector<int>& firstCorner, const vector<int>& vertexCorners, const vector<CornerFrame>& cornerFrames, const int firstVertex, const int lastVertex)
+{
+	for (auto vertex = firstVertex; vertex < lastVertex; vertex++)
+	{
+		auto tangent = XMVectorZero();
+		auto binormal = XMVectorZero();
+		auto faceNormal = XMVectorZero();
+
+		for (auto i = firstCorner[vertex]; i < firstCorner[vertex + 1]; i++)
+		{
+			const auto& cornerFrame = cornerFrames[vertexCorners[i]];
+
+			tangent = XMVectorAdd(tangent, XMLoadFloat3(&cornerFrame.tangent));
+			binormal = XMVectorAdd(binormal, XMLoadFloat3(&cornerFrame.binormal));
+			faceNormal = XMVectorAdd(faceNormal, XMLoadFloat3(&cornerFrame.normal));
+		}
+
+		auto normal = XMLoadFloat3(&vertices[vertex].normal);
+
+		if (XMVectorGetX(XMVector3LengthSq(normal)) > TANGENT_EPSILON)
+		{
+			normal = XMVector3Normalize(normal);
+		}
+		else if (XMVectorGetX(XMVector3LengthSq(faceNormal)) > TANGENT_EPSILON)
+		{
+			normal = XMVector3Normalize(faceNormal);
+		}
+		else
+		{
+			normal = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+		}
+
+		//Gram-Schmidt, the sum of projected tangents can still lean off the plane once it is normalised
+		tangent = XMVectorSubtract(tangent, XMVectorScale(normal, XMVectorGetX(XMVector3Dot(normal, tangent))));
+		tangent = XMVectorGetX(XMVector3LengthSq(tangent)) > TANGENT_EPSILON ? XMVector3Normalize(tangent) : Orthogonal(normal);
+
+		const auto handedness = XMVectorGetX(XMVector3Dot(XMVector3Cross(normal, tangent), binormal)) < 0.0f ? -1.0f : 1.0f;
+
+		XMStoreFloat3(&vertices[vertex].normal, normal);
+		XMStoreFloat3(&vertices[vertex].tangent, tangent);
+		XMStoreFloat3(&vertices[vertex].binormal, XMVectorScale(XMVector3Cross(normal, tangent), handedness));
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "JobSystem.h"
+#include "MeshVertex.h"
+
+using namespace std;
+
+//Triangles and vertices each job of Generate works on
+const int TANGENT_TRIANGLE_CHUNK_SIZE = 1024;
+const int TANGENT_VERTEX_CHUNK_SIZE = 1024;
+
+//Builds a smooth tangent frame for every vertex of an indexed mesh, accumulated over the triangles that share it.
+//Like MikkTSpace each triangle adds its tangent projected onto the vertex's normal and weighted by the angle of its
+//corner, so the frame doesn't depend on how the surface was split into triangles. Normals the model was authored
+//with are kept, vertices without one get the angle weighted average of their faces' normals.
+//The binormal is the normal crossed with the tangent, flipped where the texture is mirrored.
+//Vertices that mirror the texture in some triangles and not others get one frame between them rather than being split
+class TangentGenerator
+{
+public:
+	//Triangles then vertices are split across the job system's threads, nullptr runs everything on the calling thread
+	static void Generate(MeshVertex* const vertices, const int vertexCount, const vector<uint32_t>& indices, JobSystem* const jobSystem);
+
+private:
+	struct CornerFrame
+	{
+		XMFLOAT3 tangent;
+		XMFLOAT3 binormal;
+		XMFLOAT3 normal;
+	};
+
+	static void AccumulateTriangles(const MeshVertex* const vertices, const vector<uint32_t>& indices, const int firstTriangle, const int lastTriangle, vector<CornerFrame>& cornerFrames);
+	static void ResolveVertices(MeshVertex* const vertices, const vector<int>& firstCorner, const vector<int>& vertexCorners, const vector<CornerFrame>& cornerFrames, const int firstVertex, const int lastVertex);
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "GameObject.h"
+#include "TerrainSimulation.h"
 
 using namespace std;
 using namespace DirectX;
@@ -8,23 +9,19 @@ using namespace DirectX;
 class Terrain : public GameObject
 {
 public:
-	Terrain(ID3D11Device* const device, const XMFLOAT3& voxelArea, const XMFLOAT3& cubeScale, const shared_ptr<Shader>& shader, const shared_ptr<ResourceManager>& resourceManager);
+	Terrain(ID3D11Device* const device, const shared_ptr<TerrainSimulation>& terrainSimulation, const shared_ptr<Shader>& shader, const shared_ptr<ResourceManager>& resourceManager);
 	~Terrain();
 
-	void ResetTerrainState();
+	//Pulls any destroyed or restored cubes from the simulation before updating the instance data
+	void UpdateTerrain(const shared_ptr<TerrainSimulation>& terrainSimulation);
+	bool RenderTerrain(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) const;
 
-	void UpdateTerrain();
-	bool RenderTerrain(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) const;
-
-	void InitializeTerrainParameters(const XMFLOAT3& voxelArea, const XMFLOAT3& cubeScale);
-
-	void InitializeTerrainPositions(const XMFLOAT3& voxelArea, const XMFLOAT3& cubeScale);
-
-	void AddComponents(ID3D11Device* const device, const shared_ptr<Shader>& shader, const shared_ptr<ResourceManager>& resourceManager, const vector<const WCHAR*>& textureNames);
+	void AddComponents(ID3D11Device* const device, const shared_ptr<TerrainSimulation>& terrainSimulation, const shared_ptr<Shader>& shader, const shared_ptr<ResourceManager>& resourceManager, const vector<const WCHAR*>& textureNames);
 
 private:
 	bool initializationFailed;
 
-	vector<XMFLOAT3> initialTerrainPositions;
+	unsigned int terrainRevision;
+	vector<int> changedInstances;
 };
 
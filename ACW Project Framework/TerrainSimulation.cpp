@@ -0,0 +1,196 @@
+#include "TerrainSimulation.h"
+
+TerrainSimulation::TerrainSimulation(const XMFLOAT3& voxelArea, const XMFLOAT3& scale) : revision(0), cubeScale(scale), voxelGrid(CreateVoxelGrid(voxelArea, scale)), queryResults(), changeLogStartRevision(0), changeLogHead(0), changeLogCount(0), changeLog(TERRAIN_CHANGE_LOG_CAPACITY)
+{
+    ResetChangeLog();
+}
+
+TerrainSimulation::TerrainSimulation(const TerrainSimulation& other) = default;
+
+TerrainSimulation::TerrainSimulation(TerrainSimulation&& other) noexcept = default;
+
+TerrainSimulation::~TerrainSimulation() = default;
+
+TerrainSimulation& TerrainSimulation::operator=(const TerrainSimulation& other) = default;
+
+TerrainSimulation& TerrainSimulation::operator=(TerrainSimulation&& other) noexcept = default;
+
+VoxelGrid TerrainSimulation::CreateVoxelGrid(const XMFLOAT3& voxelArea, const XMFLOAT3& scale)
+{
+    //Same layout the cubes were always placed with, the terrain sits just below y = 0
+    const int x = static_cast<int>(voxelArea.x / 2);
+    const int y = static_cast<int>(voxelArea.y);
+    const int z = static_cast<int>(voxelArea.z / 2);
+    const int cubeScaleX = static_cast<int>(scale.x);
+    const int cubeScaleY = static_cast<int>(scale.y);
+    const int cubeScaleZ = static_cast<int>(scale.z);
+
+    const auto startX = -x * cubeScaleX;
+    const auto startY = -y * cubeScaleY - cubeScaleY / 2;
+    const auto startZ = -z * cubeScaleZ;
+    const auto endY = -(cubeScaleY / 2);
+
+    const auto dimensions = XMINT3((x - startX + cubeScaleX - 1) / cubeScaleX, (endY - startY + cubeScaleY - 1) / cubeScaleY, (z - startZ + cubeScaleZ - 1) / cubeScaleZ);
+
+    return VoxelGrid(dimensions, XMFLOAT3(startX, startY, startZ), XMFLOAT3(cubeScaleX, cubeScaleY, cubeScaleZ));
+}
+
+int TerrainSimulation::GetInstanceCount() const
+{
+    return voxelGrid.GetVoxelCount();
+}
+
+int TerrainSimulation::GetCubeCount() const
+{
+    return voxelGrid.GetOccupiedCount();
+}
+
+bool TerrainSimulation::IsInstanceStanding(const int instance) const
+{
+    const auto voxel = voxelGrid.GetIndexCoordinates(instance);
+    return voxelGrid.IsOccupied(voxel.x, voxel.y, voxel.z);
+}
+
+XMFLOAT3 TerrainSimulation::GetInstancePosition(const int instance) const
+{
+    const auto voxel = voxelGrid.GetIndexCoordinates(instance);
+    return voxelGrid.GetVoxelPosition(voxel.x, voxel.y, voxel.z);
+}
+
+XMFLOAT3 TerrainSimulation::GetInstanceScale(const int instance) const
+{
+    return IsInstanceStanding(instance) ? cubeScale : XMFLOAT3(0.0f, 0.0f, 0.0f);
+}
+
+void TerrainSimulation::GetInstancePositions(vector<XMFLOAT3>& outPositions) const
+{
+    outPositions.resize(GetInstanceCount());
+
+    for (auto instance = 0; instance < GetInstanceCount(); instance++)
+    {
+        outPositions[instance] = GetInstancePosition(instance);
+    }
+}
+
+void TerrainSimulation::GetInstanceScales(vector<XMFLOAT3>& outScales) const
+{
+    outScales.resize(GetInstanceCount());
+
+    for (auto instance = 0; instance < GetInstanceCount(); instance++)
+    {
+        outScales[instance] = GetInstanceScale(instance);
+    }
+}
+
+const XMFLOAT3& TerrainSimulation::GetCubeScale() const
+{
+    return cubeScale;
+}
+
+const VoxelGrid& TerrainSimulation::GetVoxelGrid() const
+{
+    return voxelGrid;
+}
+
+size_t TerrainSimulation::GetMemoryUsage() const
+{
+    return voxelGrid.GetMemoryUsage() + queryResults.capacity() * sizeof(XMINT3) + changeLog.capacity() * sizeof(pair<unsigned int, int>);
+}
+
+unsigned int TerrainSimulation::GetRevision() const
+{
+    return revision;
+}
+
+bool TerrainSimulation::GetChangedInstances(const unsigned int sinceRevision, vector<int>& outInstances) const
+{
+    if (sinceRevision < changeLogStartRevision)
+    {
+        return false;
+    }
+
+    //The log is in revision order so only the newest entries can be after sinceRevision
+    auto newer = 0;
+
+    while (newer < changeLogCount && changeLog[(changeLogHead - newer - 1 + TERRAIN_CHANGE_LOG_CAPACITY) % TERRAIN_CHANGE_LOG_CAPACITY].first > sinceRevision)
+    {
+        newer++;
+    }
+
+    for (auto i = newer; i > 0; i--)
+    {
+        outInstances.push_back(changeLog[(changeLogHead - i + TERRAIN_CHANGE_LOG_CAPACITY) % TERRAIN_CHANGE_LOG_CAPACITY].second);
+    }
+
+    return true;
+}
+
+bool TerrainSimulation::DestroyCube(const int x, const int y, const int z)
+{
+    if (!voxelGrid.Remove(x, y, z))
+    {
+        return false;
+    }
+
+    revision++;
+
+    LogChange(voxelGrid.GetIndex(x, y, z));
+
+    return true;
+}
+
+int TerrainSimulation::DestroyCubesInSphere(const XMFLOAT3& centre, const float radius)
+{
+    queryResults.clear();
+    voxelGrid.GetOccupiedInSphere(centre, radius, queryResults);
+
+    if (queryResults.empty())
+    {
+        return 0;
+    }
+
+    revision++;
+
+    for (const auto& voxel : queryResults)
+    {
+        voxelGrid.Remove(voxel.x, voxel.y, voxel.z);
+        LogChange(voxelGrid.GetIndex(voxel.x, voxel.y, voxel.z));
+    }
+
+    return static_cast<int>(queryResults.size());
+}
+
+void TerrainSimulation::ResetTerrainState()
+{
+    if (voxelGrid.GetOccupiedCount() != voxelGrid.GetVoxelCount())
+    {
+        voxelGrid.Fill();
+        revision++;
+
+        ResetChangeLog();
+    }
+}
+
+void TerrainSimulation::ResetChangeLog()
+{
+    //Anyone older than this has to rebuild everything
+    changeLogStartRevision = revision;
+    changeLogHead = 0;
+    changeLogCount = 0;
+}
+
+void TerrainSimulation::LogChange(const int instance)
+{
+    if (changeLogCount == TERRAIN_CHANGE_LOG_CAPACITY)
+    {
+        //Overwriting the oldest entry, readers from before its revision can no longer catch up from the log
+        changeLogStartRevision = max(changeLogStartRevision, changeLog[changeLogHead].first);
+    }
+    else
+    {
+        changeLogCount++;
+    }
+
+    changeLog[changeLogHead] = make_pair(revision, instance);
+    changeLogHead = (changeLogHead + 1) % TERRAIN_CHANGE_LOG_CAPACITY;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <DirectXMath.h>
+#include <utility>
+#include <vector>
+
+#include "VoxelGrid.h"
+
+using namespace DirectX;
+using namespace std;
+
+//Destroyed instances remembered for readers that fall behind, anyone further back rebuilds every instance
+const int TERRAIN_CHANGE_LOG_CAPACITY = 1024;
+
+//Platform neutral terrain state, the Terrain game object reads its cube positions from here when rendering
+class TerrainSimulation
+{
+public:
+	TerrainSimulation(const XMFLOAT3& voxelArea, const XMFLOAT3& cubeScale);
+	TerrainSimulation(const TerrainSimulation& other); // Copy Constructor
+	TerrainSimulation(TerrainSimulation&& other) noexcept; // Move Constructor
+	~TerrainSimulation(); // Destructor
+
+	TerrainSimulation& operator = (const TerrainSimulation& other); // Copy Assignment Operator
+	TerrainSimulation& operator = (TerrainSimulation&& other) noexcept; // Move Assignment Operator
+
+	//One instance per voxel in voxel index order. Destroyed cubes keep their slot so no other instance ever moves, and
+	//nothing but the grid is stored, positions and scales are worked out from the voxel when asked for
+	int GetInstanceCount() const;
+	//Cubes still standing
+	int GetCubeCount() const;
+	bool IsInstanceStanding(const int instance) const;
+	XMFLOAT3 GetInstancePosition(const int instance) const;
+	//The cube scale, or zero for a destroyed cube so nothing is drawn in its slot
+	XMFLOAT3 GetInstanceScale(const int instance) const;
+	//Replace the contents with every instance's position or scale
+	void GetInstancePositions(vector<XMFLOAT3>& outPositions) const;
+	void GetInstanceScales(vector<XMFLOAT3>& outScales) const;
+
+	const XMFLOAT3& GetCubeScale() const;
+	const VoxelGrid& GetVoxelGrid() const;
+	//Bytes held by the grid, the query results and the change log, reserved capacity included
+	size_t GetMemoryUsage() const;
+
+	//Incremented every time a cube changes so readers know when to rebuild their instance data
+	unsigned int GetRevision() const;
+
+	//Instances destroyed since sinceRevision, at most TERRAIN_CHANGE_LOG_CAPACITY of them.
+	//Returns false if the terrain has been reset or the change log has wrapped since then and every instance has to be rebuilt
+	bool GetChangedInstances(const unsigned int sinceRevision, vector<int>& outInstances) const;
+
+	//Returns true if there was a cube to destroy
+	bool DestroyCube(const int x, const int y, const int z);
+	//Returns the number of cubes destroyed
+	int DestroyCubesInSphere(const XMFLOAT3& centre, const float radius);
+
+	void ResetTerrainState();
+
+private:
+	static VoxelGrid CreateVoxelGrid(const XMFLOAT3& voxelArea, const XMFLOAT3& cubeScale);
+
+	void ResetChangeLog();
+	void LogChange(const int instance);
+
+	unsigned int revision;
+
+	XMFLOAT3 cubeScale;
+
+	VoxelGrid voxelGrid;
+	vector<XMINT3> queryResults;
+
+	//Ring of the revision and slot of the latest instances destroyed, nothing older than the start revision is missing
+	unsigned int changeLogStartRevision;
+	int changeLogHead;
+	int changeLogCount;
+	vector<pair<unsigned int, int>> changeLog;
+};
@@ -1,12 +1,14 @@
 #include "Texture.h"
 
-Texture::Texture(ID3D11Device* const device, const vector<const WCHAR*>& textureFileNames, const shared_ptr<ResourceManager>& resourceManager) : texture(), initializationFailed(false)
+Texture::Texture(ID3D11Device* const device, const vector<const WCHAR*>& textureFileNames, const shared_ptr<ResourceManager>& resourceManager) : textureHandles(), texture(), initializationFailed(false)
 {
 	for (unsigned int i = 0; i < textureFileNames.size(); i++)
 	{
 		ID3D11ShaderResourceView* tex = nullptr;
 
-		const auto result = resourceManager->GetTexture(device, textureFileNames[i], tex);
+		textureHandles.push_back(resourceManager->GetTextureHandle(textureFileNames[i]));
+
+		const auto result = resourceManager->GetTexture(device, textureHandles.back(), tex);
 
 		if (!result)
 		{
@@ -49,6 +51,10 @@ const vector<ID3D11ShaderResourceView*>& Texture::GetTextureList() const {
 	return texture;
 }
 
+const vector<TextureHandle>& Texture::GetTextureHandles() const {
+	return textureHandles;
+}
+
 bool Texture::GetInitializationState() const {
 	return initializationFailed;
 }
\ No newline at end of file
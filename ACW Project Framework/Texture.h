@@ -20,10 +20,13 @@ public:
 	Texture& operator = (Texture&& other) noexcept; // Move Assignment Operator
 
 	const vector<ID3D11ShaderResourceView*>& GetTextureList() const;
+	//In the same order as the texture list
+	const vector<TextureHandle>& GetTextureHandles() const;
 
 	bool GetInitializationState() const;
 
 private:
+	vector<TextureHandle> textureHandles;
 	vector<ID3D11ShaderResourceView*> texture;
 
 	bool initializationFailed;
@@ -1,3 +1,5 @@
+#include "MeshVertex.hlsli"
+
 cbuffer MatrixBuffer : register(b0)
 {
 	matrix worldInverseMatrix;
@@ -21,8 +23,7 @@ cbuffer CameraBuffer : register(b2)
 //Type definitions
 struct VertexInput
 {
-	float3 position : POSITION;
-	float2 tex : TEXCOORD0;
+	MeshVertexInput vertex;
 	matrix instanceWorldMatrix : INSTANCEMATRIX;
 };
 
@@ -36,12 +37,13 @@ struct HullInput
 HullInput Texture2DVertexShader(VertexInput input)
 {
 	HullInput output;
+	const MeshVertex vertex = DecodeMeshVertex(input.vertex);
 
 	//Calculate the position of the vertex against the matrices
-	output.position = mul(float4(input.position, 1.0f), input.instanceWorldMatrix).xyz;
+	output.position = mul(float4(vertex.position, 1.0f), input.instanceWorldMatrix).xyz;
 
 	//Pass colour as is to pixel shader
-	output.tex = input.tex;
+	output.tex = vertex.tex;
 
 	float distanceToCamera = distance(output.position, cameraPosition);
 
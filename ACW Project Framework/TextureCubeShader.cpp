@@ -2,68 +2,10 @@
 
 
 
-TextureCubeShader::TextureCubeShader(ID3D11Device* const device, HWND const hwnd) : Shader("TextureCubeVertexShader", "TextureCubeHullShader", "TextureCubeDomainShader", "TextureCubePixelShader", device, hwnd), inputLayout(nullptr), sampleState(nullptr)
+TextureCubeShader::TextureCubeShader(ID3D11Device* const device, HWND const hwnd, const MeshVertexFormat vertexFormat) : Shader("TextureCubeVertexShader", "TextureCubeHullShader", "TextureCubeDomainShader", "TextureCubePixelShader", device, hwnd, vertexFormat), inputLayout(nullptr), sampleState(nullptr)
 {
-	D3D11_INPUT_ELEMENT_DESC layout[6];
-
-	unsigned int numberOfElements = 0;
-
-	//Setup layout of buffer data in the shader
-	//Setup of the layout needs to match the struct in our Model class and the struct in the shader
-
-	layout[0].SemanticName = "POSITION";
-	layout[0].SemanticIndex = 0;
-	layout[0].Format = DXGI_FORMAT_R32G32B32_FLOAT;
-	layout[0].InputSlot = 0;
-	layout[0].AlignedByteOffset = 0;
-	layout[0].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-	layout[0].InstanceDataStepRate = 0;
-
-	layout[1].SemanticName = "TEXCOORD";
-	layout[1].SemanticIndex = 0;
-	layout[1].Format = DXGI_FORMAT_R32G32_FLOAT;
-	layout[1].InputSlot = 0;
-	layout[1].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	layout[1].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-	layout[1].InstanceDataStepRate = 0;
-
-	layout[2].SemanticName = "INSTANCEMATRIX";
-	layout[2].SemanticIndex = 0;
-	layout[2].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
-	layout[2].InputSlot = 1;
-	layout[2].AlignedByteOffset = 0;
-	layout[2].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
-	layout[2].InstanceDataStepRate = 1;
-
-	layout[3].SemanticName = "INSTANCEMATRIX";
-	layout[3].SemanticIndex = 1;
-	layout[3].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
-	layout[3].InputSlot = 1;
-	layout[3].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	layout[3].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
-	layout[3].InstanceDataStepRate = 1;
-
-	layout[4].SemanticName = "INSTANCEMATRIX";
-	layout[4].SemanticIndex = 2;
-	layout[4].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
-	layout[4].InputSlot = 1;
-	layout[4].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	layout[4].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
-	layout[4].InstanceDataStepRate = 1;
-
-	layout[5].SemanticName = "INSTANCEMATRIX";
-	layout[5].SemanticIndex = 3;
-	layout[5].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
-	layout[5].InputSlot = 1;
-	layout[5].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	layout[5].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
-	layout[5].InstanceDataStepRate = 1;
-
-	//Get count of elements in layout
-	numberOfElements = sizeof(layout) / sizeof(layout[0]);
-
 	//Create vertex input layout
-	auto result = device->CreateInputLayout(layout, numberOfElements, GetVertexShaderBuffer()->GetBufferPointer(), GetVertexShaderBuffer()->GetBufferSize(), &inputLayout);
+	auto result = CreateMeshInputLayout(device, &inputLayout);
 
 	GetVertexShaderBuffer()->Release();
 	SetVertexShaderBuffer(nullptr);
@@ -132,7 +74,7 @@ TextureCubeShader& TextureCubeShader::operator=(const TextureCubeShader& other)
 
 TextureCubeShader& TextureCubeShader::operator=(TextureCubeShader&& other) noexcept = default;
 
-bool TextureCubeShader::Render(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition)
+bool TextureCubeShader::Render(RenderContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition)
 {
 	auto const result = SetTextureShaderParameters(deviceContext, viewMatrix, projectionMatrix, textures, cameraPosition);
 
@@ -146,7 +88,7 @@ bool TextureCubeShader::Render(ID3D11DeviceContext* const deviceContext, const i
 	return true;
 }
 
-bool TextureCubeShader::SetTextureShaderParameters(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const XMFLOAT3& cameraPosition)
+bool TextureCubeShader::SetTextureShaderParameters(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const XMFLOAT3& cameraPosition)
 {
 	const auto result = SetShaderParameters(deviceContext, viewMatrix, projectionMatrix, cameraPosition);
 
@@ -166,7 +108,7 @@ bool TextureCubeShader::SetTextureShaderParameters(ID3D11DeviceContext* const de
 	return true;
 }
 
-void TextureCubeShader::RenderShader(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount) const
+void TextureCubeShader::RenderShader(RenderContext* const deviceContext, const int indexCount, const int instanceCount) const
 {
 	//Set input layout
 	deviceContext->IASetInputLayout(inputLayout);
@@ -179,5 +121,5 @@ void TextureCubeShader::RenderShader(ID3D11DeviceContext* const deviceContext, c
 
 	//Render triangle
 	//deviceContext->DrawIndexed(indexCount, 0, 0);
-	deviceContext->DrawInstanced(indexCount, instanceCount, 0, 0);
+	deviceContext->DrawIndexedInstanced(indexCount, instanceCount, 0, 0, 0);
 }
\ No newline at end of file
@@ -12,7 +12,7 @@ using namespace std;
 class TextureCubeShader : public Shader
 {
 public:
-	TextureCubeShader(ID3D11Device* const device, HWND const hwnd);
+	TextureCubeShader(ID3D11Device* const device, HWND const hwnd, const MeshVertexFormat vertexFormat);
 	TextureCubeShader(const TextureCubeShader& other);
 	TextureCubeShader(TextureCubeShader&& other) noexcept;
 	~TextureCubeShader();
@@ -20,11 +20,11 @@ public:
 	TextureCubeShader& operator = (const TextureCubeShader& other);
 	TextureCubeShader& operator = (TextureCubeShader&& other) noexcept;
 
-	bool Render(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) override;
+	bool Render(RenderContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) override;
 
 private:
-	bool SetTextureShaderParameters(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const XMFLOAT3& cameraPosition);
-	void RenderShader(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount) const;
+	bool SetTextureShaderParameters(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const XMFLOAT3& cameraPosition);
+	void RenderShader(RenderContext* const deviceContext, const int indexCount, const int instanceCount) const;
 
 	ID3D11InputLayout* inputLayout;
 	ID3D11SamplerState* sampleState;
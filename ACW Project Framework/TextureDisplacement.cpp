@@ -1,93 +1,14 @@
 #include "TextureDisplacement.h"
 
-TextureDisplacement::TextureDisplacement(ID3D11Device* const device, HWND const hwnd) : Shader("TextureDisplacementVS", "TextureDisplacementHS", "TextureDisplacementDS", "TextureDisplacementPS", device, hwnd), inputLayout(nullptr), sampleStateWrap(nullptr), sampleStateClamp(nullptr), lightBuffer(nullptr)
+TextureDisplacement::TextureDisplacement(ID3D11Device* const device, HWND const hwnd, const MeshVertexFormat vertexFormat) : Shader("TextureDisplacementVS", "TextureDisplacementHS", "TextureDisplacementDS", "TextureDisplacementPS", device, hwnd, vertexFormat), inputLayout(nullptr), sampleStateWrap(nullptr), sampleStateClamp(nullptr), lightBuffer(nullptr)
 {
 	if (GetInitializationState())
 	{
 		return;
 	}
 
-	D3D11_INPUT_ELEMENT_DESC layout[9];
-
-	unsigned int numberOfElements = 0;
-
-	layout[0].SemanticName = "POSITION";
-	layout[0].SemanticIndex = 0;
-	layout[0].Format = DXGI_FORMAT_R32G32B32_FLOAT;
-	layout[0].InputSlot = 0;
-	layout[0].AlignedByteOffset = 0;
-	layout[0].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-	layout[0].InstanceDataStepRate = 0;
-
-	layout[1].SemanticName = "TEXCOORD";
-	layout[1].SemanticIndex = 0;
-	layout[1].Format = DXGI_FORMAT_R32G32_FLOAT;
-	layout[1].InputSlot = 0;
-	layout[1].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	layout[1].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-	layout[1].InstanceDataStepRate = 0;
-
-	layout[2].SemanticName = "NORMAL";
-	layout[2].SemanticIndex = 0;
-	layout[2].Format = DXGI_FORMAT_R32G32B32_FLOAT;
-	layout[2].InputSlot = 0;
-	layout[2].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	layout[2].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-	layout[2].InstanceDataStepRate = 0;
-
-	layout[3].SemanticName = "TANGENT";
-	layout[3].SemanticIndex = 0;
-	layout[3].Format = DXGI_FORMAT_R32G32B32_FLOAT;
-	layout[3].InputSlot = 0;
-	layout[3].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	layout[3].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-	layout[3].InstanceDataStepRate = 0;
-
-	layout[4].SemanticName = "BINORMAL";
-	layout[4].SemanticIndex = 0;
-	layout[4].Format = DXGI_FORMAT_R32G32B32_FLOAT;
-	layout[4].InputSlot = 0;
-	layout[4].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	layout[4].InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-	layout[4].InstanceDataStepRate = 0;
-
-	layout[5].SemanticName = "INSTANCEMATRIX";
-	layout[5].SemanticIndex = 0;
-	layout[5].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
-	layout[5].InputSlot = 1;
-	layout[5].AlignedByteOffset = 0;
-	layout[5].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
-	layout[5].InstanceDataStepRate = 1;
-
-	layout[6].SemanticName = "INSTANCEMATRIX";
-	layout[6].SemanticIndex = 1;
-	layout[6].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
-	layout[6].InputSlot = 1;
-	layout[6].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	layout[6].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
-	layout[6].InstanceDataStepRate = 1;
-
-	layout[7].SemanticName = "INSTANCEMATRIX";
-	layout[7].SemanticIndex = 2;
-	layout[7].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
-	layout[7].InputSlot = 1;
-	layout[7].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	layout[7].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
-	layout[7].InstanceDataStepRate = 1;
-
-	layout[8].SemanticName = "INSTANCEMATRIX";
-	layout[8].SemanticIndex = 3;
-	layout[8].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
-	layout[8].InputSlot = 1;
-	layout[8].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-	layout[8].InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
-	layout[8].InstanceDataStepRate = 1;
-
-	//Get count of elements in layout
-	numberOfElements = sizeof(layout) / sizeof(layout[0]);
-
 	//Create vertex input layout
-	auto result = device->CreateInputLayout(layout, numberOfElements, GetVertexShaderBuffer()->GetBufferPointer(), GetVertexShaderBuffer()->GetBufferSize(), &inputLayout);
+	auto result = CreateMeshInputLayout(device, &inputLayout);
 
 	if (FAILED(result))
 	{
@@ -233,7 +154,7 @@ TextureDisplacement& TextureDisplacement::operator=(const TextureDisplacement& o
 
 TextureDisplacement& TextureDisplacement::operator=(TextureDisplacement&& other) noexcept = default;
 
-bool TextureDisplacement::Render(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition)
+bool TextureDisplacement::Render(RenderContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition)
 {
 	auto const result = SetTextureDisplacementShaderParameters(deviceContext, viewMatrix, projectionMatrix, textures, depthTextures, pointLightList, cameraPosition);
 
@@ -247,7 +168,7 @@ bool TextureDisplacement::Render(ID3D11DeviceContext* const deviceContext, const
 	return true;
 }
 
-bool TextureDisplacement::SetTextureDisplacementShaderParameters(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition)
+bool TextureDisplacement::SetTextureDisplacementShaderParameters(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition)
 {
 	const auto result = SetShaderParameters(deviceContext, viewMatrix, projectionMatrix, cameraPosition);
 
@@ -347,7 +268,7 @@ bool TextureDisplacement::SetTextureDisplacementShaderParameters(ID3D11DeviceCon
 	return true;
 }
 
-void TextureDisplacement::RenderShader(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount) const
+void TextureDisplacement::RenderShader(RenderContext* const deviceContext, const int indexCount, const int instanceCount) const
 {
 	//Set input layout
 	deviceContext->IASetInputLayout(inputLayout);
@@ -359,6 +280,6 @@ void TextureDisplacement::RenderShader(ID3D11DeviceContext* const deviceContext,
 	deviceContext->PSSetSamplers(0, 1, &sampleStateWrap);
 	deviceContext->PSSetSamplers(1, 1, &sampleStateClamp);
 
-	deviceContext->DrawInstanced(indexCount, instanceCount, 0, 0);
+	deviceContext->DrawIndexedInstanced(indexCount, instanceCount, 0, 0, 0);
 	//deviceContext->DrawIndexed(indexCount, 0, 0);
 }
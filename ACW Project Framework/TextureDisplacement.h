@@ -8,7 +8,7 @@ using namespace std;
 class TextureDisplacement : public Shader
 {
 public:
-	TextureDisplacement(ID3D11Device* const device, HWND const hwnd); // Default Constructor
+	TextureDisplacement(ID3D11Device* const device, HWND const hwnd, const MeshVertexFormat vertexFormat); // Default Constructor
 	TextureDisplacement(const TextureDisplacement& other); // Copy Constructor
 	TextureDisplacement(TextureDisplacement&& other) noexcept; // Move Constructor
 	~TextureDisplacement() override;
@@ -16,11 +16,11 @@ public:
 	TextureDisplacement& operator = (const TextureDisplacement& other); // Copy Assignment Operator
 	TextureDisplacement& operator = (TextureDisplacement&& other) noexcept; // Move Assignment Operator
 
-	bool Render(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) override;
+	bool Render(RenderContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) override;
 
 private:
-	bool SetTextureDisplacementShaderParameters(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition);
-	void RenderShader(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount) const;
+	bool SetTextureDisplacementShaderParameters(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition);
+	void RenderShader(RenderContext* const deviceContext, const int indexCount, const int instanceCount) const;
 
 	struct PointLightMatrix
 	{
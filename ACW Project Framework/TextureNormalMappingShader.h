@@ -12,7 +12,7 @@ using namespace std;
 class TextureNormalMappingShader : public Shader
 {
 public:
-	TextureNormalMappingShader(ID3D11Device* const device, HWND const hwnd); // Default Constructor
+	TextureNormalMappingShader(ID3D11Device* const device, HWND const hwnd, const MeshVertexFormat vertexFormat); // Default Constructor
 	TextureNormalMappingShader(const TextureNormalMappingShader& other); // Copy Constructor
 	TextureNormalMappingShader(TextureNormalMappingShader&& other) noexcept; // Move Constructor
 	~TextureNormalMappingShader() override; // Destructor
@@ -20,11 +20,11 @@ public:
 	TextureNormalMappingShader& operator = (const TextureNormalMappingShader& other); // Copy Assignment Operator
 	TextureNormalMappingShader& operator = (TextureNormalMappingShader&& other) noexcept; // Move Assignment Operator
 
-	bool Render(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) override;
+	bool Render(RenderContext* const deviceContext, const int indexCount, const int instanceCount, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<ID3D11ShaderResourceView*>& depthTextures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition) override;
 
 private:
-	bool SetTextureNormalShaderParameters(ID3D11DeviceContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition);
-	void RenderShader(ID3D11DeviceContext* const deviceContext, const int indexCount, const int instanceCount) const;
+	bool SetTextureNormalShaderParameters(RenderContext* const deviceContext, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<ID3D11ShaderResourceView*>& textures, const vector<shared_ptr<Light>>& pointLightList, const XMFLOAT3& cameraPosition);
+	void RenderShader(RenderContext* const deviceContext, const int indexCount, const int instanceCount) const;
 
 	struct PointLights
 	{
@@ -1,3 +1,5 @@
+#include "MeshVertex.hlsli"
+
 cbuffer MatrixBuffer : register(b0)
 {
 	matrix worldInverseMatrix;
@@ -21,11 +23,7 @@ cbuffer CameraBuffer : register(b2)
 //Type definitions
 struct VertexInput
 {
-	float3 position : POSITION;
-	float2 tex : TEXCOORD0;
-	float3 normal : NORMAL;
-	float3 tangent : TANGENT;
-	float3 binormal : BINORMAL;
+	MeshVertexInput vertex;
 	matrix instanceWorldMatrix : INSTANCEMATRIX;
 };
 
@@ -42,17 +40,18 @@ struct HullInput
 HullInput TextureNormalVertexShader(VertexInput input)
 {
 	HullInput output;
+	const MeshVertex vertex = DecodeMeshVertex(input.vertex);
 
 	//Calculate the position of the vertex against the matrices
-	output.position = mul(float4(input.position, 1.0f), input.instanceWorldMatrix).xyz;
+	output.position = mul(float4(vertex.position, 1.0f), input.instanceWorldMatrix).xyz;
 
 	//Pass colour as is to pixel shader
-	output.tex = input.tex;
+	output.tex = vertex.tex;
 
 	//Calculate the normal, tangent and binormal against world and normalize it
-	output.normal = normalize(mul(input.normal, (float3x3)input.instanceWorldMatrix));
-	output.tangent = normalize(mul(input.tangent, (float3x3)input.instanceWorldMatrix));
-	output.binormal = normalize(mul(input.binormal, (float3x3)input.instanceWorldMatrix));
+	output.normal = normalize(mul(vertex.normal, (float3x3)input.instanceWorldMatrix));
+	output.tangent = normalize(mul(vertex.tangent, (float3x3)input.instanceWorldMatrix));
+	output.binormal = normalize(mul(vertex.binormal, (float3x3)input.instanceWorldMatrix));
 
 	float distanceToCamera = distance(output.position, cameraPosition);
 
@@ -40,7 +40,7 @@ void TextureRenderer::SetShader(const shared_ptr<Shader>&sh)
     shader = sh;
 }
 
-bool TextureRenderer::RenderObjectsToTexture(ID3D11DeviceContext* const deviceContext, ID3D11DepthStencilView* const depthStencilView, const XMMATRIX & viewMatrix, const XMMATRIX & projectionMatrix, const vector<shared_ptr<Light>>&pointLightList, const vector<shared_ptr<GameObject>>&gameObjects, const XMFLOAT3 & cameraPosition) const
+bool TextureRenderer::RenderObjectsToTexture(RenderContext* const deviceContext, ID3D11DepthStencilView* const depthStencilView, const XMMATRIX & viewMatrix, const XMMATRIX & projectionMatrix, const vector<shared_ptr<Light>>&pointLightList, const FrameVector<GameObject*>& gameObjects, const XMFLOAT3 & cameraPosition) const
 {
     SetRenderTarget(deviceContext, depthStencilView);
 
@@ -156,12 +156,12 @@ void TextureRenderer::ReleaseResources()
     }
 }
 
-void TextureRenderer::SetRenderTarget(ID3D11DeviceContext* const deviceContext, ID3D11DepthStencilView* const depthStencilView) const
+void TextureRenderer::SetRenderTarget(RenderContext* const deviceContext, ID3D11DepthStencilView* const depthStencilView) const
 {
     deviceContext->OMSetRenderTargets(1, &renderTargetView, depthStencilView);
 }
 
-void TextureRenderer::ClearRenderTarget(ID3D11DeviceContext* const deviceContext, ID3D11DepthStencilView* const depthStencilView, const XMFLOAT4 & RGBA) const
+void TextureRenderer::ClearRenderTarget(RenderContext* const deviceContext, ID3D11DepthStencilView* const depthStencilView, const XMFLOAT4 & RGBA) const
 {
     const float colour[4]{ RGBA.x, RGBA.y, RGBA.z, RGBA.w };
 
@@ -170,7 +170,7 @@ void TextureRenderer::ClearRenderTarget(ID3D11DeviceContext* const deviceContext
     deviceContext->ClearDepthStencilView(depthStencilView, D3D11_CLEAR_DEPTH, 1.0f, 0);
 }
 
-void TextureRenderer::SwapShaderAndApplyVariables(const shared_ptr<GameObject>& gameObject) const
+void TextureRenderer::SwapShaderAndApplyVariables(GameObject* const gameObject) const
 {
     const auto originalShader = gameObject->GetShaderComponent();
 
@@ -3,6 +3,7 @@
 #include <d3d11.h>
 #include <DirectXMath.h>
 #include "Shader.h"
+#include "FrameArena.h"
 #include "GameObject.h"
 
 using namespace std;
@@ -20,7 +21,7 @@ public:
 	TextureRenderer& operator = (TextureRenderer&& other) noexcept; // Move Assignment Operator
 
 	void SetShader(const shared_ptr<Shader>& shader);
-	bool RenderObjectsToTexture(ID3D11DeviceContext* const deviceContext, ID3D11DepthStencilView* const depthStencilView, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<shared_ptr<Light>>& pointLightList, const vector<shared_ptr<GameObject>>& gameObjects, const XMFLOAT3& cameraPosition) const;
+	bool RenderObjectsToTexture(RenderContext* const deviceContext, ID3D11DepthStencilView* const depthStencilView, const XMMATRIX& viewMatrix, const XMMATRIX& projectionMatrix, const vector<shared_ptr<Light>>& pointLightList, const FrameVector<GameObject*>& gameObjects, const XMFLOAT3& cameraPosition) const;
 
 	ID3D11ShaderResourceView* GetShaderResourceView() const;
 
@@ -35,10 +36,10 @@ public:
 	void ReleaseResources();
 
 private:
-	void SetRenderTarget(ID3D11DeviceContext* const deviceContext, ID3D11DepthStencilView* const depthStencilView) const;
-	void ClearRenderTarget(ID3D11DeviceContext* const deviceContext, ID3D11DepthStencilView* const depthStencilView, const XMFLOAT4& RGBA) const;
+	void SetRenderTarget(RenderContext* const deviceContext, ID3D11DepthStencilView* const depthStencilView) const;
+	void ClearRenderTarget(RenderContext* const deviceContext, ID3D11DepthStencilView* const depthStencilView, const XMFLOAT4& RGBA) const;
 
-	void SwapShaderAndApplyVariables(const shared_ptr<GameObject>& gameObject) const;
+	void SwapShaderAndApplyVariables(GameObject* const gameObject) const;
 
 	bool initializationFailed;
 
@@ -0,0 +1,203 @@
+#include "VertexCompressor.h"
+#include <DirectXPackedVector.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace DirectX::PackedVector;
+
+int VertexCompressor::GetVertexSize(const MeshVertexFormat format)
+{
+	switch (format)
+	{
+		case MeshVertexFormat::Compact:
+			return sizeof(CompactMeshVertex);
+		case MeshVertexFormat::CompactQuantized:
+			return sizeof(QuantizedMeshVertex);
+		default:
+			return sizeof(MeshVertex);
+	}
+}
+
+void VertexCompressor::Compress(const MeshVertex* const vertices, const int vertexCount, const MeshVertexFormat format, const float boundsMin[3], const float boundsMax[3], vector<unsigned char>& output)
+{
+	output.resize(static_cast<size_t>(vertexCount) * GetVertexSize(format));
+
+	if (format == MeshVertexFormat::Full)
+	{
+		memcpy(output.data(), vertices, output.size());
+		return;
+	}
+
+	XMFLOAT3 offset;
+	XMFLOAT3 scale;
+	GetQuantization(format, boundsMin, boundsMax, offset, scale);
+
+	const float offsets[3] = { offset.x, offset.y, offset.z };
+	const float scales[3] = { scale.x, scale.y, scale.z };
+
+	for (auto i = 0; i < vertexCount; i++)
+	{
+		const auto& vertex = vertices[i];
+		const uint16_t texture[2] = { XMConvertFloatToHalf(vertex.texture.x), XMConvertFloatToHalf(vertex.texture.y) };
+		uint16_t frame[4];
+		EncodeFrame(vertex, frame);
+
+		if (format == MeshVertexFormat::Compact)
+		{
+			auto* const compactVertex = reinterpret_cast<CompactMeshVertex*>(output.data()) + i;
+			compactVertex->position = vertex.position;
+			memcpy(compactVertex->texture, texture, sizeof(texture));
+			memcpy(compactVertex->frame, frame, sizeof(frame));
+		}
+		else
+		{
+			auto* const quantizedVertex = reinterpret_cast<QuantizedMeshVertex*>(output.data()) + i;
+			const float position[3] = { vertex.position.x, vertex.position.y, vertex.position.z };
+
+			for (auto axis = 0; axis < 3; axis++)
+			{
+				//A flat axis decodes to its offset whatever is stored
+				const auto level = scales[axis] > 0.0f ? (position[axis] - offsets[axis]) / scales[axis] * QUANTIZED_POSITION_LEVELS : 0.0f;
+				quantizedVertex->position[axis] = static_cast<uint16_t>(min(max(lround(level), 0l), static_cast<long>(QUANTIZED_POSITION_LEVELS)));
+			}
+
+			quantizedVertex->position[3] = 0;
+			memcpy(quantizedVertex->texture, texture, sizeof(texture));
+			memcpy(quantizedVertex->frame, frame, sizeof(frame));
+		}
+	}
+}
+
+void VertexCompressor::Decompress(const void* const data, const int vertexCount, const MeshVertexFormat format, const float boundsMin[3], const float boundsMax[3], vector<MeshVertex>& output)
+{
+	output.resize(vertexCount);
+
+	if (format == MeshVertexFormat::Full)
+	{
+		memcpy(output.data(), data, sizeof(MeshVertex) * vertexCount);
+		return;
+	}
+
+	XMFLOAT3 offset;
+	XMFLOAT3 scale;
+	GetQuantization(format, boundsMin, boundsMax, offset, scale);
+
+	for (auto i = 0; i < vertexCount; i++)
+	{
+		auto& vertex = output[i];
+		const uint16_t* texture;
+		const uint16_t* frame;
+
+		if (format == MeshVertexFormat::Compact)
+		{
+			const auto* const compactVertex = static_cast<const CompactMeshVertex*>(data) + i;
+			vertex.position = compactVertex->position;
+			texture = compactVertex->texture;
+			frame = compactVertex->frame;
+		}
+		else
+		{
+			const auto* const quantizedVertex = static_cast<const QuantizedMeshVertex*>(data) + i;
+			vertex.position.x = offset.x + static_cast<float>(quantizedVertex->position[0]) / QUANTIZED_POSITION_LEVELS * scale.x;
+			vertex.position.y = offset.y + static_cast<float>(quantizedVertex->position[1]) / QUANTIZED_POSITION_LEVELS * scale.y;
+			vertex.position.z = offset.z + static_cast<float>(quantizedVertex->position[2]) / QUANTIZED_POSITION_LEVELS * scale.z;
+			texture = quantizedVertex->texture;
+			frame = quantizedVertex->frame;
+		}
+
+		vertex.texture = XMFLOAT2(XMConvertHalfToFloat(texture[0]), XMConvertHalfToFloat(texture[1]));
+		DecodeFrame(frame, vertex);
+	}
+}
+
+void VertexCompressor::GetQuantization(const MeshVertexFormat format, const float boundsMin[3], const float boundsMax[3], XMFLOAT3& offset, XMFLOAT3& scale)
+{
+	if (format != MeshVertexFormat::CompactQuantized)
+	{
+		offset = XMFLOAT3(0.0f, 0.0f, 0.0f);
+		scale = XMFLOAT3(1.0f, 1.0f, 1.0f);
+		return;
+	}
+
+	offset = XMFLOAT3(boundsMin[0], boundsMin[1], boundsMin[2]);
+	scale = XMFLOAT3(boundsMax[0] - boundsMin[0], boundsMax[1] - boundsMin[1], boundsMax[2] - boundsMin[2]);
+}
+
+void VertexCompressor::EncodeFrame(const MeshVertex& vertex, uint16_t frame[4])
+{
+	int normalX, normalY, tangentX, tangentY;
+	EncodeOctahedral(vertex.normal, OCTAHEDRAL_UNIT_LEVELS, OCTAHEDRAL_UNIT_LEVELS, normalX, normalY);
+	EncodeOctahedral(vertex.tangent, OCTAHEDRAL_UNIT_LEVELS, OCTAHEDRAL_SIGNED_LEVELS, tangentX, tangentY);
+
+	const auto normal = XMLoadFloat3(&vertex.normal);
+	const auto tangent = XMLoadFloat3(&vertex.tangent);
+	const auto rightHanded = XMVectorGetX(XMVector3Dot(XMVector3Cross(normal, tangent), XMLoadFloat3(&vertex.binormal))) >= 0.0f;
+
+	frame[0] = static_cast<uint16_t>(normalX);
+	frame[1] = static_cast<uint16_t>(normalY);
+	frame[2] = static_cast<uint16_t>(tangentX);
+	frame[3] = static_cast<uint16_t>(tangentY << 1 | (rightHanded ? 1 : 0));
+}
+
+void VertexCompressor::DecodeFrame(const uint16_t frame[4], MeshVertex& vertex)
+{
+	vertex.normal = DecodeOctahedral(frame[0], frame[1], OCTAHEDRAL_UNIT_LEVELS, OCTAHEDRAL_UNIT_LEVELS);
+	vertex.tangent = DecodeOctahedral(frame[2], frame[3] >> 1, OCTAHEDRAL_UNIT_LEVELS, OCTAHEDRAL_SIGNED_LEVELS);
+
+	const auto binormal = XMVector3Cross(XMLoadFloat3(&vertex.normal), XMLoadFloat3(&vertex.tangent));
+	XMStoreFloat3(&vertex.binormal, XMVectorScale(binormal, (frame[3] & 1) ? 1.0f : -1.0f));
+}
+
+void VertexCompressor::EncodeOctahedral(const XMFLOAT3& direction, const int xLevels, const int yLevels, int& x, int& y)
+{
+	//Projected onto the octahedron then the lower half folded over the upper
+	const auto length = fabs(direction.x) + fabs(direction.y) + fabs(direction.z);
+	auto octahedralX = length > 0.0f ? direction.x / length : 0.0f;
+	auto octahedralY = length > 0.0f ? direction.y / length : 0.0f;
+
+	if (direction.z < 0.0f)
+	{
+		const auto foldedX = (1.0f - fabs(octahedralY)) * (octahedralX >= 0.0f ? 1.0f : -1.0f);
+		const auto foldedY = (1.0f - fabs(octahedralX)) * (octahedralY >= 0.0f ? 1.0f : -1.0f);
+		octahedralX = foldedX;
+		octahedralY = foldedY;
+	}
+
+	const auto levelX = (octahedralX * 0.5f + 0.5f) * xLevels;
+	const auto levelY = (octahedralY * 0.5f + 0.5f) * yLevels;
+	const auto target = XMVector3Normalize(XMLoadFloat3(&direction));
+	auto bestDot = -2.0f;
+
+	for (auto candidate = 0; candidate < 4; candidate++)
+	{
+		const auto candidateX = min(max(static_cast<int>(candidate & 1 ? ceil(levelX) : floor(levelX)), 0), xLevels);
+		const auto candidateY = min(max(static_cast<int>(candidate & 2 ? ceil(levelY) : floor(levelY)), 0), yLevels);
+		const auto decoded = DecodeOctahedral(candidateX, candidateY, xLevels, yLevels);
+		const auto dot = XMVectorGetX(XMVector3Dot(XMLoadFloat3(&decoded), target));
+
+		if (dot > bestDot)
+		{
+			bestDot = dot;
+			x = candidateX;
+			y = candidateY;
+		}
+	}
+}
+
+XMFLOAT3 VertexCompressor::DecodeOctahedral(const int x, const int y, const int xLevels, const int yLevels)
+{
+	auto octahedralX = static_cast<float>(x) / xLevels * 2.0f - 1.0f;
+	auto octahedralY = static_cast<float>(y) / yLevels * 2.0f - 1.0f;
+	const auto z = 1.0f - fabs(octahedralX) - fabs(octahedralY);
+
+	//Unfolds the lower half
+	const auto fold = max(-z, 0.0f);
+	octahedralX += octahedralX >= 0.0f ? -fold : fold;
+	octahedralY += octahedralY >= 0.0f ? -fold : fold;
+
+	XMFLOAT3 decoded;
+	XMStoreFloat3(&decoded, XMVector3Normalize(XMVectorSet(octahedralX, octahedralY, z, 0.0f)));
+
+	return decoded;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "MeshVertex.h"
+
+using namespace std;
+
+//Levels the octahedral components and quantized positions are stored with, the tangent gives a bit of its second
+//component to the sign of the binormal
+const int OCTAHEDRAL_UNIT_LEVELS = 65535;
+const int OCTAHEDRAL_SIGNED_LEVELS = 32767;
+const int QUANTIZED_POSITION_LEVELS = 65535;
+
+//Packs MeshVertex into the compact formats and unpacks them exactly as the vertex shaders do, see MeshVertex.hlsli.
+//A frame is the octahedral normal in its first two components and the octahedral tangent in the last two, the last
+//keeping 15 bits for the tangent and its low bit for the sign of the binormal against normal x tangent
+class VertexCompressor
+{
+public:
+	static int GetVertexSize(const MeshVertexFormat format);
+
+	//Bounds are only used by MeshVertexFormat::CompactQuantized and have to be the ones the positions are decoded with
+	static void Compress(const MeshVertex* const vertices, const int vertexCount, const MeshVertexFormat format, const float boundsMin[3], const float boundsMax[3], vector<unsigned char>& output);
+	//Normals and tangents come back normalised, the binormal rebuilt from them and the sign
+	static void Decompress(const void* const data, const int vertexCount, const MeshVertexFormat format, const float boundsMin[3], const float boundsMax[3], vector<MeshVertex>& output);
+
+	//What the vertex shader multiplies a decoded position by and adds to it, an identity unless positions are quantized
+	static void GetQuantization(const MeshVertexFormat format, const float boundsMin[3], const float boundsMax[3], XMFLOAT3& offset, XMFLOAT3& scale);
+
+private:
+	static void EncodeFrame(const MeshVertex& vertex, uint16_t frame[4]);
+	static void DecodeFrame(const uint16_t frame[4], MeshVertex& vertex);
+
+	static void EncodeOctahedral(const XMFLOAT3& direction, const int xLevels, const int yLevels, int& x, int& y);
+	static XMFLOAT3 DecodeOctahedral(const int x, const int y, const int xLevels, const int yLevels);
+};
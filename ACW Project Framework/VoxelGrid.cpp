@@ -0,0 +1,401 @@
+#include "VoxelGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+VoxelGrid::VoxelGrid(const XMINT3& dimensions, const XMFLOAT3& origin, const XMFLOAT3& voxelSize) : dimensions(dimensions), origin(origin), voxelSize(voxelSize), occupiedCount(0), occupancy()
+{
+	occupancy.resize((GetVoxelCount() + 31) / 32);
+
+	Fill();
+}
+
+VoxelGrid::VoxelGrid(const VoxelGrid& other) = default;
+
+VoxelGrid::VoxelGrid(VoxelGrid&& other) noexcept = default;
+
+VoxelGrid::~VoxelGrid() = default;
+
+VoxelGrid& VoxelGrid::operator=(const VoxelGrid& other) = default;
+
+VoxelGrid& VoxelGrid::operator=(VoxelGrid&& other) noexcept = default;
+
+const XMINT3& VoxelGrid::GetDimensions() const
+{
+	return dimensions;
+}
+
+const XMFLOAT3& VoxelGrid::GetOrigin() const
+{
+	return origin;
+}
+
+const XMFLOAT3& VoxelGrid::GetVoxelSize() const
+{
+	return voxelSize;
+}
+
+int VoxelGrid::GetVoxelCount() const
+{
+	return dimensions.x * dimensions.y * dimensions.z;
+}
+
+int VoxelGrid::GetOccupiedCount() const
+{
+	return occupiedCount;
+}
+
+bool VoxelGrid::Contains(const int x, const int y, const int z) const
+{
+	return x >= 0 && y >= 0 && z >= 0 && x < dimensions.x && y < dimensions.y && z < dimensions.z;
+}
+
+bool VoxelGrid::IsOccupied(const int x, const int y, const int z) const
+{
+	if (!Contains(x, y, z))
+	{
+		return false;
+	}
+
+	const auto index = GetIndex(x, y, z);
+
+	return (occupancy[index >> 5] & (1u << (index & 31))) != 0;
+}
+
+bool VoxelGrid::Remove(const int x, const int y, const int z)
+{
+	if (!IsOccupied(x, y, z))
+	{
+		return false;
+	}
+
+	const auto index = GetIndex(x, y, z);
+
+	occupancy[index >> 5] &= ~(1u << (index & 31));
+	occupiedCount--;
+
+	return true;
+}
+
+void VoxelGrid::Fill()
+{
+	const auto voxelCount = GetVoxelCount();
+
+	for (auto& word : occupancy)
+	{
+		word = ~0u;
+	}
+
+	//Clear the bits past the last voxel so they never read as occupied
+	if (voxelCount & 31)
+	{
+		occupancy.back() = (1u << (voxelCount & 31)) - 1u;
+	}
+
+	occupiedCount = voxelCount;
+}
+
+XMFLOAT3 VoxelGrid::GetVoxelPosition(const int x, const int y, const int z) const
+{
+	return XMFLOAT3(origin.x + x * voxelSize.x, origin.y + y * voxelSize.y, origin.z + z * voxelSize.z);
+}
+
+XMINT3 VoxelGrid::GetVoxelCoordinates(const XMFLOAT3& position) const
+{
+	return XMINT3(static_cast<int>(floor((position.x - origin.x) / voxelSize.x + 0.5f)), static_cast<int>(floor((position.y - origin.y) / voxelSize.y + 0.5f)), static_cast<int>(floor((position.z - origin.z) / voxelSize.z + 0.5f)));
+}
+
+bool VoxelGrid::FindFirstOccupiedInSphere(const XMFLOAT3& centre, const float radius, XMINT3& outVoxel) const
+{
+	XMINT3 minimum, maximum;
+
+	if (!GetSphereBounds(centre, radius, minimum, maximum))
+	{
+		return false;
+	}
+
+	for (auto x = minimum.x; x <= maximum.x; x++)
+	{
+		for (auto y = minimum.y; y <= maximum.y; y++)
+		{
+			for (auto z = minimum.z; z <= maximum.z; z++)
+			{
+				const auto index = GetIndex(x, y, z);
+
+				if (!(occupancy[index >> 5] & (1u << (index & 31))))
+				{
+					continue;
+				}
+
+				const auto position = GetVoxelPosition(x, y, z);
+				const auto dx = position.x - centre.x;
+				const auto dy = position.y - centre.y;
+				const auto dz = position.z - centre.z;
+
+				if (dx * dx + dy * dy + dz * dz <= radius * radius)
+				{
+					outVoxel = XMINT3(x, y, z);
+					return true;
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+void VoxelGrid::GetOccupiedInSphere(const XMFLOAT3& centre, const float radius, vector<XMINT3>& outVoxels) const
+{
+	XMINT3 minimum, maximum;
+
+	if (!GetSphereBounds(centre, radius, minimum, maximum))
+	{
+		return;
+	}
+
+	//Room for the sphere's whole box even where the grid edge clips it, callers reuse outVoxels so this only
+	//allocates the first time a sphere this size is queried
+	const auto boxVoxelCount = static_cast<size_t>(floor(2.0f * radius / voxelSize.x) + 1) * static_cast<size_t>(floor(2.0f * radius / voxelSize.y) + 1) * static_cast<size_t>(floor(2.0f * radius / voxelSize.z) + 1);
+	outVoxels.reserve(outVoxels.size() + boxVoxelCount);
+
+	for (auto x = minimum.x; x <= maximum.x; x++)
+	{
+		for (auto y = minimum.y; y <= maximum.y; y++)
+		{
+			for (auto z = minimum.z; z <= maximum.z; z++)
+			{
+				const auto index = GetIndex(x, y, z);
+
+				if (!(occupancy[index >> 5] & (1u << (index & 31))))
+				{
+					continue;
+				}
+
+				const auto position = GetVoxelPosition(x, y, z);
+				const auto dx = position.x - centre.x;
+				const auto dy = position.y - centre.y;
+				const auto dz = position.z - centre.z;
+
+				if (dx * dx + dy * dy + dz * dz <= radius * radius)
+				{
+					outVoxels.emplace_back(XMINT3(x, y, z));
+				}
+			}
+		}
+	}
+}
+
+bool VoxelGrid::FindFirstOccupiedAlongSweep(const XMFLOAT3& start, const XMFLOAT3& end, const float radius, XMINT3& outVoxel, XMFLOAT3& outContactPosition) const
+{
+	const float segmentStart[3] = { start.x, start.y, start.z };
+	const float direction[3] = { end.x - start.x, end.y - start.y, end.z - start.z };
+	const float gridOrigin[3] = { origin.x, origin.y, origin.z };
+	const float cellSize[3] = { voxelSize.x, voxelSize.y, voxelSize.z };
+	const int cellCount[3] = { dimensions.x, dimensions.y, dimensions.z };
+
+	if (direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2] < 1e-12f)
+	{
+		outContactPosition = end;
+		return FindFirstOccupiedInSphere(end, radius, outVoxel);
+	}
+
+	//Clip the path to the grid grown by the radius so the walk never covers empty space
+	auto tEnter = 0.0f;
+	auto tExit = 1.0f;
+
+	for (auto axis = 0; axis < 3; axis++)
+	{
+		const auto minimum = gridOrigin[axis] - cellSize[axis] * 0.5f - radius;
+		const auto maximum = gridOrigin[axis] + cellSize[axis] * (cellCount[axis] - 0.5f) + radius;
+
+		if (direction[axis] == 0.0f)
+		{
+			if (segmentStart[axis] < minimum || segmentStart[axis] > maximum)
+			{
+				return false;
+			}
+
+			continue;
+		}
+
+		auto tNear = (minimum - segmentStart[axis]) / direction[axis];
+		auto tFar = (maximum - segmentStart[axis]) / direction[axis];
+
+		if (tNear > tFar)
+		{
+			swap(tNear, tFar);
+		}
+
+		tEnter = max(tEnter, tNear);
+		tExit = min(tExit, tFar);
+	}
+
+	if (tEnter > tExit)
+	{
+		return false;
+	}
+
+	//DDA state, t is measured along the whole path so it can be compared between axes
+	float tNextBoundary[3];
+	float tStep[3];
+	//The clipped path crosses at most this many cells. Far from the origin adding tStep can stop changing a boundary's
+	//t, so the walk is bounded by it rather than by reaching tExit
+	auto cellsCrossed = 1;
+
+	for (auto axis = 0; axis < 3; axis++)
+	{
+		if (direction[axis] == 0.0f)
+		{
+			tNextBoundary[axis] = numeric_limits<float>::infinity();
+			tStep[axis] = numeric_limits<float>::infinity();
+			continue;
+		}
+
+		//Voxel centres sit on whole coordinates so cell boundaries are half a voxel either side
+		const auto cellPosition = (segmentStart[axis] + direction[axis] * tEnter - gridOrigin[axis]) / cellSize[axis] + 0.5f;
+		const auto cell = floor(cellPosition);
+		const auto boundary = direction[axis] > 0.0f ? cell + 1.0f : cell;
+
+		tNextBoundary[axis] = tEnter + (boundary - cellPosition) * cellSize[axis] / direction[axis];
+		tStep[axis] = cellSize[axis] / fabs(direction[axis]);
+
+		const auto exitCellPosition = (segmentStart[axis] + direction[axis] * tExit - gridOrigin[axis]) / cellSize[axis] + 0.5f;
+		cellsCrossed += static_cast<int>(fabs(floor(exitCellPosition) - cell));
+	}
+
+	auto tCellStart = tEnter;
+
+	for (auto cellIndex = 0; cellIndex < cellsCrossed; cellIndex++)
+	{
+		const auto tCellEnd = min(min(min(tNextBoundary[0], tNextBoundary[1]), tNextBoundary[2]), tExit);
+
+		const auto cellStart = XMFLOAT3(start.x + direction[0] * tCellStart, start.y + direction[1] * tCellStart, start.z + direction[2] * tCellStart);
+		const auto cellEnd = XMFLOAT3(start.x + direction[0] * tCellEnd, start.y + direction[1] * tCellEnd, start.z + direction[2] * tCellEnd);
+
+		XMINT3 minimum, maximum;
+
+		//Any voxel the sphere touches while inside this cell is within radius of this piece of the path
+		if (GetBoxBounds(XMFLOAT3(min(cellStart.x, cellEnd.x) - radius, min(cellStart.y, cellEnd.y) - radius, min(cellStart.z, cellEnd.z) - radius), XMFLOAT3(max(cellStart.x, cellEnd.x) + radius, max(cellStart.y, cellEnd.y) + radius, max(cellStart.z, cellEnd.z) + radius), minimum, maximum))
+		{
+			auto tFirstContact = tCellEnd;
+			auto found = false;
+
+			for (auto x = minimum.x; x <= maximum.x; x++)
+			{
+				for (auto y = minimum.y; y <= maximum.y; y++)
+				{
+					for (auto z = minimum.z; z <= maximum.z; z++)
+					{
+						const auto index = GetIndex(x, y, z);
+
+						if (!(occupancy[index >> 5] & (1u << (index & 31))))
+						{
+							continue;
+						}
+
+						//Earliest t where the distance from the path to the voxel centre drops to radius
+						const auto position = GetVoxelPosition(x, y, z);
+						const float offset[3] = { start.x - position.x, start.y - position.y, start.z - position.z };
+
+						const auto a = direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2];
+						const auto b = offset[0] * direction[0] + offset[1] * direction[1] + offset[2] * direction[2];
+						const auto c = offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2] - radius * radius;
+
+						auto tContact = 0.0f;
+
+						if (c > 0.0f)
+						{
+							const auto discriminant = b * b - a * c;
+
+							if (discriminant < 0.0f || b > 0.0f)
+							{
+								continue;
+							}
+
+							tContact = (-b - sqrt(discriminant)) / a;
+						}
+
+						if (tContact <= tFirstContact)
+						{
+							tFirstContact = tContact;
+							outVoxel = XMINT3(x, y, z);
+							found = true;
+						}
+					}
+				}
+			}
+
+			if (found)
+			{
+				outContactPosition = XMFLOAT3(start.x + direction[0] * tFirstContact, start.y + direction[1] * tFirstContact, start.z + direction[2] * tFirstContact);
+				return true;
+			}
+		}
+
+		if (tCellEnd >= tExit)
+		{
+			return false;
+		}
+
+		//Step into the next cell along whichever axis boundary comes first
+		const auto axis = tNextBoundary[0] <= tNextBoundary[1] ? (tNextBoundary[0] <= tNextBoundary[2] ? 0 : 2) : (tNextBoundary[1] <= tNextBoundary[2] ? 1 : 2);
+
+		tCellStart = tCellEnd;
+		tNextBoundary[axis] += tStep[axis];
+	}
+
+	return false;
+}
+
+void VoxelGrid::GetOccupiedPositions(vector<XMFLOAT3>& outPositions) const
+{
+	outPositions.reserve(outPositions.size() + occupiedCount);
+
+	auto index = 0;
+
+	for (auto x = 0; x < dimensions.x; x++)
+	{
+		for (auto y = 0; y < dimensions.y; y++)
+		{
+			for (auto z = 0; z < dimensions.z; z++, index++)
+			{
+				if (occupancy[index >> 5] & (1u << (index & 31)))
+				{
+					outPositions.emplace_back(GetVoxelPosition(x, y, z));
+				}
+			}
+		}
+	}
+}
+
+size_t VoxelGrid::GetMemoryUsage() const
+{
+	return occupancy.size() * sizeof(uint32_t);
+}
+
+bool VoxelGrid::GetSphereBounds(const XMFLOAT3& centre, const float radius, XMINT3& outMinimum, XMINT3& outMaximum) const
+{
+	return GetBoxBounds(XMFLOAT3(centre.x - radius, centre.y - radius, centre.z - radius), XMFLOAT3(centre.x + radius, centre.y + radius, centre.z + radius), outMinimum, outMaximum);
+}
+
+bool VoxelGrid::GetBoxBounds(const XMFLOAT3& minimum, const XMFLOAT3& maximum, XMINT3& outMinimum, XMINT3& outMaximum) const
+{
+	outMinimum = XMINT3(static_cast<int>(ceil((minimum.x - origin.x) / voxelSize.x)), static_cast<int>(ceil((minimum.y - origin.y) / voxelSize.y)), static_cast<int>(ceil((minimum.z - origin.z) / voxelSize.z)));
+	outMaximum = XMINT3(static_cast<int>(floor((maximum.x - origin.x) / voxelSize.x)), static_cast<int>(floor((maximum.y - origin.y) / voxelSize.y)), static_cast<int>(floor((maximum.z - origin.z) / voxelSize.z)));
+
+	outMinimum = XMINT3(max(outMinimum.x, 0), max(outMinimum.y, 0), max(outMinimum.z, 0));
+	outMaximum = XMINT3(min(outMaximum.x, dimensions.x - 1), min(outMaximum.y, dimensions.y - 1), min(outMaximum.z, dimensions.z - 1));
+
+	return outMinimum.x <= outMaximum.x && outMinimum.y <= outMaximum.y && outMinimum.z <= outMaximum.z;
+}
+
+int VoxelGrid::GetIndex(const int x, const int y, const int z) const
+{
+	//z is innermost so instance order matches the original x, y, z fill
+	return (x * dimensions.y + y) * dimensions.z + z;
+}
+
+XMINT3 VoxelGrid::GetIndexCoordinates(const int index) const
+{
+	return XMINT3(index / (dimensions.y * dimensions.z), index / dimensions.z % dimensions.y, index % dimensions.z);
+}
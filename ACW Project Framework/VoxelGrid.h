@@ -0,0 +1,70 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+using namespace DirectX;
+using namespace std;
+
+//Dense occupancy grid, one bit per voxel indexed by integer coordinates.
+//Lookup and removal are constant time and the world position of a voxel is derived from its coordinates
+class VoxelGrid
+{
+public:
+	VoxelGrid(const XMINT3& dimensions, const XMFLOAT3& origin, const XMFLOAT3& voxelSize);
+	VoxelGrid(const VoxelGrid& other); // Copy Constructor
+	VoxelGrid(VoxelGrid&& other) noexcept; // Move Constructor
+	~VoxelGrid(); // Destructor
+
+	VoxelGrid& operator = (const VoxelGrid& other); // Copy Assignment Operator
+	VoxelGrid& operator = (VoxelGrid&& other) noexcept; // Move Assignment Operator
+
+	const XMINT3& GetDimensions() const;
+	const XMFLOAT3& GetOrigin() const;
+	const XMFLOAT3& GetVoxelSize() const;
+
+	int GetVoxelCount() const;
+	int GetOccupiedCount() const;
+
+	bool Contains(const int x, const int y, const int z) const;
+	bool IsOccupied(const int x, const int y, const int z) const;
+
+	//Linear index of a voxel, 0 to GetVoxelCount() - 1
+	int GetIndex(const int x, const int y, const int z) const;
+	//The voxel a linear index refers to
+	XMINT3 GetIndexCoordinates(const int index) const;
+
+	//Returns true if the voxel was occupied
+	bool Remove(const int x, const int y, const int z);
+	void Fill();
+
+	//Centre of the voxel in world space
+	XMFLOAT3 GetVoxelPosition(const int x, const int y, const int z) const;
+	//Coordinates of the voxel whose centre is nearest, these can be outside of the grid
+	XMINT3 GetVoxelCoordinates(const XMFLOAT3& position) const;
+
+	//Spatial queries only visit the voxels under the bounding box of the sphere, a voxel overlaps when its centre is within radius
+	bool FindFirstOccupiedInSphere(const XMFLOAT3& centre, const float radius, XMINT3& outVoxel) const;
+	void GetOccupiedInSphere(const XMFLOAT3& centre, const float radius, vector<XMINT3>& outVoxels) const;
+	//Moves a sphere from start to end and finds the first voxel it touches, walking the cells the path crosses with a 3D-DDA
+	bool FindFirstOccupiedAlongSweep(const XMFLOAT3& start, const XMFLOAT3& end, const float radius, XMINT3& outVoxel, XMFLOAT3& outContactPosition) const;
+
+	//Appends the world position of every occupied voxel in x, y, z order
+	void GetOccupiedPositions(vector<XMFLOAT3>& outPositions) const;
+
+	size_t GetMemoryUsage() const;
+
+private:
+	//Clamped voxel range with centres inside a sphere's or box's bounds, returns false if it misses the grid
+	bool GetSphereBounds(const XMFLOAT3& centre, const float radius, XMINT3& outMinimum, XMINT3& outMaximum) const;
+	bool GetBoxBounds(const XMFLOAT3& minimum, const XMFLOAT3& maximum, XMINT3& outMinimum, XMINT3& outMaximum) const;
+
+	XMINT3 dimensions;
+	XMFLOAT3 origin;
+	XMFLOAT3 voxelSize;
+
+	int occupiedCount;
+
+	vector<uint32_t> occupancy;
+};
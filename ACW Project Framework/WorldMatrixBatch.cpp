@@ -0,0 +1,321 @@
+#include "WorldMatrixBatch.h"
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define WORLD_MATRIX_BATCH_AVX
+#elif !defined(_XM_NO_INTRINSICS_) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define WORLD_MATRIX_BATCH_SSE
+#endif
+
+//Eight instances per iteration, one AVX register or two SSE registers per component
+static const int BLOCK_SIZE = 8;
+
+//Upper 3x4 of the parent, p[row][column]
+struct ParentRows
+{
+	float p[4][3];
+};
+
+static ParentRows GetParentRows(const XMMATRIX& parentMatrix)
+{
+	XMFLOAT4X4 parent;
+	XMStoreFloat4x4(&parent, parentMatrix);
+
+	ParentRows rows;
+
+	for (auto row = 0; row < 4; row++)
+	{
+		for (auto column = 0; column < 3; column++)
+		{
+			rows.p[row][column] = parent.m[row][column];
+		}
+	}
+
+	return rows;
+}
+
+static const XMFLOAT3& GetClamped(const vector<XMFLOAT3>& values, const size_t index)
+{
+	return index < values.size() ? values[index] : values[values.size() - 1];
+}
+
+static void ComposeInstance(const XMFLOAT3& scale, const XMFLOAT3& rotation, const XMFLOAT3& position, const ParentRows& parent, XMFLOAT4X4& outTransposedMatrix)
+{
+	float sinPitch, cosPitch, sinYaw, cosYaw, sinRoll, cosRoll;
+
+	XMScalarSinCos(&sinPitch, &cosPitch, rotation.x);
+	XMScalarSinCos(&sinYaw, &cosYaw, rotation.y);
+	XMScalarSinCos(&sinRoll, &cosRoll, rotation.z);
+
+	//Roll, then pitch, then yaw, the same rotation XMQuaternionRotationRollPitchYaw gives, with each row scaled
+	const float local[3][3] = {
+		{ scale.x * (cosRoll * cosYaw + sinRoll * sinPitch * sinYaw), scale.x * (sinRoll * cosPitch), scale.x * (sinRoll * sinPitch * cosYaw - cosRoll * sinYaw) },
+		{ scale.y * (cosRoll * sinPitch * sinYaw - sinRoll * cosYaw), scale.y * (cosRoll * cosPitch), scale.y * (sinRoll * sinYaw + cosRoll * sinPitch * cosYaw) },
+		{ scale.z * (cosPitch * sinYaw), scale.z * -sinPitch, scale.z * (cosPitch * cosYaw) }
+	};
+
+	for (auto column = 0; column < 3; column++)
+	{
+		for (auto row = 0; row < 3; row++)
+		{
+			outTransposedMatrix.m[column][row] = local[row][0] * parent.p[0][column] + local[row][1] * parent.p[1][column] + local[row][2] * parent.p[2][column];
+		}
+
+		outTransposedMatrix.m[column][3] = position.x * parent.p[0][column] + position.y * parent.p[1][column] + position.z * parent.p[2][column] + parent.p[3][column];
+	}
+
+	outTransposedMatrix.m[3][0] = 0.0f;
+	outTransposedMatrix.m[3][1] = 0.0f;
+	outTransposedMatrix.m[3][2] = 0.0f;
+	outTransposedMatrix.m[3][3] = 1.0f;
+}
+
+#if defined(WORLD_MATRIX_BATCH_AVX) || defined(WORLD_MATRIX_BATCH_SSE)
+
+//Thin wrappers so the kernel reads the same for both register widths
+#if defined(WORLD_MATRIX_BATCH_AVX)
+typedef __m256 Lanes;
+static const int LANE_COUNT = 8;
+
+static Lanes Set(const float value) { return _mm256_set1_ps(value); }
+static Lanes Load(const float* const values) { return _mm256_load_ps(values); }
+static Lanes Add(const Lanes a, const Lanes b) { return _mm256_add_ps(a, b); }
+static Lanes Sub(const Lanes a, const Lanes b) { return _mm256_sub_ps(a, b); }
+static Lanes Mul(const Lanes a, const Lanes b) { return _mm256_mul_ps(a, b); }
+static Lanes Round(const Lanes a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+static Lanes Greater(const Lanes a, const Lanes b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+static Lanes Or(const Lanes a, const Lanes b) { return _mm256_or_ps(a, b); }
+static Lanes Select(const Lanes mask, const Lanes ifTrue, const Lanes ifFalse) { return _mm256_blendv_ps(ifFalse, ifTrue, mask); }
+
+//Transposes four component registers into one matrix row for each of the eight instances
+static void StoreRow(const Lanes x, const Lanes y, const Lanes z, const Lanes w, const int row, XMFLOAT4X4* const outTransposedMatrices)
+{
+	for (auto half = 0; half < 2; half++)
+	{
+		auto r0 = half ? _mm256_extractf128_ps(x, 1) : _mm256_castps256_ps128(x);
+		auto r1 = half ? _mm256_extractf128_ps(y, 1) : _mm256_castps256_ps128(y);
+		auto r2 = half ? _mm256_extractf128_ps(z, 1) : _mm256_castps256_ps128(z);
+		auto r3 = half ? _mm256_extractf128_ps(w, 1) : _mm256_castps256_ps128(w);
+
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+		_mm_storeu_ps(outTransposedMatrices[half * 4 + 0].m[row], r0);
+		_mm_storeu_ps(outTransposedMatrices[half * 4 + 1].m[row], r1);
+		_mm_storeu_ps(outTransposedMatrices[half * 4 + 2].m[row], r2);
+		_mm_storeu_ps(outTransposedMatrices[half * 4 + 3].m[row], r3);
+	}
+}
+#else
+typedef __m128 Lanes;
+static const int LANE_COUNT = 4;
+
+static Lanes Set(const float value) { return _mm_set1_ps(value); }
+static Lanes Load(const float* const values) { return _mm_load_ps(values); }
+static Lanes Add(const Lanes a, const Lanes b) { return _mm_add_ps(a, b); }
+static Lanes Sub(const Lanes a, const Lanes b) { return _mm_sub_ps(a, b); }
+static Lanes Mul(const Lanes a, const Lanes b) { return _mm_mul_ps(a, b); }
+static Lanes Round(const Lanes a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+static Lanes Greater(const Lanes a, const Lanes b) { return _mm_cmpgt_ps(a, b); }
+static Lanes Or(const Lanes a, const Lanes b) { return _mm_or_ps(a, b); }
+static Lanes Select(const Lanes mask, const Lanes ifTrue, const Lanes ifFalse) { return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse)); }
+
+//Transposes four component registers into one matrix row for each of the four instances
+static void StoreRow(Lanes x, Lanes y, Lanes z, Lanes w, const int row, XMFLOAT4X4* const outTransposedMatrices)
+{
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+
+	_mm_storeu_ps(outTransposedMatrices[0].m[row], x);
+	_mm_storeu_ps(outTransposedMatrices[1].m[row], y);
+	_mm_storeu_ps(outTransposedMatrices[2].m[row], z);
+	_mm_storeu_ps(outTransposedMatrices[3].m[row], w);
+}
+#endif
+
+//Same range reduction and polynomials as XMScalarSinCos
+static void SinCos(const Lanes angle, Lanes& outSin, Lanes& outCos)
+{
+	const auto quotient = Round(Mul(angle, Set(XM_1DIV2PI)));
+	auto y = Sub(angle, Mul(quotient, Set(XM_2PI)));
+
+	//Map into [-pi/2, pi/2], cos changes sign when we reflect
+	const auto above = Greater(y, Set(XM_PIDIV2));
+	const auto below = Greater(Set(-XM_PIDIV2), y);
+
+	y = Select(above, Sub(Set(XM_PI), y), y);
+	y = Select(below, Sub(Set(-XM_PI), y), y);
+
+	const auto sign = Select(Or(above, below), Set(-1.0f), Set(1.0f));
+	const auto y2 = Mul(y, y);
+
+	auto sinPolynomial = Add(Mul(Set(-2.3889859e-08f), y2), Set(2.7525562e-06f));
+	sinPolynomial = Add(Mul(sinPolynomial, y2), Set(-0.00019840874f));
+	sinPolynomial = Add(Mul(sinPolynomial, y2), Set(0.0083333310f));
+	sinPolynomial = Add(Mul(sinPolynomial, y2), Set(-0.16666667f));
+	sinPolynomial = Add(Mul(sinPolynomial, y2), Set(1.0f));
+	outSin = Mul(sinPolynomial, y);
+
+	auto cosPolynomial = Add(Mul(Set(-2.6051615e-07f), y2), Set(2.4760495e-05f));
+	cosPolynomial = Add(Mul(cosPolynomial, y2), Set(-0.0013888378f));
+	cosPolynomial = Add(Mul(cosPolynomial, y2), Set(0.041666638f));
+	cosPolynomial = Add(Mul(cosPolynomial, y2), Set(-0.5f));
+	cosPolynomial = Add(Mul(cosPolynomial, y2), Set(1.0f));
+	outCos = Mul(cosPolynomial, sign);
+}
+
+static void ComposeLanes(const float* const values, const ParentRows& parent, XMFLOAT4X4* const outTransposedMatrices)
+{
+	//values holds nine arrays of LANE_COUNT floats, scale xyz, rotation xyz then position xyz
+	Lanes sinPitch, cosPitch, sinYaw, cosYaw, sinRoll, cosRoll;
+
+	SinCos(Load(values + 3 * LANE_COUNT), sinPitch, cosPitch);
+	SinCos(Load(values + 4 * LANE_COUNT), sinYaw, cosYaw);
+	SinCos(Load(values + 5 * LANE_COUNT), sinRoll, cosRoll);
+
+	const auto scaleX = Load(values);
+	const auto scaleY = Load(values + LANE_COUNT);
+	const auto scaleZ = Load(values + 2 * LANE_COUNT);
+
+	const auto sinRollSinPitch = Mul(sinRoll, sinPitch);
+	const auto cosRollSinPitch = Mul(cosRoll, sinPitch);
+
+	const Lanes local[3][3] = {
+		{ Mul(scaleX, Add(Mul(cosRoll, cosYaw), Mul(sinRollSinPitch, sinYaw))), Mul(scaleX, Mul(sinRoll, cosPitch)), Mul(scaleX, Sub(Mul(sinRollSinPitch, cosYaw), Mul(cosRoll, sinYaw))) },
+		{ Mul(scaleY, Sub(Mul(cosRollSinPitch, sinYaw), Mul(sinRoll, cosYaw))), Mul(scaleY, Mul(cosRoll, cosPitch)), Mul(scaleY, Add(Mul(sinRoll, sinYaw), Mul(cosRollSinPitch, cosYaw))) },
+		{ Mul(scaleZ, Mul(cosPitch, sinYaw)), Mul(Sub(Set(0.0f), scaleZ), sinPitch), Mul(scaleZ, Mul(cosPitch, cosYaw)) }
+	};
+
+	const auto positionX = Load(values + 6 * LANE_COUNT);
+	const auto positionY = Load(values + 7 * LANE_COUNT);
+	const auto positionZ = Load(values + 8 * LANE_COUNT);
+
+	for (auto column = 0; column < 3; column++)
+	{
+		const auto parentX = Set(parent.p[0][column]);
+		const auto parentY = Set(parent.p[1][column]);
+		const auto parentZ = Set(parent.p[2][column]);
+
+		const auto x = Add(Add(Mul(local[0][0], parentX), Mul(local[0][1], parentY)), Mul(local[0][2], parentZ));
+		const auto y = Add(Add(Mul(local[1][0], parentX), Mul(local[1][1], parentY)), Mul(local[1][2], parentZ));
+		const auto z = Add(Add(Mul(local[2][0], parentX), Mul(local[2][1], parentY)), Mul(local[2][2], parentZ));
+		const auto w = Add(Add(Add(Mul(positionX, parentX), Mul(positionY, parentY)), Mul(positionZ, parentZ)), Set(parent.p[3][column]));
+
+		StoreRow(x, y, z, w, column, outTransposedMatrices);
+	}
+
+	for (auto lane = 0; lane < LANE_COUNT; lane++)
+	{
+		outTransposedMatrices[lane].m[3][0] = 0.0f;
+		outTransposedMatrices[lane].m[3][1] = 0.0f;
+		outTransposedMatrices[lane].m[3][2] = 0.0f;
+		outTransposedMatrices[lane].m[3][3] = 1.0f;
+	}
+}
+
+#endif
+
+WorldMatrixBatch::WorldMatrixBatch() = default;
+
+WorldMatrixBatch::WorldMatrixBatch(const WorldMatrixBatch& other) = default;
+
+WorldMatrixBatch::WorldMatrixBatch(WorldMatrixBatch&& other) noexcept = default;
+
+WorldMatrixBatch::~WorldMatrixBatch() = default;
+
+WorldMatrixBatch& WorldMatrixBatch::operator=(const WorldMatrixBatch& other) = default;
+
+WorldMatrixBatch& WorldMatrixBatch::operator=(WorldMatrixBatch&& other) noexcept = default;
+
+void WorldMatrixBatch::Compose(const vector<XMFLOAT3>& scales, const vector<XMFLOAT3>& rotations, const vector<XMFLOAT3>& positions, const XMMATRIX& parentMatrix, XMFLOAT4X4* const outTransposedMatrices)
+{
+	ComposeRange(scales, rotations, positions, parentMatrix, 0, positions.size(), outTransposedMatrices);
+}
+
+void WorldMatrixBatch::ComposeRange(const vector<XMFLOAT3>& scales, const vector<XMFLOAT3>& rotations, const vector<XMFLOAT3>& positions, const XMMATRIX& parentMatrix, const size_t first, const size_t count, XMFLOAT4X4* const outTransposedMatrices)
+{
+	const auto parent = GetParentRows(parentMatrix);
+	const auto end = first + count;
+
+#if defined(WORLD_MATRIX_BATCH_AVX) || defined(WORLD_MATRIX_BATCH_SSE)
+	const auto blockEnd = end - count % BLOCK_SIZE;
+
+	//Gather a block into structure of arrays form, 32 byte aligned for the AVX loads
+	alignas(32) float values[9 * BLOCK_SIZE];
+
+	for (auto block = first; block < blockEnd; block += BLOCK_SIZE)
+	{
+		for (auto group = 0; group < BLOCK_SIZE; group += LANE_COUNT)
+		{
+			for (auto lane = 0; lane < LANE_COUNT; lane++)
+			{
+				const auto index = block + group + lane;
+				const auto& scale = GetClamped(scales, index);
+				const auto& rotation = GetClamped(rotations, index);
+				const auto& position = positions[index];
+
+				values[0 * LANE_COUNT + lane] = scale.x;
+				values[1 * LANE_COUNT + lane] = scale.y;
+				values[2 * LANE_COUNT + lane] = scale.z;
+				values[3 * LANE_COUNT + lane] = rotation.x;
+				values[4 * LANE_COUNT + lane] = rotation.y;
+				values[5 * LANE_COUNT + lane] = rotation.z;
+				values[6 * LANE_COUNT + lane] = position.x;
+				values[7 * LANE_COUNT + lane] = position.y;
+				values[8 * LANE_COUNT + lane] = position.z;
+			}
+
+			ComposeLanes(values, parent, outTransposedMatrices + block + group);
+		}
+	}
+
+	for (auto i = blockEnd; i < end; i++)
+	{
+		ComposeInstance(GetClamped(scales, i), GetClamped(rotations, i), positions[i], parent, outTransposedMatrices[i]);
+	}
+#else
+	for (auto i = first; i < end; i++)
+	{
+		ComposeInstance(GetClamped(scales, i), GetClamped(rotations, i), positions[i], parent, outTransposedMatrices[i]);
+	}
+#endif
+}
+
+void WorldMatrixBatch::ComposeScalar(const vector<XMFLOAT3>& scales, const vector<XMFLOAT3>& rotations, const vector<XMFLOAT3>& positions, const XMMATRIX& parentMatrix, XMFLOAT4X4* const outTransposedMatrices)
+{
+	const auto parent = GetParentRows(parentMatrix);
+
+	for (size_t i = 0; i < positions.size(); i++)
+	{
+		ComposeInstance(GetClamped(scales, i), GetClamped(rotations, i), positions[i], parent, outTransposedMatrices[i]);
+	}
+}
+
+void WorldMatrixBatch::ComposeReference(const vector<XMFLOAT3>& scales, const vector<XMFLOAT3>& rotations, const vector<XMFLOAT3>& positions, const XMMATRIX& parentMatrix, XMFLOAT4X4* const outTransposedMatrices)
+{
+	for (size_t i = 0; i < positions.size(); i++)
+	{
+		auto worldMatrix = XMMatrixIdentity();
+
+		const auto position = positions[i];
+		const auto scale = GetClamped(scales, i);
+		const auto rotation = GetClamped(rotations, i);
+
+		worldMatrix = XMMatrixMultiply(worldMatrix, XMMatrixScaling(scale.x, scale.y, scale.z));
+		worldMatrix = XMMatrixMultiply(worldMatrix, XMMatrixRotationQuaternion(XMQuaternionRotationRollPitchYaw(rotation.x, rotation.y, rotation.z)));
+		worldMatrix = XMMatrixMultiply(worldMatrix, XMMatrixTranslation(position.x, position.y, position.z));
+
+		worldMatrix = worldMatrix * parentMatrix;
+
+		XMStoreFloat4x4(&outTransposedMatrices[i], XMMatrixTranspose(worldMatrix));
+	}
+}
+
+int WorldMatrixBatch::GetBlockSize()
+{
+#if defined(WORLD_MATRIX_BATCH_AVX) || defined(WORLD_MATRIX_BATCH_SSE)
+	return BLOCK_SIZE;
+#else
+	return 1;
+#endif
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <vector>
+
+using namespace DirectX;
+using namespace std;
+
+//Builds transposed instance world matrices, scale * roll pitch yaw rotation * translation * parent, for many instances at once.
+//Instances are processed in structure of arrays blocks with SSE or AVX and the scale, rotation and parent are composed
+//straight into the three rows the shaders read instead of going through quaternions and full matrix multiplies.
+//Like Model has always done, an instance past the end of scales or rotations uses the last entry.
+//The parent matrix must be affine, the fourth row written is always (0, 0, 0, 1)
+class WorldMatrixBatch
+{
+public:
+	WorldMatrixBatch();
+	WorldMatrixBatch(const WorldMatrixBatch& other); // Copy Constructor
+	WorldMatrixBatch(WorldMatrixBatch&& other) noexcept; // Move Constructor
+	~WorldMatrixBatch(); // Destructor
+
+	WorldMatrixBatch& operator = (const WorldMatrixBatch& other); // Copy Assignment Operator
+	WorldMatrixBatch& operator = (WorldMatrixBatch&& other) noexcept; // Move Assignment Operator
+
+	//Uses the widest path available to this build
+	static void Compose(const vector<XMFLOAT3>& scales, const vector<XMFLOAT3>& rotations, const vector<XMFLOAT3>& positions, const XMMATRIX& parentMatrix, XMFLOAT4X4* const outTransposedMatrices);
+	//Only rebuilds instances first to first + count - 1, outTransposedMatrices is still the start of the whole array
+	static void ComposeRange(const vector<XMFLOAT3>& scales, const vector<XMFLOAT3>& rotations, const vector<XMFLOAT3>& positions, const XMMATRIX& parentMatrix, const size_t first, const size_t count, XMFLOAT4X4* const outTransposedMatrices);
+
+	//Scalar fallback, also used for the instances left over after the last full block
+	static void ComposeScalar(const vector<XMFLOAT3>& scales, const vector<XMFLOAT3>& rotations, const vector<XMFLOAT3>& positions, const XMMATRIX& parentMatrix, XMFLOAT4X4* const outTransposedMatrices);
+
+	//The per instance DirectXMath matrix multiplies this replaced, kept to check and benchmark against
+	static void ComposeReference(const vector<XMFLOAT3>& scales, const vector<XMFLOAT3>& rotations, const vector<XMFLOAT3>& positions, const XMMATRIX& parentMatrix, XMFLOAT4X4* const outTransposedMatrices);
+
+	//Instances handled per iteration of the SIMD loop, 1 when the build only has the scalar path
+	static int GetBlockSize();
+};
@@ -0,0 +1,166 @@
+#include "BenchmarkHarness.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+
+const void* volatile BenchmarkState::sink = nullptr;
+
+static long long GetTime()
+{
+	return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+BenchmarkState::BenchmarkState(const long long iterations) : iterations(iterations), remainingIterations(iterations), pausedTime(0), pauseStart(0)
+{
+}
+
+BenchmarkState::BenchmarkState(const BenchmarkState& other) = default;
+
+BenchmarkState::BenchmarkState(BenchmarkState&& other) noexcept = default;
+
+BenchmarkState::~BenchmarkState() = default;
+
+BenchmarkState& BenchmarkState::operator=(const BenchmarkState& other) = default;
+
+BenchmarkState& BenchmarkState::operator=(BenchmarkState&& other) noexcept = default;
+
+bool BenchmarkState::KeepRunning()
+{
+	if (remainingIterations == 0)
+	{
+		return false;
+	}
+
+	remainingIterations--;
+
+	return true;
+}
+
+long long BenchmarkState::GetIterations() const
+{
+	return iterations;
+}
+
+void BenchmarkState::PauseTiming()
+{
+	pauseStart = GetTime();
+}
+
+void BenchmarkState::ResumeTiming()
+{
+	pausedTime += GetTime() - pauseStart;
+}
+
+long long BenchmarkState::GetPausedTime() const
+{
+	return pausedTime;
+}
+
+BenchmarkHarness::BenchmarkHarness(const double minTime, const int repetitions, const string& filter) : minTime(minTime), repetitions(max(repetitions, 1)), filter(filter), benchmarks(), results()
+{
+}
+
+BenchmarkHarness::BenchmarkHarness(const BenchmarkHarness& other) = default;
+
+BenchmarkHarness::BenchmarkHarness(BenchmarkHarness&& other) noexcept = default;
+
+BenchmarkHarness::~BenchmarkHarness() = default;
+
+BenchmarkHarness& BenchmarkHarness::operator=(const BenchmarkHarness& other) = default;
+
+BenchmarkHarness& BenchmarkHarness::operator=(BenchmarkHarness&& other) noexcept = default;
+
+void BenchmarkHarness::Add(const string& name, const function<void(BenchmarkState&)>& benchmark)
+{
+	benchmarks.push_back({ name, benchmark });
+}
+
+void BenchmarkHarness::Run(ostream& output)
+{
+	results.clear();
+
+	output << left << setw(56) << "Benchmark" << right << setw(14) << "Median ns" << setw(14) << "Fastest ns" << setw(14) << "Slowest ns" << setw(14) << "Iterations" << endl;
+
+	for (const auto& benchmark : benchmarks)
+	{
+		if (benchmark.name.find(filter) == string::npos)
+		{
+			continue;
+		}
+
+		//Grow the iteration count until a run is long enough to time reliably, the last of these runs doubles as a warm up
+		auto iterations = 1ll;
+
+		while (Measure(benchmark, iterations) * iterations < minTime * 1e9 && iterations < (1ll << 40))
+		{
+			iterations *= 2;
+		}
+
+		vector<double> times;
+
+		for (auto i = 0; i < repetitions; i++)
+		{
+			times.push_back(Measure(benchmark, iterations));
+		}
+
+		sort(times.begin(), times.end());
+
+		const BenchmarkResult result = { benchmark.name, iterations, repetitions, times[times.size() / 2], times.front(), times.back() };
+		results.push_back(result);
+
+		output << left << setw(56) << result.name << right << fixed << setprecision(1) << setw(14) << result.median << setw(14) << result.fastest << setw(14) << result.slowest << defaultfloat << setw(14) << result.iterations << endl;
+	}
+}
+
+const vector<BenchmarkResult>& BenchmarkHarness::GetResults() const
+{
+	return results;
+}
+
+void BenchmarkHarness::WriteJson(ostream& output) const
+{
+	const auto timestamp = chrono::duration_cast<chrono::seconds>(chrono::system_clock::now().time_since_epoch()).count();
+
+	output << "{\n\"context\":{\"timestamp\":" << timestamp << ",\"num_cpus\":" << thread::hardware_concurrency() << ",\"min_time\":" << minTime << ",\"repetitions\":" << repetitions << "},\n\"benchmarks\":[";
+
+	output << fixed << setprecision(3);
+
+	for (auto i = 0u; i < results.size(); i++)
+	{
+		const auto& result = results[i];
+
+		output << (i == 0 ? "" : ",") << "\n{\"name\":\"" << result.name << "\",\"iterations\":" << result.iterations << ",\"repetitions\":" << result.repetitions
+			<< ",\"real_time\":" << result.median << ",\"min_time_ns\":" << result.fastest << ",\"max_time_ns\":" << result.slowest << ",\"time_unit\":\"ns\"}";
+	}
+
+	output << defaultfloat;
+
+	output << "\n]\n}" << endl;
+}
+
+bool BenchmarkHarness::ExportJson(const string& fileName) const
+{
+	ofstream output(fileName);
+
+	if (!output)
+	{
+		return false;
+	}
+
+	WriteJson(output);
+
+	return static_cast<bool>(output);
+}
+
+double BenchmarkHarness::Measure(const Benchmark& benchmark, const long long iterations)
+{
+	BenchmarkState state(iterations);
+
+	const auto start = GetTime();
+	benchmark.run(state);
+	const auto elapsed = GetTime() - start - state.GetPausedTime();
+
+	return static_cast<double>(max(elapsed, 0ll)) / iterations;
+}
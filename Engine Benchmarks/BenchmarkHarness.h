@@ -0,0 +1,102 @@
+#pragma once
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+//How long each repetition keeps doubling its iteration count for, and how many timed repetitions follow
+const double BENCHMARK_MIN_TIME = 0.1;
+const int BENCHMARK_REPETITIONS = 5;
+
+//Handed to a benchmark, which runs the code being timed once for every KeepRunning that returns true.
+//Setup that has to happen inside the loop goes between PauseTiming and ResumeTiming
+class BenchmarkState
+{
+public:
+	explicit BenchmarkState(const long long iterations);
+	BenchmarkState(const BenchmarkState& other); // Copy Constructor
+	BenchmarkState(BenchmarkState&& other) noexcept; // Move Constructor
+	~BenchmarkState(); // Destructor
+
+	BenchmarkState& operator = (const BenchmarkState& other); // Copy Assignment Operator
+	BenchmarkState& operator = (BenchmarkState&& other) noexcept; // Move Assignment Operator
+
+	bool KeepRunning();
+	long long GetIterations() const;
+
+	void PauseTiming();
+	void ResumeTiming();
+	//Nanoseconds spent paused, the harness takes it off the repetition's time
+	long long GetPausedTime() const;
+
+	//Stops the compiler from dropping a result that is otherwise unused
+	template <typename T>
+	static void DoNotOptimize(const T& value)
+	{
+		sink = &value;
+	}
+
+private:
+	static const void* volatile sink;
+
+	long long iterations;
+	long long remainingIterations;
+
+	long long pausedTime;
+	long long pauseStart;
+};
+
+//Median, fastest and slowest nanoseconds per iteration over the repetitions
+struct BenchmarkResult
+{
+	string name;
+	long long iterations;
+	int repetitions;
+	double median;
+	double fastest;
+	double slowest;
+};
+
+//A minimal stand-in for Google Benchmark, which isn't one of the solution's packages. Every benchmark first runs with
+//doubling iteration counts until one run takes at least minTime, then runs that many iterations repetitions times.
+//WriteJson writes the results in Google Benchmark's layout so compare_benchmarks.py, or Google's own tools, can read them
+class BenchmarkHarness
+{
+public:
+	BenchmarkHarness(const double minTime, const int repetitions, const string& filter);
+	BenchmarkHarness(const BenchmarkHarness& other); // Copy Constructor
+	BenchmarkHarness(BenchmarkHarness&& other) noexcept; // Move Constructor
+	~BenchmarkHarness(); // Destructor
+
+	BenchmarkHarness& operator = (const BenchmarkHarness& other); // Copy Assignment Operator
+	BenchmarkHarness& operator = (BenchmarkHarness&& other) noexcept; // Move Assignment Operator
+
+	void Add(const string& name, const function<void(BenchmarkState&)>& benchmark);
+
+	//Runs every benchmark whose name contains the filter, in the order they were added
+	void Run(ostream& output);
+
+	const vector<BenchmarkResult>& GetResults() const;
+	void WriteJson(ostream& output) const;
+	bool ExportJson(const string& fileName) const;
+
+private:
+	struct Benchmark
+	{
+		string name;
+		function<void(BenchmarkState&)> run;
+	};
+
+	//Nanoseconds per iteration
+	static double Measure(const Benchmark& benchmark, const long long iterations);
+
+	double minTime;
+	int repetitions;
+	string filter;
+
+	vector<Benchmark> benchmarks;
+	vector<BenchmarkResult> results;
+};
@@ -0,0 +1,123 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "BenchmarkHarness.h"
+#include "ParsingBenchmarks.h"
+#include "RenderingBenchmarks.h"
+#include "SimulationBenchmarks.h"
+#include "SimulationConfigLoader.h"
+
+using namespace std;
+
+//Times the engine's hot paths and writes the results for compare_benchmarks.py to check against a baseline
+//Usage: EngineBenchmarks [--filter text] [--json outputFile] [--min-time seconds] [--repetitions count]
+//       EngineBenchmarks --mesh-report
+//       EngineBenchmarks --vertex-report
+//       EngineBenchmarks --load-report
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && strcmp(argv[1], "--mesh-report") == 0)
+	{
+		ParsingBenchmarks::WriteBenchmarkSphere();
+
+		const RenderingBenchmarks renderingBenchmarks;
+
+		if (renderingBenchmarks.GetInitializationState())
+		{
+			cerr << "Could not create a Direct3D device" << endl;
+			return 1;
+		}
+
+		renderingBenchmarks.WriteMeshReport(cout);
+		return 0;
+	}
+
+	if (argc > 1 && strcmp(argv[1], "--load-report") == 0)
+	{
+		ParsingBenchmarks::WriteBenchmarkSphere();
+
+		const RenderingBenchmarks renderingBenchmarks;
+
+		if (renderingBenchmarks.GetInitializationState())
+		{
+			cerr << "Could not create a Direct3D device" << endl;
+			return 1;
+		}
+
+		renderingBenchmarks.WriteLoadReport(cout);
+		return 0;
+	}
+
+	if (argc > 1 && strcmp(argv[1], "--vertex-report") == 0)
+	{
+		return ParsingBenchmarks::WriteVertexReport(cout) ? 0 : 1;
+	}
+
+	string filter;
+	string jsonFile;
+	auto minTime = BENCHMARK_MIN_TIME;
+	auto repetitions = BENCHMARK_REPETITIONS;
+
+	for (auto i = 1; i < argc; i++)
+	{
+		if (i + 1 < argc && strcmp(argv[i], "--filter") == 0)
+		{
+			filter = argv[++i];
+		}
+		else if (i + 1 < argc && strcmp(argv[i], "--json") == 0)
+		{
+			jsonFile = argv[++i];
+		}
+		else if (i + 1 < argc && strcmp(argv[i], "--min-time") == 0)
+		{
+			minTime = atof(argv[++i]);
+		}
+		else if (i + 1 < argc && strcmp(argv[i], "--repetitions") == 0)
+		{
+			repetitions = atoi(argv[++i]);
+		}
+		else
+		{
+			cerr << "Usage: EngineBenchmarks [--filter text] [--json outputFile] [--min-time seconds] [--repetitions count]" << endl;
+			return 1;
+		}
+	}
+
+	if (minTime <= 0.0 || repetitions < 1)
+	{
+		cerr << "Invalid minimum time or repetition count" << endl;
+		return 1;
+	}
+
+	const auto configuration = make_shared<SimulationConfigLoader>("Configuration.txt");
+
+	BenchmarkHarness harness(minTime, repetitions, filter);
+
+	SimulationBenchmarks::Register(harness, configuration);
+	ParsingBenchmarks::Register(harness, cout);
+
+	//Outlives the run, the rendering benchmarks use its device
+	RenderingBenchmarks renderingBenchmarks;
+
+	if (renderingBenchmarks.GetInitializationState())
+	{
+		cerr << "Could not create a Direct3D device, skipping the rendering benchmarks" << endl;
+	}
+	else
+	{
+		renderingBenchmarks.Register(harness, cout);
+	}
+
+	harness.Run(cout);
+
+	if (!jsonFile.empty() && !harness.ExportJson(jsonFile))
+	{
+		cerr << "Could not write " << jsonFile << endl;
+		return 1;
+	}
+
+	return 0;
+}
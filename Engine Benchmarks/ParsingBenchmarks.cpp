@@ -0,0 +1,352 @@
+#include "ParsingBenchmarks.h"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "ObjParser.h"
+#include "TangentGenerator.h"
+#include "VertexCompressor.h"
+
+//The models tangent generation and parsing cost the most on
+static const char* const PARSED_MODEL_FILE_NAMES[] = { "sphere.obj", "cubeHigh.obj", "cylinderHigh.obj" };
+
+//ResourceManager::LoadModel's parser before ObjParser replaced it, without the tangents. It reads one token at a
+//time through an ifstream and needs the "faces" line before the faces to size its arrays
+static bool ParseWithStream(const char* const modelFileName, ObjMesh& mesh)
+{
+	ifstream fin;
+	fin.open(modelFileName);
+
+	mesh = ObjMesh();
+
+	char cmd[256] = { 0 };
+	auto faceCount = 0;
+
+	while (!fin.eof())
+	{
+		float x, y, z;
+		fin >> cmd;
+		if (0 == strcmp(cmd, "faces"))
+		{
+			fin >> faceCount;
+			mesh.corners.resize(faceCount * 3);
+		}
+		if (0 == strcmp(cmd, "v"))
+		{
+			fin >> x >> y >> z;
+			mesh.positions.emplace_back(XMFLOAT3(x, y, z));
+		}
+		else if (0 == strcmp(cmd, "vn"))
+		{
+			fin >> x >> y >> z;
+			mesh.normals.emplace_back(XMFLOAT3(x, y, z));
+		}
+		else if (0 == strcmp(cmd, "vt"))
+		{
+			fin >> x >> y >> z;
+			mesh.textures.emplace_back(XMFLOAT2(x, y));
+		}
+		else if (0 == strcmp(cmd, "f"))
+		{
+			int value;
+			auto count = 0;
+			while (0 == strcmp(cmd, "f") && count < faceCount * 3)
+			{
+				for (auto i = 0; i < 3; i++)
+				{
+					fin >> value;
+					mesh.corners[count].position = value - 1;
+					fin.ignore();
+					fin >> value;
+					mesh.corners[count].texture = value - 1;
+					fin.ignore();
+					fin >> value;
+					mesh.corners[count].normal = value - 1;
+					fin.ignore();
+					count++;
+				}
+
+				fin >> cmd;
+			}
+		}
+	}
+
+	return faceCount > 0;
+}
+
+//The vertices TangentGenerator sees in ResourceManager::LoadModel, with the authored normals and welded
+static bool BuildWeldedVertices(const string& modelFileName, vector<MeshVertex>& vertices, vector<uint32_t>& indices)
+{
+	ObjMesh mesh;
+	string error;
+
+	if (!ObjParser::ParseFile(modelFileName, mesh, error))
+	{
+		return false;
+	}
+
+	const auto sourceVertexCount = static_cast<int>(mesh.corners.size());
+	vertices.resize(sourceVertexCount);
+	indices.resize(sourceVertexCount);
+
+	for (auto count = 0; count < sourceVertexCount; count++)
+	{
+		const auto& corner = mesh.corners[count];
+		vertices[count].position = mesh.positions[corner.position];
+		vertices[count].texture = corner.texture >= 0 ? mesh.textures[corner.texture] : XMFLOAT2(0.0f, 0.0f);
+		vertices[count].normal = corner.normal >= 0 ? mesh.normals[corner.normal] : XMFLOAT3(0.0f, 0.0f, 0.0f);
+		vertices[count].tangent = XMFLOAT3(0.0f, 0.0f, 0.0f);
+		vertices[count].binormal = XMFLOAT3(0.0f, 0.0f, 0.0f);
+		indices[count] = count;
+	}
+
+	vertices.resize(MeshOptimizer::WeldVertices(vertices.data(), sourceVertexCount, sizeof(MeshVertex), indices));
+
+	return true;
+}
+
+//In degrees, atan2 rather than acos of the dot product which can't resolve small angles in floats
+static double GetAngleBetween(const XMFLOAT3& first, const XMFLOAT3& second)
+{
+	const auto crossX = static_cast<double>(first.y) * second.z - static_cast<double>(first.z) * second.y;
+	const auto crossY = static_cast<double>(first.z) * second.x - static_cast<double>(first.x) * second.z;
+	const auto crossZ = static_cast<double>(first.x) * second.y - static_cast<double>(first.y) * second.x;
+	const auto dot = static_cast<double>(first.x) * second.x + static_cast<double>(first.y) * second.y + static_cast<double>(first.z) * second.z;
+
+	return atan2(sqrt(crossX * crossX + crossY * crossY + crossZ * crossZ), dot) * 180.0 / 3.14159265358979;
+}
+
+bool ParsingBenchmarks::WriteBenchmarkSphere()
+{
+	ofstream output(BENCHMARK_SPHERE_FILE_NAME);
+
+	const auto pi = 3.14159265f;
+
+	//A ring of vertices per stack including both poles, with the seam duplicated so its texture coordinates wrap
+	for (auto stack = 0; stack <= BENCHMARK_SPHERE_STACKS; stack++)
+	{
+		const auto phi = pi * stack / BENCHMARK_SPHERE_STACKS;
+
+		for (auto slice = 0; slice <= BENCHMARK_SPHERE_SLICES; slice++)
+		{
+			const auto theta = 2.0f * pi * slice / BENCHMARK_SPHERE_SLICES;
+			const auto x = sin(phi) * cos(theta);
+			const auto y = cos(phi);
+			const auto z = sin(phi) * sin(theta);
+
+			output << "v " << x << " " << y << " " << z << "\n";
+			output << "vt " << static_cast<float>(slice) / BENCHMARK_SPHERE_SLICES << " " << static_cast<float>(stack) / BENCHMARK_SPHERE_STACKS << " 0.0\n";
+			output << "vn " << x << " " << y << " " << z << "\n";
+		}
+	}
+
+	output << "faces " << BENCHMARK_SPHERE_STACKS * BENCHMARK_SPHERE_SLICES * 2 << "\n";
+
+	for (auto stack = 0; stack < BENCHMARK_SPHERE_STACKS; stack++)
+	{
+		for (auto slice = 0; slice < BENCHMARK_SPHERE_SLICES; slice++)
+		{
+			//One based, and the same index for the position, texture and normal
+			const auto topLeft = stack * (BENCHMARK_SPHERE_SLICES + 1) + slice + 1;
+			const auto bottomLeft = topLeft + BENCHMARK_SPHERE_SLICES + 1;
+
+			output << "f " << topLeft << "/" << topLeft << "/" << topLeft << " " << bottomLeft << "/" << bottomLeft << "/" << bottomLeft << " " << topLeft + 1 << "/" << topLeft + 1 << "/" << topLeft + 1 << "\n";
+			output << "f " << topLeft + 1 << "/" << topLeft + 1 << "/" << topLeft + 1 << " " << bottomLeft << "/" << bottomLeft << "/" << bottomLeft << " " << bottomLeft + 1 << "/" << bottomLeft + 1 << "/" << bottomLeft + 1 << "\n";
+		}
+	}
+
+	return static_cast<bool>(output);
+}
+
+void ParsingBenchmarks::Register(BenchmarkHarness& harness, ostream& output)
+{
+	vector<string> fileNames;
+
+	if (WriteBenchmarkSphere())
+	{
+		fileNames.emplace_back(BENCHMARK_SPHERE_FILE_NAME);
+	}
+
+	for (const auto* modelFileName : PARSED_MODEL_FILE_NAMES)
+	{
+		if (ifstream(modelFileName))
+		{
+			fileNames.emplace_back(modelFileName);
+		}
+		else
+		{
+			output << "Skipping ObjParser/" << modelFileName << ", it isn't in the working directory" << endl;
+		}
+	}
+
+	//Shared by the tangent benchmarks and kept alive by them until the harness is destroyed
+	const auto jobSystem = make_shared<JobSystem>(JobSystem::GetDefaultWorkerThreadCount());
+
+	for (const auto& fileName : fileNames)
+	{
+		harness.Add("ObjParser/Stream/" + fileName, [fileName](BenchmarkState& state)
+		{
+			ObjMesh mesh;
+
+			while (state.KeepRunning())
+			{
+				ParseWithStream(fileName.c_str(), mesh);
+				BenchmarkState::DoNotOptimize(mesh);
+			}
+		});
+
+		harness.Add("ObjParser/Mapped/" + fileName, [fileName](BenchmarkState& state)
+		{
+			ObjMesh mesh;
+			string error;
+
+			while (state.KeepRunning())
+			{
+				ObjParser::ParseFile(fileName, mesh, error);
+				BenchmarkState::DoNotOptimize(mesh);
+			}
+		});
+
+		auto vertices = make_shared<vector<MeshVertex>>();
+		auto indices = make_shared<vector<uint32_t>>();
+
+		if (!BuildWeldedVertices(fileName, *vertices, *indices))
+		{
+			continue;
+		}
+
+		harness.Add("TangentGenerator/Serial/" + fileName, [vertices, indices](BenchmarkState& state)
+		{
+			auto generated = *vertices;
+
+			while (state.KeepRunning())
+			{
+				TangentGenerator::Generate(generated.data(), static_cast<int>(generated.size()), *indices, nullptr);
+				BenchmarkState::DoNotOptimize(generated);
+			}
+		});
+
+		harness.Add("TangentGenerator/Jobs/" + fileName, [vertices, indices, jobSystem](BenchmarkState& state)
+		{
+			auto generated = *vertices;
+
+			while (state.KeepRunning())
+			{
+				TangentGenerator::Generate(generated.data(), static_cast<int>(generated.size()), *indices, jobSystem.get());
+				BenchmarkState::DoNotOptimize(generated);
+			}
+		});
+
+		harness.Add("MeshSimplifier/LevelsOfDetail/" + fileName, [vertices, indices](BenchmarkState& state)
+		{
+			vector<uint32_t> simplified;
+			vector<MeshLevelOfDetail> levelsOfDetail;
+
+			while (state.KeepRunning())
+			{
+				simplified = *indices;
+				MeshSimplifier::GenerateLevelsOfDetail(vertices->data(), static_cast<int>(vertices->size()), simplified, levelsOfDetail);
+				BenchmarkState::DoNotOptimize(simplified);
+			}
+		});
+	}
+}
+
+bool ParsingBenchmarks::WriteVertexReport(ostream& output)
+{
+	static const MeshVertexFormat formats[] = { MeshVertexFormat::Compact, MeshVertexFormat::CompactQuantized };
+	static const char* const formatNames[] = { "Compact", "CompactQuantized" };
+
+	WriteBenchmarkSphere();
+
+	output << left << setw(24) << "Model" << setw(18) << "Format" << right << setw(8) << "Bytes" << setw(14) << "Position" << setw(12) << "Texture"
+		<< setw(12) << "Normal" << setw(12) << "Tangent" << setw(8) << "Flips" << endl;
+
+	auto passed = true;
+
+	for (const auto* modelFileName : { BENCHMARK_SPHERE_FILE_NAME, "sphere.obj", "cubeHigh.obj", "cylinderHigh.obj", "cone.obj", "plane.obj" })
+	{
+		vector<MeshVertex> vertices;
+		vector<uint32_t> indices;
+
+		if (!BuildWeldedVertices(modelFileName, vertices, indices))
+		{
+			output << left << setw(24) << modelFileName << "missing" << endl;
+			continue;
+		}
+
+		const auto vertexCount = static_cast<int>(vertices.size());
+		TangentGenerator::Generate(vertices.data(), vertexCount, indices, nullptr);
+
+		float boundsMin[3] = { vertices[0].position.x, vertices[0].position.y, vertices[0].position.z };
+		float boundsMax[3] = { boundsMin[0], boundsMin[1], boundsMin[2] };
+
+		for (const auto& vertex : vertices)
+		{
+			const float position[3] = { vertex.position.x, vertex.position.y, vertex.position.z };
+
+			for (auto axis = 0; axis < 3; axis++)
+			{
+				boundsMin[axis] = fmin(boundsMin[axis], position[axis]);
+				boundsMax[axis] = fmax(boundsMax[axis], position[axis]);
+			}
+		}
+
+		const auto extent = fmax(fmax(boundsMax[0] - boundsMin[0], boundsMax[1] - boundsMin[1]), fmax(boundsMax[2] - boundsMin[2], 1e-6f));
+
+		for (auto format = 0; format < 2; format++)
+		{
+			vector<unsigned char> compressed;
+			vector<MeshVertex> decompressed;
+
+			VertexCompressor::Compress(vertices.data(), vertexCount, formats[format], boundsMin, boundsMax, compressed);
+			VertexCompressor::Decompress(compressed.data(), vertexCount, formats[format], boundsMin, boundsMax, decompressed);
+
+			auto positionError = 0.0;
+			auto textureError = 0.0;
+			auto normalError = 0.0;
+			auto tangentError = 0.0;
+			auto flipCount = 0;
+
+			for (auto i = 0; i < vertexCount; i++)
+			{
+				const auto& original = vertices[i];
+				const auto& decoded = decompressed[i];
+
+				positionError = fmax(positionError, fabs(decoded.position.x - original.position.x) / extent);
+				positionError = fmax(positionError, fabs(decoded.position.y - original.position.y) / extent);
+				positionError = fmax(positionError, fabs(decoded.position.z - original.position.z) / extent);
+
+				textureError = fmax(textureError, fabs(decoded.texture.x - original.texture.x) / fmax(fabs(original.texture.x), 1.0f));
+				textureError = fmax(textureError, fabs(decoded.texture.y - original.texture.y) / fmax(fabs(original.texture.y), 1.0f));
+
+				normalError = fmax(normalError, GetAngleBetween(original.normal, decoded.normal));
+				tangentError = fmax(tangentError, GetAngleBetween(original.tangent, decoded.tangent));
+
+				const auto binormalDot = original.binormal.x * decoded.binormal.x + original.binormal.y * decoded.binormal.y + original.binormal.z * decoded.binormal.z;
+
+				if (binormalDot < 0.0f)
+				{
+					flipCount++;
+				}
+			}
+
+			const auto formatPassed = positionError <= VERTEX_REPORT_MAX_POSITION_ERROR && textureError <= VERTEX_REPORT_MAX_TEXTURE_ERROR &&
+				normalError <= VERTEX_REPORT_MAX_ANGLE_ERROR && tangentError <= VERTEX_REPORT_MAX_ANGLE_ERROR && flipCount == 0;
+
+			passed = passed && formatPassed;
+
+			output << left << setw(24) << modelFileName << setw(18) << formatNames[format] << right << setw(8) << VertexCompressor::GetVertexSize(formats[format])
+				<< scientific << setprecision(2) << setw(14) << positionError << setw(12) << textureError << fixed << setprecision(4) << setw(12) << normalError
+				<< setw(12) << tangentError << setw(8) << flipCount << (formatPassed ? "" : "  FAILED") << defaultfloat << endl;
+		}
+	}
+
+	return passed;
+}
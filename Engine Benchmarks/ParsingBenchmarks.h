@@ -0,0 +1,33 @@
+#pragma once
+
+#include <ostream>
+
+#include "BenchmarkHarness.h"
+
+using namespace std;
+
+//Written next to the executable so the parsers are compared even where the shipped models aren't present
+const char* const BENCHMARK_SPHERE_FILE_NAME = "BenchmarkSphere.obj";
+const int BENCHMARK_SPHERE_SLICES = 128;
+const int BENCHMARK_SPHERE_STACKS = 64;
+
+//The most the compact vertex formats may get a vertex wrong by before WriteVertexReport fails. Positions are relative
+//to the largest side of the model's bounds and texture coordinates to their own size past 1, since halves lose bits
+//as they grow
+const double VERTEX_REPORT_MAX_POSITION_ERROR = 0.0001;
+const double VERTEX_REPORT_MAX_TEXTURE_ERROR = 0.001;
+const double VERTEX_REPORT_MAX_ANGLE_ERROR = 0.05;
+
+//Parses the high poly models with ObjParser and with the stream parser ResourceManager::LoadModel used before it,
+//without a graphics device, so the two can be compared on the same files. Generates their tangents on one thread and
+//across a job system from the welded vertices LoadModel hands TangentGenerator, and builds their levels of detail
+class ParsingBenchmarks
+{
+public:
+	static void Register(BenchmarkHarness& harness, ostream& output);
+	static bool WriteBenchmarkSphere();
+
+	//Compresses and decompresses the models in every vertex format and writes the largest position, texture coordinate,
+	//normal and tangent errors and how many binormals flipped. Returns false if any are past the limits above
+	static bool WriteVertexReport(ostream& output);
+};
@@ -0,0 +1,331 @@
+#include "RenderingBenchmarks.h"
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+
+#include "GameObject.h"
+#include "MeshCache.h"
+#include "Model.h"
+#include "ParticleSystem.h"
+#include "ParsingBenchmarks.h"
+#include "Profiler.h"
+
+//The files GameObject::AddModelComponent loads, and the sphere ParsingBenchmarks writes so there is always one
+static const char* const MODEL_FILE_NAMES[] = { BENCHMARK_SPHERE_FILE_NAME, "sphere.obj", "SphereInverted.obj", "cubeHigh.obj", "cubeLow.obj", "plane.obj", "cylinderHigh.obj", "cylinderLow.obj", "cone.obj", "quad.obj" };
+
+static const int MODEL_INSTANCE_COUNTS[] = { 1, 1024, 65536 };
+
+//The textures GraphicsRenderer::LoadSceneAssets loads
+static const WCHAR* const TEXTURE_FILE_NAMES[] = { L"BaseColour.dds", L"BaseNormal.dds", L"BaseSpecular.dds", L"BaseDisplacement.dds", L"FloorColour.dds", L"FloorNormal.dds", L"FloorSpecular.dds", L"FloorDisplacement.dds", L"skybox.dds" };
+
+//Best of this many loads is reported, the first is often slowed by the files not being in the OS's cache yet
+static const int LOAD_REPORT_REPETITIONS = 3;
+
+RenderingBenchmarks::RenderingBenchmarks() : initializationFailed(false), device(nullptr), deviceContext(nullptr), resourceManager(nullptr), jobSystem(nullptr)
+{
+	const auto featureLevel = D3D_FEATURE_LEVEL_11_0;
+
+	if (FAILED(D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr, 0, &featureLevel, 1, D3D11_SDK_VERSION, &device, nullptr, &deviceContext)) &&
+		FAILED(D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_WARP, nullptr, 0, &featureLevel, 1, D3D11_SDK_VERSION, &device, nullptr, &deviceContext)))
+	{
+		initializationFailed = true;
+		return;
+	}
+
+	resourceManager = make_shared<ResourceManager>();
+	jobSystem = make_shared<JobSystem>(JobSystem::GetDefaultWorkerThreadCount());
+
+	if (!WriteBenchmarkModel())
+	{
+		initializationFailed = true;
+	}
+}
+
+RenderingBenchmarks::~RenderingBenchmarks()
+{
+	Model::SetJobSystem(nullptr);
+
+	//Buffers the resource manager holds go before the device
+	resourceManager.reset();
+
+	if (deviceContext)
+	{
+		deviceContext->Release();
+		deviceContext = nullptr;
+	}
+
+	if (device)
+	{
+		device->Release();
+		device = nullptr;
+	}
+}
+
+void RenderingBenchmarks::WriteMeshReport(ostream& output) const
+{
+	ResourceManager loader;
+
+	output << left << setw(24) << "Model" << right << setw(16) << "OBJ vertices" << setw(12) << "Vertices" << setw(12) << "Reduction" << setw(12) << "Triangles"
+		<< setw(14) << "ACMR before" << setw(14) << "ACMR after" << "  Level of detail triangles" << endl;
+
+	output << fixed << setprecision(3);
+
+	for (const auto* modelFileName : MODEL_FILE_NAMES)
+	{
+		ID3D11Buffer* vertexBuffer = nullptr;
+		ID3D11Buffer* indexBuffer = nullptr;
+
+		if (!ifstream(modelFileName) || !loader.GetModel(device, modelFileName, vertexBuffer, indexBuffer))
+		{
+			output << left << setw(24) << modelFileName << right << setw(16) << "missing" << endl;
+			continue;
+		}
+
+		const auto& statistics = loader.GetMeshStatistics(loader.GetMeshHandle(modelFileName));
+		const auto reduction = 1.0 - static_cast<double>(statistics.vertexCount) / statistics.sourceVertexCount;
+
+		output << left << setw(24) << modelFileName << right << setw(16) << statistics.sourceVertexCount << setw(12) << statistics.vertexCount << setw(11) << reduction * 100.0 << "%"
+			<< setw(12) << statistics.triangleCount << setw(14) << statistics.unoptimizedAcmr << setw(14) << statistics.acmr << " ";
+
+		for (const auto triangleCount : statistics.levelOfDetailTriangleCounts)
+		{
+			output << " " << triangleCount;
+		}
+
+		output << endl;
+	}
+
+	output << defaultfloat;
+}
+
+void RenderingBenchmarks::WriteLoadReport(ostream& output) const
+{
+	output << left << setw(24) << "Load" << right << setw(12) << "Serial ms" << setw(14) << "Parallel ms" << setw(10) << "Speedup" << endl;
+
+	output << fixed << setprecision(3);
+
+	for (const auto cached : { false, true })
+	{
+		auto serialTime = 0.0;
+		auto parallelTime = 0.0;
+
+		for (auto repetition = 0; repetition < LOAD_REPORT_REPETITIONS; repetition++)
+		{
+			const auto serial = TimeLoad(false, cached);
+			const auto parallel = TimeLoad(true, cached);
+
+			serialTime = repetition == 0 ? serial : min(serialTime, serial);
+			parallelTime = repetition == 0 ? parallel : min(parallelTime, parallel);
+		}
+
+		output << left << setw(24) << (cached ? "From .meshbin" : "From OBJ") << right << setw(12) << serialTime << setw(14) << parallelTime << setw(9) << serialTime / parallelTime << "x" << endl;
+	}
+
+	output << defaultfloat;
+	output << "Across " << jobSystem->GetThreadCount() << " threads" << endl;
+}
+
+double RenderingBenchmarks::TimeLoad(const bool parallel, const bool cached) const
+{
+	//Written by the load before, a load from the OBJ files has to parse them again
+	if (!cached)
+	{
+		for (const auto* modelFileName : MODEL_FILE_NAMES)
+		{
+			remove(MeshCache::GetCacheFileName(modelFileName).c_str());
+		}
+	}
+
+	ResourceManager::SetJobSystem(parallel ? jobSystem.get() : nullptr);
+
+	ResourceManager loader;
+
+	const auto start = Profiler::GetTime();
+
+	for (const auto* modelFileName : MODEL_FILE_NAMES)
+	{
+		if (!ifstream(modelFileName))
+		{
+			continue;
+		}
+
+		if (parallel)
+		{
+			loader.LoadModelAsync(modelFileName);
+		}
+		else
+		{
+			ID3D11Buffer* vertexBuffer = nullptr;
+			ID3D11Buffer* indexBuffer = nullptr;
+			loader.GetModel(device, modelFileName, vertexBuffer, indexBuffer);
+		}
+	}
+
+	for (const auto* textureFileName : TEXTURE_FILE_NAMES)
+	{
+		if (parallel)
+		{
+			loader.LoadTextureAsync(textureFileName);
+		}
+		else
+		{
+			ID3D11ShaderResourceView* texture = nullptr;
+			loader.GetTexture(device, textureFileName, texture);
+		}
+	}
+
+	if (parallel)
+	{
+		loader.FinishLoads(device);
+	}
+
+	const auto time = (Profiler::GetTime() - start) / 1000000.0;
+
+	ResourceManager::SetJobSystem(nullptr);
+
+	return time;
+}
+
+bool RenderingBenchmarks::GetInitializationState() const
+{
+	return initializationFailed;
+}
+
+bool RenderingBenchmarks::WriteBenchmarkModel()
+{
+	ofstream output(BENCHMARK_MODEL_FILE_NAME);
+
+	//Same layout as the shipped models, the face count comes before the faces
+	output << "v -1.0 -1.0 0.0\nv -1.0 1.0 0.0\nv 1.0 1.0 0.0\nv 1.0 -1.0 0.0\n";
+	output << "vt 0.0 1.0 0.0\nvt 0.0 0.0 0.0\nvt 1.0 0.0 0.0\nvt 1.0 1.0 0.0\n";
+	output << "vn 0.0 0.0 -1.0\n";
+	output << "faces 2\n";
+	output << "f 1/1/1 2/2/1 3/3/1\nf 1/1/1 3/3/1 4/4/1\n";
+
+	return static_cast<bool>(output);
+}
+
+void RenderingBenchmarks::Register(BenchmarkHarness& harness, ostream& output)
+{
+	auto* const benchmarkDevice = device;
+	auto* const benchmarkJobSystem = jobSystem.get();
+
+	for (const auto instanceCount : MODEL_INSTANCE_COUNTS)
+	{
+		const vector<XMFLOAT3> scales(instanceCount, XMFLOAT3(1.0f, 1.0f, 1.0f));
+		const vector<XMFLOAT3> rotations(instanceCount, XMFLOAT3(0.0f, 0.5f, 0.0f));
+		vector<XMFLOAT3> positions(instanceCount);
+
+		for (auto i = 0; i < instanceCount; i++)
+		{
+			positions[i] = XMFLOAT3(static_cast<float>(i % 256), static_cast<float>(i / 256), 0.0f);
+		}
+
+		const auto model = make_shared<Model>(device, resourceManager->GetMeshHandle(BENCHMARK_MODEL_FILE_NAME), resourceManager, scales, rotations, positions);
+
+		if (model->GetInitializationState())
+		{
+			output << "Skipping Model::Update, " << BENCHMARK_MODEL_FILE_NAME << " couldn't be loaded" << endl;
+			break;
+		}
+
+		//One frame's update each, the snapshot is published between them the way GraphicsRenderer does
+		const auto update = [model, scales, rotations, positions](BenchmarkState& state)
+		{
+			while (state.KeepRunning())
+			{
+				Model::PublishSnapshot();
+				model->Update(scales, rotations, positions, XMMatrixIdentity());
+			}
+		};
+
+		harness.Add("Model::Update/" + to_string(instanceCount), [update](BenchmarkState& state)
+		{
+			Model::SetJobSystem(nullptr);
+			update(state);
+		});
+
+		harness.Add("Model::Update/" + to_string(instanceCount) + "/Jobs", [update, benchmarkJobSystem](BenchmarkState& state)
+		{
+			Model::SetJobSystem(benchmarkJobSystem);
+			update(state);
+			Model::SetJobSystem(nullptr);
+		});
+	}
+
+	//A stream and an emitter with the tints FireJetParticleSystem and SmokeParticleSystem give them
+	const auto stream = make_shared<ParticleSystem>(device, nullptr, ModelType::Quad, XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(0.3f, 0.3f, 0.3f), XMFLOAT3(0.01f, 0.01f, 0.01f), XMFLOAT3(0.7f, 0.3f, 0.0f), L"BaseColour.dds", 0.5f, 2.0f, 4.0f, 100, resourceManager);
+	const auto emitter = make_shared<ParticleSystem>(device, nullptr, XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT3(0.1f, 0.1f, 0.1f), XMFLOAT3(-0.3f, -0.3f, -0.3f), XMFLOAT3(1.0f, 1.0f, 1.0f), XMFLOAT3(0.7f, 0.7f, 0.7f), L"BaseColour.dds", 0.5f, 0.01f, 2.0f, resourceManager);
+
+	if (stream->GetInitializationState() || emitter->GetInitializationState())
+	{
+		output << "Skipping ParticleSystem::UpdateParticles, quad.obj or BaseColour.dds couldn't be loaded" << endl;
+	}
+	else
+	{
+		for (const auto& particleSystem : { make_pair(string("Stream"), stream), make_pair(string("Emitter"), emitter) })
+		{
+			const auto system = particleSystem.second;
+
+			harness.Add("ParticleSystem::UpdateParticles/" + particleSystem.first, [system](BenchmarkState& state)
+			{
+				Model::SetJobSystem(nullptr);
+
+				while (state.KeepRunning())
+				{
+					Model::PublishSnapshot();
+					system->UpdateParticles(1.0f / 60.0f);
+				}
+			});
+		}
+	}
+
+	//A new resource manager every time, GetModel would otherwise hand back the one it already loaded. Text deletes the
+	//mesh cache before every load so the model is parsed, Cached loads from the cache the first load wrote
+	for (const auto* modelFileName : MODEL_FILE_NAMES)
+	{
+		if (!ifstream(modelFileName))
+		{
+			output << "Skipping ResourceManager::LoadModel/" << modelFileName << ", it isn't in the working directory" << endl;
+			continue;
+		}
+
+		const auto cacheFileName = MeshCache::GetCacheFileName(modelFileName);
+
+		for (const auto cached : { false, true })
+		{
+			harness.Add(string("ResourceManager::LoadModel/") + (cached ? "Cached/" : "Text/") + modelFileName, [benchmarkDevice, modelFileName, cacheFileName, cached](BenchmarkState& state)
+			{
+				ID3D11Buffer* vertexBuffer = nullptr;
+				ID3D11Buffer* indexBuffer = nullptr;
+
+				if (cached)
+				{
+					ResourceManager().GetModel(benchmarkDevice, modelFileName, vertexBuffer, indexBuffer);
+				}
+
+				while (state.KeepRunning())
+				{
+					state.PauseTiming();
+
+					if (!cached)
+					{
+						remove(cacheFileName.c_str());
+					}
+
+					auto loader = make_unique<ResourceManager>();
+
+					state.ResumeTiming();
+
+					loader->GetModel(benchmarkDevice, modelFileName, vertexBuffer, indexBuffer);
+					BenchmarkState::DoNotOptimize(vertexBuffer);
+
+					//Releasing the buffers isn't part of loading
+					state.PauseTiming();
+					loader.reset();
+					state.ResumeTiming();
+				}
+			});
+		}
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <d3d11.h>
+#include <memory>
+
+#include "BenchmarkHarness.h"
+#include "JobSystem.h"
+#include "ResourceManager.h"
+
+using namespace std;
+
+//Written next to the executable so Model::Update can be timed without depending on which meshes are present
+const char* const BENCHMARK_MODEL_FILE_NAME = "BenchmarkQuad.obj";
+
+//Benchmarks for the parts of the engine that need a Direct3D device: updating model instances, updating particle
+//systems and loading every shipped model. The device is created without a window, on the hardware if there is one
+//and WARP otherwise, and nothing is ever drawn with it
+class RenderingBenchmarks
+{
+public:
+	RenderingBenchmarks();
+	RenderingBenchmarks(const RenderingBenchmarks& other) = delete; // Copy Constructor
+	RenderingBenchmarks(RenderingBenchmarks&& other) noexcept = delete; // Move Constructor
+	~RenderingBenchmarks(); // Destructor
+
+	RenderingBenchmarks& operator = (const RenderingBenchmarks& other) = delete; // Copy Assignment Operator
+	RenderingBenchmarks& operator = (RenderingBenchmarks&& other) noexcept = delete; // Move Assignment Operator
+
+	//Benchmarks whose model or textures can't be loaded are reported to output and left out
+	void Register(BenchmarkHarness& harness, ostream& output);
+
+	//Loads every model and writes how far welding reduced its vertex count, the ACMR before and after reordering and
+	//the triangles in each of its levels of detail
+	void WriteMeshReport(ostream& output) const;
+
+	//Loads every model and texture one at a time and then all at once through the job system, from the OBJ files and
+	//from their caches, and writes how long each took
+	void WriteLoadReport(ostream& output) const;
+
+	bool GetInitializationState() const;
+
+private:
+	static bool WriteBenchmarkModel();
+
+	//Milliseconds to load everything into a new resource manager
+	double TimeLoad(const bool parallel, const bool cached) const;
+
+	bool initializationFailed;
+
+	ID3D11Device* device;
+	ID3D11DeviceContext* deviceContext;
+
+	shared_ptr<ResourceManager> resourceManager;
+	shared_ptr<JobSystem> jobSystem;
+};
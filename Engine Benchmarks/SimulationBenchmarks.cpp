@@ -0,0 +1,105 @@
+#include "SimulationBenchmarks.h"
+
+#include "LightManager.h"
+#include "SimulationWorld.h"
+
+//Steps the rocket until its next collision check hits the terrain, then puts it back one step so it is about to
+static RocketSimulation FindRocketBeforeImpact(const SimulationWorld& world, const float dt)
+{
+	auto rocket = *world.GetRocket();
+	rocket.LaunchRocket();
+
+	//A miss leaves the terrain as it was, so one copy does for every step
+	const auto terrain = make_shared<TerrainSimulation>(*world.GetTerrain());
+
+	auto collisionPosition = XMFLOAT3();
+	auto blastRadius = 0.0f;
+
+	for (auto step = 0; step < 10000; step++)
+	{
+		rocket.UpdateRocket(dt);
+
+		auto probe = rocket;
+
+		if (probe.CheckForTerrainCollision(terrain, collisionPosition, blastRadius))
+		{
+			return rocket;
+		}
+
+		rocket = probe;
+	}
+
+	return rocket;
+}
+
+void SimulationBenchmarks::Register(BenchmarkHarness& harness, const shared_ptr<SimulationConfigLoader>& configuration)
+{
+	const auto world = make_shared<SimulationWorld>(configuration);
+	const auto dt = configuration->GetSimulationTimeStep();
+
+	//Every frame in flight, the cone is above the terrain so the check ends early
+	harness.Add("RocketSimulation::CheckForTerrainCollision/Airborne", [world, dt](BenchmarkState& state)
+	{
+		auto rocket = *world->GetRocket();
+		rocket.LaunchRocket();
+		rocket.UpdateRocket(dt);
+
+		auto collisionPosition = XMFLOAT3();
+		auto blastRadius = 0.0f;
+
+		while (state.KeepRunning())
+		{
+			const auto hit = rocket.CheckForTerrainCollision(world->GetTerrain(), collisionPosition, blastRadius);
+			BenchmarkState::DoNotOptimize(hit);
+		}
+	});
+
+	//The frame it lands, a sweep that hits and then destroys the blast radius. The terrain is put back untimed
+	const auto rocketBeforeImpact = make_shared<RocketSimulation>(FindRocketBeforeImpact(*world, dt));
+
+	harness.Add("RocketSimulation::CheckForTerrainCollision/Impact", [world, rocketBeforeImpact](BenchmarkState& state)
+	{
+		auto rocket = *rocketBeforeImpact;
+		const auto terrain = make_shared<TerrainSimulation>(*world->GetTerrain());
+
+		auto collisionPosition = XMFLOAT3();
+		auto blastRadius = 0.0f;
+
+		while (state.KeepRunning())
+		{
+			state.PauseTiming();
+			rocket = *rocketBeforeImpact;
+			*terrain = *world->GetTerrain();
+			state.ResumeTiming();
+
+			const auto hit = rocket.CheckForTerrainCollision(terrain, collisionPosition, blastRadius);
+			BenchmarkState::DoNotOptimize(hit);
+		}
+	});
+
+	harness.Add("SimulationConfigLoader/Configuration.txt", [](BenchmarkState& state)
+	{
+		while (state.KeepRunning())
+		{
+			const SimulationConfigLoader loader("Configuration.txt");
+			BenchmarkState::DoNotOptimize(loader);
+		}
+	});
+
+	//UpdateLightVariables is the public way in to UpdateLightViewMatrix, it only adds a normalise
+	harness.Add("Light::UpdateLightViewMatrix", [configuration, dt](BenchmarkState& state)
+	{
+		const auto terrainDimensions = configuration->GetTerrainDimensions();
+
+		LightManager lightManager;
+		lightManager.AddLight(XMFLOAT3(0.0f, 0.0f, -terrainDimensions.z), XMFLOAT3(0.0f, 0.0f, 0.0f), configuration->GetSunAmbient(), configuration->GetSunDiffuse(), configuration->GetSunSpecular(), configuration->GetSunSpecularPower(), terrainDimensions.x, terrainDimensions.z, 1, terrainDimensions.z, true, true);
+
+		const auto& light = lightManager.GetLightList().front();
+
+		while (state.KeepRunning())
+		{
+			light->UpdateLightVariables(dt);
+			BenchmarkState::DoNotOptimize(light->GetLightPosition());
+		}
+	});
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <memory>
+
+#include "BenchmarkHarness.h"
+#include "SimulationConfigLoader.h"
+
+using namespace std;
+
+//Benchmarks for the simulation side, which doesn't need a graphics device: the rocket's terrain collision,
+//loading Configuration.txt and updating a light's matrices
+class SimulationBenchmarks
+{
+public:
+	static void Register(BenchmarkHarness& harness, const shared_ptr<SimulationConfigLoader>& configuration);
+};
@@ -0,0 +1,75 @@
+"""Compares two EngineBenchmarks JSON files and fails when the candidate is slower than the baseline.
+
+Usage: python compare_benchmarks.py baseline.json candidate.json [--threshold 0.05] [--noise-floor 50]
+
+A benchmark regresses when its median time grows by more than the threshold, as a fraction of the baseline,
+and by more than the noise floor in nanoseconds so the shortest benchmarks don't fail on timer jitter.
+Benchmarks in only one of the files are listed but never fail the comparison.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_medians(file_name):
+    with open(file_name) as file:
+        results = json.load(file)
+
+    return {benchmark["name"]: float(benchmark["real_time"]) for benchmark in results["benchmarks"]}
+
+
+def format_time(nanoseconds):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if nanoseconds >= scale:
+            return "%.2f %s" % (nanoseconds / scale, unit)
+
+    return "%.1f ns" % nanoseconds
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two EngineBenchmarks JSON files.")
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=0.05, help="allowed slowdown as a fraction of the baseline")
+    parser.add_argument("--noise-floor", type=float, default=50.0, help="slowdowns smaller than this many nanoseconds are ignored")
+    arguments = parser.parse_args()
+
+    baseline = load_medians(arguments.baseline)
+    candidate = load_medians(arguments.candidate)
+
+    names = [name for name in baseline if name in candidate]
+    width = max([len(name) for name in list(baseline) + list(candidate)] + [len("Benchmark")])
+
+    print("%-*s %12s %12s %9s" % (width, "Benchmark", "Baseline", "Candidate", "Change"))
+
+    regressions = []
+
+    for name in names:
+        before = baseline[name]
+        after = candidate[name]
+        change = (after - before) / before if before > 0.0 else 0.0
+        regressed = change > arguments.threshold and after - before > arguments.noise_floor
+
+        if regressed:
+            regressions.append(name)
+
+        print("%-*s %12s %12s %+8.1f%%%s" % (width, name, format_time(before), format_time(after), change * 100.0, "  REGRESSION" if regressed else ""))
+
+    for name in baseline:
+        if name not in candidate:
+            print("%-*s %12s %12s" % (width, name, format_time(baseline[name]), "missing"))
+
+    for name in candidate:
+        if name not in baseline:
+            print("%-*s %12s %12s" % (width, name, "new", format_time(candidate[name])))
+
+    if regressions:
+        print("\n%d of %d benchmarks are more than %.1f%% slower than the baseline" % (len(regressions), len(names), arguments.threshold * 100.0))
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
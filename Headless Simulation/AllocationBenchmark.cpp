@@ -0,0 +1,162 @@
+#include "AllocationBenchmark.h"
+
+#include "AllocationCounter.h"
+#include "FrameArena.h"
+#include "JobSystem.h"
+#include "ParticlePool.h"
+#include "SimulationWorld.h"
+
+//Deliberately small so the arena has to grow during the warm up
+static const size_t ARENA_SIZE = 8;
+static const int EMITTER_COUNT = 8;
+static const int EMITTER_PARTICLE_COUNT = 1024;
+
+//What the terrain game object keeps between frames to follow the simulation's changes
+struct TerrainReader
+{
+	const SimulationWorld* world;
+	unsigned int revision;
+	vector<int> changedInstances;
+	int changedInstanceCount;
+
+	void Update()
+	{
+		const auto& terrain = world->GetTerrain();
+
+		if (revision != terrain->GetRevision())
+		{
+			changedInstances.clear();
+
+			if (terrain->GetChangedInstances(revision, changedInstances))
+			{
+				changedInstanceCount += static_cast<int>(changedInstances.size());
+			}
+
+			revision = terrain->GetRevision();
+		}
+	}
+};
+
+AllocationBenchmark::AllocationBenchmark(const shared_ptr<SimulationConfigLoader>& configuration, const int frameCount, const int warmUpFrameCount, const int threadCount) : configuration(configuration), frameCount(frameCount), warmUpFrameCount(warmUpFrameCount), threadCount(threadCount)
+{
+}
+
+AllocationBenchmark::AllocationBenchmark(const AllocationBenchmark& other) = default;
+
+AllocationBenchmark::AllocationBenchmark(AllocationBenchmark&& other) noexcept = default;
+
+AllocationBenchmark::~AllocationBenchmark() = default;
+
+AllocationBenchmark& AllocationBenchmark::operator=(const AllocationBenchmark& other) = default;
+
+AllocationBenchmark& AllocationBenchmark::operator=(AllocationBenchmark&& other) noexcept = default;
+
+bool AllocationBenchmark::Run(ostream& output) const
+{
+	JobSystem jobSystem(threadCount - 1);
+
+	SimulationWorld world(configuration);
+	world.SetJobSystem(&jobSystem);
+
+	FrameArena arena(ARENA_SIZE);
+
+	vector<ParticlePool> emitters(EMITTER_COUNT, ParticlePool(EMITTER_PARTICLE_COUNT));
+	TerrainReader terrainReader = { &world, world.GetTerrain()->GetRevision(), vector<int>(), 0 };
+	terrainReader.changedInstances.reserve(TERRAIN_CHANGE_LOG_CAPACITY);
+
+	vector<JobHandle> frameJobs;
+
+	const auto dt = configuration->GetSimulationTimeStep();
+
+	auto warmUpAllocations = 0ull;
+	auto steadyAllocations = 0ull;
+	auto steadyBytes = 0ull;
+	auto allocatingFrames = 0;
+	auto shadowCasterCount = size_t(0);
+	auto warmUpFrames = 0;
+	auto steadyFrames = 0;
+
+	while (steadyFrames < frameCount)
+	{
+		const auto allocationsAtFrameStart = AllocationCounter::GetAllocationCount();
+		const auto bytesAtFrameStart = AllocationCounter::GetAllocatedBytes();
+		//The collision path grows its query buffers the first time it runs so the warm up lasts until there has been one
+		const auto warmingUp = warmUpFrames < warmUpFrameCount || world.GetCollisionCount() == 0;
+
+		arena.Reset();
+
+		//Same order as GraphicsRenderer, publish the last step then simulate the next while the published one is read
+		world.PublishSnapshot();
+
+		if (!world.GetRocket()->RocketLaunched())
+		{
+			world.LaunchRocket();
+		}
+
+		frameJobs.clear();
+
+		auto* const simulatedWorld = &world;
+
+		const auto simulationJob = jobSystem.Add([simulatedWorld, dt]() { simulatedWorld->UpdateFrame(dt); });
+		frameJobs.push_back(simulationJob);
+
+		for (auto& emitter : emitters)
+		{
+			auto* const pool = &emitter;
+
+			frameJobs.push_back(jobSystem.Add([pool, dt]()
+			{
+				while (pool->GetCount() < pool->GetCapacity())
+				{
+					pool->Spawn(XMFLOAT3(), XMFLOAT3());
+				}
+
+				pool->Advance(XMFLOAT3(0.0f, 2.0f, 0.0f), XMFLOAT3(1.0f, 1.0f, 1.0f), 2.0f, dt);
+			}));
+		}
+
+		auto* const reader = &terrainReader;
+
+		frameJobs.push_back(jobSystem.Add([reader]() { reader->Update(); }, simulationJob));
+
+		//Stands in for the render list, the published lights go through the arena the way the shadow pass reads them
+		FrameVector<const Light*> shadowCasters{ FrameAllocator<const Light*>(arena) };
+
+		for (const auto& light : world.GetPublishedSnapshot().lights)
+		{
+			shadowCasters.push_back(light.get());
+		}
+
+		shadowCasterCount = shadowCasters.size();
+
+		jobSystem.Wait(frameJobs);
+
+		const auto allocations = AllocationCounter::GetAllocationCount() - allocationsAtFrameStart;
+
+		if (warmingUp)
+		{
+			warmUpAllocations += allocations;
+			warmUpFrames++;
+			continue;
+		}
+
+		steadyFrames++;
+
+		if (allocations > 0)
+		{
+			steadyAllocations += allocations;
+			steadyBytes += AllocationCounter::GetAllocatedBytes() - bytesAtFrameStart;
+			allocatingFrames++;
+		}
+	}
+
+	output << "Allocation benchmark, " << frameCount << " frames after " << warmUpFrames << " warm up frames, " << jobSystem.GetThreadCount() << " threads" << endl;
+	output << "Warm up allocations:  " << warmUpAllocations << endl;
+	output << "Frames that allocated: " << allocatingFrames << endl;
+	output << "Steady allocations:   " << steadyAllocations << " (" << steadyBytes << " bytes)" << endl;
+	output << "Frame arena:          " << arena.GetHighWaterMark() << " of " << arena.GetCapacity() << " bytes, grown " << arena.GetGrowCount() << " times" << endl;
+	output << "Shadow casters:       " << shadowCasterCount << endl;
+	output << "Collisions:           " << world.GetCollisionCount() << ", " << terrainReader.changedInstanceCount << " terrain instances changed" << endl;
+
+	return steadyAllocations == 0;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <memory>
+#include <ostream>
+
+#include "SimulationConfigLoader.h"
+
+using namespace std;
+
+//Counts the heap allocations of a frame shaped like GraphicsRenderer::UpdateFrame: the simulation steps as a job
+//with its lights as jobs of their own, object updates run alongside it, the terrain's change list is read once it
+//has finished and the published lights are gathered into a frame arena.
+//Once at least warmUpFrameCount frames and the first collision have sized every buffer a frame shouldn't allocate at all
+class AllocationBenchmark
+{
+public:
+	AllocationBenchmark(const shared_ptr<SimulationConfigLoader>& configuration, const int frameCount, const int warmUpFrameCount, const int threadCount);
+	AllocationBenchmark(const AllocationBenchmark& other); // Copy Constructor
+	AllocationBenchmark(AllocationBenchmark&& other) noexcept; // Move Constructor
+	~AllocationBenchmark(); // Destructor
+
+	AllocationBenchmark& operator = (const AllocationBenchmark& other); // Copy Assignment Operator
+	AllocationBenchmark& operator = (AllocationBenchmark&& other) noexcept; // Move Assignment Operator
+
+	//Returns true if no frame after the warm up allocated
+	bool Run(ostream& output) const;
+
+private:
+	shared_ptr<SimulationConfigLoader> configuration;
+
+	int frameCount;
+	int warmUpFrameCount;
+	int threadCount;
+};
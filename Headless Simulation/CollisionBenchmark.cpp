@@ -0,0 +1,142 @@
+#include "CollisionBenchmark.h"
+#include <chrono>
+#include <iomanip>
+#include <random>
+
+CollisionBenchmark::CollisionBenchmark(const int queryCount) : queryCount(queryCount)
+{
+}
+
+CollisionBenchmark::CollisionBenchmark(const CollisionBenchmark& other) = default;
+
+CollisionBenchmark::CollisionBenchmark(CollisionBenchmark&& other) noexcept = default;
+
+CollisionBenchmark::~CollisionBenchmark() = default;
+
+CollisionBenchmark& CollisionBenchmark::operator=(const CollisionBenchmark& other) = default;
+
+CollisionBenchmark& CollisionBenchmark::operator=(CollisionBenchmark&& other) noexcept = default;
+
+void CollisionBenchmark::Run(ostream& output) const
+{
+	const XMINT3 terrainSizes[] = { XMINT3(80, 10, 40), XMINT3(120, 16, 44), XMINT3(160, 22, 48), XMINT3(220, 33, 55) };
+
+	//Cone radius plus cube radius, and that plus the rocket's blast radius
+	const auto hitRadius = 2.0f;
+	const auto blastRadius = 7.0f;
+
+	output << "Collision query benchmark, " << queryCount << " queries per size" << endl;
+	output << setw(12) << "Terrain" << setw(10) << "Cubes" << setw(16) << "Full scan ns" << setw(14) << "Indexed ns" << setw(10) << "Speedup" << endl;
+
+	for (const auto& size : terrainSizes)
+	{
+		const auto grid = VoxelGrid(size, XMFLOAT3(-size.x / 2.0f, -static_cast<float>(size.y), -size.z / 2.0f), XMFLOAT3(1.0f, 1.0f, 1.0f));
+
+		//Same query points for both paths, spread over the top few layers where the rocket lands
+		mt19937 generator(1234);
+		uniform_real_distribution<float> xDistribution(-size.x / 2.0f, size.x / 2.0f);
+		uniform_real_distribution<float> yDistribution(-4.0f, 0.0f);
+		uniform_real_distribution<float> zDistribution(-size.z / 2.0f, size.z / 2.0f);
+
+		vector<XMFLOAT3> queries;
+		queries.reserve(queryCount);
+
+		for (auto i = 0; i < queryCount; i++)
+		{
+			queries.emplace_back(XMFLOAT3(xDistribution(generator), yDistribution(generator), zDistribution(generator)));
+		}
+
+		vector<XMINT3> results;
+		auto fullScanFound = 0;
+		auto indexedFound = 0;
+
+		auto start = chrono::steady_clock::now();
+
+		for (const auto& query : queries)
+		{
+			fullScanFound += QueryFullScan(grid, query, hitRadius, blastRadius);
+		}
+
+		const auto fullScanNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / queryCount;
+
+		start = chrono::steady_clock::now();
+
+		for (const auto& query : queries)
+		{
+			indexedFound += QueryIndexed(grid, query, hitRadius, blastRadius, results);
+		}
+
+		const auto indexedNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / queryCount;
+
+		output << setw(12) << (to_string(size.x) + "x" + to_string(size.y) + "x" + to_string(size.z)) << setw(10) << grid.GetVoxelCount() << fixed << setprecision(1) << setw(16) << fullScanNs << setw(14) << indexedNs << setw(9) << fullScanNs / indexedNs << "x";
+
+		if (fullScanFound != indexedFound)
+		{
+			output << "  MISMATCH " << fullScanFound << " != " << indexedFound;
+		}
+
+		output << endl;
+	}
+}
+
+int CollisionBenchmark::QueryFullScan(const VoxelGrid& grid, const XMFLOAT3& centre, const float hitRadius, const float blastRadius)
+{
+	const auto& dimensions = grid.GetDimensions();
+
+	auto hit = false;
+
+	for (auto x = 0; x < dimensions.x && !hit; x++)
+	{
+		for (auto y = 0; y < dimensions.y && !hit; y++)
+		{
+			for (auto z = 0; z < dimensions.z && !hit; z++)
+			{
+				const auto position = grid.GetVoxelPosition(x, y, z);
+				const auto distance = XMFLOAT3(position.x - centre.x, position.y - centre.y, position.z - centre.z);
+
+				hit = grid.IsOccupied(x, y, z) && distance.x * distance.x + distance.y * distance.y + distance.z * distance.z <= hitRadius * hitRadius;
+			}
+		}
+	}
+
+	if (!hit)
+	{
+		return 0;
+	}
+
+	auto found = 0;
+
+	for (auto x = 0; x < dimensions.x; x++)
+	{
+		for (auto y = 0; y < dimensions.y; y++)
+		{
+			for (auto z = 0; z < dimensions.z; z++)
+			{
+				const auto position = grid.GetVoxelPosition(x, y, z);
+				const auto distance = XMFLOAT3(position.x - centre.x, position.y - centre.y, position.z - centre.z);
+
+				if (grid.IsOccupied(x, y, z) && distance.x * distance.x + distance.y * distance.y + distance.z * distance.z <= blastRadius * blastRadius)
+				{
+					found++;
+				}
+			}
+		}
+	}
+
+	return found;
+}
+
+int CollisionBenchmark::QueryIndexed(const VoxelGrid& grid, const XMFLOAT3& centre, const float hitRadius, const float blastRadius, vector<XMINT3>& results)
+{
+	auto hitVoxel = XMINT3();
+
+	if (!grid.FindFirstOccupiedInSphere(centre, hitRadius, hitVoxel))
+	{
+		return 0;
+	}
+
+	results.clear();
+	grid.GetOccupiedInSphere(centre, blastRadius, results);
+
+	return static_cast<int>(results.size());
+}
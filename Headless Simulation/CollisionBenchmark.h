@@ -0,0 +1,33 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <ostream>
+#include <vector>
+
+#include "VoxelGrid.h"
+
+using namespace DirectX;
+using namespace std;
+
+//Times the rocket/terrain collision queries against the full scan they replaced, for terrain sizes from the scene's
+//80x10x40 up to the 220x33x55 in Configuration.txt
+class CollisionBenchmark
+{
+public:
+	explicit CollisionBenchmark(const int queryCount);
+	CollisionBenchmark(const CollisionBenchmark& other); // Copy Constructor
+	CollisionBenchmark(CollisionBenchmark&& other) noexcept; // Move Constructor
+	~CollisionBenchmark(); // Destructor
+
+	CollisionBenchmark& operator = (const CollisionBenchmark& other); // Copy Assignment Operator
+	CollisionBenchmark& operator = (CollisionBenchmark&& other) noexcept; // Move Assignment Operator
+
+	void Run(ostream& output) const;
+
+private:
+	//Hit test then blast radius, returns the number of voxels found so both paths can be checked against each other
+	static int QueryFullScan(const VoxelGrid& grid, const XMFLOAT3& centre, const float hitRadius, const float blastRadius);
+	static int QueryIndexed(const VoxelGrid& grid, const XMFLOAT3& centre, const float hitRadius, const float blastRadius, vector<XMINT3>& results);
+
+	int queryCount;
+};
@@ -0,0 +1,145 @@
+#include "FrameStatisticsBenchmark.h"
+
+#include "FrameStatistics.h"
+#include "JobSystem.h"
+#include "ParticlePool.h"
+#include "Profiler.h"
+#include "SimulationWorld.h"
+
+static const int WARM_UP_FRAME_COUNT = 30;
+static const int EMITTER_COUNT = 16;
+static const int EMITTER_PARTICLE_COUNT = 8192;
+
+FrameStatisticsBenchmark::FrameStatisticsBenchmark(const shared_ptr<SimulationConfigLoader>& configuration, const int frameCount, const int threadCount, const string& outputFileName) : configuration(configuration), frameCount(frameCount), threadCount(threadCount), outputFileName(outputFileName)
+{
+}
+
+FrameStatisticsBenchmark::FrameStatisticsBenchmark(const FrameStatisticsBenchmark& other) = default;
+
+FrameStatisticsBenchmark::FrameStatisticsBenchmark(FrameStatisticsBenchmark&& other) noexcept = default;
+
+FrameStatisticsBenchmark::~FrameStatisticsBenchmark() = default;
+
+FrameStatisticsBenchmark& FrameStatisticsBenchmark::operator=(const FrameStatisticsBenchmark& other) = default;
+
+FrameStatisticsBenchmark& FrameStatisticsBenchmark::operator=(FrameStatisticsBenchmark&& other) noexcept = default;
+
+bool FrameStatisticsBenchmark::Run(ostream& output) const
+{
+	JobSystem jobSystem(threadCount - 1);
+
+	SimulationWorld world(configuration);
+	world.SetJobSystem(&jobSystem);
+
+	vector<ParticlePool> emitters(EMITTER_COUNT, ParticlePool(EMITTER_PARTICLE_COUNT));
+
+	auto terrainRevision = world.GetTerrain()->GetRevision();
+	vector<int> changedInstances;
+	changedInstances.reserve(TERRAIN_CHANGE_LOG_CAPACITY);
+
+	//Sized to the run so the percentiles cover every recorded frame
+	FrameStatistics statistics(frameCount);
+	const auto framePhase = statistics.AddPhase("Frame");
+	const auto simulationPhase = statistics.AddPhase("Simulation");
+	const auto particlePhase = statistics.AddPhase("Particles");
+	const auto terrainPhase = statistics.AddPhase("Terrain changes");
+	const auto waitPhase = statistics.AddPhase("Wait for jobs");
+
+	vector<JobHandle> frameJobs;
+
+	const auto dt = configuration->GetSimulationTimeStep();
+
+	for (auto frame = -WARM_UP_FRAME_COUNT; frame < frameCount; frame++)
+	{
+		//Phases recorded by jobs look at this before the frame's Wait, so it doesn't change while they run
+		const auto recording = frame >= 0;
+		const auto frameStart = Profiler::GetTime();
+
+		world.PublishSnapshot();
+
+		if (!world.GetRocket()->RocketLaunched())
+		{
+			world.LaunchRocket();
+		}
+
+		frameJobs.clear();
+
+		const auto simulationJob = jobSystem.Add([&world, &statistics, simulationPhase, recording, dt]()
+		{
+			const auto start = Profiler::GetTime();
+			world.UpdateFrame(dt);
+
+			if (recording)
+			{
+				statistics.Record(simulationPhase, Profiler::GetTime() - start);
+			}
+		});
+
+		frameJobs.push_back(simulationJob);
+
+		frameJobs.push_back(jobSystem.Add([&jobSystem, &emitters, &statistics, particlePhase, recording, dt]()
+		{
+			const auto start = Profiler::GetTime();
+
+			jobSystem.ParallelFor(EMITTER_COUNT, 1, [&emitters, dt](const int first, const int last)
+			{
+				for (auto i = first; i < last; i++)
+				{
+					while (emitters[i].GetCount() < emitters[i].GetCapacity())
+					{
+						emitters[i].Spawn(XMFLOAT3(), XMFLOAT3());
+					}
+
+					emitters[i].Advance(XMFLOAT3(0.0f, 2.0f, 0.0f), XMFLOAT3(1.0f, 1.0f, 1.0f), 2.0f, dt);
+				}
+			});
+
+			if (recording)
+			{
+				statistics.Record(particlePhase, Profiler::GetTime() - start);
+			}
+		}));
+
+		frameJobs.push_back(jobSystem.Add([&world, &terrainRevision, &changedInstances, &statistics, terrainPhase, recording]()
+		{
+			const auto start = Profiler::GetTime();
+			const auto& terrain = world.GetTerrain();
+
+			if (terrainRevision != terrain->GetRevision())
+			{
+				changedInstances.clear();
+				terrain->GetChangedInstances(terrainRevision, changedInstances);
+				terrainRevision = terrain->GetRevision();
+			}
+
+			if (recording)
+			{
+				statistics.Record(terrainPhase, Profiler::GetTime() - start);
+			}
+		}, simulationJob));
+
+		const auto waitStart = Profiler::GetTime();
+
+		jobSystem.Wait(frameJobs);
+
+		if (recording)
+		{
+			const auto frameEnd = Profiler::GetTime();
+
+			statistics.Record(waitPhase, frameEnd - waitStart);
+			statistics.Record(framePhase, frameEnd - frameStart);
+		}
+	}
+
+	output << "Frame statistics, " << frameCount << " frames after " << WARM_UP_FRAME_COUNT << " warm up frames, " << jobSystem.GetThreadCount() << " threads, " << world.GetCollisionCount() << " collisions" << endl;
+	statistics.WriteSummary(output);
+
+	if (outputFileName.empty())
+	{
+		return true;
+	}
+
+	const auto json = outputFileName.size() >= 5 && outputFileName.compare(outputFileName.size() - 5, 5, ".json") == 0;
+
+	return json ? statistics.ExportJson(outputFileName) : statistics.ExportCsv(outputFileName);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include "SimulationConfigLoader.h"
+
+using namespace std;
+
+//Runs frames shaped like GraphicsRenderer::UpdateFrame for frameCount frames and reports each phase's percentiles
+//and hitches: the whole frame, the simulation step, the particle emitters, reading the terrain's changes and the
+//time the frame waits for its jobs. The first warm up frames aren't recorded.
+//Compare the summary or the CSV/JSON before and after a change to decide whether it made things faster
+class FrameStatisticsBenchmark
+{
+public:
+	FrameStatisticsBenchmark(const shared_ptr<SimulationConfigLoader>& configuration, const int frameCount, const int threadCount, const string& outputFileName);
+	FrameStatisticsBenchmark(const FrameStatisticsBenchmark& other); // Copy Constructor
+	FrameStatisticsBenchmark(FrameStatisticsBenchmark&& other) noexcept; // Move Constructor
+	~FrameStatisticsBenchmark(); // Destructor
+
+	FrameStatisticsBenchmark& operator = (const FrameStatisticsBenchmark& other); // Copy Assignment Operator
+	FrameStatisticsBenchmark& operator = (FrameStatisticsBenchmark&& other) noexcept; // Move Assignment Operator
+
+	//Writes outputFileName as JSON if it ends in .json and CSV otherwise, returns false if it couldn't be written
+	bool Run(ostream& output) const;
+
+private:
+	shared_ptr<SimulationConfigLoader> configuration;
+
+	int frameCount;
+	int threadCount;
+	string outputFileName;
+};
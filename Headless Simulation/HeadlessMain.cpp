@@ -0,0 +1,152 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+#include "AllocationBenchmark.h"
+#include "CollisionBenchmark.h"
+#include "FrameStatisticsBenchmark.h"
+#include "InputReplay.h"
+#include "JobBenchmark.h"
+#include "ParticleBenchmark.h"
+#include "Profiler.h"
+#include "SimulationConfigLoader.h"
+#include "SimulationWorld.h"
+#include "TransformBenchmark.h"
+
+using namespace std;
+
+//Steps the scene without a window or a graphics device
+//Usage: HeadlessSimulation [configurationFile] [frameCount] [timeScale] [traceFile]
+//       HeadlessSimulation --collision-benchmark [queryCount]
+//       HeadlessSimulation --transform-benchmark [instanceCount]
+//       HeadlessSimulation --particle-benchmark [frameCount]
+//       HeadlessSimulation --job-benchmark [frameCount] [maxThreadCount]
+//       HeadlessSimulation --allocation-benchmark [frameCount] [warmUpFrameCount] [threadCount]
+//       HeadlessSimulation --frame-statistics [frameCount] [threadCount] [outputFile.csv|outputFile.json]
+//       HeadlessSimulation --replay inputLog [threadCount] [statisticsFile.csv|statisticsFile.json]
+//       HeadlessSimulation --record-script inputLog [frameCount]
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && strcmp(argv[1], "--collision-benchmark") == 0)
+	{
+		const CollisionBenchmark benchmark(argc > 2 ? atoi(argv[2]) : 10000);
+		benchmark.Run(cout);
+		return 0;
+	}
+
+	if (argc > 1 && strcmp(argv[1], "--transform-benchmark") == 0)
+	{
+		const TransformBenchmark benchmark(argc > 2 ? atoi(argv[2]) : 32000, 50);
+		benchmark.Run(cout);
+		return 0;
+	}
+
+	if (argc > 1 && strcmp(argv[1], "--particle-benchmark") == 0)
+	{
+		const ParticleBenchmark benchmark(argc > 2 ? atoi(argv[2]) : 120);
+		benchmark.Run(cout);
+		return 0;
+	}
+
+	if (argc > 1 && strcmp(argv[1], "--job-benchmark") == 0)
+	{
+		const auto configuration = make_shared<SimulationConfigLoader>("Configuration.txt");
+		const JobBenchmark benchmark(configuration, argc > 2 ? atoi(argv[2]) : 100, argc > 3 ? atoi(argv[3]) : JobSystem::GetDefaultWorkerThreadCount() + 1);
+		benchmark.Run(cout);
+		return 0;
+	}
+
+	if (argc > 1 && strcmp(argv[1], "--allocation-benchmark") == 0)
+	{
+		const auto configuration = make_shared<SimulationConfigLoader>("Configuration.txt");
+		const AllocationBenchmark benchmark(configuration, argc > 2 ? atoi(argv[2]) : 1000, argc > 3 ? atoi(argv[3]) : 60, argc > 4 ? atoi(argv[4]) : JobSystem::GetDefaultWorkerThreadCount() + 1);
+		return benchmark.Run(cout) ? 0 : 1;
+	}
+
+	if (argc > 1 && strcmp(argv[1], "--frame-statistics") == 0)
+	{
+		const auto configuration = make_shared<SimulationConfigLoader>("Configuration.txt");
+		const FrameStatisticsBenchmark benchmark(configuration, argc > 2 ? atoi(argv[2]) : 1000, argc > 3 ? atoi(argv[3]) : JobSystem::GetDefaultWorkerThreadCount() + 1, argc > 4 ? argv[4] : "");
+
+		if (!benchmark.Run(cout))
+		{
+			cerr << "Could not write " << argv[4] << endl;
+			return 1;
+		}
+
+		return 0;
+	}
+
+	if (argc > 2 && strcmp(argv[1], "--replay") == 0)
+	{
+		const auto configuration = make_shared<SimulationConfigLoader>("Configuration.txt");
+		const InputReplay replay(configuration, argv[2], argc > 3 ? atoi(argv[3]) : JobSystem::GetDefaultWorkerThreadCount() + 1, argc > 4 ? argv[4] : "");
+		return replay.Run(cout) ? 0 : 1;
+	}
+
+	if (argc > 2 && strcmp(argv[1], "--record-script") == 0)
+	{
+		const auto configuration = make_shared<SimulationConfigLoader>("Configuration.txt");
+		return InputReplay::RecordScript(configuration, argv[2], argc > 3 ? atoi(argv[3]) : 1200, cout) ? 0 : 1;
+	}
+
+	const char* configurationFile = argc > 1 ? argv[1] : "Configuration.txt";
+
+	const auto configuration = make_shared<SimulationConfigLoader>(configurationFile);
+
+	const auto dt = configuration->GetSimulationTimeStep();
+	const auto frameCount = argc > 2 ? atoi(argv[2]) : configuration->GetHeadlessFrameCount();
+	const auto timeScale = argc > 3 ? atoi(argv[3]) : 1;
+	const char* traceFile = argc > 4 ? argv[4] : nullptr;
+
+	if (dt <= 0.0f || frameCount <= 0 || timeScale < 1)
+	{
+		cerr << "Invalid SimulationTimeStep, HeadlessFrameCount or time scale" << endl;
+		return 1;
+	}
+
+	Profiler::SetThreadName("Main");
+	Profiler::SetEnabled(traceFile != nullptr);
+
+	auto world = make_shared<SimulationWorld>(configuration);
+
+	//Accelerated time for soak tests, collisions are swept so large steps stay correct
+	world->AddTimeScale(timeScale - 1);
+
+	const auto start = chrono::steady_clock::now();
+
+	for (auto frame = 0; frame < frameCount; frame++)
+	{
+		//Keep a rocket in the air so collision and terrain destruction are exercised
+		if (!world->GetRocket()->RocketLaunched())
+		{
+			world->LaunchRocket();
+		}
+
+		world->UpdateFrame(dt);
+	}
+
+	const auto end = chrono::steady_clock::now();
+	const auto elapsedMs = chrono::duration<double, milli>(end - start).count();
+
+	cout << "Frames:            " << frameCount << endl;
+	cout << "Time step:         " << dt << " s" << endl;
+	cout << "Time scale:        " << world->GetTimeScale() << endl;
+	cout << "Simulated time:    " << frameCount * dt * world->GetTimeScale() << " s" << endl;
+	cout << "Terrain cubes:     " << world->GetTerrain()->GetCubeCount() << endl;
+	cout << "Terrain memory:    " << world->GetTerrain()->GetMemoryUsage() << " bytes (occupancy bits " << world->GetTerrain()->GetVoxelGrid().GetMemoryUsage() << ")" << endl;
+	cout << "Collisions:        " << world->GetCollisionCount() << endl;
+	cout << "Wall time:         " << elapsedMs << " ms" << endl;
+	cout << "Average per frame: " << elapsedMs / frameCount << " ms" << endl;
+
+	//Only the last PROFILER_EVENTS_PER_THREAD zones are kept
+	if (traceFile && !Profiler::ExportChromeTrace(traceFile))
+	{
+		cerr << "Could not write " << traceFile << endl;
+		return 1;
+	}
+
+	return 0;
+}
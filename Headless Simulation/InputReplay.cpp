@@ -0,0 +1,171 @@
+#include "InputReplay.h"
+#include <iomanip>
+
+#include "FrameStatistics.h"
+#include "InputController.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "SimulationWorld.h"
+
+//A key press or release on a frame of the script, which repeats every SCRIPT_LENGTH frames
+struct ScriptedKeyEvent
+{
+	int frame;
+	unsigned int key;
+	bool pressed;
+};
+
+static const int SCRIPT_LENGTH = 480;
+
+static const ScriptedKeyEvent SCRIPT[] = {
+	//Turn the launcher before launching and watch from the rocket
+	{ 10, KEY_SHIFT, true }, { 11, KEY_COMMA, true }, { 12, KEY_COMMA, false }, { 14, KEY_SHIFT, false },
+	{ 20, KEY_F3, true }, { 21, KEY_F3, false },
+	{ 30, KEY_F11, true }, { 31, KEY_F11, false },
+	//Speed up, then hold W a while to turn the camera
+	{ 60, KEY_SHIFT, true }, { 61, KEY_T, true }, { 62, KEY_T, false }, { 63, KEY_SHIFT, false },
+	{ 90, KEY_F2, true }, { 91, KEY_F2, false },
+	{ 100, KEY_W, true }, { 130, KEY_W, false },
+	{ 140, KEY_CONTROL, true }, { 141, KEY_D, true }, { 160, KEY_D, false }, { 161, KEY_CONTROL, false },
+	//Slow back down, reset and launch from the other side
+	{ 240, KEY_T, true }, { 241, KEY_T, false },
+	{ 250, KEY_R, true }, { 251, KEY_R, false },
+	{ 260, KEY_SHIFT, true }, { 261, KEY_PERIOD, true }, { 262, KEY_PERIOD, false }, { 263, KEY_PERIOD, true }, { 264, KEY_PERIOD, false }, { 265, KEY_SHIFT, false },
+	{ 270, KEY_F4, true }, { 271, KEY_F4, false },
+	{ 280, KEY_F11, true }, { 281, KEY_F11, false },
+	{ 400, KEY_F1, true }, { 401, KEY_F1, false }
+};
+
+InputReplay::InputReplay(const shared_ptr<SimulationConfigLoader>& configuration, const string& logFileName, const int threadCount, const string& statisticsFileName) : configuration(configuration), logFileName(logFileName), threadCount(threadCount), statisticsFileName(statisticsFileName)
+{
+}
+
+InputReplay::InputReplay(const InputReplay& other) = default;
+
+InputReplay::InputReplay(InputReplay&& other) noexcept = default;
+
+InputReplay::~InputReplay() = default;
+
+InputReplay& InputReplay::operator=(const InputReplay& other) = default;
+
+InputReplay& InputReplay::operator=(InputReplay&& other) noexcept = default;
+
+bool InputReplay::Run(ostream& output) const
+{
+	InputLog log;
+
+	if (!log.Load(logFileName))
+	{
+		output << "Could not read the input log " << logFileName << endl;
+		return false;
+	}
+
+	JobSystem jobSystem(threadCount - 1);
+
+	const auto world = make_shared<SimulationWorld>(configuration);
+	world->SetJobSystem(&jobSystem);
+
+	const auto keyboard = make_shared<Keyboard>();
+	InputController controller(keyboard, world);
+
+	FrameStatistics statistics(log.GetFrameCount());
+	const auto simulationPhase = statistics.AddPhase("Simulation");
+
+	auto simulatedTime = 0.0;
+
+	//Same order as the window: the keys that arrived, then the controls, then the step
+	for (auto frame = 0; frame < log.GetFrameCount(); frame++)
+	{
+		log.ApplyKeyEvents(frame, *keyboard);
+		controller.ProcessInput();
+
+		const auto dt = log.GetDeltaTime(frame);
+
+		world->PublishSnapshot();
+
+		const auto start = Profiler::GetTime();
+		world->UpdateFrame(dt);
+		statistics.Record(simulationPhase, Profiler::GetTime() - start);
+
+		simulatedTime += static_cast<double>(dt) * world->GetTimeScale();
+	}
+
+	const auto checksum = world->GetStateChecksum();
+	const auto matched = checksum == log.GetFinalChecksum();
+
+	output << "Replayed " << log.GetFrameCount() << " frames of " << logFileName << " on " << jobSystem.GetThreadCount() << " threads" << endl;
+	output << "Simulated time:    " << simulatedTime << " s" << endl;
+	output << "Collisions:        " << world->GetCollisionCount() << endl;
+	output << "Terrain cubes:     " << world->GetTerrain()->GetCubeCount() << endl;
+	output << "Camera mode:       " << world->GetCameraMode() << endl;
+	output << "Time scale:        " << world->GetTimeScale() << endl;
+	output << "Checksum:          " << hex << setw(16) << setfill('0') << checksum << ", recorded " << setw(16) << log.GetFinalChecksum() << dec << setfill(' ') << (matched ? " (match)" : " (MISMATCH)") << endl;
+
+	statistics.WriteSummary(output);
+
+	if (!statisticsFileName.empty())
+	{
+		const auto json = statisticsFileName.size() >= 5 && statisticsFileName.compare(statisticsFileName.size() - 5, 5, ".json") == 0;
+
+		if (!(json ? statistics.ExportJson(statisticsFileName) : statistics.ExportCsv(statisticsFileName)))
+		{
+			output << "Could not write " << statisticsFileName << endl;
+			return false;
+		}
+	}
+
+	return matched;
+}
+
+bool InputReplay::RecordScript(const shared_ptr<SimulationConfigLoader>& configuration, const string& logFileName, const int frameCount, ostream& output)
+{
+	const auto world = make_shared<SimulationWorld>(configuration);
+	const auto keyboard = make_shared<Keyboard>();
+	InputController controller(keyboard, world);
+
+	InputLog log;
+
+	const auto timeStep = configuration->GetSimulationTimeStep();
+
+	for (auto frame = 0; frame < frameCount; frame++)
+	{
+		for (const auto& event : SCRIPT)
+		{
+			if (event.frame == frame % SCRIPT_LENGTH)
+			{
+				log.AddKeyEvent(event.key, event.pressed);
+
+				if (event.pressed)
+				{
+					keyboard->SetKeyPressed(event.key);
+				}
+				else
+				{
+					keyboard->SetKeyReleased(event.key);
+				}
+			}
+		}
+
+		controller.ProcessInput();
+
+		//Frames mostly on time with a slow one every so often
+		const auto dt = timeStep * (frame % 37 == 0 ? 2.5f : 0.9f + 0.05f * static_cast<float>(frame % 5));
+
+		world->PublishSnapshot();
+		world->UpdateFrame(dt);
+
+		log.EndFrame(dt);
+	}
+
+	log.SetFinalChecksum(world->GetStateChecksum());
+
+	if (!log.Save(logFileName))
+	{
+		output << "Could not write " << logFileName << endl;
+		return false;
+	}
+
+	output << "Recorded " << frameCount << " frames to " << logFileName << ", " << world->GetCollisionCount() << " collisions, checksum " << hex << setw(16) << setfill('0') << log.GetFinalChecksum() << dec << setfill(' ') << endl;
+
+	return true;
+}
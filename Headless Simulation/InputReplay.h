@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include "InputLog.h"
+#include "SimulationConfigLoader.h"
+
+using namespace std;
+
+//Steps a world with the keys and frame times of an input log, recorded by the window when Configuration.txt has
+//an InputRecordFile or by RecordScript. The keys go through the same InputController the window uses so rocket
+//launches, terrain destruction and camera modes all happen on the same frames, and the final state is checked
+//against the checksum the recording ended with. Each frame's step is timed so a change can be measured on exactly
+//the same workload before and after
+class InputReplay
+{
+public:
+	InputReplay(const shared_ptr<SimulationConfigLoader>& configuration, const string& logFileName, const int threadCount, const string& statisticsFileName);
+	InputReplay(const InputReplay& other); // Copy Constructor
+	InputReplay(InputReplay&& other) noexcept; // Move Constructor
+	~InputReplay(); // Destructor
+
+	InputReplay& operator = (const InputReplay& other); // Copy Assignment Operator
+	InputReplay& operator = (InputReplay&& other) noexcept; // Move Assignment Operator
+
+	//Returns false if the log couldn't be read, the replay ended in a different state or the statistics couldn't be written
+	bool Run(ostream& output) const;
+
+	//Records frameCount frames of a fixed session, launching, rotating, resetting, changing the camera and the time
+	//scale, with frame times that vary the way a window's do. Gives a workload to replay without running the window
+	static bool RecordScript(const shared_ptr<SimulationConfigLoader>& configuration, const string& logFileName, const int frameCount, ostream& output);
+
+private:
+	shared_ptr<SimulationConfigLoader> configuration;
+
+	string logFileName;
+	int threadCount;
+	string statisticsFileName;
+};
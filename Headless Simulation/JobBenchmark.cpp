@@ -0,0 +1,160 @@
+#include "JobBenchmark.h"
+#include <chrono>
+#include <iomanip>
+
+#include "SimulationWorld.h"
+
+//Roughly the scene at Configuration.txt's terrain size, plus the particle emitters
+static const int TERRAIN_INSTANCE_COUNT = 220 * 33 * 55;
+static const int TERRAIN_CHUNK_SIZE = 4096;
+static const int OBJECT_COUNT = 32;
+static const int OBJECT_INSTANCE_COUNT = 512;
+static const int EMITTER_COUNT = 16;
+static const int EMITTER_PARTICLE_COUNT = 8192;
+
+JobBenchmark::JobBenchmark(const shared_ptr<SimulationConfigLoader>& configuration, const int frameCount, const int maxThreadCount) : configuration(configuration), frameCount(frameCount), maxThreadCount(maxThreadCount)
+{
+}
+
+JobBenchmark::JobBenchmark(const JobBenchmark& other) = default;
+
+JobBenchmark::JobBenchmark(JobBenchmark&& other) noexcept = default;
+
+JobBenchmark::~JobBenchmark() = default;
+
+JobBenchmark& JobBenchmark::operator=(const JobBenchmark& other) = default;
+
+JobBenchmark& JobBenchmark::operator=(JobBenchmark&& other) noexcept = default;
+
+void JobBenchmark::Run(ostream& output) const
+{
+	output << "Job system benchmark, " << frameCount << " frames, " << TERRAIN_INSTANCE_COUNT << " terrain instances, " << OBJECT_COUNT << " objects, " << EMITTER_COUNT << " emitters" << endl;
+	output << setw(8) << "Threads" << setw(12) << "Frame ms" << setw(10) << "Speedup" << setw(13) << "Efficiency" << setw(16) << "Checksum" << endl;
+
+	auto singleThreadMs = 0.0;
+
+	for (auto threadCount = 1; threadCount <= maxThreadCount; threadCount++)
+	{
+		auto checksum = 0.0;
+		const auto frameMs = Time(threadCount, checksum);
+
+		if (threadCount == 1)
+		{
+			singleThreadMs = frameMs;
+		}
+
+		const auto speedup = singleThreadMs / frameMs;
+
+		output << setw(8) << threadCount << fixed << setprecision(3) << setw(12) << frameMs << setprecision(2) << setw(9) << speedup << "x" << setw(12) << speedup / threadCount * 100.0 << "%" << setprecision(1) << setw(16) << checksum << defaultfloat << endl;
+	}
+}
+
+double JobBenchmark::Time(const int threadCount, double& outChecksum) const
+{
+	JobSystem jobSystem(threadCount - 1);
+
+	SimulationWorld world(configuration);
+	world.SetJobSystem(&jobSystem);
+
+	vector<XMFLOAT3> terrainPositions(TERRAIN_INSTANCE_COUNT);
+
+	for (auto i = 0; i < TERRAIN_INSTANCE_COUNT; i++)
+	{
+		terrainPositions[i] = XMFLOAT3(static_cast<float>(i % 220), -static_cast<float>(i / 220 % 33), static_cast<float>(i / (220 * 33)));
+	}
+
+	const vector<XMFLOAT3> unitScale = { XMFLOAT3(1.0f, 1.0f, 1.0f) };
+	const vector<XMFLOAT3> noRotation = { XMFLOAT3(0.0f, 0.0f, 0.0f) };
+
+	vector<XMFLOAT4X4> terrainMatrices(TERRAIN_INSTANCE_COUNT);
+	vector<vector<XMFLOAT3>> objectRotations(OBJECT_COUNT, vector<XMFLOAT3>(OBJECT_INSTANCE_COUNT));
+	vector<vector<XMFLOAT4X4>> objectMatrices(OBJECT_COUNT, vector<XMFLOAT4X4>(OBJECT_INSTANCE_COUNT));
+	const vector<XMFLOAT3> objectPositions(OBJECT_INSTANCE_COUNT, XMFLOAT3(1.0f, 2.0f, 3.0f));
+	vector<ParticlePool> emitters(EMITTER_COUNT, ParticlePool(EMITTER_PARTICLE_COUNT));
+
+	vector<JobHandle> frameJobs;
+
+	const auto dt = configuration->GetSimulationTimeStep();
+
+	//The first frame is untimed so thread start up and first touches of memory aren't counted
+	auto start = chrono::steady_clock::now();
+
+	for (auto frame = -1; frame < frameCount; frame++)
+	{
+		if (frame == 0)
+		{
+			start = chrono::steady_clock::now();
+		}
+
+		frameJobs.clear();
+
+		const auto simulationJob = jobSystem.Add([&world, dt]()
+		{
+			if (!world.GetRocket()->RocketLaunched())
+			{
+				world.LaunchRocket();
+			}
+
+			world.UpdateFrame(dt);
+		});
+
+		frameJobs.push_back(simulationJob);
+
+		for (auto i = 0; i < OBJECT_COUNT; i++)
+		{
+			frameJobs.push_back(jobSystem.Add([&objectRotations, &objectMatrices, &objectPositions, &unitScale, i, frame]()
+			{
+				for (auto& rotation : objectRotations[i])
+				{
+					rotation.y = 0.01f * (frame + i);
+				}
+
+				WorldMatrixBatch::Compose(unitScale, objectRotations[i], objectPositions, XMMatrixIdentity(), objectMatrices[i].data());
+			}));
+		}
+
+		for (auto& emitter : emitters)
+		{
+			auto* const pool = &emitter;
+
+			frameJobs.push_back(jobSystem.Add([pool, dt]()
+			{
+				while (pool->GetCount() < pool->GetCapacity())
+				{
+					pool->Spawn(XMFLOAT3(), XMFLOAT3());
+				}
+
+				pool->Advance(XMFLOAT3(0.0f, 2.0f, 0.0f), XMFLOAT3(1.0f, 1.0f, 1.0f), 2.0f, dt);
+			}));
+		}
+
+		//Like the terrain game object, this reads the simulation so it waits for it, then splits its matrices into chunks
+		frameJobs.push_back(jobSystem.Add([&jobSystem, &terrainPositions, &terrainMatrices, &unitScale, &noRotation, &world]()
+		{
+			const auto parentMatrix = XMMatrixTranslation(0.0f, static_cast<float>(world.GetCollisionCount()), 0.0f);
+
+			jobSystem.ParallelFor(TERRAIN_INSTANCE_COUNT, TERRAIN_CHUNK_SIZE, [&](const int first, const int last)
+			{
+				WorldMatrixBatch::ComposeRange(unitScale, noRotation, terrainPositions, parentMatrix, first, last - first, terrainMatrices.data());
+			});
+		}, simulationJob));
+
+		jobSystem.Wait(frameJobs);
+	}
+
+	const auto elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+	outChecksum = 0.0;
+
+	for (auto i = 0; i < TERRAIN_INSTANCE_COUNT; i += 97)
+	{
+		outChecksum += terrainMatrices[i].m[0][3] + terrainMatrices[i].m[1][3] + terrainMatrices[i].m[2][3];
+	}
+
+	for (const auto& matrices : objectMatrices)
+	{
+		outChecksum += matrices[0].m[0][0] + matrices[0].m[0][2];
+	}
+
+	return elapsedMs / frameCount;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <ostream>
+#include <vector>
+
+#include "JobSystem.h"
+#include "ParticlePool.h"
+#include "SimulationConfigLoader.h"
+#include "WorldMatrixBatch.h"
+
+using namespace DirectX;
+using namespace std;
+
+//Times a frame shaped like GraphicsRenderer's update phases on job systems of 1 to maxThreadCount threads.
+//The simulation steps as one job with its lights as jobs of their own, the terrain's matrices are built in
+//chunks and a set of smaller objects and particle emitters each update as a job
+class JobBenchmark
+{
+public:
+	JobBenchmark(const shared_ptr<SimulationConfigLoader>& configuration, const int frameCount, const int maxThreadCount);
+	JobBenchmark(const JobBenchmark& other); // Copy Constructor
+	JobBenchmark(JobBenchmark&& other) noexcept; // Move Constructor
+	~JobBenchmark(); // Destructor
+
+	JobBenchmark& operator = (const JobBenchmark& other); // Copy Assignment Operator
+	JobBenchmark& operator = (JobBenchmark&& other) noexcept; // Move Assignment Operator
+
+	void Run(ostream& output) const;
+
+private:
+	//Milliseconds per frame, outChecksum sums the last frame's matrices so every thread count can be compared
+	double Time(const int threadCount, double& outChecksum) const;
+
+	shared_ptr<SimulationConfigLoader> configuration;
+
+	int frameCount;
+	int maxThreadCount;
+};
@@ -0,0 +1,111 @@
+#include "ParticleBenchmark.h"
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <random>
+
+//Smoke grows from nothing to the kill scale in two seconds at 60 frames a second
+static const XMFLOAT3 VELOCITY = XMFLOAT3(0.0f, 2.0f, 0.0f);
+static const XMFLOAT3 SCALE_RATE = XMFLOAT3(1.0f, 1.0f, 1.0f);
+static const float KILL_SCALE = 2.0f;
+static const float DT = 1.0f / 60.0f;
+
+ParticleBenchmark::ParticleBenchmark(const int frameCount) : frameCount(frameCount)
+{
+}
+
+ParticleBenchmark::ParticleBenchmark(const ParticleBenchmark& other) = default;
+
+ParticleBenchmark::ParticleBenchmark(ParticleBenchmark&& other) noexcept = default;
+
+ParticleBenchmark::~ParticleBenchmark() = default;
+
+ParticleBenchmark& ParticleBenchmark::operator=(const ParticleBenchmark& other) = default;
+
+ParticleBenchmark& ParticleBenchmark::operator=(ParticleBenchmark&& other) noexcept = default;
+
+void ParticleBenchmark::Run(ostream& output) const
+{
+	const int particleCounts[] = { 1000, 100000, 1000000 };
+
+	output << "Particle benchmark, " << frameCount << " frames, " << ParticlePool::GetLaneCount() << " particles per instruction" << endl;
+	output << setw(10) << "Particles" << setw(11) << "Retire" << setw(12) << "Scalar us" << setw(10) << "SIMD us" << setw(10) << "Speedup" << setw(13) << "ns/particle" << setw(15) << "Particles/ms" << setw(12) << "Retired" << setw(12) << "Mismatches" << endl;
+
+	for (const auto particleCount : particleCounts)
+	{
+		for (auto scattered = 0; scattered < 2; scattered++)
+		{
+			ParticlePool scalarPool(particleCount);
+			ParticlePool lanesPool(particleCount);
+
+			FillPool(scalarPool, scattered != 0);
+			FillPool(lanesPool, scattered != 0);
+
+			auto scalarRetired = 0;
+			auto lanesRetired = 0;
+
+			const auto scalarUs = Time(scalarPool, false, scalarRetired);
+			const auto lanesUs = Time(lanesPool, true, lanesRetired);
+
+			const auto nsPerParticle = lanesUs * 1000.0 / particleCount;
+			const auto mismatches = CountMismatches(scalarPool, lanesPool) + (scalarRetired != lanesRetired ? 1 : 0);
+
+			output << setw(10) << particleCount << setw(11) << (scattered ? "Scattered" : "Oldest") << fixed << setprecision(2) << setw(12) << scalarUs << setw(10) << lanesUs << setw(9) << scalarUs / lanesUs << "x" << setprecision(3) << setw(13) << nsPerParticle << setprecision(0) << setw(15) << 1000000.0 / nsPerParticle << setw(12) << lanesRetired / frameCount << setw(12) << mismatches << defaultfloat << endl;
+		}
+	}
+}
+
+void ParticleBenchmark::FillPool(ParticlePool& pool, const bool scattered)
+{
+	mt19937 generator(1234);
+	uniform_real_distribution<float> scaleDistribution(0.0f, KILL_SCALE);
+
+	pool.Clear();
+
+	for (auto i = 0; i < pool.GetCapacity(); i++)
+	{
+		//Oldest first, so without scattering the scale falls from the kill scale towards nothing
+		const auto scale = scattered ? scaleDistribution(generator) : KILL_SCALE * (pool.GetCapacity() - i) / pool.GetCapacity();
+
+		pool.Spawn(XMFLOAT3(0.0f, scale, 0.0f), XMFLOAT3(scale, scale, scale));
+	}
+}
+
+double ParticleBenchmark::Time(ParticlePool& pool, const bool useLanes, int& outRetiredCount) const
+{
+	auto elapsed = chrono::steady_clock::duration::zero();
+
+	outRetiredCount = 0;
+
+	for (auto frame = 0; frame < frameCount; frame++)
+	{
+		const auto start = chrono::steady_clock::now();
+
+		outRetiredCount += useLanes ? pool.Advance(VELOCITY, SCALE_RATE, KILL_SCALE, DT) : pool.AdvanceScalar(VELOCITY, SCALE_RATE, KILL_SCALE, DT);
+
+		elapsed += chrono::steady_clock::now() - start;
+
+		while (pool.GetCount() < pool.GetCapacity())
+		{
+			pool.Spawn(XMFLOAT3(), XMFLOAT3());
+		}
+	}
+
+	return chrono::duration<double, micro>(elapsed).count() / frameCount;
+}
+
+int ParticleBenchmark::CountMismatches(const ParticlePool& a, const ParticlePool& b)
+{
+	auto mismatches = 0;
+
+	//Both paths do the same float adds so they should agree exactly, slot for slot
+	for (auto i = 0; i < a.GetCapacity(); i++)
+	{
+		if (memcmp(&a.GetPositions()[i], &b.GetPositions()[i], sizeof(XMFLOAT3)) != 0 || memcmp(&a.GetScales()[i], &b.GetScales()[i], sizeof(XMFLOAT3)) != 0 || a.GetAges()[i] != b.GetAges()[i])
+		{
+			mismatches++;
+		}
+	}
+
+	return mismatches;
+}
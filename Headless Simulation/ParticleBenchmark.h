@@ -0,0 +1,36 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <ostream>
+
+#include "ParticlePool.h"
+
+using namespace DirectX;
+using namespace std;
+
+//Times ParticlePool::Advance against the one particle at a time update for pools of 1k, 100k and 1M particles,
+//with particles retired oldest first like the smoke emitters and scattered through the pool
+class ParticleBenchmark
+{
+public:
+	explicit ParticleBenchmark(const int frameCount);
+	ParticleBenchmark(const ParticleBenchmark& other); // Copy Constructor
+	ParticleBenchmark(ParticleBenchmark&& other) noexcept; // Move Constructor
+	~ParticleBenchmark(); // Destructor
+
+	ParticleBenchmark& operator = (const ParticleBenchmark& other); // Copy Assignment Operator
+	ParticleBenchmark& operator = (ParticleBenchmark&& other) noexcept; // Move Assignment Operator
+
+	void Run(ostream& output) const;
+
+private:
+	//Full pool, scattered gives every particle a random starting scale instead of one that grows with its age
+	static void FillPool(ParticlePool& pool, const bool scattered);
+
+	//Microseconds per frame spent in the update, the pool is topped back up after every frame outside of the timing
+	double Time(ParticlePool& pool, const bool useLanes, int& outRetiredCount) const;
+
+	static int CountMismatches(const ParticlePool& a, const ParticlePool& b);
+
+	int frameCount;
+};
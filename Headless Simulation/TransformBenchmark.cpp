@@ -0,0 +1,95 @@
+#include "TransformBenchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <random>
+
+TransformBenchmark::TransformBenchmark(const int instanceCount, const int repeatCount) : instanceCount(instanceCount), repeatCount(repeatCount)
+{
+}
+
+TransformBenchmark::TransformBenchmark(const TransformBenchmark& other) = default;
+
+TransformBenchmark::TransformBenchmark(TransformBenchmark&& other) noexcept = default;
+
+TransformBenchmark::~TransformBenchmark() = default;
+
+TransformBenchmark& TransformBenchmark::operator=(const TransformBenchmark& other) = default;
+
+TransformBenchmark& TransformBenchmark::operator=(TransformBenchmark&& other) noexcept = default;
+
+void TransformBenchmark::Run(ostream& output) const
+{
+	mt19937 generator(1234);
+	uniform_real_distribution<float> positionDistribution(-100.0f, 100.0f);
+	uniform_real_distribution<float> rotationDistribution(-XM_2PI, XM_2PI);
+	uniform_real_distribution<float> scaleDistribution(0.5f, 2.0f);
+
+	vector<XMFLOAT3> positions, rotations, scales;
+
+	for (auto i = 0; i < instanceCount; i++)
+	{
+		positions.emplace_back(XMFLOAT3(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator)));
+		rotations.emplace_back(XMFLOAT3(rotationDistribution(generator), rotationDistribution(generator), rotationDistribution(generator)));
+		scales.emplace_back(XMFLOAT3(scaleDistribution(generator), scaleDistribution(generator), scaleDistribution(generator)));
+	}
+
+	const vector<XMFLOAT3> sharedScale = { XMFLOAT3(1.0f, 1.0f, 1.0f) };
+	const vector<XMFLOAT3> sharedRotation = { XMFLOAT3(0.0f, 0.0f, 0.0f) };
+
+	//Same sort of parent the rocket parts get
+	const auto parentMatrix = XMMatrixMultiply(XMMatrixRotationQuaternion(XMQuaternionRotationRollPitchYaw(0.0f, 0.0f, -0.4f)), XMMatrixTranslation(-40.0f, 3.0f, 0.0f));
+
+	vector<XMFLOAT4X4> reference(instanceCount), scalar(instanceCount), batched(instanceCount);
+
+	output << "World matrix benchmark, " << instanceCount << " instances, " << repeatCount << " runs, " << WorldMatrixBatch::GetBlockSize() << " instances per block" << endl;
+	output << setw(22) << "Case" << setw(14) << "Reference ns" << setw(11) << "Scalar ns" << setw(12) << "Batched ns" << setw(10) << "Speedup" << setw(14) << "Max error" << endl;
+
+	for (auto shared = 0; shared < 2; shared++)
+	{
+		const auto& caseScales = shared ? sharedScale : scales;
+		const auto& caseRotations = shared ? sharedRotation : rotations;
+
+		const auto referenceNs = Time(&WorldMatrixBatch::ComposeReference, caseScales, caseRotations, positions, parentMatrix, reference);
+		const auto scalarNs = Time(&WorldMatrixBatch::ComposeScalar, caseScales, caseRotations, positions, parentMatrix, scalar);
+		const auto batchedNs = Time(&WorldMatrixBatch::Compose, caseScales, caseRotations, positions, parentMatrix, batched);
+
+		const auto largestDifference = max(GetLargestDifference(reference, scalar), GetLargestDifference(reference, batched));
+
+		output << setw(22) << (shared ? "Shared scale/rotation" : "Per instance") << fixed << setprecision(2) << setw(14) << referenceNs << setw(11) << scalarNs << setw(12) << batchedNs << setw(9) << referenceNs / batchedNs << "x" << scientific << setprecision(2) << setw(14) << largestDifference << defaultfloat << endl;
+	}
+}
+
+double TransformBenchmark::Time(const ComposeFunction compose, const vector<XMFLOAT3>& scales, const vector<XMFLOAT3>& rotations, const vector<XMFLOAT3>& positions, const XMMATRIX& parentMatrix, vector<XMFLOAT4X4>& outMatrices) const
+{
+	//One untimed run to warm the caches
+	compose(scales, rotations, positions, parentMatrix, outMatrices.data());
+
+	const auto start = chrono::steady_clock::now();
+
+	for (auto i = 0; i < repeatCount; i++)
+	{
+		compose(scales, rotations, positions, parentMatrix, outMatrices.data());
+	}
+
+	return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / (static_cast<double>(repeatCount) * positions.size());
+}
+
+float TransformBenchmark::GetLargestDifference(const vector<XMFLOAT4X4>& a, const vector<XMFLOAT4X4>& b)
+{
+	auto largest = 0.0f;
+
+	for (size_t i = 0; i < a.size(); i++)
+	{
+		for (auto row = 0; row < 4; row++)
+		{
+			for (auto column = 0; column < 4; column++)
+			{
+				largest = max(largest, fabs(a[i].m[row][column] - b[i].m[row][column]));
+			}
+		}
+	}
+
+	return largest;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <ostream>
+#include <vector>
+
+#include "WorldMatrixBatch.h"
+
+using namespace DirectX;
+using namespace std;
+
+//Times the batched instance world matrices against the per instance DirectXMath path Model used to take, for the
+//terrain's case of one shared scale and rotation and for every instance having its own
+class TransformBenchmark
+{
+public:
+	TransformBenchmark(const int instanceCount, const int repeatCount);
+	TransformBenchmark(const TransformBenchmark& other); // Copy Constructor
+	TransformBenchmark(TransformBenchmark&& other) noexcept; // Move Constructor
+	~TransformBenchmark(); // Destructor
+
+	TransformBenchmark& operator = (const TransformBenchmark& other); // Copy Assignment Operator
+	TransformBenchmark& operator = (TransformBenchmark&& other) noexcept; // Move Assignment Operator
+
+	void Run(ostream& output) const;
+
+private:
+	typedef void (*ComposeFunction)(const vector<XMFLOAT3>&, const vector<XMFLOAT3>&, const vector<XMFLOAT3>&, const XMMATRIX&, XMFLOAT4X4* const);
+
+	//Nanoseconds per instance, averaged over repeatCount runs
+	double Time(const ComposeFunction compose, const vector<XMFLOAT3>& scales, const vector<XMFLOAT3>& rotations, const vector<XMFLOAT3>& positions, const XMMATRIX& parentMatrix, vector<XMFLOAT4X4>& outMatrices) const;
+
+	static float GetLargestDifference(const vector<XMFLOAT4X4>& a, const vector<XMFLOAT4X4>& b);
+
+	int instanceCount;
+	int repeatCount;
+};